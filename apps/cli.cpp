@@ -273,6 +273,15 @@ std::optional<hpoea::core::ExperimentConfig> make_experiment_config(
     config.optimizer_budget = to_core_budget(run.optimizer_budget);
     config.log_file_path = run.planned_output_path;
     config.random_seed = *seed;
+    if (const auto kind = hpoea::core::parse_batch_evaluator_kind(run.batch_evaluator)) {
+        config.batch_evaluator.kind = *kind;
+    }
+    config.share_initial_population = run.share_initial_population;
+    if (run.seed_repeats) {
+        config.seed_repeats = hpoea::core::SeedRepeatPolicy{
+            run.seed_repeats->min_repeats, run.seed_repeats->max_repeats, run.seed_repeats->relative_margin,
+            run.seed_repeats->absolute_margin, run.seed_repeats->parallel_repeats};
+    }
     // baseline applies fixed parameters itself
     if (optimizer->type != "baseline" && !algorithm->fixed_parameters.empty()) {
         config.algorithm_baseline_parameters = algorithm->fixed_parameters;
@@ -575,11 +584,16 @@ int run_config(const std::filesystem::path &path, const RunOptions &options) {
             std::size_t records_written = 0;
             {
                 hpoea::core::JsonlLogger logger{experiment_config->log_file_path};
+                // a problem-set run hands its first instance to optimize()
+                experiment_config->problem_set = prepared.dispatch.problem_set;
+                const auto &problem = prepared.dispatch.problem
+                                          ? *prepared.dispatch.problem
+                                          : *prepared.dispatch.problem_set->instances().front().problem;
                 result = manager.run_experiment(
                     *experiment_config,
                     *prepared.dispatch.optimizer,
                     *prepared.dispatch.algorithm_factory,
-                    *prepared.dispatch.problem,
+                    problem,
                     logger);
                 records_written = logger.records_written();
             }
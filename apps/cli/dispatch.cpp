@@ -2,7 +2,14 @@
 
 #include "hpoea/config/supported_types.hpp"
 #include "hpoea/core/baseline_optimizer.hpp"
+#include "hpoea/core/bayesian_optimizer.hpp"
+#include "hpoea/core/grid_search_optimizer.hpp"
+#include "hpoea/core/hyperband_optimizer.hpp"
+#include "hpoea/core/parallel_tempering_optimizer.hpp"
+#include "hpoea/core/pbt_optimizer.hpp"
+#include "hpoea/core/racing_optimizer.hpp"
 #include "hpoea/core/random_search_optimizer.hpp"
+#include "hpoea/core/tpe_optimizer.hpp"
 #include "hpoea/core/search_space.hpp"
 #include "hpoea/wrappers/problems/benchmark_problems.hpp"
 
@@ -34,6 +41,7 @@ using hpoea::config::AlgorithmSpec;
 using hpoea::config::ConfigValue;
 using hpoea::config::OptimizerSpec;
 using hpoea::config::ProblemParameterSet;
+using hpoea::config::ProblemSetSpec;
 using hpoea::config::ProblemSpec;
 using hpoea::config::ResolvedRunSpec;
 using hpoea::config::SearchParameterMode;
@@ -65,6 +73,28 @@ const ProblemSpec *find_problem(const SuiteConfig &config,
     return nullptr;
 }
 
+const ProblemSetSpec *find_problem_set(const SuiteConfig &config,
+                                       std::string_view id) {
+    for (const auto &problem_set : config.problem_sets) {
+        if (problem_set.id == id) {
+            return &problem_set;
+        }
+    }
+    return nullptr;
+}
+
+// a set runs when every listed problem does
+hpoea::cli::ComponentDispatch annotate_problem_set(const SuiteConfig &config,
+                                                   const ProblemSetSpec &problem_set) {
+    for (const auto &id : problem_set.problems) {
+        const auto *problem = find_problem(config, id);
+        if (!problem || !contains(benchmark_problem_type_ids, problem->type)) {
+            return {problem_set.id, "problem_set", "core", "unsupported", false};
+        }
+    }
+    return {problem_set.id, "problem_set", "core", "supported", true};
+}
+
 hpoea::cli::ComponentDispatch annotate_problem(const ProblemSpec *problem,
                                                std::string_view id) {
     if (!problem) {
@@ -103,7 +133,9 @@ hpoea::cli::ComponentDispatch annotate_optimizer(const OptimizerSpec *optimizer,
     if (!optimizer) {
         return {std::string{id}, "<missing>", "missing", "unsupported", false};
     }
-    if (optimizer->type == "random_search" || optimizer->type == "baseline") {
+    if (optimizer->type == "random_search" || optimizer->type == "hyperband" || optimizer->type == "bayesian" ||
+        optimizer->type == "tpe" || optimizer->type == "racing" || optimizer->type == "grid_search" ||
+        optimizer->type == "pbt" || optimizer->type == "parallel_tempering" || optimizer->type == "baseline") {
         return {optimizer->id, optimizer->type, "core", "supported", true};
     }
     if (contains(pagmo_optimizer_type_ids, optimizer->type)) {
@@ -139,6 +171,47 @@ std::unique_ptr<hpoea::core::IProblem> make_problem(const ProblemSpec &problem,
     }
 }
 
+std::shared_ptr<hpoea::core::ProblemSet> make_problem_set(const SuiteConfig &config,
+                                                          const ProblemSetSpec &problem_set,
+                                                          std::vector<std::string> &errors) {
+    const auto aggregation = hpoea::core::parse_problem_set_aggregation(problem_set.aggregation);
+    if (!aggregation) {
+        errors.push_back("problem_sets." + problem_set.id + ": unknown aggregation: " + problem_set.aggregation);
+        return nullptr;
+    }
+    std::vector<hpoea::core::ProblemSetInstance> instances;
+    for (std::size_t i = 0; i < problem_set.problems.size(); ++i) {
+        const auto *problem = find_problem(config, problem_set.problems[i]);
+        if (!problem) {
+            add_missing_error(errors, "problem", problem_set.problems[i]);
+            return nullptr;
+        }
+        auto made = make_problem(*problem, errors);
+        if (!made) {
+            return nullptr;
+        }
+        hpoea::core::ProblemSetInstance instance;
+        instance.problem = std::move(made);
+        if (!problem_set.offsets.empty()) {
+            instance.offset = problem_set.offsets.at(i);
+        }
+        if (!problem_set.scales.empty()) {
+            instance.scale = problem_set.scales.at(i);
+        }
+        if (!problem_set.references.empty()) {
+            instance.reference = problem_set.references.at(i);
+        }
+        instances.push_back(std::move(instance));
+    }
+    try {
+        return std::make_shared<hpoea::core::ProblemSet>(problem_set.id, std::move(instances), *aggregation,
+                                                         problem_set.parallel_instances);
+    } catch (const std::exception &exception) {
+        errors.push_back("problem_sets." + problem_set.id + ": " + exception.what());
+        return nullptr;
+    }
+}
+
 #if defined(HPOEA_CONFIG_HAS_PAGMO)
 std::unique_ptr<hpoea::core::IEvolutionaryAlgorithmFactory> make_pagmo_algorithm_factory(
     std::string_view type) {
@@ -242,6 +315,62 @@ std::unique_ptr<hpoea::core::IHyperparameterOptimizer> make_optimizer(
         return random_search;
     }
 
+    if (optimizer.type == "hyperband") {
+        auto hyperband = std::make_unique<hpoea::core::HyperbandOptimizer>();
+        if (auto search = build_search()) {
+            hyperband->set_search_space(std::move(search));
+        }
+        return hyperband;
+    }
+
+    if (optimizer.type == "bayesian") {
+        auto bayesian = std::make_unique<hpoea::core::BayesianOptimizer>();
+        if (auto search = build_search()) {
+            bayesian->set_search_space(std::move(search));
+        }
+        return bayesian;
+    }
+
+    if (optimizer.type == "tpe") {
+        auto tpe = std::make_unique<hpoea::core::TpeOptimizer>();
+        if (auto search = build_search()) {
+            tpe->set_search_space(std::move(search));
+        }
+        return tpe;
+    }
+
+    if (optimizer.type == "racing") {
+        auto racing = std::make_unique<hpoea::core::RacingOptimizer>();
+        if (auto search = build_search()) {
+            racing->set_search_space(std::move(search));
+        }
+        return racing;
+    }
+
+    if (optimizer.type == "grid_search") {
+        auto grid_search = std::make_unique<hpoea::core::GridSearchOptimizer>();
+        if (auto search = build_search()) {
+            grid_search->set_search_space(std::move(search));
+        }
+        return grid_search;
+    }
+
+    if (optimizer.type == "pbt") {
+        auto pbt = std::make_unique<hpoea::core::PbtOptimizer>();
+        if (auto search = build_search()) {
+            pbt->set_search_space(std::move(search));
+        }
+        return pbt;
+    }
+
+    if (optimizer.type == "parallel_tempering") {
+        auto parallel_tempering = std::make_unique<hpoea::core::ParallelTemperingOptimizer>();
+        if (auto search = build_search()) {
+            parallel_tempering->set_search_space(std::move(search));
+        }
+        return parallel_tempering;
+    }
+
     if (optimizer.type == "baseline") {
         if (algorithm.fixed_parameters.empty()) {
             return std::make_unique<hpoea::core::BaselineOptimizer>();
@@ -297,8 +426,8 @@ std::optional<std::size_t> tuned_algorithm_dimension(const AlgorithmSpec &algori
             continue;
         }
         const auto it = algorithm.search_parameters.find(descriptor.name);
-        if (it != algorithm.search_parameters.end() &&
-            it->second.mode == SearchParameterMode::Exclude) {
+        if (it == algorithm.search_parameters.end() ? !descriptor.tuned_by_default
+                                                    : it->second.mode == SearchParameterMode::Exclude) {
             continue;
         }
         dimension += 1;
@@ -333,7 +462,11 @@ const config::OptimizerSpec *find_optimizer(const config::SuiteConfig &config,
 RunDispatch annotate_run_dispatch(const SuiteConfig &config,
                                   const ResolvedRunSpec &run) {
     RunDispatch annotation;
-    annotation.problem = annotate_problem(find_problem(config, run.problem_id), run.problem_id);
+    if (const auto *problem_set = find_problem_set(config, run.problem_id)) {
+        annotation.problem = annotate_problem_set(config, *problem_set);
+    } else {
+        annotation.problem = annotate_problem(find_problem(config, run.problem_id), run.problem_id);
+    }
     annotation.algorithm = annotate_algorithm(find_algorithm(config, run.algorithm_id), run.algorithm_id);
     annotation.optimizer = annotate_optimizer(find_optimizer(config, run.optimizer_id), run.optimizer_id);
     annotation.runnable = annotation.problem.runnable
@@ -346,10 +479,11 @@ DispatchResult make_dispatch_objects(const SuiteConfig &config,
                                       const ResolvedRunSpec &run) {
     DispatchResult result;
     const auto *problem = find_problem(config, run.problem_id);
+    const auto *problem_set = find_problem_set(config, run.problem_id);
     const auto *algorithm = find_algorithm(config, run.algorithm_id);
     const auto *optimizer = find_optimizer(config, run.optimizer_id);
 
-    if (!problem) {
+    if (!problem && !problem_set) {
         add_missing_error(result.errors, "problem", run.problem_id);
     }
     if (!algorithm) {
@@ -363,7 +497,11 @@ DispatchResult make_dispatch_objects(const SuiteConfig &config,
     }
 
     try {
-        result.objects.problem = make_problem(*problem, result.errors);
+        if (problem) {
+            result.objects.problem = make_problem(*problem, result.errors);
+        } else {
+            result.objects.problem_set = make_problem_set(config, *problem_set, result.errors);
+        }
         result.objects.algorithm_factory = make_algorithm_factory(*algorithm, result.errors);
         // make_optimizer tolerates a null factory
         // so optimizer error still gets reported
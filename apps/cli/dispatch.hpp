@@ -4,6 +4,7 @@
 #include "hpoea/core/evolution_algorithm.hpp"
 #include "hpoea/core/hyperparameter_optimizer.hpp"
 #include "hpoea/core/problem.hpp"
+#include "hpoea/core/problem_set.hpp"
 
 #include <cstddef>
 #include <memory>
@@ -29,8 +30,10 @@ struct RunDispatch {
     bool runnable{false};
 };
 
+// a run names either a problem or a problem set
 struct DispatchObjects {
     std::unique_ptr<core::IProblem> problem;
+    std::shared_ptr<core::ProblemSet> problem_set;
     std::unique_ptr<core::IEvolutionaryAlgorithmFactory> algorithm_factory;
     std::unique_ptr<core::IHyperparameterOptimizer> optimizer;
 };
@@ -41,7 +44,7 @@ struct DispatchResult {
 
     [[nodiscard]] bool ok() const noexcept {
         return errors.empty()
-            && objects.problem != nullptr
+            && (objects.problem != nullptr || objects.problem_set != nullptr)
             && objects.algorithm_factory != nullptr
             && objects.optimizer != nullptr;
     }
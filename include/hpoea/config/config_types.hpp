@@ -60,6 +60,29 @@ struct ProblemSpec {
     ProblemParameterSet parameters;
 };
 
+// experiments name a problem set like a problem
+// offsets and scales are empty or hold one value per problem
+struct ProblemSetSpec {
+    std::string id;
+    std::vector<std::string> problems;
+    // "mean_rank", "mean_normalized" or "worst_case"
+    std::string aggregation{"mean_normalized"};
+    std::vector<double> offsets;
+    std::vector<double> scales;
+    // one array of reference objective values per problem, for mean_rank
+    std::vector<std::vector<double>> references;
+    std::size_t parallel_instances{1};
+};
+
+// mirrors core::SeedRepeatPolicy
+struct SeedRepeatsConfig {
+    std::size_t min_repeats{1};
+    std::size_t max_repeats{1};
+    double relative_margin{0.1};
+    double absolute_margin{0.0};
+    std::size_t parallel_repeats{1};
+};
+
 struct AlgorithmSpec {
     std::string id;
     std::string type;
@@ -82,6 +105,10 @@ struct ExperimentSpec {
     std::optional<std::size_t> validation_repeats;
     std::optional<std::uint64_t> seed;
     std::optional<std::string> output_name;
+    // "none" or "thread"
+    std::optional<std::string> batch_evaluator;
+    std::optional<bool> share_initial_population;
+    std::optional<SeedRepeatsConfig> seed_repeats;
     std::optional<BudgetConfig> algorithm_budget;
     std::optional<BudgetConfig> optimizer_budget;
 };
@@ -96,6 +123,9 @@ struct ResolvedRunSpec {
     std::size_t validation_repeats{0};
     std::uint64_t seed{0};
     std::string output_name;
+    std::string batch_evaluator{"none"};
+    bool share_initial_population{false};
+    std::optional<SeedRepeatsConfig> seed_repeats;
     std::filesystem::path planned_output_path;
     BudgetConfig algorithm_budget{};
     BudgetConfig optimizer_budget{};
@@ -109,6 +139,7 @@ struct SuiteConfig {
     std::size_t repetitions{1};
     std::size_t validation_repeats{0};
     std::vector<ProblemSpec> problems;
+    std::vector<ProblemSetSpec> problem_sets;
     std::vector<AlgorithmSpec> algorithms;
     std::vector<OptimizerSpec> optimizers;
     std::vector<ExperimentSpec> experiments;
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "hpoea/core/batch_evaluator.hpp"
+#include "hpoea/core/evolution_algorithm.hpp"
+#include "hpoea/core/problem.hpp"
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <vector>
+
+namespace hpoea::core {
+
+// an inner run driven from outside. ask() blocks until the run either wants
+// candidates evaluated or has finished (empty batch), tell() hands the
+// fitness back in ask() order, fail() makes the pending evaluations throw.
+class IAskTellRun {
+public:
+    virtual ~IAskTellRun() = default;
+
+    [[nodiscard]] virtual const std::vector<std::vector<double>> &ask() = 0;
+
+    virtual void tell(const std::vector<double> &fitness) = 0;
+
+    virtual void fail(std::exception_ptr error) = 0;
+
+    // valid once ask() returned an empty batch
+    [[nodiscard]] virtual OptimizationResult result() = 0;
+};
+
+using AskTellRunPtr = std::unique_ptr<IAskTellRun>;
+
+// runs ask/tell to completion with problem.evaluate; native ask/tell
+// algorithms implement run() through this
+[[nodiscard]] OptimizationResult drive_ask_tell(IAskTellRun &run, const IProblem &problem);
+
+// steps runs in lockstep: each round gathers the pending candidates of the
+// active runs into one evaluate_batch call and tells each run its slice
+// back. at most max_active runs (0: one per hardware thread) are active at
+// once, in run order; a finished run makes room for the next. runs from
+// start() that take a batch evaluator ask for a whole batch at a time
+// through one with keep_trajectory set, and so behave as run().
+// if evaluate_batch throws, every run that contributed to the batch fails
+// that evaluation. results are returned in run order.
+[[nodiscard]] std::vector<OptimizationResult> run_interleaved(std::vector<AskTellRunPtr> &runs,
+                                                              const IProblem &problem,
+                                                              const BatchEvaluateFn &evaluate_batch,
+                                                              std::size_t max_active = 0);
+
+} // namespace hpoea::core
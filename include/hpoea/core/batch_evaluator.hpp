@@ -0,0 +1,63 @@
+#pragma once
+
+#include "hpoea/core/problem.hpp"
+
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace hpoea::core {
+
+// evaluates a batch of decision vectors on one problem.
+// must return exactly one fitness per decision vector, in order.
+using BatchEvaluateFn =
+    std::function<std::vector<double>(const IProblem &, const std::vector<std::vector<double>> &)>;
+
+// how population algorithms evaluate a generation.
+// none: one candidate at a time in the run's thread
+// thread: candidates spread over a thread pool, IProblem::evaluate must be
+//         safe to call concurrently (it already is under ParallelExperimentManager)
+// custom: the whole generation goes to evaluate
+enum class BatchEvaluatorKind {
+    None,
+    Thread,
+    Custom
+};
+
+struct BatchEvaluatorConfig {
+    BatchEvaluatorKind kind{BatchEvaluatorKind::None};
+    // required for custom, ignored otherwise
+    BatchEvaluateFn evaluate;
+    // algorithms that batch generations only through a different variant
+    // (pso through pagmo::pso_gen) keep their own one and batch just the
+    // initial population, so the run follows its unbatched trajectory
+    bool keep_trajectory{false};
+};
+
+[[nodiscard]] inline std::string_view to_string(BatchEvaluatorKind kind) noexcept {
+    switch (kind) {
+        case BatchEvaluatorKind::None:
+            return "none";
+        case BatchEvaluatorKind::Thread:
+            return "thread";
+        case BatchEvaluatorKind::Custom:
+            return "custom";
+    }
+    return "none";
+}
+
+[[nodiscard]] inline std::optional<BatchEvaluatorKind> parse_batch_evaluator_kind(std::string_view text) noexcept {
+    if (text == "none") {
+        return BatchEvaluatorKind::None;
+    }
+    if (text == "thread") {
+        return BatchEvaluatorKind::Thread;
+    }
+    if (text == "custom") {
+        return BatchEvaluatorKind::Custom;
+    }
+    return std::nullopt;
+}
+
+} // namespace hpoea::core
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "hpoea/core/hyper_optimizer_base.hpp"
+
+#include <memory>
+
+namespace hpoea::core {
+
+// gaussian process bayesian optimization over the unit-cube encoding of the
+// search space, so log, log2 and sqrt transforms warp the model's inputs.
+// a sobol design seeds the model, then each round proposes batch_size
+// configurations by maximizing expected improvement or a lower confidence
+// bound, with kriging-believer fantasies between the proposals of a batch.
+// acquisition scoring and the batch's trials share parallel_workers threads;
+// trials depend on batch_size but not on the thread count.
+class BayesianOptimizer final : public HyperOptimizerBase {
+public:
+    BayesianOptimizer();
+
+    [[nodiscard]] HyperparameterOptimizerPtr clone() const override {
+        return std::make_unique<BayesianOptimizer>(*this);
+    }
+
+    [[nodiscard]] HyperparameterOptimizationResult optimize(const IEvolutionaryAlgorithmFactory &algorithm_factory,
+                                                            const IProblem &problem, const Budget &optimizer_budget,
+                                                            const Budget &algorithm_budget,
+                                                            unsigned long seed) override;
+};
+
+} // namespace hpoea::core
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+
+namespace hpoea::core {
+
+// where and how often a long inner run saves its state.
+// a checkpointed run steps one generation at a time and writes the file
+// when every_generations or every_wall_time has passed since the last
+// write (every generation when neither is set). restarting the same run
+// with an existing file resumes from it and ends with the same result as
+// an uninterrupted checkpointed run with the same seed.
+// steps keep the algorithm's memory on, so adaptation state carries over
+// as it does inside one evolve() call and the trajectory is the one of an
+// unstepped run. the difference: an unstepped run ends early once its
+// ftol/xtol stop fires, a checkpointed one runs to its generation budget.
+struct CheckpointPolicy {
+    std::filesystem::path path;
+    std::optional<std::size_t> every_generations;
+    std::optional<std::chrono::milliseconds> every_wall_time;
+};
+
+} // namespace hpoea::core
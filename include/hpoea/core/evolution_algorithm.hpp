@@ -1,17 +1,24 @@
 #pragma once
 
+#include "hpoea/core/batch_evaluator.hpp"
 #include "hpoea/core/parameters.hpp"
 #include "hpoea/core/problem.hpp"
+#include "hpoea/core/progress.hpp"
 #include "hpoea/core/types.hpp"
 
 #include <limits>
 #include <memory>
 #include <optional>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
 namespace hpoea::core {
 
+class IAskTellRun;
+class InitialPopulationCache;
+struct InitialPopulation;
+
 struct OptimizationResult {
     RunStatus status{RunStatus::InternalError};
     double best_fitness{std::numeric_limits<double>::infinity()};
@@ -23,6 +30,13 @@ struct OptimizationResult {
     ParameterSet effective_parameters{};
     unsigned long seed{0};
     std::string message;
+    // per-instance results of a problem-set run, in instance order
+    std::vector<OptimizationResult> instance_results;
+    // per-seed results of a repeated run, in repeat order
+    std::vector<OptimizationResult> repeat_results;
+    // the evaluated population the run ended with, set by algorithms
+    // whose set_warm_start returned true
+    std::shared_ptr<const InitialPopulation> final_population;
 };
 
 class IEvolutionaryAlgorithm {
@@ -37,6 +51,38 @@ public:
 
     [[nodiscard]] virtual OptimizationResult run(const IProblem &problem, const Budget &budget, unsigned long seed) = 0;
 
+    // starts an externally stepped run (see ask_tell.hpp). the default runs
+    // a clone through run() on a worker thread and suspends it at every
+    // evaluate call; problem must outlive the returned run.
+    [[nodiscard]] virtual std::unique_ptr<IAskTellRun> start(const IProblem &problem, const Budget &budget,
+                                                             unsigned long seed);
+
+    // population algorithms override this to evaluate whole generations
+    // through the given evaluator; the rest only accept none
+    virtual void set_batch_evaluator(const BatchEvaluatorConfig &config) {
+        if (config.kind != BatchEvaluatorKind::None) {
+            throw std::invalid_argument("algorithm does not support batch evaluators");
+        }
+    }
+
+    // population algorithms take their initial population from cache when
+    // set (null turns it off); others run unchanged
+    virtual void set_initial_population_cache(std::shared_ptr<InitialPopulationCache> cache) { (void)cache; }
+
+    // population algorithms that can continue from an evaluated population
+    // return true: their runs start from start instead of drawing an
+    // initial population (null draws as usual), charge its individuals as
+    // cached evaluations and report their final population. the rest
+    // return false and run unchanged.
+    virtual bool set_warm_start(std::shared_ptr<const InitialPopulation> start) {
+        (void)start;
+        return false;
+    }
+
+    // algorithms with a generation loop report through callback and stop
+    // when it returns false (empty turns it off); others run unchanged
+    virtual void set_progress_callback(ProgressCallback callback) { (void)callback; }
+
     [[nodiscard]] virtual std::unique_ptr<IEvolutionaryAlgorithm> clone() const = 0;
 };
 
@@ -1,11 +1,15 @@
 #pragma once
 
+#include "hpoea/core/batch_evaluator.hpp"
 #include "hpoea/core/hyperparameter_optimizer.hpp"
 #include "hpoea/core/logging.hpp"
+#include "hpoea/core/problem_set.hpp"
 #include "hpoea/core/search_space.hpp"
+#include "hpoea/core/seed_repeats.hpp"
 #include "hpoea/core/types.hpp"
 
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <thread>
 #include <vector>
@@ -25,6 +29,21 @@ struct ExperimentConfig {
     Budget optimizer_budget{};
     std::optional<ParameterSet> optimizer_parameters;
     std::optional<ParameterSet> algorithm_baseline_parameters;
+    // applied to every inner algorithm the factory creates
+    BatchEvaluatorConfig batch_evaluator{};
+    // trials of one optimize() call share evaluated initial populations,
+    // validation runs never do
+    bool share_initial_population{false};
+    // when set, every inner run covers all instances of the set through a
+    // ProblemSetFactory per optimize() call, validation runs included, and
+    // each instance run is logged as its own record. the problem passed to
+    // run_experiment only reaches optimize(); pass one of the instances.
+    std::shared_ptr<const ProblemSet> problem_set;
+    // when set, tuning runs score each configuration by the mean of
+    // repeated inner runs through a SeedRepeatFactory per optimize() call,
+    // outside any problem set. every repeat is logged as its own record;
+    // validation runs stay single runs.
+    std::optional<SeedRepeatPolicy> seed_repeats;
     std::filesystem::path log_file_path;
     std::optional<unsigned long> random_seed;
 };
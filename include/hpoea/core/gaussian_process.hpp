@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace hpoea::core {
+
+// matern 5/2 kernel with one length scale for every coordinate.
+// signal variance is 1 on standardized targets, noise is added to the diagonal.
+struct GaussianProcessKernel {
+    double length_scale{0.2};
+    double noise{1e-6};
+};
+
+struct GaussianProcessPrediction {
+    double mean{0.0};
+    double variance{0.0};
+};
+
+// gaussian process regression on points in the unit cube.
+// the lower cholesky factor is stored row by row, so add() extends it
+// with one forward solve in O(n^2) instead of refactoring in O(n^3).
+// targets are kept apart from points: set_targets() standardizes them and
+// solves for the weights in O(n^2), so a changing mean, scale or imputed
+// failure value never touches the factor. predict() is const and may run
+// concurrently when every thread passes its own scratch vector.
+class GaussianProcess {
+public:
+    explicit GaussianProcess(std::size_t dimension, GaussianProcessKernel kernel = {});
+
+    [[nodiscard]] std::size_t dimension() const noexcept { return dimension_; }
+    [[nodiscard]] std::size_t size() const noexcept { return points_.size() / (dimension_ == 0 ? 1 : dimension_); }
+    [[nodiscard]] const GaussianProcessKernel &kernel() const noexcept { return kernel_; }
+
+    void add(const std::vector<double> &point);
+
+    // one target per added point, in the order they were added
+    void set_targets(const std::vector<double> &targets);
+
+    // needs set_targets() after the last add()
+    [[nodiscard]] GaussianProcessPrediction predict(const std::vector<double> &point,
+                                                    std::vector<double> &scratch) const;
+
+    // of the standardized targets, needs set_targets() after the last add()
+    [[nodiscard]] double log_marginal_likelihood() const;
+
+    // refactors every point under a new kernel and keeps the targets
+    void set_kernel(GaussianProcessKernel kernel);
+
+    // the grid kernel with the highest marginal likelihood on points and
+    // targets; O(grid * n^3), meant for a few hundred points
+    [[nodiscard]] static GaussianProcessKernel fit_kernel(std::size_t dimension,
+                                                          const std::vector<std::vector<double>> &points,
+                                                          const std::vector<double> &targets);
+
+private:
+    [[nodiscard]] double covariance(const double *a, const double *b) const noexcept;
+    // solves L * out = rhs in place over the first n rows
+    void forward_solve(std::vector<double> &values, std::size_t n) const noexcept;
+    void solve_weights();
+
+    std::size_t dimension_;
+    GaussianProcessKernel kernel_;
+    std::vector<double> points_;
+    // row i holds L(i, 0..i) starting at i * (i + 1) / 2
+    std::vector<double> factor_;
+    std::vector<double> targets_;
+    double target_mean_{0.0};
+    double target_scale_{1.0};
+    // forward-solved standardized targets and K^-1 times them
+    std::vector<double> whitened_;
+    std::vector<double> weights_;
+};
+
+} // namespace hpoea::core
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "hpoea/core/hyper_optimizer_base.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace hpoea::core {
+
+// exhaustive search over the cartesian product of per-parameter axes.
+// booleans, categorical values and discrete choices contribute every
+// value; integer ranges every value up to resolution values and
+// resolution evenly spaced ones beyond; continuous parameters resolution
+// points spanning their transformed bounds. grid point i is the mixed-radix
+// number i with the last tunable parameter as the fastest digit, so the
+// grid is never materialized. trial_index is the grid index and seeds
+// derive from it; a run started at start_index therefore repeats the
+// trials an uninterrupted run would make there. contiguous index ranges
+// are handed to parallel_workers in order, so a wall-time stop leaves a
+// gap-free prefix to resume after.
+class GridSearchOptimizer final : public HyperOptimizerBase {
+public:
+    GridSearchOptimizer();
+
+    [[nodiscard]] HyperparameterOptimizerPtr clone() const override {
+        return std::make_unique<GridSearchOptimizer>(*this);
+    }
+
+    [[nodiscard]] HyperparameterOptimizationResult optimize(const IEvolutionaryAlgorithmFactory &algorithm_factory,
+                                                            const IProblem &problem, const Budget &optimizer_budget,
+                                                            const Budget &algorithm_budget,
+                                                            unsigned long seed) override;
+
+    // points in the grid of space under the configured search space and
+    // resolution; throws std::invalid_argument when the count overflows
+    [[nodiscard]] std::size_t grid_size(const ParameterSpace &space) const;
+
+    // configuration at grid index, std::out_of_range past the last point
+    [[nodiscard]] ParameterSet grid_point(const ParameterSpace &space, std::size_t index) const;
+
+    // the start_index that continues after result's last trial
+    [[nodiscard]] static std::size_t resume_index(const HyperparameterOptimizationResult &result);
+};
+
+} // namespace hpoea::core
@@ -1,9 +1,14 @@
 #pragma once
 
 #include "hpoea/core/hyperparameter_optimizer.hpp"
+#include "hpoea/core/pruning.hpp"
 #include "hpoea/core/search_space.hpp"
+#include "hpoea/core/trial_history.hpp"
 
+#include <cstddef>
 #include <memory>
+#include <optional>
+#include <vector>
 
 namespace hpoea::core {
 
@@ -26,14 +31,34 @@ public:
 
     void set_search_space(std::shared_ptr<SearchSpace> search_space);
 
+    // stops hopeless inner runs early, see TrialPruner. nullopt turns it off
+    void set_pruning_policy(std::optional<PruningPolicy> policy);
+    [[nodiscard]] const std::optional<PruningPolicy> &pruning_policy() const noexcept { return pruning_policy_; }
+
+    // seeds optimize() with up to prior_count of the best earlier trials of
+    // the same algorithm, problem id and search space. null turns it off
+    void set_trial_history(std::shared_ptr<const TrialHistory> history, std::size_t prior_count = 8);
+    [[nodiscard]] const std::shared_ptr<const TrialHistory> &trial_history() const noexcept { return history_; }
+
 protected:
     HyperOptimizerBase(ParameterSpace space, AlgorithmIdentity identity);
     HyperOptimizerBase(const HyperOptimizerBase &other);
 
+    // a fresh pruner for one optimize() call, null without a policy
+    [[nodiscard]] std::shared_ptr<TrialPruner> make_trial_pruner() const;
+
+    // the history's best trials for this run that fit the search space,
+    // best first. whole-valued doubles read from a log are converted back.
+    [[nodiscard]] std::vector<HistoryTrial> prior_trials(const IEvolutionaryAlgorithmFactory &algorithm_factory,
+                                                         const IProblem &problem) const;
+
     ParameterSpace parameter_space_;
     ParameterSet configured_parameters_;
     AlgorithmIdentity identity_;
     std::shared_ptr<SearchSpace> search_space_;
+    std::optional<PruningPolicy> pruning_policy_;
+    std::shared_ptr<const TrialHistory> history_;
+    std::size_t prior_count_{8};
 };
 
 } // namespace hpoea::core
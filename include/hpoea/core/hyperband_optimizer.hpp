@@ -0,0 +1,37 @@
+#pragma once
+
+#include "hpoea/core/hyper_optimizer_base.hpp"
+
+#include <memory>
+
+namespace hpoea::core {
+
+// hyperband (li et al. 2018) and asynchronous successive halving (li et al. 2020).
+// the inner budget is the fidelity: algorithm_budget.function_evaluations
+// when set, else algorithm_budget.generations, is the full fidelity R.
+// rung k runs at min_fidelity * eta^k, the top rung at R. every rung
+// evaluation is one trial whose requested_budget carries its fidelity.
+// a promoted configuration reruns from scratch at the higher fidelity
+// with the same seed; there is no warm start.
+//
+// variant "hyperband" runs iterations passes over all brackets, each rung
+// a synchronous batch. trials are identical for any parallel_workers.
+// variant "asha" runs one bracket without barriers: a free worker promotes
+// the best unpromoted top 1/eta of the highest possible rung, else samples a
+// new configuration, up to iterations * eta^(rungs - 1) configurations.
+// with more than one worker the trial sequence depends on timing.
+class HyperbandOptimizer final : public HyperOptimizerBase {
+public:
+    HyperbandOptimizer();
+
+    [[nodiscard]] HyperparameterOptimizerPtr clone() const override {
+        return std::make_unique<HyperbandOptimizer>(*this);
+    }
+
+    [[nodiscard]] HyperparameterOptimizationResult optimize(const IEvolutionaryAlgorithmFactory &algorithm_factory,
+                                                            const IProblem &problem, const Budget &optimizer_budget,
+                                                            const Budget &algorithm_budget,
+                                                            unsigned long seed) override;
+};
+
+} // namespace hpoea::core
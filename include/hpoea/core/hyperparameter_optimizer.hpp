@@ -27,11 +27,12 @@ struct HyperparameterTrialRecord {
     ParameterSet parameters;
     OptimizationResult optimization_result;
     std::size_t trial_index{0};
+    // set by optimizers that continue trials from earlier ones
+    std::optional<TrialLineage> lineage{};
 };
 
-// trials over feval budget cannot become best
-[[nodiscard]] inline bool is_selectable_trial(const HyperparameterTrialRecord &trial) {
-    const auto &result = trial.optimization_result;
+// runs over feval budget cannot become best
+[[nodiscard]] inline bool is_selectable_run(const OptimizationResult &result) {
     if (result.status != RunStatus::Success && result.status != RunStatus::BudgetExceeded) {
         return false;
     }
@@ -43,6 +44,23 @@ struct HyperparameterTrialRecord {
            result.algorithm_usage.function_evaluations <= *feval_budget;
 }
 
+[[nodiscard]] inline bool is_selectable_trial(const HyperparameterTrialRecord &trial) {
+    return is_selectable_run(trial.optimization_result);
+}
+
+// what a model-based optimizer may learn from a trial: the objective of a
+// selectable trial, or the best-so-far of a pruned one, which bounds what
+// its full run would have reached. nullopt for every other trial.
+[[nodiscard]] inline std::optional<double> observed_objective(const HyperparameterTrialRecord &trial) {
+    if (is_selectable_trial(trial)) {
+        return trial.optimization_result.best_fitness;
+    }
+    if (trial.optimization_result.status == RunStatus::Pruned && std::isfinite(trial.optimization_result.best_fitness)) {
+        return trial.optimization_result.best_fitness;
+    }
+    return std::nullopt;
+}
+
 struct HyperparameterOptimizationResult {
     RunStatus status{RunStatus::InternalError};
     ParameterSet best_parameters;
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "hpoea/core/problem.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace hpoea::core {
+
+// an evaluated initial population, in draw order
+struct InitialPopulation {
+    std::vector<std::vector<double>> decision_vectors;
+    std::vector<double> fitness;
+    // opaque state of the run that ended with this population, empty when
+    // there is none. algorithms that can resume such a run store it in
+    // their final_population and read it back from set_warm_start.
+    std::string state;
+    // one population per inner run of a wrapped run (problem set instance,
+    // seed repeat), in order, null for a run that ended without one. the
+    // wrapper's own decision vectors stay empty
+    std::vector<std::shared_ptr<const InitialPopulation>> parts;
+};
+
+// shares evaluated initial populations between the inner runs of one
+// optimize() call. runs on the same problem with the same population size
+// draw their initial points from one seed stream, so the first run
+// evaluates them and the rest reuse the fitness values.
+// safe to share across threads.
+class InitialPopulationCache {
+public:
+    explicit InitialPopulationCache(unsigned long seed) noexcept : seed_(seed) {}
+
+    InitialPopulationCache(const InitialPopulationCache &) = delete;
+    InitialPopulationCache &operator=(const InitialPopulationCache &) = delete;
+
+    // seed for the initial points of population_size individuals
+    [[nodiscard]] unsigned long seed_for(std::size_t population_size) const noexcept;
+
+    // the cached population for (problem, population_size), built with
+    // build on first use. concurrent callers for one key wait for a single
+    // build; a build that throws leaves the key empty for the next caller.
+    // built reports whether this call evaluated the population.
+    [[nodiscard]] std::shared_ptr<const InitialPopulation> get_or_build(
+        const IProblem &problem,
+        std::size_t population_size,
+        const std::function<InitialPopulation()> &build,
+        bool *built = nullptr);
+
+    // same, keyed additionally by variant so runs that draw their initial
+    // points differently (e.g. another point sequence) never share a slot
+    [[nodiscard]] std::shared_ptr<const InitialPopulation> get_or_build(
+        const IProblem &problem,
+        std::size_t population_size,
+        std::size_t variant,
+        const std::function<InitialPopulation()> &build,
+        bool *built = nullptr);
+
+    // evaluations served from the cache so far
+    [[nodiscard]] std::size_t reused_evaluations() const;
+
+private:
+    struct Slot {
+        std::mutex mutex;
+        std::shared_ptr<const InitialPopulation> population;
+    };
+
+    unsigned long seed_;
+    mutable std::mutex mutex_;
+    std::map<std::tuple<const IProblem *, std::size_t, std::size_t>, std::shared_ptr<Slot>> slots_;
+    std::size_t reused_evaluations_{0};
+};
+
+} // namespace hpoea::core
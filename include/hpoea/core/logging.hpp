@@ -4,6 +4,7 @@
 #include "hpoea/core/types.hpp"
 
 #include <atomic>
+#include <cstddef>
 #include <filesystem>
 #include <fstream>
 #include <mutex>
@@ -34,6 +35,14 @@ struct RunRecord {
     unsigned long algorithm_seed{0};
     std::optional<unsigned long> optimizer_seed;
     std::string message;
+    // set on the per-instance records of a problem-set run
+    std::optional<std::string> problem_set_id;
+    // the trial's objective when it aggregates several inner runs
+    std::optional<double> aggregated_objective;
+    // set on the per-seed records of a repeated run
+    std::optional<std::size_t> repeat_index;
+    // set on the records of trials that continued from earlier ones
+    std::optional<TrialLineage> lineage;
 };
 
 class ILogger {
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "hpoea/core/hyper_optimizer_base.hpp"
+
+#include <memory>
+
+namespace hpoea::core {
+
+// parallel tempering (replica exchange) over the unit cube of the search
+// space. replicas chains run at temperatures spaced geometrically from tf
+// (chain 0) to ts, and every sweep moves each chain once: one coordinate,
+// cycling through them, steps by up to start_range * T / ts, and choice
+// coordinates are redrawn. a move is accepted with the metropolis rule at
+// the chain's temperature. every swap_interval sweeps, neighbouring chains
+// offer to exchange states, even pairs and odd pairs in turn. a sweep's
+// moves run in parallel; every move is one trial and the budget is
+// checked per move, so a function_evaluations budget is spent exactly.
+// trials do not depend on parallel_workers.
+class ParallelTemperingOptimizer final : public HyperOptimizerBase {
+public:
+    ParallelTemperingOptimizer();
+
+    [[nodiscard]] HyperparameterOptimizerPtr clone() const override {
+        return std::make_unique<ParallelTemperingOptimizer>(*this);
+    }
+
+    [[nodiscard]] HyperparameterOptimizationResult optimize(const IEvolutionaryAlgorithmFactory &algorithm_factory,
+                                                            const IProblem &problem, const Budget &optimizer_budget,
+                                                            const Budget &algorithm_budget,
+                                                            unsigned long seed) override;
+};
+
+} // namespace hpoea::core
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "hpoea/core/parameters.hpp"
+#include "hpoea/core/search_space.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace hpoea::core {
+
+// true when at least one descriptor is neither fixed nor excluded
+[[nodiscard]] bool has_tunable_dimension(const ParameterSpace &space, const SearchSpace *search_space);
+
+// draws one configuration uniformly from the search space.
+// fixed values and defaults fill the rest; excluded parameters are left out.
+// throws ParameterValidationError when the result would not validate.
+[[nodiscard]] ParameterSet sample_parameters(const ParameterSpace &space,
+                                             const SearchSpace *search_space,
+                                             std::mt19937_64 &rng);
+
+// maps the tunable parameters of a search space onto [0, 1]^dimension.
+// continuous values spread linearly over their transformed bounds, so a
+// log transform warps the cube. integers, discrete choices, booleans and
+// categorical choices split their coordinate into equal-width cells in
+// index order. fixed, excluded and default values are handled like in
+// sample_parameters. the encoding keeps its own copies of both spaces.
+class UnitCubeEncoding {
+public:
+    UnitCubeEncoding(const ParameterSpace &space, const SearchSpace *search_space);
+
+    [[nodiscard]] std::size_t dimension() const noexcept { return dimensions_.size(); }
+
+    // parameter behind coordinate index
+    [[nodiscard]] const std::string &name(std::size_t index) const;
+
+    // unordered choices behind coordinate index: categorical values,
+    // booleans and discrete choice lists. 0 for continuous parameters and
+    // integer ranges. choice k decodes from (k + 0.5) / choices.
+    [[nodiscard]] std::size_t choices(std::size_t index) const;
+
+    // equal-width cells behind coordinate index: the choices above or the
+    // values of an integer range. 0 for continuous parameters.
+    [[nodiscard]] std::size_t cells(std::size_t index) const;
+
+    // coordinates outside [0, 1] are clamped.
+    // throws ParameterValidationError when the result would not validate.
+    [[nodiscard]] ParameterSet decode(const std::vector<double> &unit) const;
+
+    // coordinates that decode back to parameters, at the cell center for
+    // choices and integers. nullopt when a tunable parameter is missing,
+    // has the wrong type or lies outside the search space.
+    [[nodiscard]] std::optional<std::vector<double>> encode(const ParameterSet &parameters) const;
+
+private:
+    struct Dimension {
+        std::size_t descriptor{0};
+        // 0 for continuous coordinates
+        double cells{0.0};
+        bool unordered{false};
+        ContinuousRange bounds{};
+    };
+
+    [[nodiscard]] const SearchSpace *search_space() const noexcept {
+        return search_space_ ? &*search_space_ : nullptr;
+    }
+
+    ParameterSpace space_;
+    std::optional<SearchSpace> search_space_;
+    std::vector<Dimension> dimensions_;
+};
+
+} // namespace hpoea::core
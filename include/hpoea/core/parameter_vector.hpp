@@ -0,0 +1,65 @@
+#pragma once
+
+#include "hpoea/core/parameters.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hpoea::core {
+
+// one parameter value without its name or type; the schema knows both
+struct ParameterSlot {
+    bool set{false};
+    // continuous value
+    double real{0.0};
+    // integer value, 0 or 1 for booleans, choice index for categoricals
+    std::int64_t integer{0};
+};
+
+// one slot per descriptor of a ParameterSpace, in descriptor order
+using ParameterVector = std::vector<ParameterSlot>;
+
+// positional view of a ParameterSpace for building, validating and
+// completing parameters as a ParameterVector, without name lookups or
+// string copies. convert to and from ParameterSet only at the api edges.
+// the space must outlive the schema.
+class ParameterSchema {
+public:
+    explicit ParameterSchema(const ParameterSpace &space) noexcept : space_(space) {}
+
+    [[nodiscard]] const ParameterSpace &space() const noexcept { return space_; }
+
+    [[nodiscard]] std::size_t size() const noexcept { return space_.size(); }
+
+    // all slots unset
+    [[nodiscard]] ParameterVector make_vector() const { return ParameterVector(size()); }
+
+    // value as slot index; integers widen to continuous. throws
+    // ParameterValidationError when the value does not validate.
+    [[nodiscard]] ParameterSlot slot(std::size_t index, const ParameterValue &value) const;
+
+    [[nodiscard]] ParameterValue value(std::size_t index, const ParameterSlot &slot) const;
+
+    // throws ParameterValidationError with the message validate_value
+    // gives for the same value
+    void check(std::size_t index, const ParameterSlot &slot) const;
+
+    // throws ParameterValidationError for unknown names or invalid values
+    [[nodiscard]] ParameterVector to_vector(const ParameterSet &parameters) const;
+
+    // the set slots
+    [[nodiscard]] ParameterSet to_set(const ParameterVector &values) const;
+
+    // like ParameterSpace::validate
+    void validate(const ParameterVector &values) const;
+
+    // like ParameterSpace::apply_defaults, in place
+    void apply_defaults(ParameterVector &values) const;
+
+private:
+    const ParameterSpace &space_;
+};
+
+} // namespace hpoea::core
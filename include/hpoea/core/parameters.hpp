@@ -1,9 +1,11 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -38,6 +40,9 @@ struct ParameterDescriptor {
     std::vector<std::string> categorical_choices;
     std::optional<ParameterValue> default_value;
     bool required{false};
+    // false keeps the parameter at its default unless a search space
+    // names it, so adding an option does not grow default tuning spaces
+    bool tuned_by_default{true};
 };
 
 class ParameterValidationError final : public std::runtime_error {
@@ -53,6 +58,9 @@ public:
 
     [[nodiscard]] const ParameterDescriptor &descriptor(const std::string &name) const;
 
+    // position of name in descriptors(); throws ParameterValidationError when unknown
+    [[nodiscard]] std::size_t index(const std::string &name) const;
+
     [[nodiscard]] const std::vector<ParameterDescriptor> &descriptors() const noexcept { return descriptors_; }
 
     [[nodiscard]] bool empty() const noexcept { return descriptors_.empty(); }
@@ -70,5 +78,26 @@ private:
     std::unordered_map<std::string, std::size_t> index_;
 };
 
+// 64-bit fnv-1a, the same on every platform: words go in little-endian,
+// text is length-prefixed, and 0.0 and -0.0 hash equal
+class Fnv1a {
+public:
+    void bytes(const void *data, std::size_t size);
+    void word(std::uint64_t value);
+    void text(std::string_view value);
+    void real(double value);
+    // the alternative's index, then its value
+    void value(const ParameterValue &value);
+
+    [[nodiscard]] std::uint64_t digest() const noexcept { return hash_; }
+
+private:
+    std::uint64_t hash_{0xcbf29ce484222325ULL};
+};
+
+// hash of a parameter set that does not depend on insertion order or the
+// platform; equal sets hash equal, with 0.0 and -0.0 treated as equal
+[[nodiscard]] std::uint64_t hash_parameter_set(const ParameterSet &parameters);
+
 } // namespace hpoea::core
 
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "hpoea/core/hyper_optimizer_base.hpp"
+
+#include <memory>
+
+namespace hpoea::core {
+
+// population based training (jaderberg et al. 2017) over inner runs.
+// members configurations start like random search samples and run in
+// rounds, each on 1 / rounds of the algorithm budget, in parallel. after
+// every round but the last, the exploit_fraction worst members take over
+// the parameters and final population of a random member among as many
+// best ones, then perturb the parameters in the unit cube of the search
+// space: each coordinate is redrawn with resample_probability, and ordered
+// ones otherwise move by perturb_step up or down. a member's next round
+// continues from its population through set_warm_start, including any
+// algorithm state the population carries; algorithms that cannot start
+// fresh instead. every round is a trial per member, with its TrialLineage.
+// decisions depend on the seed only, not on parallel_workers. a wall-time
+// budget is checked before every trial and ends the run after the last
+// complete one. pbt does not apply a pruning policy.
+class PbtOptimizer final : public HyperOptimizerBase {
+public:
+    PbtOptimizer();
+
+    [[nodiscard]] HyperparameterOptimizerPtr clone() const override { return std::make_unique<PbtOptimizer>(*this); }
+
+    [[nodiscard]] HyperparameterOptimizationResult optimize(const IEvolutionaryAlgorithmFactory &algorithm_factory,
+                                                            const IProblem &problem, const Budget &optimizer_budget,
+                                                            const Budget &algorithm_budget,
+                                                            unsigned long seed) override;
+};
+
+} // namespace hpoea::core
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hpoea::core {
+
+// how initial points are spread over the search box.
+// uniform: independent pseudo-random draws
+// sobol: sobol sequence, linear matrix scrambling plus a digital shift
+// halton: halton sequence, random multiplicative digit scrambling
+// latin_hypercube: one point per stratum and dimension in each block
+enum class PointSequenceKind {
+    Uniform,
+    Sobol,
+    Halton,
+    LatinHypercube
+};
+
+[[nodiscard]] std::string_view to_string(PointSequenceKind kind) noexcept;
+
+// accepts "uniform", "sobol", "halton" and "lhs"
+[[nodiscard]] std::optional<PointSequenceKind> parse_point_sequence_kind(std::string_view text) noexcept;
+
+// config names of every kind, for categorical parameter descriptors
+[[nodiscard]] std::vector<std::string> point_sequence_choices();
+
+// a seeded stream of points in [0, 1)^dimension.
+// tables are built once in the constructor; next() is O(dimension) and
+// does not allocate once out has the right size. block_size is the number
+// of points the caller expects to draw: latin hypercube stratifies each
+// block of that many points, the other kinds ignore it.
+class PointSequence {
+public:
+    PointSequence(PointSequenceKind kind, std::size_t dimension, std::size_t block_size, std::uint64_t seed);
+
+    [[nodiscard]] PointSequenceKind kind() const noexcept { return kind_; }
+    [[nodiscard]] std::size_t dimension() const noexcept { return dimension_; }
+
+    void next(std::vector<double> &out);
+
+    // next point mapped onto [lower, upper) per coordinate
+    void next_in_box(const std::vector<double> &lower, const std::vector<double> &upper, std::vector<double> &out);
+
+private:
+    void init_sobol();
+    void init_halton();
+    void init_latin_hypercube();
+    void shuffle_strata();
+
+    PointSequenceKind kind_;
+    std::size_t dimension_;
+    std::size_t block_size_;
+    std::mt19937_64 rng_;
+    std::uint64_t index_{0};
+
+    // sobol: 32 direction numbers per dimension and the gray-code state
+    std::vector<std::array<std::uint32_t, 32>> directions_;
+    std::vector<std::uint32_t> state_;
+
+    // halton: base and digit multiplier per dimension
+    std::vector<std::uint32_t> bases_;
+    std::vector<std::uint32_t> multipliers_;
+
+    // latin hypercube: block_size stratum indices per dimension
+    std::vector<std::uint32_t> strata_;
+};
+
+} // namespace hpoea::core
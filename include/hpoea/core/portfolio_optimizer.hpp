@@ -0,0 +1,45 @@
+#pragma once
+
+#include "hpoea/core/hyper_optimizer_base.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace hpoea::core {
+
+// runs several tuners on one function_evaluations budget. the budget is
+// split over rounds, and each round every member gets its share of the
+// round, on up to parallel_workers threads. shares start equal and move
+// toward the members that improved on the incumbent; min_share of every
+// round is spread evenly so no member starves. inner runs go through a
+// memo keyed by parameter set, budget and problem id, and run on a seed
+// derived from that key: a repeat of a call from an earlier round, or of
+// the member's own, is answered from it and costs no budget. members
+// derived from HyperOptimizerBase start every round from the best trials
+// so far and take the portfolio's search space and pruning policy. the
+// merged trials carry their member and round in lineage.
+class PortfolioOptimizer final : public HyperOptimizerBase {
+public:
+    PortfolioOptimizer();
+    explicit PortfolioOptimizer(std::vector<HyperparameterOptimizerPtr> members);
+    PortfolioOptimizer(const PortfolioOptimizer &other);
+
+    // lineage.member is the index in the order added
+    void add_member(HyperparameterOptimizerPtr member);
+    [[nodiscard]] std::size_t member_count() const noexcept { return members_.size(); }
+
+    [[nodiscard]] HyperparameterOptimizerPtr clone() const override {
+        return std::make_unique<PortfolioOptimizer>(*this);
+    }
+
+    [[nodiscard]] HyperparameterOptimizationResult optimize(const IEvolutionaryAlgorithmFactory &algorithm_factory,
+                                                            const IProblem &problem, const Budget &optimizer_budget,
+                                                            const Budget &algorithm_budget,
+                                                            unsigned long seed) override;
+
+private:
+    std::vector<HyperparameterOptimizerPtr> members_;
+};
+
+} // namespace hpoea::core
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "hpoea/core/hyperparameter_optimizer.hpp"
+#include "hpoea/core/problem.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hpoea::core {
+
+// how a configuration's results on the instances of a problem set become
+// one objective, lower is better.
+// mean_rank: mean over instances of the run's midrank among the
+//            instance's reference values, scaled to (0, 1)
+// mean_normalized: mean of (fitness - offset) / scale
+// worst_case: largest (fitness - offset) / scale
+enum class ProblemSetAggregation {
+    MeanRank,
+    MeanNormalized,
+    WorstCase
+};
+
+[[nodiscard]] inline std::string_view to_string(ProblemSetAggregation aggregation) noexcept {
+    switch (aggregation) {
+        case ProblemSetAggregation::MeanRank:
+            return "mean_rank";
+        case ProblemSetAggregation::MeanNormalized:
+            return "mean_normalized";
+        case ProblemSetAggregation::WorstCase:
+            return "worst_case";
+    }
+    return "mean_normalized";
+}
+
+[[nodiscard]] inline std::optional<ProblemSetAggregation> parse_problem_set_aggregation(
+    std::string_view text) noexcept {
+    if (text == "mean_rank") {
+        return ProblemSetAggregation::MeanRank;
+    }
+    if (text == "mean_normalized") {
+        return ProblemSetAggregation::MeanNormalized;
+    }
+    if (text == "worst_case") {
+        return ProblemSetAggregation::WorstCase;
+    }
+    return std::nullopt;
+}
+
+struct ProblemSetInstance {
+    std::shared_ptr<const IProblem> problem;
+    // fitness is normalized as (fitness - offset) / scale
+    double offset{0.0};
+    double scale{1.0};
+    // fixed objective values mean_rank ranks a run against, e.g. from
+    // baseline runs; required by mean_rank, ignored otherwise
+    std::vector<double> reference;
+};
+
+// a family of problem instances every configuration is run on.
+// instances are shared, not copied, and must allow concurrent evaluate()
+// calls when parallel_instances is above 1 (0 means one thread per core).
+class ProblemSet {
+public:
+    ProblemSet(std::string id,
+               std::vector<ProblemSetInstance> instances,
+               ProblemSetAggregation aggregation = ProblemSetAggregation::MeanNormalized,
+               std::size_t parallel_instances = 1);
+
+    [[nodiscard]] const std::string &id() const noexcept { return id_; }
+    [[nodiscard]] const std::vector<ProblemSetInstance> &instances() const noexcept { return instances_; }
+    [[nodiscard]] ProblemSetAggregation aggregation() const noexcept { return aggregation_; }
+    [[nodiscard]] std::size_t parallel_instances() const noexcept { return parallel_instances_; }
+
+private:
+    std::string id_;
+    std::vector<ProblemSetInstance> instances_;
+    ProblemSetAggregation aggregation_;
+    std::size_t parallel_instances_;
+};
+
+// runs every configuration on all instances of a problem set. algorithms
+// it creates ignore the problem run() receives: they run one base
+// algorithm per instance, on up to parallel_instances threads, and return
+// the aggregate as best_fitness with the per-instance results, in instance
+// order, as instance_results. instance i runs with a seed derived from
+// the run's seed and i, under the full algorithm budget. the aggregate is
+// finite only when every instance run is selectable; its budget counts
+// and usage are totals over the instances.
+class ProblemSetFactory final : public IEvolutionaryAlgorithmFactory {
+public:
+    ProblemSetFactory(const IEvolutionaryAlgorithmFactory &base_factory,
+                      std::shared_ptr<const ProblemSet> problem_set);
+
+    [[nodiscard]] EvolutionaryAlgorithmPtr create() const override;
+
+    [[nodiscard]] const ParameterSpace &parameter_space() const noexcept override {
+        return base_factory_.parameter_space();
+    }
+
+    [[nodiscard]] const AlgorithmIdentity &identity() const noexcept override { return base_factory_.identity(); }
+
+    [[nodiscard]] const ProblemSet &problem_set() const noexcept { return *problem_set_; }
+
+private:
+    const IEvolutionaryAlgorithmFactory &base_factory_;
+    std::shared_ptr<const ProblemSet> problem_set_;
+};
+
+} // namespace hpoea::core
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+
+namespace hpoea::core {
+
+// best-so-far of an inner run, reported from its generation loop
+struct ProgressReport {
+    std::size_t function_evaluations{0};
+    std::size_t generations{0};
+    double best_fitness{std::numeric_limits<double>::infinity()};
+    // which inner run of a wrapped run reported it (problem set instance,
+    // seed repeat), 0 for a plain run
+    std::size_t stream{0};
+};
+
+// called after the initial population and after every generation.
+// returning false stops the run, which then ends RunStatus::Pruned.
+// a run calls it from one thread at a time.
+using ProgressCallback = std::function<bool(const ProgressReport &)>;
+
+} // namespace hpoea::core
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "hpoea/core/progress.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace hpoea::core {
+
+// median and percentile compare a run with the other trials of the same
+// optimize() call at the same checkpoint; patience only looks at the run
+enum class PruningRule {
+    None,
+    Median,
+    Percentile,
+    Patience
+};
+
+struct PruningPolicy {
+    PruningRule rule{PruningRule::None};
+    // function evaluations between checkpoints, must be positive
+    std::size_t interval{1000};
+    // percentile rule: prune above this percentile (0..100) of the others
+    double percentile{50.0};
+    // median and percentile: other trials that must have reached a
+    // checkpoint before it prunes anything
+    std::size_t startup_trials{5};
+    // checkpoints every run survives
+    std::size_t warmup_checkpoints{1};
+    // patience rule: reports past a checkpoint without an improvement
+    // above min_delta
+    std::size_t patience{3};
+    double min_delta{0.0};
+};
+
+// throws std::invalid_argument on a zero interval, a percentile outside
+// [0, 100] or a negative min_delta
+void validate_pruning_policy(const PruningPolicy &policy);
+
+// records the best-so-far of every trial at every checkpoint it crosses,
+// i.e. at each multiple of interval evaluations, and decides from those
+// whether a run goes on. a run is compared at the first report at or past
+// the checkpoint; population algorithms report once per generation. each
+// report stream is compared with the same stream of the other trials.
+// shared by the trials of one optimize() call and safe across threads.
+// with several trials in flight, which others a run sees at a checkpoint
+// depends on timing.
+class TrialPruner {
+public:
+    explicit TrialPruner(PruningPolicy policy);
+
+    TrialPruner(const TrialPruner &) = delete;
+    TrialPruner &operator=(const TrialPruner &) = delete;
+
+    [[nodiscard]] const PruningPolicy &policy() const noexcept { return policy_; }
+
+    // a callback for one run; keeps the run's own state, shares the rest
+    [[nodiscard]] ProgressCallback monitor();
+
+    // best-so-far values recorded for stream at checkpoint index (after
+    // (index + 1) * interval evaluations), in arrival order
+    [[nodiscard]] std::vector<double> recorded(std::size_t checkpoint, std::size_t stream = 0) const;
+
+    // runs stopped so far
+    [[nodiscard]] std::size_t pruned_count() const;
+
+private:
+    // records value and says whether the run may continue
+    [[nodiscard]] bool keep(std::size_t stream, std::size_t checkpoint, double value);
+
+    PruningPolicy policy_;
+    mutable std::mutex mutex_;
+    // by stream, then checkpoint
+    std::vector<std::vector<std::vector<double>>> checkpoints_;
+    std::size_t pruned_{0};
+};
+
+} // namespace hpoea::core
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "hpoea/core/hyper_optimizer_base.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace hpoea::core {
+
+// f-race (birattari et al. 2002) over random candidate configurations.
+// every step runs all surviving candidates on one instance with one seed,
+// the problem passed to optimize() first and the added instances after it,
+// cycling through them. candidates run in parallel within a step. from
+// step first_test on, a friedman test with conover's post-hoc comparison,
+// or a paired t-test against the best mean, drops candidates that are
+// significantly worse at the given confidence. the race ends with one
+// survivor, after max_steps steps, or when the optimizer budget cannot
+// pay for a full step. the winner has the best mean rank (friedman) or
+// mean objective (t_test) over the steps it ran. trials do not depend on
+// parallel_workers.
+class RacingOptimizer final : public HyperOptimizerBase {
+public:
+    RacingOptimizer();
+
+    [[nodiscard]] HyperparameterOptimizerPtr clone() const override {
+        return std::make_unique<RacingOptimizer>(*this);
+    }
+
+    // instances raced after the optimize() problem. they are shared, not
+    // copied, and must allow concurrent evaluate() calls.
+    void set_instances(std::vector<std::shared_ptr<const IProblem>> instances);
+    [[nodiscard]] const std::vector<std::shared_ptr<const IProblem>> &instances() const noexcept {
+        return instances_;
+    }
+
+    [[nodiscard]] HyperparameterOptimizationResult optimize(const IEvolutionaryAlgorithmFactory &algorithm_factory,
+                                                            const IProblem &problem, const Budget &optimizer_budget,
+                                                            const Budget &algorithm_budget,
+                                                            unsigned long seed) override;
+
+private:
+    std::vector<std::shared_ptr<const IProblem>> instances_;
+};
+
+} // namespace hpoea::core
@@ -70,6 +70,11 @@ private:
   std::unordered_map<std::string, ParameterConfig> configs_;
 };
 
+// config's mode, or for a parameter the search space does not name,
+// optimize unless the descriptor opts out (then fixed at its default)
+[[nodiscard]] SearchMode effective_mode(const ParameterDescriptor &descriptor,
+                                        const ParameterConfig *config) noexcept;
+
 [[nodiscard]] double inverse_transform(double value, Transform transform);
 [[nodiscard]] ContinuousRange transform_bounds(ContinuousRange bounds,
                                                Transform transform);
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "hpoea/core/hyperparameter_optimizer.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace hpoea::core {
+
+// how many seeds score one configuration. a run starts with min_repeats
+// inner runs and doubles them up to max_repeats while its mean stays
+// within relative_margin * |incumbent| + absolute_margin of the incumbent,
+// the lowest mean of the runs that reached max_repeats. a run that falls
+// behind stops early; without an incumbent every run goes to max_repeats.
+struct SeedRepeatPolicy {
+    std::size_t min_repeats{1};
+    std::size_t max_repeats{1};
+    double relative_margin{0.1};
+    double absolute_margin{0.0};
+    // threads per run, 0 means one per core
+    std::size_t parallel_repeats{1};
+};
+
+class SeedRepeatIncumbent;
+
+// scores every configuration by the mean of repeated inner runs under a
+// SeedRepeatPolicy. repeat r runs with a seed derived from the run's seed
+// and r, under the full algorithm budget, and the inner results come back
+// in repeat order as repeat_results. the mean is finite only when every
+// repeat is selectable; budget counts and usage are totals over the
+// repeats made. algorithms of one factory share the incumbent, so use a
+// fresh factory per optimize() call. with parallel trials, how far a run
+// goes depends on which runs finished before it.
+class SeedRepeatFactory final : public IEvolutionaryAlgorithmFactory {
+public:
+    // throws std::invalid_argument for an inconsistent policy
+    SeedRepeatFactory(const IEvolutionaryAlgorithmFactory &base_factory, SeedRepeatPolicy policy);
+
+    [[nodiscard]] EvolutionaryAlgorithmPtr create() const override;
+
+    [[nodiscard]] const ParameterSpace &parameter_space() const noexcept override {
+        return base_factory_.parameter_space();
+    }
+
+    [[nodiscard]] const AlgorithmIdentity &identity() const noexcept override { return base_factory_.identity(); }
+
+    [[nodiscard]] const SeedRepeatPolicy &policy() const noexcept { return policy_; }
+
+private:
+    const IEvolutionaryAlgorithmFactory &base_factory_;
+    SeedRepeatPolicy policy_;
+    std::shared_ptr<SeedRepeatIncumbent> incumbent_;
+};
+
+} // namespace hpoea::core
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "hpoea/core/hyper_optimizer_base.hpp"
+
+#include <memory>
+
+namespace hpoea::core {
+
+// tree-structured parzen estimator (bergstra et al. 2011), univariate.
+// trials are ranked by objective; the best gamma fraction feeds the good
+// density l(x), the rest the bad density g(x). continuous parameters and
+// integer ranges use truncated gaussian kernels on the unit-cube encoding,
+// so log transforms apply; categorical, boolean and discrete-choice
+// parameters use smoothed choice frequencies directly. each proposal draws
+// candidate_count points from l and keeps the best l(x) / g(x).
+// batch_size > 1 proposes with a constant liar: pending proposals join the
+// model at the worst observed objective. trials depend on batch_size but
+// not on parallel_workers.
+class TpeOptimizer final : public HyperOptimizerBase {
+public:
+    TpeOptimizer();
+
+    [[nodiscard]] HyperparameterOptimizerPtr clone() const override {
+        return std::make_unique<TpeOptimizer>(*this);
+    }
+
+    [[nodiscard]] HyperparameterOptimizationResult optimize(const IEvolutionaryAlgorithmFactory &algorithm_factory,
+                                                            const IProblem &problem, const Budget &optimizer_budget,
+                                                            const Budget &algorithm_budget,
+                                                            unsigned long seed) override;
+};
+
+} // namespace hpoea::core
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "hpoea/core/parameters.hpp"
+#include "hpoea/core/search_space.hpp"
+#include "hpoea/core/types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace hpoea::core {
+
+// one earlier tuning trial
+struct HistoryTrial {
+    ParameterSet parameters;
+    double objective{0.0};
+};
+
+// the trials that can seed a run: same algorithm, same problem id and
+// same effective search space
+struct HistoryKey {
+    AlgorithmIdentity algorithm;
+    std::string problem_id;
+    std::uint64_t space_fingerprint{0};
+};
+
+// stable hash of what space under search_space lets an optimizer pick:
+// every parameter's name, type and mode, and the bounds, transform and
+// choices of tunable ones or the value of fixed ones
+[[nodiscard]] std::uint64_t search_space_fingerprint(const ParameterSpace &space, const SearchSpace *search_space);
+
+// earlier trials grouped by HistoryKey, for warm-starting optimize().
+// trials come from add(), from JSONL run logs or from a history file
+// written by save(). open() maps such a file and reads only its key
+// table, so opening is O(keys) however many trials it holds; best()
+// decodes just the trials it returns. a history is read-only once built
+// and safe to query from several threads.
+class TrialHistory {
+public:
+    TrialHistory();
+
+    // non-finite objectives are ignored
+    void add(const HistoryKey &key, ParameterSet parameters, double objective);
+
+    // adds the tuning-phase records of a JSONL run log whose status is
+    // success or budget_exceeded and whose objective is finite. logs do
+    // not record the search space, so the trials are filed under
+    // space_fingerprint. returns the number of trials added; throws
+    // std::runtime_error for an unreadable file or a malformed line.
+    std::size_t load_jsonl(const std::filesystem::path &path, std::uint64_t space_fingerprint);
+
+    // writes every trial, each key's trials sorted by objective, through a
+    // temporary file renamed over path. saving over the file this history
+    // maps leaves the mapping on the old contents; windows rejects it with
+    // std::invalid_argument.
+    void save(const std::filesystem::path &path) const;
+
+    // maps a file written by save(); trials added later stay in memory.
+    // throws std::runtime_error when the file is unreadable or corrupt.
+    [[nodiscard]] static TrialHistory open(const std::filesystem::path &path);
+
+    // up to count trials of key, lowest objective first
+    [[nodiscard]] std::vector<HistoryTrial> best(const HistoryKey &key, std::size_t count) const;
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+private:
+    class MappedFile;
+
+    struct Bucket {
+        // records [first, first + count) of the mapped file
+        std::size_t mapped_first{0};
+        std::size_t mapped_count{0};
+        std::vector<HistoryTrial> added;
+    };
+
+    std::shared_ptr<const MappedFile> file_;
+    std::map<std::string, Bucket> buckets_;
+    std::size_t size_{0};
+};
+
+} // namespace hpoea::core
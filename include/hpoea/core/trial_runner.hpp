@@ -0,0 +1,95 @@
+#pragma once
+
+#include "hpoea/core/hyperparameter_optimizer.hpp"
+#include "hpoea/core/problem.hpp"
+#include "hpoea/core/progress.hpp"
+#include "hpoea/core/types.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hpoea::core {
+
+class TrialPruner;
+
+// one inner run of a freshly created and configured algorithm.
+// parameters is called inside the guarded region, so a sampling error
+// fails the trial like a configure or run error does. a successful run
+// with a non-finite objective is reported as an internal error.
+// started is set when configure succeeded and the run was attempted.
+// progress, when set, is handed to the algorithm before the run, and
+// prepare, when set, is called on the configured algorithm after it.
+[[nodiscard]] HyperparameterTrialRecord run_trial(const IEvolutionaryAlgorithmFactory &algorithm_factory,
+                                                  const IProblem &problem,
+                                                  const Budget &algorithm_budget,
+                                                  unsigned long seed,
+                                                  std::size_t trial_index,
+                                                  const std::function<ParameterSet()> &parameters,
+                                                  bool *started = nullptr,
+                                                  ProgressCallback progress = {},
+                                                  const std::function<void(IEvolutionaryAlgorithm &)> &prepare = {});
+
+// a pruner's callback for one trial, empty without a pruner
+[[nodiscard]] ProgressCallback trial_progress(const std::shared_ptr<TrialPruner> &pruner);
+
+// callback split over the count inner runs of a wrapped run (problem set
+// instances, seed repeats): callback i reports as stream i (stream
+// s * count + i for stream s of a nested wrapper), and calls are
+// serialized. once one stream is stopped the others stop at their next
+// report. empty callbacks for an empty callback
+[[nodiscard]] std::vector<ProgressCallback> split_progress(ProgressCallback callback, std::size_t count);
+
+// fills status, best_parameters, best_objective and message from the
+// selectable trial with the lowest objective. optimizer_name prefixes the
+// messages, e.g. "random search completed".
+void select_best_trial(HyperparameterOptimizationResult &result, std::string_view optimizer_name);
+
+// a configured parallel_workers value, 0 meaning one worker per core
+[[nodiscard]] std::size_t resolve_worker_count(std::size_t configured) noexcept;
+
+// a non-negative integer optimizer parameter; throws std::invalid_argument
+// when it is missing, not an integer or negative
+[[nodiscard]] std::size_t count_parameter(const ParameterSet &parameters, const std::string &name);
+
+// a double optimizer parameter; throws std::invalid_argument when it is
+// missing or not a double
+[[nodiscard]] double real_parameter(const ParameterSet &parameters, const std::string &name);
+
+// the parallel_workers parameter through resolve_worker_count, 1 when the
+// optimizer does not have one
+[[nodiscard]] std::size_t parallel_workers(const ParameterSet &parameters);
+
+// true once budget.wall_time has passed since start, never without one.
+// callable, so it doubles as run_indexed's stop
+class WallTimeLimit {
+public:
+    WallTimeLimit(const Budget &budget, std::chrono::steady_clock::time_point start)
+        : limit_(budget.wall_time), start_(start) {}
+
+    [[nodiscard]] bool operator()() const {
+        return limit_ && std::chrono::duration_cast<std::chrono::milliseconds>(
+                             std::chrono::steady_clock::now() - start_) >= *limit_;
+    }
+
+private:
+    std::optional<std::chrono::milliseconds> limit_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// calls job(i) for i in [0, count) on up to workers threads, inline when
+// workers <= 1. indices are handed out in order and stop() is checked
+// before each one; started jobs always finish, so a stop leaves every
+// index below the highest started one done. the first exception thrown
+// by a job stops the pool and is rethrown once all threads joined.
+void run_indexed(std::size_t count,
+                 std::size_t workers,
+                 const std::function<void(std::size_t)> &job,
+                 const std::function<bool()> &stop);
+
+} // namespace hpoea::core
@@ -12,7 +12,9 @@ enum class RunStatus {
     BudgetExceeded,
     FailedEvaluation,
     InvalidConfiguration,
-    InternalError
+    InternalError,
+    // stopped early because its progress callback said so
+    Pruned
 };
 
 struct Budget {
@@ -23,9 +25,12 @@ struct Budget {
 
 // usage reported by a single ea run (inner data path).
 struct AlgorithmRunUsage {
+    // charged evaluations, cached ones included
     std::size_t function_evaluations{0};
     std::size_t generations{0};
     std::chrono::milliseconds wall_time{0};
+    // served from a shared initial-population cache, not evaluated by this run
+    std::size_t cached_function_evaluations{0};
 };
 
 // usage counters for the outer hyperparameter optimizer.
@@ -33,6 +38,14 @@ struct OptimizerRunUsage {
     std::size_t objective_calls{0};  // number of complete ea runs
     std::size_t iterations{0};       // optimizer-side stepping
     std::chrono::milliseconds wall_time{0};
+    // configurations proposed, repeats included; left 0 by optimizers
+    // that do not track duplicates
+    std::size_t proposed_configurations{0};
+    // proposals whose decoded parameter set was proposed before
+    std::size_t duplicate_configurations{0};
+    // duplicates answered from an earlier run instead of a new ea run;
+    // counted in objective_calls only under the reuse_counted policy
+    std::size_t cached_objective_calls{0};
 };
 
 using EffectiveBudget = Budget;
@@ -60,4 +73,18 @@ struct ErrorInfo {
     std::string detail;
 };
 
+// where a trial sits in a population of inner runs that hand state on.
+// parent_trial is the trial it continued from: the member's own previous
+// trial, or with exploited set the better member's trial whose state it
+// took over before perturbing the parameters. unset for a first trial.
+// resumed is set when the run started from that trial's final population,
+// and stays false when there was none or the algorithm refused it.
+struct TrialLineage {
+    std::size_t member{0};
+    std::size_t round{0};
+    std::optional<std::size_t> parent_trial;
+    bool exploited{false};
+    bool resumed{false};
+};
+
 } // namespace hpoea::core
@@ -1,14 +1,37 @@
 #pragma once
 
+#include "hpoea/core/batch_evaluator.hpp"
+#include "hpoea/core/checkpoint.hpp"
 #include "hpoea/core/evolution_algorithm.hpp"
 #include "hpoea/core/hyperparameter_optimizer.hpp"
+#include "hpoea/core/initial_population_cache.hpp"
 #include "hpoea/core/parameters.hpp"
+#include "hpoea/core/point_sequence.hpp"
+#include "hpoea/core/progress.hpp"
 #include "hpoea/core/types.hpp"
 
 #include <memory>
+#include <optional>
+#include <string>
 
 namespace hpoea::pagmo_wrappers {
 
+// execution options threaded into run_population.
+// not tunable, kept across clone().
+struct PopulationRunOptions {
+    std::optional<core::CheckpointPolicy> checkpoint;
+    core::BatchEvaluatorConfig batch_evaluator{};
+    // shared with the other runs of one optimize() call
+    std::shared_ptr<core::InitialPopulationCache> initial_population_cache;
+    // called after the initial population and after every generation,
+    // watched through the problem's evaluations; the evolve is unchanged
+    core::ProgressCallback progress;
+    // the population to continue from, see set_warm_start
+    std::shared_ptr<const core::InitialPopulation> warm_start;
+    // set once set_warm_start was called; results carry final_population
+    bool report_final_population{false};
+};
+
 // base for all pagmo EA wrappers.
 class PagmoAlgorithmBase : public core::IEvolutionaryAlgorithm {
 public:
@@ -16,12 +39,28 @@ public:
     [[nodiscard]] const core::ParameterSpace &parameter_space() const noexcept override { return parameter_space_; }
     void configure(const core::ParameterSet &parameters) override;
 
+    // nullopt turns checkpointing off. a checkpointed run follows the
+    // unstepped trajectory but ignores ftol/xtol, see core::CheckpointPolicy
+    void set_checkpoint_policy(std::optional<core::CheckpointPolicy> policy);
+    // thread uses pagmo::thread_bfe, custom routes generations through the
+    // callback; pso switches to pagmo::pso_gen to batch every generation
+    // unless keep_trajectory is set, the other algorithms batch the
+    // initial population only
+    void set_batch_evaluator(const core::BatchEvaluatorConfig &config) override;
+    void set_initial_population_cache(std::shared_ptr<core::InitialPopulationCache> cache) override;
+    void set_progress_callback(core::ProgressCallback callback) override;
+    // a start larger than population_size keeps its best individuals,
+    // a smaller one is topped up with freshly drawn ones
+    bool set_warm_start(std::shared_ptr<const core::InitialPopulation> start) override;
+    [[nodiscard]] const PopulationRunOptions &run_options() const noexcept { return run_options_; }
+
 protected:
     PagmoAlgorithmBase(core::ParameterSpace space, core::AlgorithmIdentity identity);
 
     core::ParameterSpace parameter_space_;
     core::ParameterSet configured_parameters_;
     core::AlgorithmIdentity identity_;
+    PopulationRunOptions run_options_;
 };
 
 // base for all pagmo EA factories.
@@ -80,4 +119,17 @@ inline core::ParameterDescriptor make_xtol_descriptor(double default_val = 1e-6)
     return d;
 }
 
+// how the initial population is spread over the bounds,
+// see core::PointSequenceKind. added last and left out of default tuning
+// spaces, so existing spaces keep their dimensions and order
+inline core::ParameterDescriptor make_population_init_descriptor() {
+    core::ParameterDescriptor d;
+    d.name = "population_init";
+    d.type = core::ParameterType::Categorical;
+    d.categorical_choices = core::point_sequence_choices();
+    d.default_value = std::string{"uniform"};
+    d.tuned_by_default = false;
+    return d;
+}
+
 } // namespace hpoea::pagmo_wrappers
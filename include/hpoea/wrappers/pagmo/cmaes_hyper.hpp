@@ -4,6 +4,9 @@
 
 namespace hpoea::pagmo_wrappers {
 
+// pagmo::cmaes evaluates its offspring one at a time and has no batch
+// hook, so parallel_workers only spreads the initial population over
+// threads; every later generation runs its trials sequentially
 class PagmoCmaesHyperOptimizer final : public PagmoHyperOptimizerBase {
 public:
     PagmoCmaesHyperOptimizer();
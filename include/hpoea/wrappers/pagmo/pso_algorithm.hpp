@@ -12,6 +12,10 @@ public:
                                                const core::Budget &budget,
                                                unsigned long seed) override;
 
+    // the implementation becomes pagmo::pso_gen while a batch evaluator
+    // without keep_trajectory is set
+    void set_batch_evaluator(const core::BatchEvaluatorConfig &config) override;
+
     [[nodiscard]] std::unique_ptr<core::IEvolutionaryAlgorithm> clone() const override;
 };
 
@@ -10,6 +10,10 @@ public:
 
     [[nodiscard]] core::HyperparameterOptimizerPtr clone() const override;
 
+    // the implementation follows parallel_workers: pagmo::pso for one
+    // worker, pagmo::pso_gen for more
+    void configure(const core::ParameterSet &parameters) override;
+
     [[nodiscard]] core::HyperparameterOptimizationResult optimize(
         const core::IEvolutionaryAlgorithmFactory &algorithm_factory,
         const core::IProblem &problem,
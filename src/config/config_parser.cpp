@@ -27,10 +27,12 @@ using hpoea::config::OptimizerSpec;
 using hpoea::config::ParseDiagnostic;
 using hpoea::config::ParseDiagnosticSeverity;
 using hpoea::config::ParseResult;
+using hpoea::config::ProblemSetSpec;
 using hpoea::config::ProblemSpec;
 using hpoea::config::SearchChoiceList;
 using hpoea::config::SearchParameterMode;
 using hpoea::config::SearchParameterSpec;
+using hpoea::config::SeedRepeatsConfig;
 using hpoea::config::SuiteConfig;
 using hpoea::config::detail::join_index;
 using hpoea::config::detail::join_path;
@@ -160,6 +162,20 @@ private:
         return *value;
     }
 
+    std::optional<bool> bool_field(const toml::table &table,
+                                   std::string_view key,
+                                   std::string_view path) {
+        const auto *node = table.get(key);
+        if (!node) {
+            return std::nullopt;
+        }
+        if (!node->is_boolean()) {
+            error(std::string{path}, "expected boolean, got " + node_type_name(*node));
+            return std::nullopt;
+        }
+        return *node->value<bool>();
+    }
+
     std::optional<std::int64_t> read_integer(const toml::node &node,
                                              std::string_view path) {
         const auto value = node.value<std::int64_t>();
@@ -308,6 +324,40 @@ private:
         return budget;
     }
 
+    std::optional<SeedRepeatsConfig> parse_seed_repeats(const toml::table &table,
+                                                        std::string_view path) {
+        const auto before = error_count_;
+        diagnose_unknown_keys(table, path, {"min_repeats", "max_repeats", "relative_margin", "absolute_margin",
+                                            "parallel_repeats"});
+        SeedRepeatsConfig repeats;
+        if (const auto value = nonnegative_integer_field<std::size_t>(table, "min_repeats",
+                                                                      join_path(path, "min_repeats"))) {
+            repeats.min_repeats = *value;
+        }
+        if (const auto value = nonnegative_integer_field<std::size_t>(table, "max_repeats",
+                                                                      join_path(path, "max_repeats"))) {
+            repeats.max_repeats = *value;
+        }
+        if (const auto *node = table.get("relative_margin")) {
+            if (const auto value = read_double(*node, join_path(path, "relative_margin"))) {
+                repeats.relative_margin = *value;
+            }
+        }
+        if (const auto *node = table.get("absolute_margin")) {
+            if (const auto value = read_double(*node, join_path(path, "absolute_margin"))) {
+                repeats.absolute_margin = *value;
+            }
+        }
+        if (const auto value = nonnegative_integer_field<std::size_t>(table, "parallel_repeats",
+                                                                      join_path(path, "parallel_repeats"))) {
+            repeats.parallel_repeats = *value;
+        }
+        if (error_count_ != before) {
+            return std::nullopt;
+        }
+        return repeats;
+    }
+
     std::optional<SearchChoiceList> parse_search_choices(const toml::array &array,
                                                          std::string_view path) {
         SearchChoiceList choices;
@@ -377,7 +427,7 @@ private:
     }
 
     void parse_root(const toml::table &root) {
-        diagnose_unknown_keys(root, {}, {"schema_version", "suite", "problems", "algorithms",
+        diagnose_unknown_keys(root, {}, {"schema_version", "suite", "problems", "problem_sets", "algorithms",
                                          "optimizers", "experiments", "matrices"});
         config_ = SuiteConfig{};
         if (const auto version = nonnegative_integer_field<std::size_t>(root, "schema_version", "schema_version")) {
@@ -388,6 +438,7 @@ private:
         }
         parse_suite(root);
         parse_problems(root);
+        parse_problem_sets(root);
         parse_algorithms(root);
         parse_optimizers(root);
         parse_experiments(root);
@@ -449,6 +500,116 @@ private:
         }
     }
 
+    std::optional<std::vector<std::string>> string_array_field(const toml::table &table,
+                                                               std::string_view key,
+                                                               std::string_view path) {
+        const auto *node = table.get(key);
+        if (!node) {
+            error(std::string{path}, "missing required array");
+            return std::nullopt;
+        }
+        const auto *array = node->as_array();
+        if (!array) {
+            error(std::string{path}, "expected array, got " + node_type_name(*node));
+            return std::nullopt;
+        }
+        std::vector<std::string> values;
+        values.reserve(array->size());
+        for (std::size_t i = 0; i < array->size(); ++i) {
+            const auto value = array->get(i)->value<std::string>();
+            if (!value) {
+                error(join_index(path, i), "expected string, got " + node_type_name(*array->get(i)));
+                return std::nullopt;
+            }
+            values.push_back(*value);
+        }
+        return values;
+    }
+
+    std::optional<std::vector<double>> double_array_field(const toml::table &table,
+                                                          std::string_view key,
+                                                          std::string_view path) {
+        const auto *node = table.get(key);
+        if (!node) {
+            return std::nullopt;
+        }
+        const auto *array = node->as_array();
+        if (!array) {
+            error(std::string{path}, "expected array, got " + node_type_name(*node));
+            return std::nullopt;
+        }
+        std::vector<double> values;
+        values.reserve(array->size());
+        for (std::size_t i = 0; i < array->size(); ++i) {
+            const auto value = read_double(*array->get(i), join_index(path, i));
+            if (!value) {
+                return std::nullopt;
+            }
+            values.push_back(*value);
+        }
+        return values;
+    }
+
+    void parse_problem_sets(const toml::table &root) {
+        const auto *problem_sets = table_field(root, "problem_sets", "problem_sets", false);
+        if (!problem_sets) {
+            return;
+        }
+        for (const auto &[raw_key, node] : *problem_sets) {
+            const std::string id{raw_key.str()};
+            const auto path = join_path("problem_sets", id);
+            const auto *table = node.as_table();
+            if (!table) {
+                error(path, "expected table, got " + node_type_name(node));
+                continue;
+            }
+            diagnose_unknown_keys(*table, path, {"problems", "aggregation", "offsets", "scales", "references",
+                                                 "parallel_instances"});
+            ProblemSetSpec problem_set;
+            problem_set.id = id;
+            if (auto problems = string_array_field(*table, "problems", join_path(path, "problems"))) {
+                problem_set.problems = std::move(*problems);
+            }
+            if (const auto value = string_field(*table, "aggregation", join_path(path, "aggregation"), false)) {
+                problem_set.aggregation = *value;
+            }
+            if (auto offsets = double_array_field(*table, "offsets", join_path(path, "offsets"))) {
+                problem_set.offsets = std::move(*offsets);
+            }
+            if (auto scales = double_array_field(*table, "scales", join_path(path, "scales"))) {
+                problem_set.scales = std::move(*scales);
+            }
+            if (const auto *references = table->get("references")) {
+                const auto references_path = join_path(path, "references");
+                if (const auto *rows = references->as_array()) {
+                    for (std::size_t i = 0; i < rows->size(); ++i) {
+                        const auto row_path = join_index(references_path, i);
+                        const auto *row = rows->get(i)->as_array();
+                        if (!row) {
+                            error(row_path, "expected array, got " + node_type_name(*rows->get(i)));
+                            break;
+                        }
+                        std::vector<double> values;
+                        values.reserve(row->size());
+                        for (std::size_t k = 0; k < row->size(); ++k) {
+                            if (const auto value = read_double(*row->get(k), join_index(row_path, k))) {
+                                values.push_back(*value);
+                            }
+                        }
+                        problem_set.references.push_back(std::move(values));
+                    }
+                } else {
+                    error(references_path, "expected array, got " + node_type_name(*references));
+                }
+            }
+            if (const auto value = nonnegative_integer_field<std::size_t>(*table, "parallel_instances",
+                                                                          join_path(path, "parallel_instances"))) {
+                problem_set.parallel_instances = *value;
+            }
+            config_.problem_sets.push_back(std::move(problem_set));
+        }
+    }
+
     void parse_algorithms(const toml::table &root) {
         const auto *algorithms = table_field(root, "algorithms", "algorithms", false);
         if (!algorithms) {
@@ -546,7 +707,8 @@ private:
     void parse_experiment(const toml::table &table,
                           std::string_view path) {
         diagnose_unknown_keys(table, path, {"id", "problem", "algorithm", "optimizer", "repetitions",
-                                            "validation_repeats", "seed", "output_name",
+                                            "validation_repeats", "seed", "output_name", "batch_evaluator",
+                                            "share_initial_population", "seed_repeats",
                                             "algorithm_budget", "optimizer_budget"});
         ExperimentSpec experiment;
         if (const auto value = string_field(table, "id", join_path(path, "id"), true)) {
@@ -574,6 +736,16 @@ private:
         if (const auto value = string_field(table, "output_name", join_path(path, "output_name"), false)) {
             experiment.output_name = *value;
         }
+        if (const auto value = string_field(table, "batch_evaluator", join_path(path, "batch_evaluator"), false)) {
+            experiment.batch_evaluator = *value;
+        }
+        if (const auto value = bool_field(table, "share_initial_population",
+                                          join_path(path, "share_initial_population"))) {
+            experiment.share_initial_population = *value;
+        }
+        if (const auto *repeats = table_field(table, "seed_repeats", join_path(path, "seed_repeats"), false)) {
+            experiment.seed_repeats = parse_seed_repeats(*repeats, join_path(path, "seed_repeats"));
+        }
         if (const auto *budget = table_field(table, "algorithm_budget", join_path(path, "algorithm_budget"), false)) {
             experiment.algorithm_budget = parse_budget(*budget, join_path(path, "algorithm_budget"));
         }
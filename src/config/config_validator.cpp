@@ -2,10 +2,14 @@
 
 #include "hpoea/config/suite_expander.hpp"
 #include "hpoea/config/supported_types.hpp"
+#include "hpoea/core/batch_evaluator.hpp"
+#include "hpoea/core/problem_set.hpp"
 
 #include "path_helpers.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <optional>
@@ -14,6 +18,7 @@
 #include <unordered_map>
 #include <utility>
 #include <variant>
+#include <vector>
 
 namespace {
 
@@ -21,8 +26,10 @@ using hpoea::config::AlgorithmSpec;
 using hpoea::config::BudgetConfig;
 using hpoea::config::ExperimentSpec;
 using hpoea::config::ExpansionDiagnosticSeverity;
+using hpoea::config::ProblemSetSpec;
 using hpoea::config::SearchParameterMode;
 using hpoea::config::SearchParameterSpec;
+using hpoea::config::SeedRepeatsConfig;
 using hpoea::config::SuiteConfig;
 using hpoea::config::ValidationDiagnostic;
 using hpoea::config::ValidationDiagnosticSeverity;
@@ -34,8 +41,15 @@ using hpoea::config::pagmo_optimizer_type_ids;
 using hpoea::config::detail::join_index;
 using hpoea::config::detail::join_path;
 
-constexpr std::array<std::string_view, 1> core_optimizer_type_ids{
-    "random_search"
+constexpr std::array<std::string_view, 8> core_optimizer_type_ids{
+    "random_search",
+    "hyperband",
+    "bayesian",
+    "tpe",
+    "racing",
+    "grid_search",
+    "pbt",
+    "parallel_tempering"
 };
 
 // fixed value or smallest value search can pick
@@ -80,9 +94,11 @@ public:
     ValidationResult validate() {
         validate_suite();
         index_problems();
+        index_problem_sets();
         index_algorithms();
         index_optimizers();
         validate_problems();
+        validate_problem_sets();
         validate_algorithms();
         validate_optimizers();
         validate_experiments();
@@ -141,6 +157,27 @@ private:
         }
     }
 
+    void index_problem_sets() {
+        for (std::size_t i = 0; i < config_.problem_sets.size(); ++i) {
+            const auto &problem_set = config_.problem_sets[i];
+            if (problem_set.id.empty()) {
+                add_error(join_path(join_index("problem_sets", i), "id"), "problem set id must not be empty");
+                continue;
+            }
+            if (problems_by_id_.contains(problem_set.id)) {
+                add_error(join_path("problem_sets", problem_set.id),
+                          "problem set id '" + problem_set.id + "' is also a problem id");
+                continue;
+            }
+            const auto [it, inserted] =
+                problem_sets_by_id_.emplace(problem_set.id, join_path(join_index("problem_sets", i), "id"));
+            if (!inserted) {
+                add_error(join_path("problem_sets", problem_set.id),
+                          "duplicate problem set id '" + problem_set.id + "' also produced by " + it->second);
+            }
+        }
+    }
+
     void index_algorithms() {
         for (std::size_t i = 0; i < config_.algorithms.size(); ++i) {
             const auto &algorithm = config_.algorithms[i];
@@ -187,6 +224,68 @@ private:
         }
     }
 
+    void validate_problem_sets() {
+        for (const auto &problem_set : config_.problem_sets) {
+            const auto base_path = join_path("problem_sets", problem_set.id);
+            if (problem_set.problems.empty()) {
+                add_error(join_path(base_path, "problems"), "problem set must list at least one problem");
+            }
+            for (std::size_t i = 0; i < problem_set.problems.size(); ++i) {
+                const auto &problem = problem_set.problems[i];
+                if (!problems_by_id_.contains(problem)) {
+                    add_error(join_index(join_path(base_path, "problems"), i),
+                              "problem set '" + problem_set.id + "': unknown problem '" + problem + "'");
+                }
+            }
+            if (!hpoea::core::parse_problem_set_aggregation(problem_set.aggregation)) {
+                add_error(join_path(base_path, "aggregation"),
+                          "aggregation must be 'mean_rank', 'mean_normalized' or 'worst_case', got '" +
+                              problem_set.aggregation + "'");
+            }
+            validate_normalization(problem_set, problem_set.offsets, join_path(base_path, "offsets"), false);
+            validate_normalization(problem_set, problem_set.scales, join_path(base_path, "scales"), true);
+            validate_references(problem_set, join_path(base_path, "references"));
+        }
+    }
+
+    // mean_rank ranks against fixed reference values, one array per problem
+    void validate_references(const ProblemSetSpec &problem_set, const std::string &path) {
+        if (problem_set.aggregation != "mean_rank" && problem_set.references.empty()) {
+            return;
+        }
+        if (problem_set.references.size() != problem_set.problems.size()) {
+            add_error(path, "expected one reference array per problem (" +
+                                std::to_string(problem_set.problems.size()) + "), got " +
+                                std::to_string(problem_set.references.size()));
+            return;
+        }
+        for (std::size_t i = 0; i < problem_set.references.size(); ++i) {
+            const auto &values = problem_set.references[i];
+            if (values.empty() || !std::ranges::all_of(values, [](double value) { return std::isfinite(value); })) {
+                add_error(join_index(path, i), "reference values must be finite and non-empty");
+            }
+        }
+    }
+
+    void validate_normalization(const ProblemSetSpec &problem_set,
+                                const std::vector<double> &values,
+                                const std::string &path,
+                                bool positive) {
+        if (values.empty()) {
+            return;
+        }
+        if (values.size() != problem_set.problems.size()) {
+            add_error(path, "expected one value per problem (" + std::to_string(problem_set.problems.size()) +
+                                "), got " + std::to_string(values.size()));
+            return;
+        }
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            if (!std::isfinite(values[i]) || (positive && values[i] <= 0.0)) {
+                add_error(join_index(path, i), positive ? "scale must be finite and positive" : "offset must be finite");
+            }
+        }
+    }
+
     void validate_algorithms() {
         for (const auto &algorithm : config_.algorithms) {
             const auto base_path = join_path("algorithms", algorithm.id);
@@ -249,6 +348,20 @@ private:
         if (experiment.repetitions.has_value() && *experiment.repetitions < 1) {
             add_error(join_path(base_path, "repetitions"), "experiment repetitions must be at least 1");
         }
+        if (experiment.batch_evaluator.has_value()) {
+            // custom needs an evaluate callback, which a config cannot give
+            const auto kind = hpoea::core::parse_batch_evaluator_kind(*experiment.batch_evaluator);
+            if (!kind || *kind == hpoea::core::BatchEvaluatorKind::Custom) {
+                const std::string none{hpoea::core::to_string(hpoea::core::BatchEvaluatorKind::None)};
+                const std::string thread{hpoea::core::to_string(hpoea::core::BatchEvaluatorKind::Thread)};
+                add_error(join_path(base_path, "batch_evaluator"),
+                          "batch_evaluator must be '" + none + "' or '" + thread +
+                              "', got '" + *experiment.batch_evaluator + "'");
+            }
+        }
+        if (experiment.seed_repeats.has_value()) {
+            validate_seed_repeats(*experiment.seed_repeats, join_path(base_path, "seed_repeats"));
+        }
         if (experiment.algorithm_budget.has_value()) {
             validate_budget(*experiment.algorithm_budget, join_path(base_path, "algorithm_budget"));
         }
@@ -262,7 +375,7 @@ private:
                             "types; prefer function_evaluations for cross-optimizer comparisons");
             }
         }
-        if (!problems_by_id_.contains(experiment.problem)) {
+        if (!problems_by_id_.contains(experiment.problem) && !problem_sets_by_id_.contains(experiment.problem)) {
             add_error(join_path(base_path, "problem"),
                       "experiment '" + experiment.id + "': unknown problem '" + experiment.problem + "'");
         }
@@ -320,6 +433,22 @@ private:
         }
     }
 
+    void validate_seed_repeats(const SeedRepeatsConfig &repeats,
+                               const std::string &path) {
+        if (repeats.min_repeats == 0) {
+            add_error(join_path(path, "min_repeats"), "min_repeats must be at least 1");
+        }
+        if (repeats.max_repeats < repeats.min_repeats) {
+            add_error(join_path(path, "max_repeats"), "max_repeats must not be below min_repeats");
+        }
+        if (!std::isfinite(repeats.relative_margin) || repeats.relative_margin < 0.0) {
+            add_error(join_path(path, "relative_margin"), "relative_margin must be finite and non-negative");
+        }
+        if (!std::isfinite(repeats.absolute_margin) || repeats.absolute_margin < 0.0) {
+            add_error(join_path(path, "absolute_margin"), "absolute_margin must be finite and non-negative");
+        }
+    }
+
     bool search_has_bounds(const SearchParameterSpec &spec) const noexcept {
         return spec.min_present || spec.max_present
             || spec.continuous_range.has_value() || spec.integer_range.has_value();
@@ -424,6 +553,7 @@ private:
     const SuiteConfig &config_;
     ValidationResult result_;
     std::unordered_map<std::string, std::string> problems_by_id_;
+    std::unordered_map<std::string, std::string> problem_sets_by_id_;
     std::unordered_map<std::string, std::string> algorithms_by_id_;
     std::unordered_map<std::string, std::string> optimizers_by_id_;
 };
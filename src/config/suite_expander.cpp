@@ -249,6 +249,9 @@ private:
             run.validation_repeats = validation_repeats;
             run.seed = derive_seed(config_, exp, repetition_index);
             run.output_name = *output_name;
+            run.batch_evaluator = exp.batch_evaluator.value_or("none");
+            run.share_initial_population = exp.share_initial_population.value_or(false);
+            run.seed_repeats = exp.seed_repeats;
             run.run_id = *normalized_id + "__rep" + format_repetition_index(repetition_index);
             run.planned_output_path = make_output_path(config_.output_dir, run.output_name, repetition_index);
             run.algorithm_budget = algorithm_budget;
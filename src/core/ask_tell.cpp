@@ -0,0 +1,325 @@
+#include "hpoea/core/ask_tell.hpp"
+
+#include "hpoea/core/error_classification.hpp"
+#include "hpoea/core/trial_runner.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace {
+
+using hpoea::core::Budget;
+using hpoea::core::EvolutionaryAlgorithmPtr;
+using hpoea::core::IProblem;
+using hpoea::core::OptimizationResult;
+
+// thrown into a suspended run whose owner went away
+class RunAbandoned final : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// hand-off point between the worker running the algorithm and the caller
+// driving ask/tell. only one batch is in flight per run.
+struct Channel {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::vector<double>> pending;
+    std::vector<double> fitness;
+    std::exception_ptr error;
+    bool waiting{false};
+    bool finished{false};
+    bool abandoned{false};
+    OptimizationResult result;
+
+    std::vector<double> exchange(const std::vector<std::vector<double>> &batch) {
+        std::unique_lock lock(mutex);
+        if (abandoned) {
+            throw RunAbandoned("ask/tell run abandoned");
+        }
+        pending = batch;
+        error = nullptr;
+        waiting = true;
+        cv.notify_all();
+        cv.wait(lock, [this] { return !waiting || abandoned; });
+        if (abandoned) {
+            throw RunAbandoned("ask/tell run abandoned");
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(fitness);
+    }
+};
+
+class BridgedProblem final : public IProblem {
+public:
+    BridgedProblem(const IProblem &problem, std::shared_ptr<Channel> channel)
+        : problem_(problem), channel_(std::move(channel)) {}
+
+    [[nodiscard]] const hpoea::core::ProblemMetadata &metadata() const noexcept override {
+        return problem_.metadata();
+    }
+
+    [[nodiscard]] std::size_t dimension() const override { return problem_.dimension(); }
+
+    [[nodiscard]] std::vector<double> lower_bounds() const override { return problem_.lower_bounds(); }
+
+    [[nodiscard]] std::vector<double> upper_bounds() const override { return problem_.upper_bounds(); }
+
+    [[nodiscard]] double evaluate(const std::vector<double> &decision_vector) const override {
+        return channel_->exchange({decision_vector}).front();
+    }
+
+    [[nodiscard]] bool is_stochastic() const noexcept override { return problem_.is_stochastic(); }
+
+private:
+    const IProblem &problem_;
+    std::shared_ptr<Channel> channel_;
+};
+
+// ask/tell over a blocking run(): the algorithm runs on its own thread and
+// parks inside every evaluation until the caller tells the fitness.
+// algorithms that take a batch evaluator park once per generation and ask
+// for all of it. the thread starts at the first ask(), so runs that were
+// started but never asked hold no thread.
+class ThreadedAskTellRun final : public hpoea::core::IAskTellRun {
+public:
+    ThreadedAskTellRun(EvolutionaryAlgorithmPtr algorithm, const IProblem &problem, const Budget &budget,
+                       unsigned long seed)
+        : channel_(std::make_shared<Channel>()),
+          problem_(std::make_unique<BridgedProblem>(problem, channel_)),
+          algorithm_(std::move(algorithm)),
+          budget_(budget),
+          seed_(seed) {
+        hpoea::core::BatchEvaluatorConfig batched;
+        batched.kind = hpoea::core::BatchEvaluatorKind::Custom;
+        // stepping must not change the run
+        batched.keep_trajectory = true;
+        batched.evaluate = [channel = channel_](const IProblem &, const std::vector<std::vector<double>> &batch) {
+            return channel->exchange(batch);
+        };
+        try {
+            algorithm_->set_batch_evaluator(batched);
+        } catch (const std::invalid_argument &) {
+            // evaluates one candidate at a time
+        }
+    }
+
+    ThreadedAskTellRun(const ThreadedAskTellRun &) = delete;
+    ThreadedAskTellRun &operator=(const ThreadedAskTellRun &) = delete;
+
+    ~ThreadedAskTellRun() override {
+        if (!worker_.joinable()) {
+            return;
+        }
+        {
+            std::scoped_lock lock(channel_->mutex);
+            if (!channel_->finished) {
+                channel_->abandoned = true;
+                channel_->cv.notify_all();
+            }
+        }
+        worker_.join();
+    }
+
+    [[nodiscard]] const std::vector<std::vector<double>> &ask() override {
+        launch();
+        std::unique_lock lock(channel_->mutex);
+        channel_->cv.wait(lock, [this] { return channel_->waiting || channel_->finished; });
+        if (channel_->finished) {
+            asked_.clear();
+        } else {
+            asked_ = channel_->pending;
+        }
+        return asked_;
+    }
+
+    void tell(const std::vector<double> &fitness) override {
+        std::scoped_lock lock(channel_->mutex);
+        if (!channel_->waiting) {
+            throw std::logic_error("tell() called without a pending ask()");
+        }
+        if (fitness.size() != channel_->pending.size()) {
+            throw std::invalid_argument("tell() expects " + std::to_string(channel_->pending.size()) +
+                                        " fitness values, got " + std::to_string(fitness.size()));
+        }
+        channel_->fitness = fitness;
+        channel_->waiting = false;
+        channel_->cv.notify_all();
+    }
+
+    void fail(std::exception_ptr error) override {
+        std::scoped_lock lock(channel_->mutex);
+        if (!channel_->waiting) {
+            throw std::logic_error("fail() called without a pending ask()");
+        }
+        channel_->error = std::move(error);
+        channel_->waiting = false;
+        channel_->cv.notify_all();
+    }
+
+    [[nodiscard]] OptimizationResult result() override {
+        launch();
+        std::unique_lock lock(channel_->mutex);
+        channel_->cv.wait(lock, [this] { return channel_->finished; });
+        return channel_->result;
+    }
+
+private:
+    void launch() {
+        if (worker_.joinable()) {
+            return;
+        }
+        worker_ = std::thread([this, budget = budget_, seed = seed_] {
+            OptimizationResult result;
+            try {
+                result = algorithm_->run(*problem_, budget, seed);
+            } catch (const std::exception &ex) {
+                const auto classified = hpoea::core::classify_exception(ex);
+                result.status = classified.status;
+                result.error_info = classified.error_info;
+                result.requested_budget = budget;
+                result.seed = seed;
+                result.message = ex.what();
+            } catch (...) {
+                result.status = hpoea::core::RunStatus::InternalError;
+                result.error_info = hpoea::core::ErrorInfo{"internal_error", "unknown_exception", "unknown error"};
+                result.requested_budget = budget;
+                result.seed = seed;
+                result.message = "unknown error";
+            }
+            std::scoped_lock lock(channel_->mutex);
+            channel_->result = std::move(result);
+            channel_->finished = true;
+            channel_->cv.notify_all();
+        });
+    }
+
+    std::shared_ptr<Channel> channel_;
+    std::unique_ptr<BridgedProblem> problem_;
+    EvolutionaryAlgorithmPtr algorithm_;
+    Budget budget_;
+    unsigned long seed_;
+    std::vector<std::vector<double>> asked_;
+    std::thread worker_;
+};
+
+} // namespace
+
+namespace hpoea::core {
+
+std::unique_ptr<IAskTellRun> IEvolutionaryAlgorithm::start(const IProblem &problem, const Budget &budget,
+                                                           unsigned long seed) {
+    return std::make_unique<ThreadedAskTellRun>(clone(), problem, budget, seed);
+}
+
+OptimizationResult drive_ask_tell(IAskTellRun &run, const IProblem &problem) {
+    std::vector<double> fitness;
+    for (;;) {
+        const auto &candidates = run.ask();
+        if (candidates.empty()) {
+            break;
+        }
+        fitness.clear();
+        try {
+            for (const auto &candidate : candidates) {
+                fitness.push_back(problem.evaluate(candidate));
+            }
+        } catch (...) {
+            run.fail(std::current_exception());
+            continue;
+        }
+        run.tell(fitness);
+    }
+    return run.result();
+}
+
+std::vector<OptimizationResult> run_interleaved(std::vector<AskTellRunPtr> &runs, const IProblem &problem,
+                                                const BatchEvaluateFn &evaluate_batch, std::size_t max_active) {
+    for (const auto &run : runs) {
+        if (!run) {
+            throw std::invalid_argument("run_interleaved requires non-null runs");
+        }
+    }
+    if (!evaluate_batch) {
+        throw std::invalid_argument("run_interleaved requires a batch evaluator");
+    }
+
+    struct Slice {
+        std::size_t run;
+        std::size_t count;
+    };
+
+    // a run holds a thread from its first ask() until it finishes, so only
+    // window runs are in flight; the next one is admitted as one finishes
+    const auto window = std::min(resolve_worker_count(max_active), runs.size());
+    std::vector<std::size_t> active;
+    active.reserve(window);
+    std::size_t admitted = 0;
+    std::vector<std::vector<double>> batch;
+    std::vector<Slice> slices;
+    std::vector<double> told;
+    for (;;) {
+        batch.clear();
+        slices.clear();
+        for (std::size_t slot = 0; slot < active.size() || admitted < runs.size();) {
+            if (slot == active.size()) {
+                if (active.size() == window) {
+                    break;
+                }
+                active.push_back(admitted++);
+            }
+            const auto i = active[slot];
+            const auto &candidates = runs[i]->ask();
+            if (candidates.empty()) {
+                active.erase(active.begin() + static_cast<std::ptrdiff_t>(slot));
+                continue;
+            }
+            slices.push_back(Slice{i, candidates.size()});
+            batch.insert(batch.end(), candidates.begin(), candidates.end());
+            ++slot;
+        }
+        if (slices.empty()) {
+            break;
+        }
+
+        std::vector<double> fitness;
+        try {
+            fitness = evaluate_batch(problem, batch);
+            if (fitness.size() != batch.size()) {
+                throw std::runtime_error("batch evaluator returned " + std::to_string(fitness.size()) +
+                                         " fitness values for " + std::to_string(batch.size()) + " candidates");
+            }
+        } catch (...) {
+            const auto error = std::current_exception();
+            for (const auto &slice : slices) {
+                runs[slice.run]->fail(error);
+            }
+            continue;
+        }
+
+        std::size_t offset = 0;
+        for (const auto &slice : slices) {
+            const auto first = fitness.begin() + static_cast<std::ptrdiff_t>(offset);
+            told.assign(first, first + static_cast<std::ptrdiff_t>(slice.count));
+            runs[slice.run]->tell(told);
+            offset += slice.count;
+        }
+    }
+
+    std::vector<OptimizationResult> results;
+    results.reserve(runs.size());
+    for (auto &run : runs) {
+        results.push_back(run->result());
+    }
+    return results;
+}
+
+} // namespace hpoea::core
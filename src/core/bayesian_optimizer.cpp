@@ -0,0 +1,448 @@
+#include "hpoea/core/bayesian_optimizer.hpp"
+
+#include "hpoea/core/budget_checks.hpp"
+#include "hpoea/core/error_classification.hpp"
+#include "hpoea/core/gaussian_process.hpp"
+#include "hpoea/core/parameter_sampling.hpp"
+#include "hpoea/core/point_sequence.hpp"
+#include "hpoea/core/seeding.hpp"
+#include "hpoea/core/trial_runner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace {
+
+constexpr const char *SAMPLE_COUNT = "sample_count";
+constexpr const char *INITIAL_SAMPLES = "initial_samples";
+constexpr const char *ACQUISITION = "acquisition";
+constexpr const char *UCB_BETA = "ucb_beta";
+constexpr const char *ACQUISITION_SAMPLES = "acquisition_samples";
+constexpr const char *BATCH_SIZE = "batch_size";
+constexpr const char *PARALLEL_WORKERS = "parallel_workers";
+// keeps design and proposal streams apart from the inner run seeds
+constexpr std::uint64_t proposal_stream_salt = 0x3c6ef372fe94f82bULL;
+// kernel refits cost O(n^3), so the kernel is frozen past this many points
+constexpr std::size_t refit_limit = 256;
+constexpr std::size_t local_search_starts = 4;
+
+hpoea::core::ParameterSpace make_parameter_space() {
+    hpoea::core::ParameterSpace space;
+
+    hpoea::core::ParameterDescriptor d;
+    d.name = SAMPLE_COUNT;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{0, 100000};
+    d.default_value = std::int64_t{0};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = INITIAL_SAMPLES;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{0, 10000};
+    d.default_value = std::int64_t{0};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = ACQUISITION;
+    d.type = hpoea::core::ParameterType::Categorical;
+    d.categorical_choices = {"ei", "ucb"};
+    d.default_value = std::string{"ei"};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = UCB_BETA;
+    d.type = hpoea::core::ParameterType::Continuous;
+    d.continuous_range = hpoea::core::ContinuousRange{0.0, 100.0};
+    d.default_value = 2.0;
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = ACQUISITION_SAMPLES;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{8, 100000};
+    d.default_value = std::int64_t{256};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = BATCH_SIZE;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{1, 256};
+    d.default_value = std::int64_t{1};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = PARALLEL_WORKERS;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{0, 1024};
+    d.default_value = std::int64_t{1};
+    space.add_descriptor(d);
+
+    return space;
+}
+
+struct Acquisition {
+    bool expected_improvement{true};
+    double beta{2.0};
+    double incumbent{0.0};
+
+    // larger is better
+    [[nodiscard]] double score(const hpoea::core::GaussianProcessPrediction &prediction) const {
+        const auto sigma = std::sqrt(prediction.variance);
+        if (!expected_improvement) {
+            return -(prediction.mean - beta * sigma);
+        }
+        const auto gain = incumbent - prediction.mean;
+        if (sigma < 1e-12) {
+            return std::max(gain, 0.0);
+        }
+        const auto z = gain / sigma;
+        const auto cdf = 0.5 * std::erfc(-z / std::numbers::sqrt2);
+        const auto pdf = std::exp(-0.5 * z * z) / std::sqrt(2.0 * std::numbers::pi);
+        return gain * cdf + sigma * pdf;
+    }
+};
+
+double score_point(const hpoea::core::GaussianProcess &model, const Acquisition &acquisition,
+                   const std::vector<double> &point) {
+    thread_local std::vector<double> scratch;
+    return acquisition.score(model.predict(point, scratch));
+}
+
+// random and incumbent-centred candidates, then compass search from the best few
+std::vector<double> maximize_acquisition(const hpoea::core::GaussianProcess &model,
+                                         const Acquisition &acquisition,
+                                         const std::vector<std::vector<double>> &incumbents,
+                                         std::size_t samples,
+                                         std::size_t workers,
+                                         std::uint64_t seed) {
+    const auto dimension = model.dimension();
+    std::mt19937_64 rng{seed};
+    std::uniform_real_distribution<double> unit{0.0, 1.0};
+    std::normal_distribution<double> jitter{0.0, 0.05};
+
+    std::vector<std::vector<double>> candidates;
+    candidates.reserve(samples + incumbents.size() * (samples / 8 + 1));
+    for (std::size_t i = 0; i < samples; ++i) {
+        std::vector<double> point(dimension);
+        for (auto &x : point) {
+            x = unit(rng);
+        }
+        candidates.push_back(std::move(point));
+    }
+    for (const auto &incumbent : incumbents) {
+        for (std::size_t i = 0; i < samples / 8 + 1; ++i) {
+            auto point = incumbent;
+            for (auto &x : point) {
+                x = std::clamp(x + jitter(rng), 0.0, 1.0);
+            }
+            candidates.push_back(std::move(point));
+        }
+    }
+
+    std::vector<double> scores(candidates.size());
+    hpoea::core::run_indexed(
+        candidates.size(), workers,
+        [&](std::size_t i) { scores[i] = score_point(model, acquisition, candidates[i]); }, [] { return false; });
+
+    std::vector<std::size_t> order(candidates.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    const auto starts = std::min(local_search_starts, order.size());
+    std::partial_sort(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(starts), order.end(),
+                      [&](std::size_t a, std::size_t b) {
+                          return scores[a] != scores[b] ? scores[a] > scores[b] : a < b;
+                      });
+
+    std::vector<std::vector<double>> refined(starts);
+    std::vector<double> refined_scores(starts);
+    const auto max_evaluations = 10u * dimension + 10u;
+    hpoea::core::run_indexed(
+        starts, workers,
+        [&](std::size_t s) {
+            auto point = candidates[order[s]];
+            auto best = scores[order[s]];
+            double step = 0.1;
+            std::size_t evaluations = 0;
+            while (step > 1e-3 && evaluations < max_evaluations) {
+                bool moved = false;
+                for (std::size_t k = 0; k < dimension && evaluations < max_evaluations; ++k) {
+                    for (const double direction : {1.0, -1.0}) {
+                        auto trial = point;
+                        trial[k] = std::clamp(trial[k] + direction * step, 0.0, 1.0);
+                        if (trial[k] == point[k]) {
+                            continue;
+                        }
+                        const auto score = score_point(model, acquisition, trial);
+                        ++evaluations;
+                        if (score > best) {
+                            best = score;
+                            point = std::move(trial);
+                            moved = true;
+                            break;
+                        }
+                    }
+                }
+                if (!moved) {
+                    step *= 0.5;
+                }
+            }
+            refined[s] = std::move(point);
+            refined_scores[s] = best;
+        },
+        [] { return false; });
+
+    std::size_t winner = 0;
+    for (std::size_t s = 1; s < starts; ++s) {
+        if (refined_scores[s] > refined_scores[winner]) {
+            winner = s;
+        }
+    }
+    return refined[winner];
+}
+
+} // namespace
+
+namespace hpoea::core {
+
+BayesianOptimizer::BayesianOptimizer()
+    : HyperOptimizerBase(make_parameter_space(), {"BayesianOptimization", "gaussian_process", "1.0"}) {}
+
+HyperparameterOptimizationResult BayesianOptimizer::optimize(const IEvolutionaryAlgorithmFactory &algorithm_factory,
+                                                             const IProblem &problem,
+                                                             const Budget &optimizer_budget,
+                                                             const Budget &algorithm_budget, unsigned long seed) {
+
+    HyperparameterOptimizationResult result;
+    result.status = RunStatus::InternalError;
+    result.seed = seed;
+    result.effective_optimizer_parameters = configured_parameters_;
+
+    const auto start_time = std::chrono::steady_clock::now();
+
+    try {
+        const auto &algorithm_space = algorithm_factory.parameter_space();
+        if (algorithm_space.empty()) {
+            throw std::invalid_argument("algorithm has no tunable parameters");
+        }
+        if (search_space_) {
+            search_space_->validate(algorithm_space);
+        }
+        if (!has_tunable_dimension(algorithm_space, search_space_.get())) {
+            throw ParameterValidationError(
+                "all parameters are fixed or excluded; use BaselineOptimizer for fixed/default runs");
+        }
+        if (optimizer_budget.generations.has_value()) {
+            throw std::invalid_argument("bayesian optimization does not consume a generations budget; use "
+                                        "optimizer_budget.function_evaluations");
+        }
+
+        const auto configured_samples = count_parameter(configured_parameters_, SAMPLE_COUNT);
+        std::size_t planned_samples = configured_samples;
+        if (configured_samples == 0u) {
+            if (!optimizer_budget.function_evaluations.has_value()) {
+                throw std::invalid_argument(
+                    "bayesian optimization sample_count is 0 and no optimizer_budget.function_evaluations is set; "
+                    "set sample_count or provide a function_evaluations budget");
+            }
+            planned_samples = *optimizer_budget.function_evaluations;
+        } else if (optimizer_budget.function_evaluations.has_value()) {
+            planned_samples = std::min(planned_samples, *optimizer_budget.function_evaluations);
+        }
+        if (planned_samples == 0u) {
+            const auto end_time = std::chrono::steady_clock::now();
+            result.status = RunStatus::BudgetExceeded;
+            result.message = "optimizer budget allows zero bayesian optimization samples";
+            result.optimizer_usage.wall_time =
+                std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+            return result;
+        }
+
+        const UnitCubeEncoding encoding(algorithm_space, search_space_.get());
+        const auto dimension = encoding.dimension();
+        const auto configured_initial = count_parameter(configured_parameters_, INITIAL_SAMPLES);
+        const auto design_size =
+            std::min(configured_initial == 0u ? 2u * dimension + 1u : configured_initial, planned_samples);
+        // earlier trials stand in for part of the initial design
+        const auto priors = prior_trials(algorithm_factory, problem);
+        const auto initial_samples = design_size - std::min(design_size, priors.size());
+        const auto batch_size = std::max<std::size_t>(count_parameter(configured_parameters_, BATCH_SIZE), 1u);
+        const auto acquisition_samples = count_parameter(configured_parameters_, ACQUISITION_SAMPLES);
+        const auto workers = parallel_workers(configured_parameters_);
+        Acquisition acquisition;
+        const auto acquisition_it = configured_parameters_.find(ACQUISITION);
+        acquisition.expected_improvement = acquisition_it == configured_parameters_.end() ||
+                                           std::get<std::string>(acquisition_it->second) != "ucb";
+        acquisition.beta = real_parameter(configured_parameters_, UCB_BETA);
+
+        const auto proposal_seed = static_cast<std::uint64_t>(seed) ^ proposal_stream_salt;
+        PointSequence design(PointSequenceKind::Sobol, dimension, initial_samples, derive_stream_seed(proposal_seed, 0));
+
+        GaussianProcess model(dimension, {0.2 * std::sqrt(static_cast<double>(dimension)), 1e-6});
+        std::vector<std::vector<double>> points;
+        // nan marks a trial that cannot be selected; it is imputed with the worst finite value
+        std::vector<double> observed;
+        std::size_t fitted_size = 0;
+        for (const auto &prior : priors) {
+            points.push_back(*encoding.encode(prior.parameters));
+            observed.push_back(prior.objective);
+            model.add(points.back());
+        }
+
+        const auto imputed_targets = [&] {
+            double worst = -std::numeric_limits<double>::infinity();
+            for (auto y : observed) {
+                if (!std::isnan(y)) {
+                    worst = std::max(worst, y);
+                }
+            }
+            auto targets = observed;
+            for (auto &y : targets) {
+                if (std::isnan(y)) {
+                    y = std::isfinite(worst) ? worst : 0.0;
+                }
+            }
+            return targets;
+        };
+
+        const auto propose = [&](std::size_t count, std::size_t first_index) {
+            auto targets = imputed_targets();
+            // a large initial design is fitted once on its first refit_limit points
+            const auto fit_size = std::min(points.size(), refit_limit);
+            if (fit_size >= 2u && (fitted_size == 0u || (points.size() <= refit_limit &&
+                                                         4u * points.size() >= 5u * fitted_size + 4u))) {
+                const std::vector<std::vector<double>> fit_points(points.begin(),
+                                                                  points.begin() + static_cast<std::ptrdiff_t>(fit_size));
+                const std::vector<double> fit_targets(targets.begin(),
+                                                      targets.begin() + static_cast<std::ptrdiff_t>(fit_size));
+                model.set_kernel(GaussianProcess::fit_kernel(dimension, fit_points, fit_targets));
+                fitted_size = points.size();
+            }
+            model.set_targets(targets);
+
+            std::vector<std::size_t> ranked(points.size());
+            std::iota(ranked.begin(), ranked.end(), std::size_t{0});
+            const auto incumbent_count = std::min<std::size_t>(ranked.size(), 4u);
+            std::partial_sort(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(incumbent_count),
+                              ranked.end(), [&](std::size_t a, std::size_t b) {
+                                  return targets[a] != targets[b] ? targets[a] < targets[b] : a < b;
+                              });
+            std::vector<std::vector<double>> incumbents;
+            for (std::size_t i = 0; i < incumbent_count; ++i) {
+                incumbents.push_back(points[ranked[i]]);
+            }
+            acquisition.incumbent = incumbent_count == 0u ? 0.0 : targets[ranked[0]];
+
+            // kriging believer: later proposals see earlier ones at their predicted mean
+            std::optional<GaussianProcess> fantasy;
+            std::vector<double> scratch;
+            std::vector<std::vector<double>> proposals;
+            for (std::size_t q = 0; q < count; ++q) {
+                const auto &current = fantasy ? *fantasy : model;
+                proposals.push_back(maximize_acquisition(current, acquisition, incumbents, acquisition_samples,
+                                                         workers,
+                                                         derive_stream_seed(proposal_seed, first_index + q + 1)));
+                if (q + 1 < count) {
+                    if (!fantasy) {
+                        fantasy = model;
+                    }
+                    const auto believed = fantasy->predict(proposals.back(), scratch).mean;
+                    fantasy->add(proposals.back());
+                    targets.push_back(believed);
+                    fantasy->set_targets(targets);
+                }
+            }
+            return proposals;
+        };
+
+        const auto pruner = make_trial_pruner();
+        std::atomic<std::size_t> calls{0};
+        const auto run_point = [&](const std::vector<double> &point, std::size_t trial_index) {
+            const auto trial_seed =
+                static_cast<unsigned long>(derive_stream_seed(static_cast<std::uint64_t>(seed), trial_index));
+            bool started = false;
+            auto trial = run_trial(algorithm_factory, problem, algorithm_budget, trial_seed, trial_index,
+                                   [&] { return encoding.decode(point); }, &started, trial_progress(pruner));
+            if (started) {
+                calls.fetch_add(1, std::memory_order_relaxed);
+            }
+            return trial;
+        };
+        const WallTimeLimit wall_time_spent{optimizer_budget, start_time};
+
+        bool stopped_for_wall_time = false;
+        result.trials.reserve(planned_samples);
+        while (result.trials.size() < planned_samples) {
+            if (wall_time_spent()) {
+                stopped_for_wall_time = true;
+                break;
+            }
+            const auto first_index = result.trials.size();
+            std::vector<std::vector<double>> batch;
+            if (first_index < initial_samples) {
+                const auto count = std::min(batch_size, initial_samples - first_index);
+                for (std::size_t i = 0; i < count; ++i) {
+                    std::vector<double> point;
+                    design.next(point);
+                    batch.push_back(std::move(point));
+                }
+            } else {
+                batch = propose(std::min(batch_size, planned_samples - first_index), first_index);
+            }
+
+            std::vector<std::optional<HyperparameterTrialRecord>> slots(batch.size());
+            run_indexed(
+                batch.size(), workers,
+                [&](std::size_t i) { slots[i] = run_point(batch[i], first_index + i); }, wall_time_spent);
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                if (!slots[i]) {
+                    stopped_for_wall_time = true;
+                    break;
+                }
+                points.push_back(batch[i]);
+                observed.push_back(
+                    observed_objective(*slots[i]).value_or(std::numeric_limits<double>::quiet_NaN()));
+                model.add(batch[i]);
+                result.trials.push_back(std::move(*slots[i]));
+            }
+            if (stopped_for_wall_time) {
+                break;
+            }
+        }
+
+        const auto end_time = std::chrono::steady_clock::now();
+        result.optimizer_usage.objective_calls = calls.load(std::memory_order_relaxed);
+        result.optimizer_usage.iterations = result.trials.size();
+        result.optimizer_usage.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+        select_best_trial(result, "bayesian optimization");
+        if (stopped_for_wall_time) {
+            result.status = RunStatus::BudgetExceeded;
+            result.message = "wall-time budget exceeded";
+        }
+        apply_optimizer_budget_status(optimizer_budget, result.optimizer_usage, result.status, result.message);
+    } catch (const std::exception &ex) {
+        const auto end_time = std::chrono::steady_clock::now();
+        const auto classified = classify_exception(ex);
+        result.status = classified.status;
+        result.error_info = classified.error_info;
+        result.message = ex.what();
+        result.optimizer_usage.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+    }
+
+    return result;
+}
+
+} // namespace hpoea::core
@@ -2,7 +2,9 @@
 
 #include "hpoea/core/error_classification.hpp"
 #include "hpoea/core/hyperparameter_optimizer.hpp"
+#include "hpoea/core/initial_population_cache.hpp"
 #include "hpoea/core/logging.hpp"
+#include "hpoea/core/parameter_vector.hpp"
 #include "hpoea/core/seeding.hpp"
 #include "hpoea/core/types.hpp"
 
@@ -98,12 +100,15 @@ public:
             }
         }
 
-        ParameterSet merged = parameters;
+        // merged by position, converted to a set once for the inner algorithm
+        const hpoea::core::ParameterSchema schema(inner_->parameter_space());
+        auto values = schema.to_vector(parameters);
         for (const auto &[name, value] : baseline_parameters_) {
-            merged.insert_or_assign(name, value);
+            const auto index = schema.space().index(name);
+            values[index] = schema.slot(index, value);
         }
-
-        merged = inner_->parameter_space().apply_defaults(merged);
+        schema.apply_defaults(values);
+        auto merged = schema.to_set(values);
         inner_->configure(merged);
         configured_parameters_ = std::move(merged);
     }
@@ -118,6 +123,22 @@ public:
         return result;
     }
 
+    void set_batch_evaluator(const hpoea::core::BatchEvaluatorConfig &config) override {
+        inner_->set_batch_evaluator(config);
+    }
+
+    void set_initial_population_cache(std::shared_ptr<hpoea::core::InitialPopulationCache> cache) override {
+        inner_->set_initial_population_cache(std::move(cache));
+    }
+
+    void set_progress_callback(hpoea::core::ProgressCallback callback) override {
+        inner_->set_progress_callback(std::move(callback));
+    }
+
+    bool set_warm_start(std::shared_ptr<const hpoea::core::InitialPopulation> start) override {
+        return inner_->set_warm_start(std::move(start));
+    }
+
     [[nodiscard]] std::unique_ptr<IEvolutionaryAlgorithm> clone() const override {
         return std::make_unique<BaselineAppliedAlgorithm>(
             inner_->clone(), baseline_parameters_, exposed_parameter_space_);
@@ -162,17 +183,84 @@ private:
     hpoea::core::ParameterSpace filtered_parameter_space_;
 };
 
+// hands every created algorithm the experiment's batch evaluator
+class BatchEvaluatorAppliedFactory final : public IEvolutionaryAlgorithmFactory {
+public:
+    BatchEvaluatorAppliedFactory(const IEvolutionaryAlgorithmFactory &base_factory,
+                                 hpoea::core::BatchEvaluatorConfig batch_evaluator)
+        : base_factory_(base_factory), batch_evaluator_(std::move(batch_evaluator)) {
+        if (batch_evaluator_.kind == hpoea::core::BatchEvaluatorKind::Custom && !batch_evaluator_.evaluate) {
+            throw std::invalid_argument("custom batch evaluator requires an evaluate function");
+        }
+    }
+
+    [[nodiscard]] EvolutionaryAlgorithmPtr create() const override {
+        auto algorithm = base_factory_.create();
+        algorithm->set_batch_evaluator(batch_evaluator_);
+        return algorithm;
+    }
+
+    [[nodiscard]] const hpoea::core::ParameterSpace &parameter_space() const noexcept override {
+        return base_factory_.parameter_space();
+    }
+
+    [[nodiscard]] const AlgorithmIdentity &identity() const noexcept override {
+        return base_factory_.identity();
+    }
+
+private:
+    const IEvolutionaryAlgorithmFactory &base_factory_;
+    hpoea::core::BatchEvaluatorConfig batch_evaluator_;
+};
+
+// hands every created algorithm one optimize() call's population cache
+class SharedInitialPopulationFactory final : public IEvolutionaryAlgorithmFactory {
+public:
+    SharedInitialPopulationFactory(const IEvolutionaryAlgorithmFactory &base_factory,
+                                   std::shared_ptr<hpoea::core::InitialPopulationCache> cache)
+        : base_factory_(base_factory), cache_(std::move(cache)) {}
+
+    [[nodiscard]] EvolutionaryAlgorithmPtr create() const override {
+        auto algorithm = base_factory_.create();
+        algorithm->set_initial_population_cache(cache_);
+        return algorithm;
+    }
+
+    [[nodiscard]] const hpoea::core::ParameterSpace &parameter_space() const noexcept override {
+        return base_factory_.parameter_space();
+    }
+
+    [[nodiscard]] const AlgorithmIdentity &identity() const noexcept override {
+        return base_factory_.identity();
+    }
+
+private:
+    const IEvolutionaryAlgorithmFactory &base_factory_;
+    std::shared_ptr<hpoea::core::InitialPopulationCache> cache_;
+};
+
+// layers the per-experiment factory wrappers over base_factory.
+// the wrappers live in owned_factories and reference each other in order.
 const IEvolutionaryAlgorithmFactory &resolve_algorithm_factory(
     const IEvolutionaryAlgorithmFactory &base_factory,
-    const std::optional<ParameterSet> &baseline_parameters,
-    std::unique_ptr<IEvolutionaryAlgorithmFactory> &owned_factory) {
-    if (!baseline_parameters.has_value()) {
-        return base_factory;
+    const ExperimentConfig &config,
+    std::vector<std::unique_ptr<IEvolutionaryAlgorithmFactory>> &owned_factories) {
+    const IEvolutionaryAlgorithmFactory *active = &base_factory;
+
+    if (config.batch_evaluator.kind != hpoea::core::BatchEvaluatorKind::None) {
+        owned_factories.push_back(std::make_unique<BatchEvaluatorAppliedFactory>(*active, config.batch_evaluator));
+        active = owned_factories.back().get();
+        // reject unsupported algorithms before any trial starts
+        (void)active->create();
+    }
+
+    if (config.algorithm_baseline_parameters.has_value()) {
+        auto validated_baseline = validate_baseline_parameters(*active, *config.algorithm_baseline_parameters);
+        owned_factories.push_back(std::make_unique<BaselineAppliedFactory>(*active, std::move(validated_baseline)));
+        active = owned_factories.back().get();
     }
 
-    auto validated_baseline = validate_baseline_parameters(base_factory, *baseline_parameters);
-    owned_factory = std::make_unique<BaselineAppliedFactory>(base_factory, std::move(validated_baseline));
-    return *owned_factory;
+    return *active;
 }
 
 std::pair<std::mt19937_64, unsigned long> seed_rng(const std::optional<unsigned long> &random_seed) {
@@ -198,6 +286,7 @@ ParameterSet select_logged_parameters(const HyperparameterTrialRecord &trial_rec
 
 // distinct stream from tuning trial seeds
 constexpr std::uint64_t validation_stream_salt = 0x0a11da7e5eed5a17ULL;
+constexpr std::uint64_t initial_population_stream_salt = 0x1417a1909e5eed00ULL;
 
 bool has_selectable_trial(const hpoea::core::HyperparameterOptimizationResult &result) {
     return std::any_of(result.trials.begin(), result.trials.end(),
@@ -239,7 +328,7 @@ void run_validation_repeats(const ExperimentConfig &config,
 }
 
 RunRecord build_run_record(const ExperimentConfig &config,
-                           const IProblem &problem,
+                           const std::string &problem_id,
                            const AlgorithmIdentity &algorithm_identity,
                            const AlgorithmIdentity &optimizer_identity,
                            const ParameterSet &optimizer_parameters,
@@ -247,7 +336,7 @@ RunRecord build_run_record(const ExperimentConfig &config,
                            const HyperparameterTrialRecord &trial_record) {
     RunRecord log_record;
     log_record.experiment_id = config.experiment_id;
-    log_record.problem_id = problem.metadata().id;
+    log_record.problem_id = problem_id;
     log_record.evolutionary_algorithm = algorithm_identity;
     log_record.hyper_optimizer = optimizer_identity;
     log_record.algorithm_parameters = select_logged_parameters(trial_record);
@@ -261,9 +350,67 @@ RunRecord build_run_record(const ExperimentConfig &config,
     log_record.algorithm_seed = trial_record.optimization_result.seed;
     log_record.optimizer_seed = optimizer_seed;
     log_record.message = trial_record.optimization_result.message;
+    log_record.lineage = trial_record.lineage;
     return log_record;
 }
 
+// one record per inner run: per repeat of a repeated run and per instance
+// of a problem-set run, else one record for the whole run
+void log_run(const ExperimentConfig &config,
+             const IProblem &problem,
+             const AlgorithmIdentity &algorithm_identity,
+             const AlgorithmIdentity &optimizer_identity,
+             const ParameterSet &optimizer_parameters,
+             unsigned long optimizer_seed,
+             const HyperparameterTrialRecord &trial_record,
+             hpoea::core::RunPhase phase,
+             hpoea::core::ILogger &logger) {
+    const auto &result = trial_record.optimization_result;
+    std::optional<double> aggregated_objective;
+    if (config.problem_set || !result.repeat_results.empty()) {
+        aggregated_objective = result.best_fitness;
+    }
+
+    const auto log_one = [&](const std::string &problem_id, const hpoea::core::OptimizationResult &run,
+                             std::optional<std::size_t> repeat_index) {
+        auto log_record = build_run_record(config, problem_id, algorithm_identity, optimizer_identity,
+                                           optimizer_parameters, optimizer_seed,
+                                           {trial_record.parameters, run, trial_record.trial_index,
+                                            trial_record.lineage});
+        log_record.phase = phase;
+        log_record.aggregated_objective = aggregated_objective;
+        log_record.repeat_index = repeat_index;
+        if (config.problem_set) {
+            log_record.problem_set_id = config.problem_set->id();
+        }
+        logger.log(log_record);
+    };
+    const auto log_instances = [&](const hpoea::core::OptimizationResult &run,
+                                   std::optional<std::size_t> repeat_index) {
+        if (!config.problem_set) {
+            log_one(problem.metadata().id, run, repeat_index);
+            return;
+        }
+        const auto &instances = config.problem_set->instances();
+        if (run.instance_results.size() != instances.size()) {
+            // failed before any instance ran
+            log_one(config.problem_set->id(), run, repeat_index);
+            return;
+        }
+        for (std::size_t i = 0; i < instances.size(); ++i) {
+            log_one(instances[i].problem->metadata().id, run.instance_results[i], repeat_index);
+        }
+    };
+
+    if (result.repeat_results.empty()) {
+        log_instances(result, std::nullopt);
+        return;
+    }
+    for (std::size_t r = 0; r < result.repeat_results.size(); ++r) {
+        log_instances(result.repeat_results[r], r);
+    }
+}
+
 // trial i uses seeds[i] and slot i
 // deterministic under any thread timing
 void run_trials(
@@ -284,8 +431,38 @@ void run_trials(
         if (trial >= config.trials_per_optimizer) break;
         const unsigned long optimizer_seed = seeds[trial];
 
+        // runs every configuration on each instance of the set
+        std::optional<hpoea::core::ProblemSetFactory> problem_set_factory;
+        if (config.problem_set) {
+            problem_set_factory.emplace(active_algorithm_factory, config.problem_set);
+        }
+        const IEvolutionaryAlgorithmFactory &run_factory =
+            problem_set_factory ? static_cast<const IEvolutionaryAlgorithmFactory &>(*problem_set_factory)
+                                : active_algorithm_factory;
+
+        // a fresh incumbent per optimize() call; validation runs once per seed
+        std::optional<hpoea::core::SeedRepeatFactory> seed_repeat_factory;
+        if (config.seed_repeats) {
+            seed_repeat_factory.emplace(run_factory, *config.seed_repeats);
+        }
+        const IEvolutionaryAlgorithmFactory &scored_factory =
+            seed_repeat_factory ? static_cast<const IEvolutionaryAlgorithmFactory &>(*seed_repeat_factory)
+                                : run_factory;
+
+        // a fresh cache per optimize() call
+        std::optional<SharedInitialPopulationFactory> sharing_factory;
+        if (config.share_initial_population) {
+            sharing_factory.emplace(
+                scored_factory,
+                std::make_shared<hpoea::core::InitialPopulationCache>(static_cast<unsigned long>(
+                    hpoea::core::splitmix64(static_cast<std::uint64_t>(optimizer_seed) ^
+                                            initial_population_stream_salt))));
+        }
+        const IEvolutionaryAlgorithmFactory &trial_factory =
+            sharing_factory ? static_cast<const IEvolutionaryAlgorithmFactory &>(*sharing_factory) : scored_factory;
+
         auto optimization_result = worker_optimizer.optimize(
-            active_algorithm_factory,
+            trial_factory,
             problem,
             config.optimizer_budget,
             config.algorithm_budget,
@@ -295,33 +472,21 @@ void run_trials(
             optimization_result.effective_optimizer_parameters = optimizer_parameters;
         }
 
-        run_validation_repeats(config, active_algorithm_factory, problem, optimizer_seed, optimization_result);
+        run_validation_repeats(config, run_factory, problem, optimizer_seed, optimization_result);
 
         optimization_results[trial] = std::move(optimization_result);
 
         {
             std::scoped_lock lock(logger_mutex);
             for (const auto &trial_record : optimization_results[trial].trials) {
-                logger.log(build_run_record(
-                    config,
-                    problem,
-                    active_algorithm_factory.identity(),
-                    worker_optimizer.identity(),
-                    optimizer_parameters,
-                    optimizer_seed,
-                    trial_record));
+                log_run(config, problem, active_algorithm_factory.identity(), worker_optimizer.identity(),
+                        optimizer_parameters, optimizer_seed, trial_record, hpoea::core::RunPhase::Tuning, logger);
             }
             for (const auto &validation_run : optimization_results[trial].validation_runs) {
-                auto log_record = build_run_record(
-                    config,
-                    problem,
-                    active_algorithm_factory.identity(),
-                    worker_optimizer.identity(),
-                    optimizer_parameters,
-                    optimizer_seed,
-                    {optimization_results[trial].best_parameters, validation_run});
-                log_record.phase = hpoea::core::RunPhase::Validation;
-                logger.log(log_record);
+                log_run(config, problem, active_algorithm_factory.identity(), worker_optimizer.identity(),
+                        optimizer_parameters, optimizer_seed,
+                        {optimization_results[trial].best_parameters, validation_run},
+                        hpoea::core::RunPhase::Validation, logger);
             }
         }
     }
@@ -345,9 +510,8 @@ ExperimentResult SequentialExperimentManager::run_experiment(const ExperimentCon
             "set max_parallel_trials to 1 or use ParallelExperimentManager");
     }
 
-    std::unique_ptr<IEvolutionaryAlgorithmFactory> owned_factory;
-    const auto &active_algorithm_factory =
-        resolve_algorithm_factory(algorithm_factory, config.algorithm_baseline_parameters, owned_factory);
+    std::vector<std::unique_ptr<IEvolutionaryAlgorithmFactory>> owned_factories;
+    const auto &active_algorithm_factory = resolve_algorithm_factory(algorithm_factory, config, owned_factories);
 
     ExperimentResult result;
     result.experiment_id = config.experiment_id;
@@ -397,9 +561,8 @@ ExperimentResult ParallelExperimentManager::run_experiment(const ExperimentConfi
         throw std::invalid_argument("max_parallel_trials must be greater than zero");
     }
 
-    std::unique_ptr<IEvolutionaryAlgorithmFactory> owned_factory;
-    const auto &active_algorithm_factory =
-        resolve_algorithm_factory(algorithm_factory, config.algorithm_baseline_parameters, owned_factory);
+    std::vector<std::unique_ptr<IEvolutionaryAlgorithmFactory>> owned_factories;
+    const auto &active_algorithm_factory = resolve_algorithm_factory(algorithm_factory, config, owned_factories);
 
     ExperimentResult result;
     result.experiment_id = config.experiment_id;
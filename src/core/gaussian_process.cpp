@@ -0,0 +1,204 @@
+#include "hpoea/core/gaussian_process.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+
+// keeps the factor positive definite when a point repeats
+constexpr double min_pivot = 1e-12;
+
+// four independent sums let the compiler pipeline and vectorize without
+// reassociating one serial chain, which strict floating point forbids
+double dot(const double *a, const double *b, std::size_t n) noexcept {
+    double s0 = 0.0;
+    double s1 = 0.0;
+    double s2 = 0.0;
+    double s3 = 0.0;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < n; ++i) {
+        s0 += a[i] * b[i];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+} // namespace
+
+namespace hpoea::core {
+
+GaussianProcess::GaussianProcess(std::size_t dimension, GaussianProcessKernel kernel)
+    : dimension_(dimension), kernel_(kernel) {
+    if (dimension_ == 0u) {
+        throw std::invalid_argument("gaussian process dimension must be positive");
+    }
+    if (!(kernel_.length_scale > 0.0) || !(kernel_.noise >= 0.0)) {
+        throw std::invalid_argument("gaussian process needs a positive length scale and non-negative noise");
+    }
+}
+
+double GaussianProcess::covariance(const double *a, const double *b) const noexcept {
+    double squared = 0.0;
+    for (std::size_t i = 0; i < dimension_; ++i) {
+        const auto delta = a[i] - b[i];
+        squared += delta * delta;
+    }
+    const auto s = std::sqrt(5.0 * squared) / kernel_.length_scale;
+    return (1.0 + s + s * s / 3.0) * std::exp(-s);
+}
+
+void GaussianProcess::forward_solve(std::vector<double> &values, std::size_t n) const noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto *row = factor_.data() + i * (i + 1) / 2;
+        values[i] = (values[i] - dot(row, values.data(), i)) / row[i];
+    }
+}
+
+void GaussianProcess::add(const std::vector<double> &point) {
+    if (point.size() != dimension_) {
+        throw std::invalid_argument("gaussian process point has " + std::to_string(point.size()) +
+                                    " coordinates, expected " + std::to_string(dimension_));
+    }
+    const auto n = size();
+    std::vector<double> row(n + 1);
+    for (std::size_t i = 0; i < n; ++i) {
+        row[i] = covariance(points_.data() + i * dimension_, point.data());
+    }
+    forward_solve(row, n);
+    const auto pivot = 1.0 + kernel_.noise - dot(row.data(), row.data(), n);
+    row[n] = std::sqrt(std::max(pivot, min_pivot));
+
+    factor_.insert(factor_.end(), row.begin(), row.end());
+    points_.insert(points_.end(), point.begin(), point.end());
+}
+
+void GaussianProcess::set_targets(const std::vector<double> &targets) {
+    if (targets.size() != size()) {
+        throw std::invalid_argument("gaussian process has " + std::to_string(size()) + " points but " +
+                                    std::to_string(targets.size()) + " targets");
+    }
+    targets_ = targets;
+    solve_weights();
+}
+
+void GaussianProcess::solve_weights() {
+    const auto n = targets_.size();
+    target_mean_ = 0.0;
+    for (auto y : targets_) {
+        target_mean_ += y;
+    }
+    target_mean_ = n == 0u ? 0.0 : target_mean_ / static_cast<double>(n);
+    double spread = 0.0;
+    for (auto y : targets_) {
+        spread += (y - target_mean_) * (y - target_mean_);
+    }
+    target_scale_ = n < 2u ? 1.0 : std::sqrt(spread / static_cast<double>(n - 1));
+    if (!(target_scale_ > 1e-12) || !std::isfinite(target_scale_)) {
+        target_scale_ = 1.0;
+    }
+
+    whitened_.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        whitened_[i] = (targets_[i] - target_mean_) / target_scale_;
+    }
+    forward_solve(whitened_, n);
+
+    // back substitution with L^T, column i of L^T is row i of L
+    weights_ = whitened_;
+    for (std::size_t i = n; i-- > 0;) {
+        const auto *row = factor_.data() + i * (i + 1) / 2;
+        weights_[i] /= row[i];
+        for (std::size_t j = 0; j < i; ++j) {
+            weights_[j] -= row[j] * weights_[i];
+        }
+    }
+}
+
+GaussianProcessPrediction GaussianProcess::predict(const std::vector<double> &point,
+                                                   std::vector<double> &scratch) const {
+    const auto n = size();
+    if (weights_.size() != n) {
+        throw std::logic_error("gaussian process targets are out of date");
+    }
+    if (n == 0u) {
+        return {0.0, 1.0};
+    }
+    scratch.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        scratch[i] = covariance(points_.data() + i * dimension_, point.data());
+    }
+    const auto mean = dot(scratch.data(), weights_.data(), n);
+    forward_solve(scratch, n);
+    const auto variance = std::max(1.0 - dot(scratch.data(), scratch.data(), n), 0.0);
+    return {target_mean_ + target_scale_ * mean, target_scale_ * target_scale_ * variance};
+}
+
+double GaussianProcess::log_marginal_likelihood() const {
+    const auto n = size();
+    if (weights_.size() != n) {
+        throw std::logic_error("gaussian process targets are out of date");
+    }
+    double log_det = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        log_det += std::log(factor_[i * (i + 1) / 2 + i]);
+    }
+    return -0.5 * dot(whitened_.data(), whitened_.data(), n) - log_det -
+           0.5 * static_cast<double>(n) * std::log(2.0 * std::numbers::pi);
+}
+
+void GaussianProcess::set_kernel(GaussianProcessKernel kernel) {
+    GaussianProcess rebuilt(dimension_, kernel);
+    const auto n = size();
+    std::vector<double> point(dimension_);
+    for (std::size_t i = 0; i < n; ++i) {
+        std::copy_n(points_.begin() + static_cast<std::ptrdiff_t>(i * dimension_), dimension_, point.begin());
+        rebuilt.add(point);
+    }
+    if (targets_.size() == n) {
+        rebuilt.set_targets(targets_);
+    }
+    *this = std::move(rebuilt);
+}
+
+GaussianProcessKernel GaussianProcess::fit_kernel(std::size_t dimension,
+                                                  const std::vector<std::vector<double>> &points,
+                                                  const std::vector<double> &targets) {
+    constexpr double length_factors[] = {0.05, 0.1, 0.2, 0.4, 0.8};
+    constexpr double noises[] = {1e-6, 1e-4, 1e-2, 1e-1};
+    const auto diagonal = std::sqrt(static_cast<double>(dimension));
+
+    GaussianProcessKernel best;
+    best.length_scale = 0.2 * diagonal;
+    if (points.size() < 2u) {
+        return best;
+    }
+    double best_likelihood = -std::numeric_limits<double>::infinity();
+    for (auto factor : length_factors) {
+        for (auto noise : noises) {
+            GaussianProcess candidate(dimension, {factor * diagonal, noise});
+            for (const auto &point : points) {
+                candidate.add(point);
+            }
+            candidate.set_targets(targets);
+            const auto likelihood = candidate.log_marginal_likelihood();
+            if (likelihood > best_likelihood) {
+                best_likelihood = likelihood;
+                best = candidate.kernel();
+            }
+        }
+    }
+    return best;
+}
+
+} // namespace hpoea::core
@@ -0,0 +1,266 @@
+#include "hpoea/core/grid_search_optimizer.hpp"
+
+#include "hpoea/core/budget_checks.hpp"
+#include "hpoea/core/error_classification.hpp"
+#include "hpoea/core/parameter_sampling.hpp"
+#include "hpoea/core/seeding.hpp"
+#include "hpoea/core/trial_runner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace {
+
+constexpr const char *RESOLUTION = "resolution";
+constexpr const char *START_INDEX = "start_index";
+constexpr const char *PARALLEL_WORKERS = "parallel_workers";
+// index ranges per worker before a wall-time check
+constexpr std::size_t shards_per_worker = 4;
+constexpr std::size_t max_shard_size = 16;
+
+hpoea::core::ParameterSpace make_parameter_space() {
+    hpoea::core::ParameterSpace space;
+
+    hpoea::core::ParameterDescriptor d;
+    d.name = RESOLUTION;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{2, 1000};
+    d.default_value = std::int64_t{5};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = START_INDEX;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{0, std::numeric_limits<std::int64_t>::max()};
+    d.default_value = std::int64_t{0};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = PARALLEL_WORKERS;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{0, 1024};
+    d.default_value = std::int64_t{1};
+    space.add_descriptor(d);
+
+    return space;
+}
+
+// unit-cube coordinates of every axis; the product is never built
+class Grid {
+public:
+    Grid(const hpoea::core::UnitCubeEncoding &encoding, std::size_t resolution) {
+        axes_.resize(encoding.dimension());
+        for (std::size_t d = 0; d < axes_.size(); ++d) {
+            auto &axis = axes_[d];
+            const auto cells = encoding.cells(d);
+            if (cells == 0u) {
+                for (std::size_t i = 0; i < resolution; ++i) {
+                    axis.push_back(static_cast<double>(i) / static_cast<double>(resolution - 1));
+                }
+            } else if (encoding.choices(d) > 0u || cells <= resolution) {
+                for (std::size_t k = 0; k < cells; ++k) {
+                    axis.push_back(cell_center(k, cells));
+                }
+            } else {
+                // evenly spaced integers, both ends included
+                const auto span = static_cast<double>(cells - 1);
+                for (std::size_t i = 0; i < resolution; ++i) {
+                    const auto k = static_cast<std::size_t>(
+                        std::llround(span * static_cast<double>(i) / static_cast<double>(resolution - 1)));
+                    axis.push_back(cell_center(k, cells));
+                }
+            }
+            if (size_ > std::numeric_limits<std::size_t>::max() / axis.size()) {
+                throw std::invalid_argument("grid has more points than a grid index can address");
+            }
+            size_ *= axis.size();
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    // mixed-radix digits of index, last axis fastest
+    void point(std::size_t index, std::vector<double> &out) const {
+        if (index >= size_) {
+            throw std::out_of_range("grid index " + std::to_string(index) + " is past the last of " +
+                                    std::to_string(size_) + " points");
+        }
+        out.resize(axes_.size());
+        for (std::size_t d = axes_.size(); d-- > 0;) {
+            const auto &axis = axes_[d];
+            out[d] = axis[index % axis.size()];
+            index /= axis.size();
+        }
+    }
+
+private:
+    [[nodiscard]] static double cell_center(std::size_t k, std::size_t cells) {
+        return (static_cast<double>(k) + 0.5) / static_cast<double>(cells);
+    }
+
+    std::vector<std::vector<double>> axes_;
+    std::size_t size_{1};
+};
+
+} // namespace
+
+namespace hpoea::core {
+
+GridSearchOptimizer::GridSearchOptimizer()
+    : HyperOptimizerBase(make_parameter_space(), {"GridSearch", "cartesian_grid", "1.0"}) {}
+
+std::size_t GridSearchOptimizer::grid_size(const ParameterSpace &space) const {
+    const UnitCubeEncoding encoding(space, search_space_.get());
+    return Grid(encoding, count_parameter(configured_parameters_, RESOLUTION)).size();
+}
+
+ParameterSet GridSearchOptimizer::grid_point(const ParameterSpace &space, std::size_t index) const {
+    const UnitCubeEncoding encoding(space, search_space_.get());
+    std::vector<double> unit;
+    Grid(encoding, count_parameter(configured_parameters_, RESOLUTION)).point(index, unit);
+    return encoding.decode(unit);
+}
+
+std::size_t GridSearchOptimizer::resume_index(const HyperparameterOptimizationResult &result) {
+    if (!result.trials.empty()) {
+        return result.trials.back().trial_index + 1u;
+    }
+    return result.effective_optimizer_parameters.contains(START_INDEX)
+               ? count_parameter(result.effective_optimizer_parameters, START_INDEX)
+               : 0u;
+}
+
+HyperparameterOptimizationResult GridSearchOptimizer::optimize(const IEvolutionaryAlgorithmFactory &algorithm_factory,
+                                                               const IProblem &problem,
+                                                               const Budget &optimizer_budget,
+                                                               const Budget &algorithm_budget, unsigned long seed) {
+
+    HyperparameterOptimizationResult result;
+    result.status = RunStatus::InternalError;
+    result.seed = seed;
+    result.effective_optimizer_parameters = configured_parameters_;
+
+    const auto start_time = std::chrono::steady_clock::now();
+
+    try {
+        const auto &algorithm_space = algorithm_factory.parameter_space();
+        if (algorithm_space.empty()) {
+            throw std::invalid_argument("algorithm has no tunable parameters");
+        }
+        if (search_space_) {
+            search_space_->validate(algorithm_space);
+        }
+        if (!has_tunable_dimension(algorithm_space, search_space_.get())) {
+            throw ParameterValidationError(
+                "all parameters are fixed or excluded; use BaselineOptimizer for fixed/default runs");
+        }
+
+        if (optimizer_budget.generations.has_value()) {
+            throw std::invalid_argument(
+                "grid search does not consume a generations budget; use optimizer_budget.function_evaluations");
+        }
+
+        const UnitCubeEncoding encoding(algorithm_space, search_space_.get());
+        const Grid grid(encoding, count_parameter(configured_parameters_, RESOLUTION));
+        const auto start_index = count_parameter(configured_parameters_, START_INDEX);
+        if (start_index > grid.size()) {
+            throw std::invalid_argument("start_index " + std::to_string(start_index) + " is past the last of " +
+                                        std::to_string(grid.size()) + " grid points");
+        }
+        auto planned_points = grid.size() - start_index;
+        if (optimizer_budget.function_evaluations.has_value()) {
+            planned_points = std::min(planned_points, *optimizer_budget.function_evaluations);
+        }
+
+        if (planned_points == 0u) {
+            const auto end_time = std::chrono::steady_clock::now();
+            result.status = RunStatus::BudgetExceeded;
+            result.message = start_index == grid.size() ? "grid search has no points left after start_index"
+                                                        : "optimizer budget allows zero grid search points";
+            result.optimizer_usage.wall_time =
+                std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+            return result;
+        }
+
+        const auto pruner = make_trial_pruner();
+        std::atomic<std::size_t> calls{0};
+        const auto grid_trial = [&](std::size_t grid_index) {
+            const auto trial_seed =
+                static_cast<unsigned long>(derive_stream_seed(static_cast<std::uint64_t>(seed), grid_index));
+            bool started = false;
+            auto trial = run_trial(algorithm_factory, problem, algorithm_budget, trial_seed, grid_index,
+                                   [&] {
+                                       std::vector<double> unit;
+                                       grid.point(grid_index, unit);
+                                       return encoding.decode(unit);
+                                   },
+                                   &started, trial_progress(pruner));
+            if (started) {
+                calls.fetch_add(1, std::memory_order_relaxed);
+            }
+            return trial;
+        };
+        const WallTimeLimit wall_time_spent{optimizer_budget, start_time};
+
+        // shards of contiguous indices go out in order and a started shard
+        // always finishes, so a wall-time stop leaves a gap-free prefix
+        const auto workers = parallel_workers(configured_parameters_);
+        const auto shard_size = std::clamp<std::size_t>(
+            planned_points / (workers * shards_per_worker), 1u, max_shard_size);
+        const auto shards = (planned_points + shard_size - 1u) / shard_size;
+        std::vector<std::optional<HyperparameterTrialRecord>> slots(planned_points);
+        run_indexed(
+            shards, workers,
+            [&](std::size_t shard) {
+                const auto first = shard * shard_size;
+                const auto last = std::min(first + shard_size, planned_points);
+                for (auto offset = first; offset < last; ++offset) {
+                    slots[offset] = grid_trial(start_index + offset);
+                }
+            },
+            wall_time_spent);
+
+        bool stopped_for_wall_time = false;
+        result.trials.reserve(planned_points);
+        for (auto &slot : slots) {
+            if (!slot) {
+                stopped_for_wall_time = true;
+                break;
+            }
+            result.trials.push_back(std::move(*slot));
+        }
+
+        const auto end_time = std::chrono::steady_clock::now();
+        result.optimizer_usage.objective_calls = calls.load(std::memory_order_relaxed);
+        result.optimizer_usage.iterations = result.trials.size();
+        result.optimizer_usage.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+        select_best_trial(result, "grid search");
+        if (stopped_for_wall_time) {
+            result.status = RunStatus::BudgetExceeded;
+            result.message = "wall-time budget exceeded";
+        }
+        apply_optimizer_budget_status(optimizer_budget, result.optimizer_usage, result.status, result.message);
+    } catch (const std::exception &ex) {
+        const auto end_time = std::chrono::steady_clock::now();
+        const auto classified = classify_exception(ex);
+        result.status = classified.status;
+        result.error_info = classified.error_info;
+        result.message = ex.what();
+        result.optimizer_usage.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+    }
+
+    return result;
+}
+
+} // namespace hpoea::core
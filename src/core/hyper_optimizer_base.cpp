@@ -1,6 +1,9 @@
 #include "hpoea/core/hyper_optimizer_base.hpp"
 
+#include "hpoea/core/parameter_sampling.hpp"
+
 #include <utility>
+#include <variant>
 
 namespace hpoea::core {
 
@@ -13,7 +16,10 @@ HyperOptimizerBase::HyperOptimizerBase(const HyperOptimizerBase &other)
     : parameter_space_(other.parameter_space_),
       configured_parameters_(other.configured_parameters_),
       identity_(other.identity_),
-      search_space_(other.search_space_ ? std::make_shared<SearchSpace>(*other.search_space_) : nullptr) {}
+      search_space_(other.search_space_ ? std::make_shared<SearchSpace>(*other.search_space_) : nullptr),
+      pruning_policy_(other.pruning_policy_),
+      history_(other.history_),
+      prior_count_(other.prior_count_) {}
 
 void HyperOptimizerBase::configure(const ParameterSet &parameters) {
     configured_parameters_ = parameter_space_.apply_defaults(parameters);
@@ -24,4 +30,54 @@ void HyperOptimizerBase::set_search_space(std::shared_ptr<SearchSpace> search_sp
     search_space_ = std::move(search_space);
 }
 
+void HyperOptimizerBase::set_pruning_policy(std::optional<PruningPolicy> policy) {
+    if (policy) {
+        validate_pruning_policy(*policy);
+    }
+    pruning_policy_ = policy;
+}
+
+std::shared_ptr<TrialPruner> HyperOptimizerBase::make_trial_pruner() const {
+    if (!pruning_policy_ || pruning_policy_->rule == PruningRule::None) {
+        return nullptr;
+    }
+    return std::make_shared<TrialPruner>(*pruning_policy_);
+}
+
+void HyperOptimizerBase::set_trial_history(std::shared_ptr<const TrialHistory> history, std::size_t prior_count) {
+    history_ = std::move(history);
+    prior_count_ = prior_count;
+}
+
+std::vector<HistoryTrial> HyperOptimizerBase::prior_trials(const IEvolutionaryAlgorithmFactory &algorithm_factory,
+                                                           const IProblem &problem) const {
+    if (!history_ || prior_count_ == 0u) {
+        return {};
+    }
+    const auto &space = algorithm_factory.parameter_space();
+    const HistoryKey key{algorithm_factory.identity(), problem.metadata().id,
+                         search_space_fingerprint(space, search_space_.get())};
+    const UnitCubeEncoding encoding(space, search_space_.get());
+
+    std::vector<HistoryTrial> priors;
+    for (auto &trial : history_->best(key, prior_count_)) {
+        for (const auto &descriptor : space.descriptors()) {
+            const auto it = trial.parameters.find(descriptor.name);
+            if (descriptor.type == ParameterType::Continuous && it != trial.parameters.end() &&
+                std::holds_alternative<std::int64_t>(it->second)) {
+                it->second = static_cast<double>(std::get<std::int64_t>(it->second));
+            }
+        }
+        try {
+            space.validate(trial.parameters);
+        } catch (const ParameterValidationError &) {
+            continue;
+        }
+        if (encoding.encode(trial.parameters)) {
+            priors.push_back(std::move(trial));
+        }
+    }
+    return priors;
+}
+
 } // namespace hpoea::core
@@ -0,0 +1,486 @@
+#include "hpoea/core/hyperband_optimizer.hpp"
+
+#include "hpoea/core/budget_checks.hpp"
+#include "hpoea/core/error_classification.hpp"
+#include "hpoea/core/parameter_sampling.hpp"
+#include "hpoea/core/seeding.hpp"
+#include "hpoea/core/trial_runner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace {
+
+constexpr const char *ETA = "eta";
+constexpr const char *MIN_FIDELITY = "min_fidelity";
+constexpr const char *VARIANT = "variant";
+constexpr const char *ITERATIONS = "iterations";
+constexpr const char *PARALLEL_WORKERS = "parallel_workers";
+// keeps configuration streams apart from the inner run seeds,
+// which use derive_stream_seed(seed, config) directly
+constexpr std::uint64_t sample_stream_salt = 0x4b7e2d1a9c3f6e85ULL;
+
+hpoea::core::ParameterSpace make_parameter_space() {
+    hpoea::core::ParameterSpace space;
+
+    hpoea::core::ParameterDescriptor d;
+    d.name = ETA;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{2, 10};
+    d.default_value = std::int64_t{3};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = MIN_FIDELITY;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{0, 100000000};
+    d.default_value = std::int64_t{0};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = VARIANT;
+    d.type = hpoea::core::ParameterType::Categorical;
+    d.categorical_choices = {"hyperband", "asha"};
+    d.default_value = std::string{"hyperband"};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = ITERATIONS;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{1, 10000};
+    d.default_value = std::int64_t{1};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = PARALLEL_WORKERS;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{0, 1024};
+    d.default_value = std::int64_t{1};
+    space.add_descriptor(d);
+
+    return space;
+}
+
+bool is_asha(const hpoea::core::ParameterSet &parameters) {
+    const auto it = parameters.find(VARIANT);
+    if (it == parameters.end() || !std::holds_alternative<std::string>(it->second)) {
+        throw std::invalid_argument(std::string("missing parameter: ") + VARIANT);
+    }
+    return std::get<std::string>(it->second) == "asha";
+}
+
+// rung k runs at min * eta^k, the top rung at full
+struct FidelityLadder {
+    std::size_t full{0};
+    std::size_t min{0};
+    std::size_t eta{0};
+    std::size_t top{0};
+    bool generations{false};
+
+    [[nodiscard]] std::size_t fidelity(std::size_t rung) const {
+        if (rung >= top) {
+            return full;
+        }
+        std::size_t value = min;
+        for (std::size_t i = 0; i < rung; ++i) {
+            value *= eta;
+        }
+        return value;
+    }
+
+    [[nodiscard]] hpoea::core::Budget budget(const hpoea::core::Budget &base, std::size_t rung) const {
+        auto out = base;
+        if (generations) {
+            out.generations = fidelity(rung);
+        } else {
+            out.function_evaluations = fidelity(rung);
+        }
+        return out;
+    }
+
+    [[nodiscard]] std::size_t fidelity_of(const hpoea::core::HyperparameterTrialRecord &trial) const {
+        const auto &requested = trial.optimization_result.requested_budget;
+        return (generations ? requested.generations : requested.function_evaluations).value_or(0u);
+    }
+};
+
+FidelityLadder make_ladder(const hpoea::core::Budget &algorithm_budget, std::size_t eta, std::size_t configured_min) {
+    FidelityLadder ladder;
+    ladder.eta = eta;
+    if (algorithm_budget.function_evaluations.has_value()) {
+        ladder.full = *algorithm_budget.function_evaluations;
+    } else if (algorithm_budget.generations.has_value()) {
+        ladder.full = *algorithm_budget.generations;
+        ladder.generations = true;
+    } else {
+        throw std::invalid_argument(
+            "hyperband uses the algorithm budget as fidelity; set algorithm_budget.function_evaluations or "
+            "generations");
+    }
+    if (ladder.full == 0u) {
+        throw std::invalid_argument("hyperband full fidelity must be positive");
+    }
+
+    if (configured_min == 0u) {
+        // four rungs when the full fidelity allows it
+        ladder.min = ladder.full;
+        for (int i = 0; i < 3; ++i) {
+            ladder.min = std::max<std::size_t>(ladder.min / eta, 1u);
+        }
+    } else if (configured_min > ladder.full) {
+        throw std::invalid_argument("hyperband min_fidelity " + std::to_string(configured_min) +
+                                    " exceeds the full fidelity " + std::to_string(ladder.full));
+    } else {
+        ladder.min = configured_min;
+    }
+
+    for (std::size_t value = ladder.min; value * eta <= ladder.full; value *= eta) {
+        ++ladder.top;
+    }
+    return ladder;
+}
+
+std::size_t power(std::size_t base, std::size_t exponent) {
+    std::size_t value = 1;
+    for (std::size_t i = 0; i < exponent; ++i) {
+        value *= base;
+    }
+    return value;
+}
+
+// failed and over-budget trials rank last and are never promoted
+double rank_fitness(const hpoea::core::HyperparameterTrialRecord &trial) {
+    return hpoea::core::is_selectable_trial(trial) ? trial.optimization_result.best_fitness
+                                                   : std::numeric_limits<double>::infinity();
+}
+
+struct Job {
+    std::size_t config{0};
+    std::size_t rung{0};
+    std::optional<hpoea::core::ParameterSet> parameters;
+};
+
+struct RungEntry {
+    std::size_t config{0};
+    double fitness{0.0};
+    hpoea::core::ParameterSet parameters;
+    bool promoted{false};
+};
+
+// best unpromoted entry inside the top 1/eta of rung, if any
+RungEntry *next_promotion(std::vector<RungEntry> &rung, std::size_t eta) {
+    const auto keep = rung.size() / eta;
+    if (keep == 0u) {
+        return nullptr;
+    }
+    std::vector<std::size_t> order(rung.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        if (rung[a].fitness != rung[b].fitness) {
+            return rung[a].fitness < rung[b].fitness;
+        }
+        return rung[a].config < rung[b].config;
+    });
+    for (std::size_t n = 0; n < keep; ++n) {
+        auto &entry = rung[order[n]];
+        if (!std::isfinite(entry.fitness)) {
+            return nullptr;
+        }
+        if (!entry.promoted) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+namespace hpoea::core {
+
+HyperbandOptimizer::HyperbandOptimizer()
+    : HyperOptimizerBase(make_parameter_space(), {"Hyperband", "successive_halving", "1.0"}) {}
+
+HyperparameterOptimizationResult HyperbandOptimizer::optimize(const IEvolutionaryAlgorithmFactory &algorithm_factory,
+                                                              const IProblem &problem,
+                                                              const Budget &optimizer_budget,
+                                                              const Budget &algorithm_budget, unsigned long seed) {
+
+    HyperparameterOptimizationResult result;
+    result.status = RunStatus::InternalError;
+    result.seed = seed;
+    result.effective_optimizer_parameters = configured_parameters_;
+
+    const auto start_time = std::chrono::steady_clock::now();
+
+    try {
+        const auto &algorithm_space = algorithm_factory.parameter_space();
+        if (algorithm_space.empty()) {
+            throw std::invalid_argument("algorithm has no tunable parameters");
+        }
+        if (search_space_) {
+            search_space_->validate(algorithm_space);
+        }
+        if (!has_tunable_dimension(algorithm_space, search_space_.get())) {
+            throw ParameterValidationError(
+                "all parameters are fixed or excluded; use BaselineOptimizer for fixed/default runs");
+        }
+        if (optimizer_budget.generations.has_value()) {
+            throw std::invalid_argument(
+                "hyperband does not consume a generations budget; use optimizer_budget.function_evaluations");
+        }
+
+        const auto eta = count_parameter(configured_parameters_, ETA);
+        const auto ladder = make_ladder(algorithm_budget, eta, count_parameter(configured_parameters_, MIN_FIDELITY));
+        const auto iterations = count_parameter(configured_parameters_, ITERATIONS);
+        const auto asha = is_asha(configured_parameters_);
+        const auto name = asha ? "asha" : "hyperband";
+        const auto workers = parallel_workers(configured_parameters_);
+
+        if (optimizer_budget.function_evaluations.has_value() && *optimizer_budget.function_evaluations == 0u) {
+            const auto end_time = std::chrono::steady_clock::now();
+            result.status = RunStatus::BudgetExceeded;
+            result.message = std::string("optimizer budget allows zero ") + name + " trials";
+            result.optimizer_usage.wall_time =
+                std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+            return result;
+        }
+        // each trial is one objective call, counted against this cap when dispatched
+        const auto call_cap = optimizer_budget.function_evaluations.value_or(std::numeric_limits<std::size_t>::max());
+
+        // a configuration keeps its sample stream and run seed on every rung
+        const auto sample_seed = static_cast<std::uint64_t>(seed) ^ sample_stream_salt;
+        std::atomic<std::size_t> calls{0};
+        const auto evaluate = [&](const Job &job, std::size_t trial_index) {
+            const auto trial_seed =
+                static_cast<unsigned long>(derive_stream_seed(static_cast<std::uint64_t>(seed), job.config));
+            const auto rung_budget = ladder.budget(algorithm_budget, job.rung);
+            bool started = false;
+            auto trial = run_trial(algorithm_factory, problem, rung_budget, trial_seed, trial_index,
+                                   [&] {
+                                       if (job.parameters) {
+                                           return *job.parameters;
+                                       }
+                                       std::mt19937_64 rng{derive_stream_seed(sample_seed, job.config)};
+                                       return sample_parameters(algorithm_space, search_space_.get(), rng);
+                                   },
+                                   &started);
+            trial.optimization_result.requested_budget = rung_budget;
+            if (started) {
+                calls.fetch_add(1, std::memory_order_relaxed);
+            }
+            return trial;
+        };
+        const WallTimeLimit wall_time_spent{optimizer_budget, start_time};
+
+        bool stopped_for_wall_time = false;
+        std::size_t dispatched = 0;
+        std::size_t next_config = 0;
+
+        if (!asha) {
+            bool cap_reached = false;
+            for (std::size_t iteration = 0; iteration < iterations && !stopped_for_wall_time && !cap_reached;
+                 ++iteration) {
+                for (std::size_t s = ladder.top + 1; s-- > 0 && !stopped_for_wall_time && !cap_reached;) {
+                    // bracket s starts n configurations s rungs below the top
+                    const auto n = ((ladder.top + 1) * power(eta, s) + s) / (s + 1);
+                    std::vector<Job> jobs;
+                    jobs.reserve(n);
+                    for (std::size_t i = 0; i < n; ++i) {
+                        jobs.push_back(Job{next_config++, ladder.top - s, std::nullopt});
+                    }
+
+                    for (std::size_t i = 0; i <= s && !jobs.empty(); ++i) {
+                        if (jobs.size() > call_cap - dispatched) {
+                            jobs.resize(call_cap - dispatched);
+                            cap_reached = true;
+                        }
+                        const auto first_index = result.trials.size();
+                        std::vector<std::optional<HyperparameterTrialRecord>> slots(jobs.size());
+                        run_indexed(
+                            jobs.size(), workers,
+                            [&](std::size_t j) { slots[j] = evaluate(jobs[j], first_index + j); }, wall_time_spent);
+
+                        std::vector<std::size_t> done;
+                        for (std::size_t j = 0; j < slots.size(); ++j) {
+                            if (!slots[j]) {
+                                stopped_for_wall_time = true;
+                                break;
+                            }
+                            done.push_back(j);
+                        }
+                        dispatched += done.size();
+                        if (stopped_for_wall_time || cap_reached || i == s) {
+                            for (auto j : done) {
+                                result.trials.push_back(std::move(*slots[j]));
+                            }
+                            break;
+                        }
+
+                        // promote the top 1/eta, ties broken by configuration order
+                        std::vector<std::size_t> order = done;
+                        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+                            return rank_fitness(*slots[a]) < rank_fitness(*slots[b]);
+                        });
+                        std::vector<Job> promoted;
+                        for (std::size_t k = 0; k < done.size() / eta; ++k) {
+                            const auto &trial = *slots[order[k]];
+                            if (!std::isfinite(rank_fitness(trial))) {
+                                break;
+                            }
+                            promoted.push_back(Job{jobs[order[k]].config, jobs[order[k]].rung + 1, trial.parameters});
+                        }
+                        for (auto j : done) {
+                            result.trials.push_back(std::move(*slots[j]));
+                        }
+                        jobs = std::move(promoted);
+                    }
+                }
+            }
+        } else {
+            const auto max_configs = iterations * power(eta, ladder.top);
+            std::vector<std::vector<RungEntry>> rungs(ladder.top + 1);
+            std::mutex state_mutex;
+            std::condition_variable state_changed;
+            std::size_t running = 0;
+            bool stop = false;
+            std::exception_ptr worker_error;
+
+            // called with state_mutex held
+            const auto next_job = [&]() -> std::optional<Job> {
+                if (dispatched >= call_cap) {
+                    return std::nullopt;
+                }
+                for (std::size_t k = ladder.top; k-- > 0;) {
+                    if (auto *entry = next_promotion(rungs[k], eta)) {
+                        entry->promoted = true;
+                        return Job{entry->config, k + 1, entry->parameters};
+                    }
+                }
+                if (next_config < max_configs) {
+                    return Job{next_config++, 0, std::nullopt};
+                }
+                return std::nullopt;
+            };
+
+            const auto work = [&] {
+                std::unique_lock lock(state_mutex);
+                while (!stop) {
+                    if (wall_time_spent()) {
+                        stopped_for_wall_time = true;
+                        stop = true;
+                        break;
+                    }
+                    auto job = next_job();
+                    if (!job) {
+                        // running trials may still fill a rung enough to promote
+                        if (running == 0u) {
+                            break;
+                        }
+                        state_changed.wait(lock);
+                        continue;
+                    }
+                    const auto trial_index = dispatched++;
+                    ++running;
+                    lock.unlock();
+
+                    std::optional<HyperparameterTrialRecord> trial;
+                    std::exception_ptr error;
+                    try {
+                        trial = evaluate(*job, trial_index);
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+
+                    lock.lock();
+                    --running;
+                    if (error) {
+                        if (!worker_error) {
+                            worker_error = error;
+                        }
+                        stop = true;
+                        break;
+                    }
+                    rungs[job->rung].push_back(RungEntry{job->config, rank_fitness(*trial), trial->parameters});
+                    result.trials.push_back(std::move(*trial));
+                    state_changed.notify_all();
+                }
+                state_changed.notify_all();
+            };
+
+            const auto thread_count = std::min(workers, max_configs);
+            if (thread_count <= 1u) {
+                work();
+            } else {
+                std::vector<std::thread> threads;
+                threads.reserve(thread_count);
+                for (std::size_t i = 0; i < thread_count; ++i) {
+                    threads.emplace_back(work);
+                }
+                for (auto &thread : threads) {
+                    thread.join();
+                }
+            }
+            if (worker_error) {
+                std::rethrow_exception(worker_error);
+            }
+            std::sort(result.trials.begin(), result.trials.end(),
+                      [](const auto &a, const auto &b) { return a.trial_index < b.trial_index; });
+        }
+
+        const auto end_time = std::chrono::steady_clock::now();
+        result.optimizer_usage.objective_calls = calls.load(std::memory_order_relaxed);
+        result.optimizer_usage.iterations = result.trials.size();
+        result.optimizer_usage.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+        select_best_trial(result, name);
+        if (result.status == RunStatus::Success) {
+            // a low-fidelity score is not comparable with a full one,
+            // so the best comes from the highest rung anything reached
+            const HyperparameterTrialRecord *best = nullptr;
+            for (const auto &trial : result.trials) {
+                if (!is_selectable_trial(trial)) {
+                    continue;
+                }
+                if (best == nullptr || ladder.fidelity_of(trial) > ladder.fidelity_of(*best) ||
+                    (ladder.fidelity_of(trial) == ladder.fidelity_of(*best) &&
+                     trial.optimization_result.best_fitness < best->optimization_result.best_fitness)) {
+                    best = &trial;
+                }
+            }
+            result.best_parameters = best->parameters;
+            result.best_objective = best->optimization_result.best_fitness;
+        }
+        if (stopped_for_wall_time) {
+            result.status = RunStatus::BudgetExceeded;
+            result.message = "wall-time budget exceeded";
+        }
+        apply_optimizer_budget_status(optimizer_budget, result.optimizer_usage, result.status, result.message);
+    } catch (const std::exception &ex) {
+        const auto end_time = std::chrono::steady_clock::now();
+        const auto classified = classify_exception(ex);
+        result.status = classified.status;
+        result.error_info = classified.error_info;
+        result.message = ex.what();
+        result.optimizer_usage.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+    }
+
+    return result;
+}
+
+} // namespace hpoea::core
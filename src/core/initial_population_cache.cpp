@@ -0,0 +1,64 @@
+#include "hpoea/core/initial_population_cache.hpp"
+
+#include "hpoea/core/seeding.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace hpoea::core {
+
+unsigned long InitialPopulationCache::seed_for(std::size_t population_size) const noexcept {
+    return static_cast<unsigned long>(derive_stream_seed(static_cast<std::uint64_t>(seed_), population_size));
+}
+
+std::shared_ptr<const InitialPopulation> InitialPopulationCache::get_or_build(
+    const IProblem &problem,
+    std::size_t population_size,
+    const std::function<InitialPopulation()> &build,
+    bool *built) {
+    return get_or_build(problem, population_size, 0u, build, built);
+}
+
+std::shared_ptr<const InitialPopulation> InitialPopulationCache::get_or_build(
+    const IProblem &problem,
+    std::size_t population_size,
+    std::size_t variant,
+    const std::function<InitialPopulation()> &build,
+    bool *built) {
+    std::shared_ptr<Slot> slot;
+    {
+        std::scoped_lock lock(mutex_);
+        auto &entry = slots_[{&problem, population_size, variant}];
+        if (!entry) {
+            entry = std::make_shared<Slot>();
+        }
+        slot = entry;
+    }
+
+    std::scoped_lock slot_lock(slot->mutex);
+    if (built != nullptr) {
+        *built = false;
+    }
+    if (slot->population) {
+        std::scoped_lock lock(mutex_);
+        reused_evaluations_ += slot->population->fitness.size();
+        return slot->population;
+    }
+
+    auto population = build();
+    if (population.decision_vectors.size() != population.fitness.size()) {
+        throw std::invalid_argument("initial population needs one fitness value per decision vector");
+    }
+    slot->population = std::make_shared<const InitialPopulation>(std::move(population));
+    if (built != nullptr) {
+        *built = true;
+    }
+    return slot->population;
+}
+
+std::size_t InitialPopulationCache::reused_evaluations() const {
+    std::scoped_lock lock(mutex_);
+    return reused_evaluations_;
+}
+
+} // namespace hpoea::core
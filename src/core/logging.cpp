@@ -178,6 +178,8 @@ std::string run_status_to_string(RunStatus status) {
         return "invalid_configuration";
     case RunStatus::InternalError:
         return "internal_error";
+    case RunStatus::Pruned:
+        return "pruned";
     }
     return "unknown";
 }
@@ -244,6 +246,7 @@ std::string serialize_run_record(const RunRecord &record) {
     oss << "\"effective_budget\":" << serialize_budget_fields(record.effective_budget) << ',';
     oss << "\"algorithm_usage\":{"
         << "\"function_evaluations\":" << record.algorithm_usage.function_evaluations << ','
+        << "\"cached_function_evaluations\":" << record.algorithm_usage.cached_function_evaluations << ','
         << "\"generations\":" << record.algorithm_usage.generations << ','
         << "\"wall_time_ms\":" << record.algorithm_usage.wall_time.count() << "},";
     oss << "\"error_info\":" << serialize_error_info(record.error_info) << ',';
@@ -253,7 +256,36 @@ std::string serialize_run_record(const RunRecord &record) {
     } else {
         oss << "\"optimizer_seed\":null,";
     }
-    oss << "\"message\":\"" << escape_json(record.message) << "\"";
+    oss << "\"message\":\"" << escape_json(record.message) << "\",";
+    if (record.problem_set_id.has_value()) {
+        oss << "\"problem_set_id\":\"" << escape_json(*record.problem_set_id) << "\",";
+    } else {
+        oss << "\"problem_set_id\":null,";
+    }
+    if (record.aggregated_objective.has_value()) {
+        oss << "\"aggregated_objective\":" << serialize_double(*record.aggregated_objective) << ',';
+    } else {
+        oss << "\"aggregated_objective\":null,";
+    }
+    if (record.repeat_index.has_value()) {
+        oss << "\"repeat_index\":" << *record.repeat_index << ',';
+    } else {
+        oss << "\"repeat_index\":null,";
+    }
+    if (record.lineage.has_value()) {
+        const auto &lineage = *record.lineage;
+        oss << "\"lineage\":{\"member\":" << lineage.member << ",\"round\":" << lineage.round
+            << ",\"parent_trial\":";
+        if (lineage.parent_trial.has_value()) {
+            oss << *lineage.parent_trial;
+        } else {
+            oss << "null";
+        }
+        oss << ",\"exploited\":" << (lineage.exploited ? "true" : "false")
+            << ",\"resumed\":" << (lineage.resumed ? "true" : "false") << '}';
+    } else {
+        oss << "\"lineage\":null";
+    }
     oss << '}';
     return oss.str();
 }
@@ -0,0 +1,318 @@
+#include "hpoea/core/parallel_tempering_optimizer.hpp"
+
+#include "hpoea/core/budget_checks.hpp"
+#include "hpoea/core/error_classification.hpp"
+#include "hpoea/core/parameter_sampling.hpp"
+#include "hpoea/core/seeding.hpp"
+#include "hpoea/core/trial_runner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace {
+
+constexpr const char *REPLICAS = "replicas";
+constexpr const char *SWEEPS = "sweeps";
+constexpr const char *TS = "ts";
+constexpr const char *TF = "tf";
+constexpr const char *START_RANGE = "start_range";
+constexpr const char *SWAP_INTERVAL = "swap_interval";
+constexpr const char *PARALLEL_WORKERS = "parallel_workers";
+// keep the start, move, acceptance and swap streams apart from the trial seeds
+constexpr std::uint64_t start_stream_salt = 0x4e2d8a1f6b3c9075ULL;
+constexpr std::uint64_t move_stream_salt = 0x93b7c5e1d2f4a608ULL;
+constexpr std::uint64_t accept_stream_salt = 0x2a6f1d9c7e5b3084ULL;
+constexpr std::uint64_t swap_stream_salt = 0xd1c3e5a7b9f20846ULL;
+
+hpoea::core::ParameterSpace make_parameter_space() {
+    hpoea::core::ParameterSpace space;
+
+    hpoea::core::ParameterDescriptor d;
+    d.name = REPLICAS;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{2, 256};
+    d.default_value = std::int64_t{8};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = SWEEPS;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{1, 100000};
+    d.default_value = std::int64_t{100};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = TS;
+    d.type = hpoea::core::ParameterType::Continuous;
+    d.continuous_range = hpoea::core::ContinuousRange{1e-6, 100.0};
+    d.default_value = 10.0;
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = TF;
+    d.type = hpoea::core::ParameterType::Continuous;
+    d.continuous_range = hpoea::core::ContinuousRange{1e-6, 100.0};
+    d.default_value = 0.1;
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = START_RANGE;
+    d.type = hpoea::core::ParameterType::Continuous;
+    d.continuous_range = hpoea::core::ContinuousRange{0.0, 1.0};
+    d.default_value = 1.0;
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = SWAP_INTERVAL;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{1, 1000};
+    d.default_value = std::int64_t{1};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = PARALLEL_WORKERS;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{0, 1024};
+    d.default_value = std::int64_t{1};
+    space.add_descriptor(d);
+
+    return space;
+}
+
+// a chain's current point, +inf until it has an observed objective
+struct Chain {
+    std::vector<double> unit;
+    double objective{std::numeric_limits<double>::infinity()};
+};
+
+// metropolis rule; a finite objective always replaces a missing one
+bool accepts(double current, double proposed, double temperature, double u) {
+    if (!std::isfinite(proposed)) {
+        return !std::isfinite(current);
+    }
+    if (!std::isfinite(current) || proposed <= current) {
+        return true;
+    }
+    return u < std::exp(-(proposed - current) / temperature);
+}
+
+// exchange between a colder and a hotter chain
+bool swaps(double colder, double hotter, double colder_temperature, double hotter_temperature, double u) {
+    if (!std::isfinite(colder) || !std::isfinite(hotter)) {
+        return hotter < colder;
+    }
+    const auto exponent = (1.0 / colder_temperature - 1.0 / hotter_temperature) * (colder - hotter);
+    return exponent >= 0.0 || u < std::exp(exponent);
+}
+
+} // namespace
+
+namespace hpoea::core {
+
+ParallelTemperingOptimizer::ParallelTemperingOptimizer()
+    : HyperOptimizerBase(make_parameter_space(), {"ParallelTempering", "replica_exchange", "1.0"}) {}
+
+HyperparameterOptimizationResult ParallelTemperingOptimizer::optimize(
+    const IEvolutionaryAlgorithmFactory &algorithm_factory, const IProblem &problem, const Budget &optimizer_budget,
+    const Budget &algorithm_budget, unsigned long seed) {
+    HyperparameterOptimizationResult result;
+    result.status = RunStatus::InternalError;
+    result.seed = seed;
+    result.effective_optimizer_parameters = configured_parameters_;
+
+    const auto start_time = std::chrono::steady_clock::now();
+
+    try {
+        const auto &algorithm_space = algorithm_factory.parameter_space();
+        if (algorithm_space.empty()) {
+            throw std::invalid_argument("algorithm has no tunable parameters");
+        }
+        if (search_space_) {
+            search_space_->validate(algorithm_space);
+        }
+        if (!has_tunable_dimension(algorithm_space, search_space_.get())) {
+            throw ParameterValidationError(
+                "all parameters are fixed or excluded; use BaselineOptimizer for fixed/default runs");
+        }
+        if (optimizer_budget.generations.has_value()) {
+            throw std::invalid_argument(
+                "parallel tempering does not consume a generations budget; "
+                "use optimizer_budget.function_evaluations");
+        }
+
+        const auto replicas = count_parameter(configured_parameters_, REPLICAS);
+        const auto sweeps = count_parameter(configured_parameters_, SWEEPS);
+        const auto ts = real_parameter(configured_parameters_, TS);
+        const auto tf = real_parameter(configured_parameters_, TF);
+        const auto start_range = real_parameter(configured_parameters_, START_RANGE);
+        const auto swap_interval = count_parameter(configured_parameters_, SWAP_INTERVAL);
+        const auto workers = parallel_workers(configured_parameters_);
+        if (tf > ts) {
+            throw std::invalid_argument("parallel tempering tf must not exceed ts");
+        }
+
+        // the first sweep evaluates every chain's start, each later one moves it
+        auto planned_moves = replicas * (sweeps + 1);
+        if (optimizer_budget.function_evaluations.has_value()) {
+            planned_moves = std::min(planned_moves, *optimizer_budget.function_evaluations);
+        }
+        if (planned_moves < replicas) {
+            result.status = RunStatus::BudgetExceeded;
+            result.message = "optimizer budget cannot start " + std::to_string(replicas) + " replicas";
+            result.optimizer_usage.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start_time);
+            return result;
+        }
+        result.effective_optimizer_parameters.insert_or_assign(
+            SWEEPS, static_cast<std::int64_t>((planned_moves - 1) / replicas));
+
+        // chain 0 is the coldest
+        std::vector<double> temperatures(replicas);
+        for (std::size_t k = 0; k < replicas; ++k) {
+            const auto position = static_cast<double>(k) / static_cast<double>(replicas - 1);
+            temperatures[k] = tf * std::pow(ts / tf, position);
+        }
+
+        const UnitCubeEncoding encoding(algorithm_space, search_space_.get());
+        const auto dimension = encoding.dimension();
+        const auto start_seed = static_cast<std::uint64_t>(seed) ^ start_stream_salt;
+        const auto move_seed = static_cast<std::uint64_t>(seed) ^ move_stream_salt;
+        const auto accept_seed = static_cast<std::uint64_t>(seed) ^ accept_stream_salt;
+        const auto swap_seed = static_cast<std::uint64_t>(seed) ^ swap_stream_salt;
+        // the best earlier configurations start the coldest chains
+        const auto priors = prior_trials(algorithm_factory, problem);
+
+        const auto start_point = [&](std::size_t k) {
+            if (k < priors.size()) {
+                if (auto unit = encoding.encode(priors[k].parameters)) {
+                    return std::move(*unit);
+                }
+            }
+            std::mt19937_64 rng{derive_stream_seed(start_seed, k)};
+            std::uniform_real_distribution<double> uniform{0.0, 1.0};
+            std::vector<double> unit(dimension);
+            for (auto &coordinate : unit) {
+                coordinate = uniform(rng);
+            }
+            return unit;
+        };
+        const auto propose = [&](const Chain &chain, std::size_t k, std::size_t sweep, std::size_t trial_index) {
+            std::mt19937_64 rng{derive_stream_seed(move_seed, trial_index)};
+            std::uniform_real_distribution<double> uniform{0.0, 1.0};
+            auto unit = chain.unit;
+            const auto d = (sweep - 1) % dimension;
+            if (encoding.choices(d) > 0u) {
+                unit[d] = uniform(rng);
+            } else {
+                // an integer step reaches at least the neighbouring cell
+                auto width = start_range * temperatures[k] / ts;
+                if (encoding.cells(d) > 0u) {
+                    width = std::max(width, 1.0 / static_cast<double>(encoding.cells(d)));
+                }
+                unit[d] = std::clamp(unit[d] + width * (2.0 * uniform(rng) - 1.0), 0.0, 1.0);
+            }
+            return unit;
+        };
+
+        const auto pruner = make_trial_pruner();
+        std::atomic<std::size_t> calls{0};
+        const WallTimeLimit wall_time_spent{optimizer_budget, start_time};
+
+        std::vector<Chain> chains(replicas);
+        bool stopped_for_wall_time = false;
+        std::size_t sweeps_done = 0;
+        result.trials.reserve(planned_moves);
+        for (std::size_t sweep = 0; result.trials.size() < planned_moves; ++sweep) {
+            // the last sweep moves the coldest chains the budget still pays for
+            const auto first_index = result.trials.size();
+            const auto moves = std::min(replicas, planned_moves - first_index);
+            std::vector<std::vector<double>> proposals(moves);
+            std::vector<std::optional<HyperparameterTrialRecord>> slots(moves);
+            run_indexed(
+                moves, workers,
+                [&](std::size_t k) {
+                    const auto trial_index = first_index + k;
+                    proposals[k] = sweep == 0 ? start_point(k) : propose(chains[k], k, sweep, trial_index);
+                    const auto trial_seed =
+                        static_cast<unsigned long>(derive_stream_seed(static_cast<std::uint64_t>(seed), trial_index));
+                    bool started = false;
+                    slots[k] = run_trial(algorithm_factory, problem, algorithm_budget, trial_seed, trial_index,
+                                         [&] { return encoding.decode(proposals[k]); }, &started,
+                                         trial_progress(pruner));
+                    if (started) {
+                        calls.fetch_add(1, std::memory_order_relaxed);
+                    }
+                },
+                wall_time_spent);
+
+            for (std::size_t k = 0; k < moves; ++k) {
+                if (!slots[k]) {
+                    stopped_for_wall_time = true;
+                    break;
+                }
+                const auto trial_index = first_index + k;
+                const auto objective = observed_objective(*slots[k]).value_or(std::numeric_limits<double>::infinity());
+                std::mt19937_64 rng{derive_stream_seed(accept_seed, trial_index)};
+                std::uniform_real_distribution<double> uniform{0.0, 1.0};
+                if (sweep == 0 || accepts(chains[k].objective, objective, temperatures[k], uniform(rng))) {
+                    chains[k].unit = std::move(proposals[k]);
+                    chains[k].objective = objective;
+                }
+                result.trials.push_back(std::move(*slots[k]));
+            }
+            if (stopped_for_wall_time) {
+                break;
+            }
+            if (sweep == 0) {
+                continue;
+            }
+            ++sweeps_done;
+
+            // even pairs and odd pairs take turns
+            if (moves == replicas && sweep % swap_interval == 0u) {
+                std::mt19937_64 rng{derive_stream_seed(swap_seed, sweep)};
+                std::uniform_real_distribution<double> uniform{0.0, 1.0};
+                for (auto k = (sweep / swap_interval) % 2u; k + 1 < replicas; k += 2) {
+                    if (swaps(chains[k].objective, chains[k + 1].objective, temperatures[k], temperatures[k + 1],
+                              uniform(rng))) {
+                        std::swap(chains[k], chains[k + 1]);
+                    }
+                }
+            }
+        }
+
+        const auto end_time = std::chrono::steady_clock::now();
+        result.optimizer_usage.objective_calls = calls.load(std::memory_order_relaxed);
+        result.optimizer_usage.iterations = sweeps_done;
+        result.optimizer_usage.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+        select_best_trial(result, "parallel tempering");
+        if (stopped_for_wall_time) {
+            result.status = RunStatus::BudgetExceeded;
+            result.message = "wall-time budget exceeded";
+        }
+        apply_optimizer_budget_status(optimizer_budget, result.optimizer_usage, result.status, result.message);
+    } catch (const std::exception &ex) {
+        const auto end_time = std::chrono::steady_clock::now();
+        const auto classified = classify_exception(ex);
+        result.status = classified.status;
+        result.error_info = classified.error_info;
+        result.message = ex.what();
+        result.optimizer_usage.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+    }
+
+    return result;
+}
+
+} // namespace hpoea::core
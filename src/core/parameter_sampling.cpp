@@ -0,0 +1,319 @@
+#include "hpoea/core/parameter_sampling.hpp"
+
+#include "hpoea/core/parameter_vector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace {
+
+const hpoea::core::ParameterConfig *find_config(const hpoea::core::SearchSpace *search_space, const std::string &name) {
+    if (!search_space) {
+        return nullptr;
+    }
+    return search_space->get(name);
+}
+
+bool is_excluded(const hpoea::core::ParameterConfig *config) {
+    return config && config->mode == hpoea::core::SearchMode::exclude;
+}
+
+bool is_tunable(const hpoea::core::ParameterDescriptor &descriptor, const hpoea::core::ParameterConfig *config) {
+    return hpoea::core::effective_mode(descriptor, config) == hpoea::core::SearchMode::optimize;
+}
+
+hpoea::core::ContinuousRange resolve_continuous_range(const hpoea::core::ParameterDescriptor &descriptor,
+                                                      const hpoea::core::ParameterConfig *config) {
+    if (!descriptor.continuous_range.has_value()) {
+        throw std::logic_error("continuous parameter missing range: " + descriptor.name);
+    }
+    if (config && config->continuous_bounds.has_value()) {
+        return config->continuous_bounds.value();
+    }
+    return descriptor.continuous_range.value();
+}
+
+hpoea::core::IntegerRange resolve_integer_range(const hpoea::core::ParameterDescriptor &descriptor,
+                                                const hpoea::core::ParameterConfig *config) {
+    if (!descriptor.integer_range.has_value()) {
+        throw std::logic_error("integer parameter missing range: " + descriptor.name);
+    }
+    if (config && config->integer_bounds.has_value()) {
+        return config->integer_bounds.value();
+    }
+    return descriptor.integer_range.value();
+}
+
+std::size_t sample_index(std::size_t size, std::mt19937_64 &rng) {
+    std::uniform_int_distribution<std::size_t> dist{0, size - 1};
+    return dist(rng);
+}
+
+const hpoea::core::ParameterValue &sample_choice(const std::vector<hpoea::core::ParameterValue> &choices,
+                                                 std::mt19937_64 &rng) {
+    if (choices.empty()) {
+        throw hpoea::core::ParameterValidationError("discrete choices cannot be empty");
+    }
+    return choices[sample_index(choices.size(), rng)];
+}
+
+hpoea::core::ParameterSlot sample_slot(const hpoea::core::ParameterSchema &schema, std::size_t index,
+                                       const hpoea::core::ParameterConfig *config, std::mt19937_64 &rng) {
+    const auto &descriptor = schema.space().descriptors()[index];
+    const bool has_choices = config && !config->discrete_choices.empty();
+    hpoea::core::ParameterSlot slot;
+    slot.set = true;
+    switch (descriptor.type) {
+    case hpoea::core::ParameterType::Continuous: {
+        const auto range = resolve_continuous_range(descriptor, config);
+        const auto transform = config ? config->transform : hpoea::core::Transform::none;
+        const auto transformed = hpoea::core::transform_bounds(range, transform);
+        std::uniform_real_distribution<double> dist{transformed.lower, transformed.upper};
+        slot.real = std::clamp(hpoea::core::inverse_transform(dist(rng), transform), range.lower, range.upper);
+        return slot;
+    }
+    case hpoea::core::ParameterType::Integer: {
+        if (has_choices) {
+            return schema.slot(index, sample_choice(config->discrete_choices, rng));
+        }
+        const auto range = resolve_integer_range(descriptor, config);
+        std::uniform_int_distribution<std::int64_t> dist{range.lower, range.upper};
+        slot.integer = dist(rng);
+        return slot;
+    }
+    case hpoea::core::ParameterType::Boolean: {
+        std::bernoulli_distribution dist{0.5};
+        slot.integer = dist(rng) ? 1 : 0;
+        return slot;
+    }
+    case hpoea::core::ParameterType::Categorical:
+        if (has_choices) {
+            return schema.slot(index, sample_choice(config->discrete_choices, rng));
+        }
+        if (descriptor.categorical_choices.empty()) {
+            throw hpoea::core::ParameterValidationError("Categorical descriptor without choices: " + descriptor.name);
+        }
+        slot.integer = static_cast<std::int64_t>(sample_index(descriptor.categorical_choices.size(), rng));
+        return slot;
+    }
+    throw std::logic_error("unhandled ParameterType value");
+}
+
+// fills defaults for parameters neither set nor excluded, validates, and
+// converts to a ParameterSet
+hpoea::core::ParameterSet complete_parameters(const hpoea::core::ParameterSchema &schema,
+                                              const hpoea::core::SearchSpace *search_space,
+                                              hpoea::core::ParameterVector &values) {
+    const auto &descriptors = schema.space().descriptors();
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (values[i].set) {
+            schema.check(i, values[i]);
+            continue;
+        }
+        const auto &descriptor = descriptors[i];
+        if (is_excluded(find_config(search_space, descriptor.name))) {
+            continue;
+        }
+        if (descriptor.default_value.has_value()) {
+            values[i] = schema.slot(i, *descriptor.default_value);
+        } else if (descriptor.required) {
+            throw hpoea::core::ParameterValidationError("missing required parameter: " + descriptor.name);
+        }
+    }
+    return schema.to_set(values);
+}
+
+} // namespace
+
+namespace hpoea::core {
+
+bool has_tunable_dimension(const ParameterSpace &space, const SearchSpace *search_space) {
+    for (const auto &descriptor : space.descriptors()) {
+        if (is_tunable(descriptor, find_config(search_space, descriptor.name))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+ParameterSet sample_parameters(const ParameterSpace &space, const SearchSpace *search_space, std::mt19937_64 &rng) {
+    const ParameterSchema schema(space);
+    auto values = schema.make_vector();
+    const auto &descriptors = space.descriptors();
+    for (std::size_t i = 0; i < descriptors.size(); ++i) {
+        const auto *config = find_config(search_space, descriptors[i].name);
+        if (config && config->mode == SearchMode::fixed) {
+            if (config->fixed_value.has_value()) {
+                values[i] = schema.slot(i, *config->fixed_value);
+            }
+            continue;
+        }
+        if (!is_tunable(descriptors[i], config)) {
+            continue;
+        }
+        values[i] = sample_slot(schema, i, config, rng);
+    }
+
+    return complete_parameters(schema, search_space, values);
+}
+
+UnitCubeEncoding::UnitCubeEncoding(const ParameterSpace &space, const SearchSpace *search_space)
+    : space_(space), search_space_(search_space ? std::optional<SearchSpace>(*search_space) : std::nullopt) {
+    const auto &descriptors = space_.descriptors();
+    for (std::size_t index = 0; index < descriptors.size(); ++index) {
+        const auto &descriptor = descriptors[index];
+        const auto *config = find_config(this->search_space(), descriptor.name);
+        if (!is_tunable(descriptor, config)) {
+            continue;
+        }
+        Dimension dimension;
+        dimension.descriptor = index;
+        if (config && !config->discrete_choices.empty()) {
+            dimension.cells = static_cast<double>(config->discrete_choices.size());
+            dimension.unordered = true;
+        } else if (descriptor.type == ParameterType::Integer) {
+            const auto range = resolve_integer_range(descriptor, config);
+            dimension.cells = static_cast<double>(range.upper - range.lower) + 1.0;
+        } else if (descriptor.type == ParameterType::Boolean) {
+            dimension.cells = 2.0;
+            dimension.unordered = true;
+        } else if (descriptor.type == ParameterType::Categorical) {
+            dimension.unordered = true;
+            if (descriptor.categorical_choices.empty()) {
+                throw ParameterValidationError("Categorical descriptor without choices: " + descriptor.name);
+            }
+            dimension.cells = static_cast<double>(descriptor.categorical_choices.size());
+        } else {
+            const auto range = resolve_continuous_range(descriptor, config);
+            const auto transform = config ? config->transform : Transform::none;
+            dimension.bounds = transform_bounds(range, transform);
+        }
+        dimensions_.push_back(dimension);
+    }
+}
+
+const std::string &UnitCubeEncoding::name(std::size_t index) const {
+    return space_.descriptors()[dimensions_.at(index).descriptor].name;
+}
+
+std::size_t UnitCubeEncoding::choices(std::size_t index) const {
+    const auto &dimension = dimensions_.at(index);
+    return dimension.unordered ? static_cast<std::size_t>(dimension.cells) : 0u;
+}
+
+std::size_t UnitCubeEncoding::cells(std::size_t index) const {
+    return static_cast<std::size_t>(dimensions_.at(index).cells);
+}
+
+ParameterSet UnitCubeEncoding::decode(const std::vector<double> &unit) const {
+    if (unit.size() != dimensions_.size()) {
+        throw std::invalid_argument("unit point has " + std::to_string(unit.size()) + " coordinates, expected " +
+                                    std::to_string(dimensions_.size()));
+    }
+    const ParameterSchema schema(space_);
+    auto values = schema.make_vector();
+    const auto &descriptors = space_.descriptors();
+    for (std::size_t i = 0; i < descriptors.size(); ++i) {
+        const auto *config = find_config(search_space(), descriptors[i].name);
+        if (config && config->mode == SearchMode::fixed && config->fixed_value.has_value()) {
+            values[i] = schema.slot(i, *config->fixed_value);
+        }
+    }
+
+    for (std::size_t i = 0; i < dimensions_.size(); ++i) {
+        const auto &dimension = dimensions_[i];
+        const auto &descriptor = descriptors[dimension.descriptor];
+        const auto *config = find_config(search_space(), descriptor.name);
+        auto &slot = values[dimension.descriptor];
+        slot.set = true;
+        const auto u = std::clamp(unit[i], 0.0, 1.0);
+        if (dimension.cells == 0.0) {
+            const auto transform = config ? config->transform : Transform::none;
+            const auto range = resolve_continuous_range(descriptor, config);
+            const auto value = inverse_transform(
+                dimension.bounds.lower + u * (dimension.bounds.upper - dimension.bounds.lower), transform);
+            slot.real = std::clamp(value, range.lower, range.upper);
+            continue;
+        }
+        const auto cell = static_cast<std::size_t>(std::min(std::floor(u * dimension.cells), dimension.cells - 1.0));
+        if (config && !config->discrete_choices.empty()) {
+            slot = schema.slot(dimension.descriptor, config->discrete_choices[cell]);
+        } else if (descriptor.type == ParameterType::Integer) {
+            const auto range = resolve_integer_range(descriptor, config);
+            slot.integer = range.lower + static_cast<std::int64_t>(cell);
+        } else {
+            // boolean false and true are cells 0 and 1, like choice indices
+            slot.integer = static_cast<std::int64_t>(cell);
+        }
+    }
+
+    return complete_parameters(schema, search_space(), values);
+}
+
+std::optional<std::vector<double>> UnitCubeEncoding::encode(const ParameterSet &parameters) const {
+    std::vector<double> unit(dimensions_.size());
+    for (std::size_t i = 0; i < dimensions_.size(); ++i) {
+        const auto &dimension = dimensions_[i];
+        const auto &descriptor = space_.descriptors()[dimension.descriptor];
+        const auto *config = find_config(search_space(), descriptor.name);
+        const auto it = parameters.find(descriptor.name);
+        if (it == parameters.end()) {
+            return std::nullopt;
+        }
+        const auto &value = it->second;
+        if (dimension.cells == 0.0) {
+            if (!std::holds_alternative<double>(value)) {
+                return std::nullopt;
+            }
+            const auto numeric = std::get<double>(value);
+            const auto range = resolve_continuous_range(descriptor, config);
+            if (!(numeric >= range.lower && numeric <= range.upper)) {
+                return std::nullopt;
+            }
+            const auto transform = config ? config->transform : Transform::none;
+            const auto transformed = transform_bounds({numeric, numeric}, transform).lower;
+            const auto width = dimension.bounds.upper - dimension.bounds.lower;
+            unit[i] = width > 0.0 ? std::clamp((transformed - dimension.bounds.lower) / width, 0.0, 1.0) : 0.5;
+            continue;
+        }
+
+        std::optional<std::size_t> cell;
+        if (config && !config->discrete_choices.empty()) {
+            const auto &choices = config->discrete_choices;
+            const auto found = std::find(choices.begin(), choices.end(), value);
+            if (found != choices.end()) {
+                cell = static_cast<std::size_t>(found - choices.begin());
+            }
+        } else if (descriptor.type == ParameterType::Integer) {
+            const auto range = resolve_integer_range(descriptor, config);
+            if (std::holds_alternative<std::int64_t>(value)) {
+                const auto integer = std::get<std::int64_t>(value);
+                if (integer >= range.lower && integer <= range.upper) {
+                    cell = static_cast<std::size_t>(integer - range.lower);
+                }
+            }
+        } else if (descriptor.type == ParameterType::Boolean) {
+            if (std::holds_alternative<bool>(value)) {
+                cell = std::get<bool>(value) ? 1u : 0u;
+            }
+        } else if (std::holds_alternative<std::string>(value)) {
+            const auto &choices = descriptor.categorical_choices;
+            const auto found = std::find(choices.begin(), choices.end(), std::get<std::string>(value));
+            if (found != choices.end()) {
+                cell = static_cast<std::size_t>(found - choices.begin());
+            }
+        }
+        if (!cell) {
+            return std::nullopt;
+        }
+        unit[i] = (static_cast<double>(*cell) + 0.5) / dimension.cells;
+    }
+    return unit;
+}
+
+} // namespace hpoea::core
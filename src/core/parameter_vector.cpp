@@ -0,0 +1,141 @@
+#include "hpoea/core/parameter_vector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <variant>
+
+namespace {
+
+void check_size(const hpoea::core::ParameterVector &values, std::size_t size) {
+    if (values.size() != size) {
+        throw hpoea::core::ParameterValidationError("parameter vector has " + std::to_string(values.size()) +
+                                                    " slots, expected " + std::to_string(size));
+    }
+}
+
+} // namespace
+
+namespace hpoea::core {
+
+ParameterSlot ParameterSchema::slot(std::size_t index, const ParameterValue &value) const {
+    const auto &descriptor = space_.descriptors().at(index);
+    space_.validate_value(descriptor, value);
+
+    ParameterSlot result;
+    result.set = true;
+    switch (descriptor.type) {
+    case ParameterType::Continuous:
+        result.real = std::holds_alternative<double>(value) ? std::get<double>(value)
+                                                            : static_cast<double>(std::get<std::int64_t>(value));
+        break;
+    case ParameterType::Integer:
+        result.integer = std::get<std::int64_t>(value);
+        break;
+    case ParameterType::Boolean:
+        result.integer = std::get<bool>(value) ? 1 : 0;
+        break;
+    case ParameterType::Categorical: {
+        const auto &choices = descriptor.categorical_choices;
+        result.integer = std::ranges::find(choices, std::get<std::string>(value)) - choices.begin();
+        break;
+    }
+    }
+    return result;
+}
+
+ParameterValue ParameterSchema::value(std::size_t index, const ParameterSlot &slot) const {
+    const auto &descriptor = space_.descriptors().at(index);
+    switch (descriptor.type) {
+    case ParameterType::Continuous:
+        return slot.real;
+    case ParameterType::Integer:
+        return slot.integer;
+    case ParameterType::Boolean:
+        return slot.integer != 0;
+    case ParameterType::Categorical:
+        return descriptor.categorical_choices.at(static_cast<std::size_t>(slot.integer));
+    }
+    throw std::logic_error("unhandled ParameterType value");
+}
+
+void ParameterSchema::check(std::size_t index, const ParameterSlot &slot) const {
+    const auto &descriptor = space_.descriptors().at(index);
+    switch (descriptor.type) {
+    case ParameterType::Continuous: {
+        const auto &range = descriptor.continuous_range;
+        if (std::isfinite(slot.real) && (!range || (slot.real >= range->lower && slot.real <= range->upper))) {
+            return;
+        }
+        break;
+    }
+    case ParameterType::Integer: {
+        const auto &range = descriptor.integer_range;
+        if (!range || (slot.integer >= range->lower && slot.integer <= range->upper)) {
+            return;
+        }
+        break;
+    }
+    case ParameterType::Boolean:
+        return;
+    case ParameterType::Categorical:
+        if (slot.integer >= 0 && static_cast<std::size_t>(slot.integer) < descriptor.categorical_choices.size()) {
+            return;
+        }
+        throw ParameterValidationError("parameter '" + descriptor.name + "' expects type categorical with choice index " +
+                                       std::to_string(slot.integer) + " out of range");
+    }
+    // the slow path only runs to build the error
+    space_.validate_value(descriptor, value(index, slot));
+}
+
+ParameterVector ParameterSchema::to_vector(const ParameterSet &parameters) const {
+    auto values = make_vector();
+    for (const auto &[name, value] : parameters) {
+        const auto index = space_.index(name);
+        values[index] = slot(index, value);
+    }
+    return values;
+}
+
+ParameterSet ParameterSchema::to_set(const ParameterVector &values) const {
+    check_size(values, size());
+    const auto &descriptors = space_.descriptors();
+    ParameterSet parameters;
+    parameters.reserve(static_cast<std::size_t>(std::ranges::count_if(values, &ParameterSlot::set)));
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (values[i].set) {
+            parameters.emplace(descriptors[i].name, value(i, values[i]));
+        }
+    }
+    return parameters;
+}
+
+void ParameterSchema::validate(const ParameterVector &values) const {
+    check_size(values, size());
+    const auto &descriptors = space_.descriptors();
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (values[i].set) {
+            check(i, values[i]);
+        } else if (descriptors[i].required) {
+            throw ParameterValidationError("missing required parameter: " + descriptors[i].name);
+        }
+    }
+}
+
+void ParameterSchema::apply_defaults(ParameterVector &values) const {
+    check_size(values, size());
+    const auto &descriptors = space_.descriptors();
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (values[i].set) {
+            check(i, values[i]);
+        } else if (descriptors[i].default_value.has_value()) {
+            values[i] = slot(i, *descriptors[i].default_value);
+        } else if (descriptors[i].required) {
+            throw ParameterValidationError("missing required parameter: " + descriptors[i].name);
+        }
+    }
+}
+
+} // namespace hpoea::core
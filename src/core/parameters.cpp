@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <ranges>
 #include <cmath>
+#include <cstring>
 #include <sstream>
 #include <stdexcept>
 
@@ -34,6 +35,19 @@ hpoea::core::ParameterValue coerce_continuous(const hpoea::core::ParameterDescri
     return value;
 }
 
+// builds the message only on failure; values are validated on every trial
+template <typename Detail>
+[[noreturn]] void reject(const hpoea::core::ParameterDescriptor &descriptor, Detail detail) {
+    std::ostringstream message;
+    message << "parameter '" << descriptor.name << "' expects type " << parameter_type_to_string(descriptor.type);
+    detail(message);
+    throw hpoea::core::ParameterValidationError(message.str());
+}
+
+[[noreturn]] void reject_variant(const hpoea::core::ParameterDescriptor &descriptor) {
+    reject(descriptor, [](std::ostream &message) { message << " but received mismatched variant type"; });
+}
+
 } // namespace
 
 namespace hpoea::core {
@@ -84,11 +98,15 @@ bool ParameterSpace::contains(const std::string &name) const noexcept {
 }
 
 const ParameterDescriptor &ParameterSpace::descriptor(const std::string &name) const {
+    return descriptors_[index(name)];
+}
+
+std::size_t ParameterSpace::index(const std::string &name) const {
     auto it = index_.find(name);
     if (it == index_.end()) {
         throw ParameterValidationError("unknown parameter: " + name);
     }
-    return descriptors_[it->second];
+    return it->second;
 }
 
 void ParameterSpace::validate(const ParameterSet &values) const {
@@ -106,6 +124,7 @@ void ParameterSpace::validate(const ParameterSet &values) const {
 
 ParameterSet ParameterSpace::apply_defaults(const ParameterSet &overrides) const {
     ParameterSet result;
+    result.reserve(descriptors_.size());
 
     for (const auto &[name, value] : overrides) {
         const auto &desc = descriptor(name);
@@ -130,9 +149,6 @@ ParameterSet ParameterSpace::apply_defaults(const ParameterSet &overrides) const
 }
 
 void ParameterSpace::validate_value(const ParameterDescriptor &descriptor, const ParameterValue &value) const {
-    std::ostringstream message;
-    message << "parameter '" << descriptor.name << "' expects type " << parameter_type_to_string(descriptor.type);
-
     switch (descriptor.type) {
     case ParameterType::Continuous: {
         double numeric;
@@ -141,59 +157,111 @@ void ParameterSpace::validate_value(const ParameterDescriptor &descriptor, const
         } else if (std::holds_alternative<std::int64_t>(value)) {
             numeric = static_cast<double>(std::get<std::int64_t>(value));
         } else {
-            message << " but received mismatched variant type";
-            throw ParameterValidationError(message.str());
+            reject_variant(descriptor);
         }
         if (!std::isfinite(numeric)) {
-            message << " but received non-finite value";
-            throw ParameterValidationError(message.str());
+            reject(descriptor, [](std::ostream &message) { message << " but received non-finite value"; });
         }
         if (descriptor.continuous_range.has_value()) {
             const auto &range = *descriptor.continuous_range;
             if (numeric < range.lower || numeric > range.upper) {
-                message << " outside bounds [" << range.lower << ", " << range.upper << "]";
-                throw ParameterValidationError(message.str());
+                reject(descriptor, [&](std::ostream &message) {
+                    message << " outside bounds [" << range.lower << ", " << range.upper << "]";
+                });
             }
         }
         break;
     }
     case ParameterType::Integer: {
         if (!std::holds_alternative<std::int64_t>(value)) {
-            message << " but received mismatched variant type";
-            throw ParameterValidationError(message.str());
+            reject_variant(descriptor);
         }
         const auto numeric = std::get<std::int64_t>(value);
         if (descriptor.integer_range.has_value()) {
             const auto &range = *descriptor.integer_range;
             if (numeric < range.lower || numeric > range.upper) {
-                message << " outside bounds [" << range.lower << ", " << range.upper << "]";
-                throw ParameterValidationError(message.str());
+                reject(descriptor, [&](std::ostream &message) {
+                    message << " outside bounds [" << range.lower << ", " << range.upper << "]";
+                });
             }
         }
         break;
     }
     case ParameterType::Boolean: {
         if (!std::holds_alternative<bool>(value)) {
-            message << " but received mismatched variant type";
-            throw ParameterValidationError(message.str());
+            reject_variant(descriptor);
         }
         break;
     }
     case ParameterType::Categorical: {
         if (!std::holds_alternative<std::string>(value)) {
-            message << " but received mismatched variant type";
-            throw ParameterValidationError(message.str());
+            reject_variant(descriptor);
         }
         const auto &label = std::get<std::string>(value);
         const auto &choices = descriptor.categorical_choices;
         const auto iter = std::ranges::find(choices, label);
         if (iter == choices.end()) {
-            message << " with invalid choice '" << label << "'";
-            throw ParameterValidationError(message.str());
+            reject(descriptor, [&](std::ostream &message) { message << " with invalid choice '" << label << "'"; });
         }
         break;
     }
     }
 }
 
+void Fnv1a::bytes(const void *data, std::size_t size) {
+    const auto *p = static_cast<const unsigned char *>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash_ = (hash_ ^ p[i]) * 0x100000001b3ULL;
+    }
+}
+
+void Fnv1a::word(std::uint64_t value) {
+    for (int shift = 0; shift < 64; shift += 8) {
+        const auto byte = static_cast<unsigned char>(value >> shift);
+        bytes(&byte, 1);
+    }
+}
+
+void Fnv1a::text(std::string_view value) {
+    word(value.size());
+    bytes(value.data(), value.size());
+}
+
+void Fnv1a::real(double value) {
+    const double canonical = value == 0.0 ? 0.0 : value;
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &canonical, sizeof(bits));
+    word(bits);
+}
+
+void Fnv1a::value(const ParameterValue &value) {
+    word(value.index());
+    if (const auto *real_value = std::get_if<double>(&value)) {
+        real(*real_value);
+    } else if (const auto *integer = std::get_if<std::int64_t>(&value)) {
+        word(static_cast<std::uint64_t>(*integer));
+    } else if (const auto *flag = std::get_if<bool>(&value)) {
+        word(*flag ? 1u : 0u);
+    } else {
+        text(std::get<std::string>(value));
+    }
+}
+
+std::uint64_t hash_parameter_set(const ParameterSet &parameters) {
+    // entries in name order
+    std::vector<const ParameterSet::value_type *> entries;
+    entries.reserve(parameters.size());
+    for (const auto &entry : parameters) {
+        entries.push_back(&entry);
+    }
+    std::ranges::sort(entries, {}, [](const auto *entry) -> const std::string & { return entry->first; });
+
+    Fnv1a hash;
+    for (const auto *entry : entries) {
+        hash.text(entry->first);
+        hash.value(entry->second);
+    }
+    return hash.digest();
+}
+
 } // namespace hpoea::core
@@ -0,0 +1,323 @@
+#include "hpoea/core/pbt_optimizer.hpp"
+
+#include "hpoea/core/budget_checks.hpp"
+#include "hpoea/core/error_classification.hpp"
+#include "hpoea/core/initial_population_cache.hpp"
+#include "hpoea/core/parameter_sampling.hpp"
+#include "hpoea/core/seeding.hpp"
+#include "hpoea/core/trial_runner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace {
+
+constexpr const char *MEMBERS = "members";
+constexpr const char *ROUNDS = "rounds";
+constexpr const char *EXPLOIT_FRACTION = "exploit_fraction";
+constexpr const char *PERTURB_STEP = "perturb_step";
+constexpr const char *RESAMPLE_PROBABILITY = "resample_probability";
+constexpr const char *PARALLEL_WORKERS = "parallel_workers";
+// keep the member and exploit streams apart from the trial seeds
+constexpr std::uint64_t member_stream_salt = 0x7b3e91d2c4a5f608ULL;
+constexpr std::uint64_t exploit_stream_salt = 0x1f6a2d8c9e3b4705ULL;
+
+hpoea::core::ParameterSpace make_parameter_space() {
+    hpoea::core::ParameterSpace space;
+
+    hpoea::core::ParameterDescriptor d;
+    d.name = MEMBERS;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{2, 1024};
+    d.default_value = std::int64_t{8};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = ROUNDS;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{1, 10000};
+    d.default_value = std::int64_t{4};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = EXPLOIT_FRACTION;
+    d.type = hpoea::core::ParameterType::Continuous;
+    d.continuous_range = hpoea::core::ContinuousRange{0.0, 0.5};
+    d.default_value = 0.25;
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = PERTURB_STEP;
+    d.type = hpoea::core::ParameterType::Continuous;
+    d.continuous_range = hpoea::core::ContinuousRange{0.0, 1.0};
+    d.default_value = 0.1;
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = RESAMPLE_PROBABILITY;
+    d.type = hpoea::core::ParameterType::Continuous;
+    d.continuous_range = hpoea::core::ContinuousRange{0.0, 1.0};
+    d.default_value = 0.25;
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = PARALLEL_WORKERS;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{0, 1024};
+    d.default_value = std::int64_t{1};
+    space.add_descriptor(d);
+
+    return space;
+}
+
+// one round's share of the algorithm budget
+hpoea::core::Budget round_budget(const hpoea::core::Budget &budget, std::size_t rounds) {
+    if (!budget.function_evaluations && !budget.generations) {
+        throw std::invalid_argument(
+            "population based training splits algorithm_budget.function_evaluations or generations into rounds; "
+            "set one of them");
+    }
+    hpoea::core::Budget share = budget;
+    if (share.function_evaluations) {
+        *share.function_evaluations /= rounds;
+        if (*share.function_evaluations == 0u) {
+            throw std::invalid_argument("algorithm_budget.function_evaluations is smaller than rounds");
+        }
+    }
+    if (share.generations) {
+        *share.generations /= rounds;
+        if (*share.generations == 0u) {
+            throw std::invalid_argument("algorithm_budget.generations is smaller than rounds");
+        }
+    }
+    if (share.wall_time) {
+        *share.wall_time /= static_cast<long>(rounds);
+    }
+    return share;
+}
+
+struct Member {
+    hpoea::core::ParameterSet parameters;
+    // final population of the last trial, with the algorithm state it
+    // carries; null to start fresh
+    std::shared_ptr<const hpoea::core::InitialPopulation> state;
+    std::optional<std::size_t> last_trial;
+    std::optional<std::size_t> parent_trial;
+    bool exploited{false};
+    double score{std::numeric_limits<double>::infinity()};
+};
+
+} // namespace
+
+namespace hpoea::core {
+
+PbtOptimizer::PbtOptimizer()
+    : HyperOptimizerBase(make_parameter_space(), {"PopulationBasedTraining", "pbt", "1.0"}) {}
+
+HyperparameterOptimizationResult PbtOptimizer::optimize(const IEvolutionaryAlgorithmFactory &algorithm_factory,
+                                                        const IProblem &problem, const Budget &optimizer_budget,
+                                                        const Budget &algorithm_budget, unsigned long seed) {
+    HyperparameterOptimizationResult result;
+    result.status = RunStatus::InternalError;
+    result.seed = seed;
+    result.effective_optimizer_parameters = configured_parameters_;
+
+    const auto start_time = std::chrono::steady_clock::now();
+
+    try {
+        const auto &algorithm_space = algorithm_factory.parameter_space();
+        if (algorithm_space.empty()) {
+            throw std::invalid_argument("algorithm has no tunable parameters");
+        }
+        if (search_space_) {
+            search_space_->validate(algorithm_space);
+        }
+        if (!has_tunable_dimension(algorithm_space, search_space_.get())) {
+            throw ParameterValidationError(
+                "all parameters are fixed or excluded; use BaselineOptimizer for fixed/default runs");
+        }
+        if (optimizer_budget.generations.has_value()) {
+            throw std::invalid_argument(
+                "population based training does not consume a generations budget; "
+                "use optimizer_budget.function_evaluations");
+        }
+
+        const auto member_count = count_parameter(configured_parameters_, MEMBERS);
+        const auto rounds = count_parameter(configured_parameters_, ROUNDS);
+        const auto exploit_fraction = real_parameter(configured_parameters_, EXPLOIT_FRACTION);
+        const auto perturb_step = real_parameter(configured_parameters_, PERTURB_STEP);
+        const auto resample_probability = real_parameter(configured_parameters_, RESAMPLE_PROBABILITY);
+        const auto workers = parallel_workers(configured_parameters_);
+        const auto segment_budget = round_budget(algorithm_budget, rounds);
+
+        // a round runs every member, so the budget pays for whole rounds
+        auto planned_rounds = rounds;
+        if (optimizer_budget.function_evaluations.has_value()) {
+            planned_rounds = std::min(planned_rounds, *optimizer_budget.function_evaluations / member_count);
+        }
+        if (planned_rounds == 0u) {
+            result.status = RunStatus::BudgetExceeded;
+            result.message = "optimizer budget allows no full round of " + std::to_string(member_count) + " members";
+            result.optimizer_usage.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start_time);
+            return result;
+        }
+
+        const UnitCubeEncoding encoding(algorithm_space, search_space_.get());
+        const auto member_seed = static_cast<std::uint64_t>(seed) ^ member_stream_salt;
+        const auto exploit_seed = static_cast<std::uint64_t>(seed) ^ exploit_stream_salt;
+        // the best earlier configurations seed the first members
+        const auto priors = prior_trials(algorithm_factory, problem);
+
+        const auto perturb = [&](const ParameterSet &parameters, std::mt19937_64 &rng) {
+            auto unit = encoding.encode(parameters);
+            if (!unit) {
+                return sample_parameters(algorithm_space, search_space_.get(), rng);
+            }
+            std::uniform_real_distribution<double> uniform{0.0, 1.0};
+            for (std::size_t d = 0; d < unit->size(); ++d) {
+                if (uniform(rng) < resample_probability) {
+                    (*unit)[d] = uniform(rng);
+                } else if (encoding.choices(d) == 0u) {
+                    const auto step = uniform(rng) < 0.5 ? -perturb_step : perturb_step;
+                    (*unit)[d] = std::clamp((*unit)[d] + step, 0.0, 1.0);
+                }
+            }
+            return encoding.decode(*unit);
+        };
+
+        std::vector<Member> members(member_count);
+        std::atomic<std::size_t> calls{0};
+        const WallTimeLimit wall_time_spent{optimizer_budget, start_time};
+
+        bool stopped_for_wall_time = false;
+        std::size_t rounds_done = 0;
+        result.trials.reserve(planned_rounds * member_count);
+        for (std::size_t round = 0; round < planned_rounds; ++round) {
+            if (wall_time_spent()) {
+                stopped_for_wall_time = true;
+                break;
+            }
+
+            std::vector<std::optional<HyperparameterTrialRecord>> slots(member_count);
+            run_indexed(
+                member_count, workers,
+                [&](std::size_t m) {
+                    auto &member = members[m];
+                    const auto trial_index = round * member_count + m;
+                    const auto trial_seed =
+                        static_cast<unsigned long>(derive_stream_seed(static_cast<std::uint64_t>(seed), trial_index));
+                    bool started = false;
+                    bool resumed = false;
+                    auto trial = run_trial(
+                        algorithm_factory, problem, segment_budget, trial_seed, trial_index,
+                        [&] {
+                            if (round > 0) {
+                                return member.parameters;
+                            }
+                            if (m < priors.size()) {
+                                return priors[m].parameters;
+                            }
+                            std::mt19937_64 rng{derive_stream_seed(member_seed, m)};
+                            return sample_parameters(algorithm_space, search_space_.get(), rng);
+                        },
+                        &started, {},
+                        [&](IEvolutionaryAlgorithm &algorithm) {
+                            resumed = algorithm.set_warm_start(member.state) && member.state != nullptr;
+                        });
+                    if (started) {
+                        calls.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    trial.lineage = TrialLineage{m, round, member.parent_trial, member.exploited, resumed};
+
+                    if (!trial.parameters.empty()) {
+                        member.parameters = trial.parameters;
+                    }
+                    member.state = trial.optimization_result.final_population;
+                    member.last_trial = trial_index;
+                    member.score = is_selectable_trial(trial) ? trial.optimization_result.best_fitness
+                                                              : std::numeric_limits<double>::infinity();
+                    slots[m] = std::move(trial);
+                },
+                wall_time_spent);
+            for (auto &slot : slots) {
+                if (!slot) {
+                    stopped_for_wall_time = true;
+                    break;
+                }
+                result.trials.push_back(std::move(*slot));
+            }
+            if (stopped_for_wall_time) {
+                break;
+            }
+            ++rounds_done;
+            if (round + 1 == planned_rounds) {
+                break;
+            }
+
+            for (auto &member : members) {
+                member.parent_trial = member.last_trial;
+                member.exploited = false;
+            }
+            // best first, ties by member index
+            std::vector<std::size_t> order(member_count);
+            std::iota(order.begin(), order.end(), std::size_t{0});
+            std::stable_sort(order.begin(), order.end(),
+                             [&](std::size_t a, std::size_t b) { return members[a].score < members[b].score; });
+            const auto replaced = exploit_fraction > 0.0
+                                      ? std::max<std::size_t>(
+                                            1u, static_cast<std::size_t>(exploit_fraction *
+                                                                         static_cast<double>(member_count)))
+                                      : 0u;
+            std::mt19937_64 rng{derive_stream_seed(exploit_seed, round)};
+            std::uniform_int_distribution<std::size_t> pick{0, replaced > 0u ? replaced - 1u : 0u};
+            for (std::size_t j = 0; j < replaced; ++j) {
+                const auto &donor = members[order[pick(rng)]];
+                auto &loser = members[order[member_count - 1u - j]];
+                if (!std::isfinite(donor.score)) {
+                    continue;
+                }
+                loser.parameters = perturb(donor.parameters, rng);
+                loser.state = donor.state;
+                loser.parent_trial = donor.last_trial;
+                loser.exploited = true;
+            }
+        }
+
+        const auto end_time = std::chrono::steady_clock::now();
+        result.optimizer_usage.objective_calls = calls.load(std::memory_order_relaxed);
+        result.optimizer_usage.iterations = rounds_done;
+        result.optimizer_usage.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+        select_best_trial(result, "population based training");
+        if (stopped_for_wall_time) {
+            result.status = RunStatus::BudgetExceeded;
+            result.message = "wall-time budget exceeded";
+        }
+        apply_optimizer_budget_status(optimizer_budget, result.optimizer_usage, result.status, result.message);
+    } catch (const std::exception &ex) {
+        const auto end_time = std::chrono::steady_clock::now();
+        const auto classified = classify_exception(ex);
+        result.status = classified.status;
+        result.error_info = classified.error_info;
+        result.message = ex.what();
+        result.optimizer_usage.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+    }
+
+    return result;
+}
+
+} // namespace hpoea::core
@@ -0,0 +1,353 @@
+#include "hpoea/core/point_sequence.hpp"
+
+#include "hpoea/core/seeding.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+using hpoea::core::PointSequenceKind;
+
+// primitive polynomial x^degree + ... + 1, interior coefficients in
+// coefficients (most significant first), and its initial direction numbers
+struct SobolPolynomial {
+    unsigned degree;
+    std::uint32_t coefficients;
+    std::array<std::uint32_t, 7> initial;
+};
+
+// joe & kuo (2008), new-joe-kuo-6.21201, dimensions 2 to 21
+constexpr SobolPolynomial joe_kuo_table[] = {
+    {1, 0, {1}},
+    {2, 1, {1, 3}},
+    {3, 1, {1, 3, 1}},
+    {3, 2, {1, 1, 1}},
+    {4, 1, {1, 1, 3, 3}},
+    {4, 4, {1, 3, 5, 13}},
+    {5, 2, {1, 1, 5, 5, 17}},
+    {5, 4, {1, 1, 5, 5, 5}},
+    {5, 7, {1, 1, 7, 11, 19}},
+    {5, 11, {1, 1, 5, 1, 1}},
+    {5, 13, {1, 1, 1, 3, 11}},
+    {5, 14, {1, 3, 5, 5, 31}},
+    {6, 1, {1, 3, 3, 9, 7, 49}},
+    {6, 13, {1, 1, 1, 15, 21, 21}},
+    {6, 16, {1, 3, 1, 13, 27, 49}},
+    {6, 19, {1, 1, 1, 15, 7, 5}},
+    {6, 22, {1, 3, 1, 15, 13, 25}},
+    {6, 25, {1, 1, 5, 5, 19, 61}},
+    {7, 1, {1, 3, 7, 11, 23, 15, 103}},
+    {7, 4, {1, 3, 7, 13, 13, 15, 69}},
+};
+
+// a * b mod p over GF(2), p of the given degree
+std::uint64_t gf2_mulmod(std::uint64_t a, std::uint64_t b, std::uint64_t p, unsigned degree) {
+    std::uint64_t result = 0;
+    while (b != 0) {
+        if (b & 1u) {
+            result ^= a;
+        }
+        b >>= 1;
+        a <<= 1;
+        if (a & (std::uint64_t{1} << degree)) {
+            a ^= p;
+        }
+    }
+    return result;
+}
+
+std::uint64_t gf2_powmod_x(std::uint64_t exponent, std::uint64_t p, unsigned degree) {
+    std::uint64_t result = 1;
+    std::uint64_t base = degree == 1 ? (2u ^ p) : 2u;
+    while (exponent != 0) {
+        if (exponent & 1u) {
+            result = gf2_mulmod(result, base, p, degree);
+        }
+        base = gf2_mulmod(base, base, p, degree);
+        exponent >>= 1;
+    }
+    return result;
+}
+
+// x has order 2^degree - 1 modulo p
+bool is_primitive(std::uint64_t p, unsigned degree) {
+    const std::uint64_t order = (std::uint64_t{1} << degree) - 1;
+    if (gf2_powmod_x(order, p, degree) != 1) {
+        return false;
+    }
+    auto remaining = order;
+    for (std::uint64_t factor = 2; factor * factor <= remaining; ++factor) {
+        if (remaining % factor != 0) {
+            continue;
+        }
+        if (gf2_powmod_x(order / factor, p, degree) == 1) {
+            return false;
+        }
+        while (remaining % factor == 0) {
+            remaining /= factor;
+        }
+    }
+    return remaining == 1 || gf2_powmod_x(order / remaining, p, degree) != 1;
+}
+
+// primitive polynomials in joe-kuo order: by degree, then coefficients
+std::vector<SobolPolynomial> primitive_polynomials(std::size_t count) {
+    std::vector<SobolPolynomial> polynomials;
+    polynomials.reserve(count);
+    for (unsigned degree = 1; polynomials.size() < count; ++degree) {
+        if (degree > 31) {
+            throw std::invalid_argument("sobol sequence dimension too large");
+        }
+        const std::uint32_t interior = std::uint32_t{1} << (degree - 1);
+        for (std::uint32_t coefficients = 0; coefficients < interior && polynomials.size() < count; ++coefficients) {
+            const auto p = (std::uint64_t{1} << degree) | (std::uint64_t{coefficients} << 1) | 1u;
+            if (is_primitive(p, degree)) {
+                polynomials.push_back({degree, coefficients, {}});
+            }
+        }
+    }
+    return polynomials;
+}
+
+std::vector<std::uint32_t> first_primes(std::size_t count) {
+    std::vector<std::uint32_t> primes;
+    primes.reserve(count);
+    for (std::uint32_t candidate = 2; primes.size() < count; ++candidate) {
+        bool prime = true;
+        for (const auto p : primes) {
+            if (p * p > candidate) {
+                break;
+            }
+            if (candidate % p == 0) {
+                prime = false;
+                break;
+            }
+        }
+        if (prime) {
+            primes.push_back(candidate);
+        }
+    }
+    return primes;
+}
+
+constexpr double two_pow_minus_32 = 1.0 / 4294967296.0;
+
+} // namespace
+
+namespace hpoea::core {
+
+std::string_view to_string(PointSequenceKind kind) noexcept {
+    switch (kind) {
+        case PointSequenceKind::Uniform:
+            return "uniform";
+        case PointSequenceKind::Sobol:
+            return "sobol";
+        case PointSequenceKind::Halton:
+            return "halton";
+        case PointSequenceKind::LatinHypercube:
+            return "lhs";
+    }
+    return "uniform";
+}
+
+std::optional<PointSequenceKind> parse_point_sequence_kind(std::string_view text) noexcept {
+    for (const auto kind : {PointSequenceKind::Uniform, PointSequenceKind::Sobol, PointSequenceKind::Halton,
+                            PointSequenceKind::LatinHypercube}) {
+        if (text == to_string(kind)) {
+            return kind;
+        }
+    }
+    return std::nullopt;
+}
+
+std::vector<std::string> point_sequence_choices() {
+    return {"uniform", "sobol", "halton", "lhs"};
+}
+
+PointSequence::PointSequence(PointSequenceKind kind, std::size_t dimension, std::size_t block_size,
+                             std::uint64_t seed)
+    : kind_(kind),
+      dimension_(dimension),
+      block_size_(std::max<std::size_t>(block_size, 1)),
+      rng_(splitmix64(seed)) {
+    switch (kind_) {
+        case PointSequenceKind::Uniform:
+            break;
+        case PointSequenceKind::Sobol:
+            init_sobol();
+            break;
+        case PointSequenceKind::Halton:
+            init_halton();
+            break;
+        case PointSequenceKind::LatinHypercube:
+            init_latin_hypercube();
+            break;
+    }
+}
+
+void PointSequence::init_sobol() {
+    constexpr std::size_t table_size = sizeof(joe_kuo_table) / sizeof(joe_kuo_table[0]);
+    const auto polynomials = dimension_ > 1 + table_size
+        ? primitive_polynomials(dimension_ - 1)
+        : std::vector<SobolPolynomial>{};
+
+    directions_.assign(dimension_, {});
+    for (std::size_t j = 0; j < dimension_; ++j) {
+        auto &v = directions_[j];
+        if (j == 0) {
+            // van der corput
+            for (unsigned k = 0; k < 32; ++k) {
+                v[k] = std::uint32_t{1} << (31 - k);
+            }
+        } else {
+            const bool tabled = j - 1 < table_size;
+            const auto &poly = tabled ? joe_kuo_table[j - 1] : polynomials[j - 1];
+            const auto s = poly.degree;
+            std::uint64_t stream = splitmix64(0x5eb0151d1ec7005eULL + j);
+            for (unsigned k = 0; k < s; ++k) {
+                // beyond the table: fixed odd m_k < 2^(k+1)
+                stream = splitmix64(stream);
+                const auto m = tabled
+                    ? poly.initial[k]
+                    : static_cast<std::uint32_t>((stream & ((std::uint64_t{1} << (k + 1)) - 1)) | 1u);
+                v[k] = m << (31 - k);
+            }
+            for (unsigned k = s; k < 32; ++k) {
+                v[k] = v[k - s] ^ (v[k - s] >> s);
+                for (unsigned i = 1; i < s; ++i) {
+                    if ((poly.coefficients >> (s - 1 - i)) & 1u) {
+                        v[k] ^= v[k - i];
+                    }
+                }
+            }
+        }
+
+        // linear matrix scrambling: output digit i mixes input digits 0..i
+        std::array<std::uint32_t, 32> rows{};
+        for (unsigned i = 0; i < 32; ++i) {
+            const auto above = i == 0 ? std::uint32_t{0} : ~std::uint32_t{0} << (32 - i);
+            rows[i] = (static_cast<std::uint32_t>(rng_()) & above) | (std::uint32_t{1} << (31 - i));
+        }
+        for (auto &direction : v) {
+            std::uint32_t scrambled = 0;
+            for (unsigned i = 0; i < 32; ++i) {
+                if (std::popcount(direction & rows[i]) & 1) {
+                    scrambled |= std::uint32_t{1} << (31 - i);
+                }
+            }
+            direction = scrambled;
+        }
+    }
+
+    // digital shift
+    state_.resize(dimension_);
+    for (auto &value : state_) {
+        value = static_cast<std::uint32_t>(rng_());
+    }
+}
+
+void PointSequence::init_halton() {
+    bases_ = first_primes(dimension_);
+    multipliers_.resize(dimension_);
+    for (std::size_t j = 0; j < dimension_; ++j) {
+        std::uniform_int_distribution<std::uint32_t> pick(1, std::max<std::uint32_t>(bases_[j] - 1, 1));
+        multipliers_[j] = pick(rng_);
+    }
+}
+
+void PointSequence::init_latin_hypercube() {
+    if (block_size_ > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::invalid_argument("latin hypercube block size too large");
+    }
+    strata_.resize(dimension_ * block_size_);
+    shuffle_strata();
+}
+
+void PointSequence::shuffle_strata() {
+    for (std::size_t j = 0; j < dimension_; ++j) {
+        const auto first = strata_.begin() + static_cast<std::ptrdiff_t>(j * block_size_);
+        const auto last = first + static_cast<std::ptrdiff_t>(block_size_);
+        for (std::uint32_t i = 0; i < block_size_; ++i) {
+            *(first + i) = i;
+        }
+        std::shuffle(first, last, rng_);
+    }
+}
+
+void PointSequence::next(std::vector<double> &out) {
+    out.resize(dimension_);
+    switch (kind_) {
+        case PointSequenceKind::Uniform: {
+            std::uniform_real_distribution<double> unit(0.0, 1.0);
+            for (auto &value : out) {
+                value = unit(rng_);
+            }
+            break;
+        }
+        case PointSequenceKind::Sobol: {
+            if (index_ > std::numeric_limits<std::uint32_t>::max()) {
+                throw std::out_of_range("sobol sequence exhausted");
+            }
+            // gray-code order: point n flips the direction of the lowest zero bit of n - 1
+            if (index_ > 0) {
+                const auto bit = static_cast<unsigned>(std::countr_one(index_ - 1));
+                for (std::size_t j = 0; j < dimension_; ++j) {
+                    state_[j] ^= directions_[j][bit];
+                }
+            }
+            for (std::size_t j = 0; j < dimension_; ++j) {
+                out[j] = static_cast<double>(state_[j]) * two_pow_minus_32;
+            }
+            break;
+        }
+        case PointSequenceKind::Halton: {
+            // index 0 is the origin in every base, start at 1
+            const auto n = index_ + 1;
+            for (std::size_t j = 0; j < dimension_; ++j) {
+                // reversed scrambled digits over base^digits, exact in integers
+                const std::uint64_t base = bases_[j];
+                std::uint64_t numerator = 0;
+                std::uint64_t denominator = 1;
+                for (auto rest = n; rest != 0; rest /= base) {
+                    numerator = numerator * base + (rest % base) * multipliers_[j] % base;
+                    denominator *= base;
+                }
+                out[j] = std::min(static_cast<double>(numerator) / static_cast<double>(denominator),
+                                  std::nextafter(1.0, 0.0));
+            }
+            break;
+        }
+        case PointSequenceKind::LatinHypercube: {
+            const auto slot = static_cast<std::size_t>(index_ % block_size_);
+            if (slot == 0 && index_ > 0) {
+                shuffle_strata();
+            }
+            std::uniform_real_distribution<double> unit(0.0, 1.0);
+            const double width = 1.0 / static_cast<double>(block_size_);
+            for (std::size_t j = 0; j < dimension_; ++j) {
+                const auto stratum = strata_[j * block_size_ + slot];
+                out[j] = std::min((static_cast<double>(stratum) + unit(rng_)) * width, std::nextafter(1.0, 0.0));
+            }
+            break;
+        }
+    }
+    ++index_;
+}
+
+void PointSequence::next_in_box(const std::vector<double> &lower, const std::vector<double> &upper,
+                                std::vector<double> &out) {
+    if (lower.size() != dimension_ || upper.size() != dimension_) {
+        throw std::invalid_argument("point sequence bounds do not match its dimension");
+    }
+    next(out);
+    for (std::size_t j = 0; j < dimension_; ++j) {
+        out[j] = lower[j] + out[j] * (upper[j] - lower[j]);
+    }
+}
+
+} // namespace hpoea::core
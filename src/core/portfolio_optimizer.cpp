@@ -0,0 +1,489 @@
+#include "hpoea/core/portfolio_optimizer.hpp"
+
+#include "hpoea/core/budget_checks.hpp"
+#include "hpoea/core/error_classification.hpp"
+#include "hpoea/core/seeding.hpp"
+#include "hpoea/core/trial_runner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace {
+
+constexpr const char *ROUNDS = "rounds";
+constexpr const char *MIN_SHARE = "min_share";
+constexpr const char *PARALLEL_WORKERS = "parallel_workers";
+// keeps member seeds apart from the inner run seeds the members derive
+constexpr std::uint64_t member_stream_salt = 0x7c1f3a5e9d2b4086ULL;
+// keeps the memo's inner run seeds apart from the member seeds
+constexpr std::uint64_t call_stream_salt = 0x3e8b1d6f52a9c047ULL;
+
+hpoea::core::ParameterSpace make_parameter_space() {
+    hpoea::core::ParameterSpace space;
+
+    hpoea::core::ParameterDescriptor d;
+    d.name = ROUNDS;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{1, 1000};
+    d.default_value = std::int64_t{4};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = MIN_SHARE;
+    d.type = hpoea::core::ParameterType::Continuous;
+    d.continuous_range = hpoea::core::ContinuousRange{0.0, 1.0};
+    d.default_value = 0.2;
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = PARALLEL_WORKERS;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{0, 1024};
+    d.default_value = std::int64_t{1};
+    space.add_descriptor(d);
+
+    return space;
+}
+
+// one inner call. a call repeats another only when all of it matches:
+// hyperband rungs differ in budget, problem-set instances in problem. the
+// seed is not part of it, since every member derives its own
+struct RunKey {
+    hpoea::core::ParameterSet parameters;
+    hpoea::core::Budget budget;
+    std::string problem_id;
+};
+
+bool same_call(const RunKey &lhs, const RunKey &rhs) {
+    return lhs.problem_id == rhs.problem_id &&
+           lhs.budget.function_evaluations == rhs.budget.function_evaluations &&
+           lhs.budget.generations == rhs.budget.generations && lhs.budget.wall_time == rhs.budget.wall_time &&
+           lhs.parameters == rhs.parameters;
+}
+
+std::uint64_t hash_run_key(const RunKey &key) {
+    hpoea::core::Fnv1a hash;
+    hash.word(hpoea::core::hash_parameter_set(key.parameters));
+    // zero for an absent limit, limit + 1 otherwise
+    hash.word(key.budget.function_evaluations ? *key.budget.function_evaluations + 1u : 0u);
+    hash.word(key.budget.generations ? *key.budget.generations + 1u : 0u);
+    hash.word(key.budget.wall_time ? static_cast<std::uint64_t>(key.budget.wall_time->count()) + 1u : 0u);
+    hash.text(key.problem_id);
+    return hash.digest();
+}
+
+struct MemoEntry {
+    RunKey key;
+    hpoea::core::OptimizationResult result;
+};
+
+// completed inner runs by hash_run_key, colliding keys side by side
+using RunMemo = std::unordered_map<std::uint64_t, std::vector<MemoEntry>>;
+
+const hpoea::core::OptimizationResult *find_run(const RunMemo &memo, std::uint64_t hash, const RunKey &key) {
+    const auto it = memo.find(hash);
+    if (it == memo.end()) {
+        return nullptr;
+    }
+    for (const auto &entry : it->second) {
+        if (same_call(entry.key, key)) {
+            return &entry.result;
+        }
+    }
+    return nullptr;
+}
+
+// only runs that ended on their own are worth repeating
+bool memoizable(const hpoea::core::OptimizationResult &result) {
+    return result.status == hpoea::core::RunStatus::Success || result.status == hpoea::core::RunStatus::BudgetExceeded;
+}
+
+// one member's view of the memo in one round: the runs of earlier rounds,
+// read-only, and its own, which it may add from several threads. members
+// never see each other's runs of the same round, so a round does not
+// depend on how the members are scheduled. seed is the portfolio's, the
+// same for every member and round.
+struct MemberMemo {
+    const RunMemo *earlier{nullptr};
+    std::uint64_t seed{0};
+    std::mutex mutex;
+    RunMemo own;
+    std::size_t runs{0};
+    std::size_t hits{0};
+};
+
+// answers a repeated call from the memo instead of running it. a call runs
+// on a seed derived from the call itself, so whichever member or round
+// makes it first, the answer is the same. a warm started run depends on
+// more than its call and always runs, on the seed it was given.
+class MemoAlgorithm final : public hpoea::core::IEvolutionaryAlgorithm {
+public:
+    MemoAlgorithm(hpoea::core::EvolutionaryAlgorithmPtr inner, MemberMemo *memo)
+        : inner_(std::move(inner)), memo_(memo) {}
+
+    [[nodiscard]] const hpoea::core::AlgorithmIdentity &identity() const noexcept override {
+        return inner_->identity();
+    }
+
+    [[nodiscard]] const hpoea::core::ParameterSpace &parameter_space() const noexcept override {
+        return inner_->parameter_space();
+    }
+
+    void configure(const hpoea::core::ParameterSet &parameters) override {
+        inner_->configure(parameters);
+        parameters_ = parameters;
+    }
+
+    [[nodiscard]] hpoea::core::OptimizationResult run(const hpoea::core::IProblem &problem,
+                                                      const hpoea::core::Budget &budget,
+                                                      unsigned long seed) override {
+        RunKey key{parameters_, budget, problem.metadata().id};
+        const auto hash = hash_run_key(key);
+        if (!warm_started_) {
+            std::lock_guard lock(memo_->mutex);
+            const auto *hit = find_run(*memo_->earlier, hash, key);
+            if (!hit) {
+                hit = find_run(memo_->own, hash, key);
+            }
+            if (hit) {
+                ++memo_->hits;
+                return *hit;
+            }
+            ++memo_->runs;
+        } else {
+            std::lock_guard lock(memo_->mutex);
+            ++memo_->runs;
+        }
+
+        const auto call_seed =
+            warm_started_ ? seed : static_cast<unsigned long>(hpoea::core::derive_stream_seed(memo_->seed, hash));
+        auto result = inner_->run(problem, budget, call_seed);
+        if (!warm_started_ && memoizable(result)) {
+            std::lock_guard lock(memo_->mutex);
+            if (!find_run(memo_->own, hash, key)) {
+                memo_->own[hash].push_back({std::move(key), result});
+            }
+        }
+        return result;
+    }
+
+    void set_batch_evaluator(const hpoea::core::BatchEvaluatorConfig &config) override {
+        inner_->set_batch_evaluator(config);
+    }
+
+    void set_initial_population_cache(std::shared_ptr<hpoea::core::InitialPopulationCache> cache) override {
+        inner_->set_initial_population_cache(std::move(cache));
+    }
+
+    bool set_warm_start(std::shared_ptr<const hpoea::core::InitialPopulation> start) override {
+        const bool started = start != nullptr;
+        const bool accepted = inner_->set_warm_start(std::move(start));
+        warm_started_ = accepted && started;
+        return accepted;
+    }
+
+    void set_progress_callback(hpoea::core::ProgressCallback callback) override {
+        inner_->set_progress_callback(std::move(callback));
+    }
+
+    [[nodiscard]] hpoea::core::EvolutionaryAlgorithmPtr clone() const override {
+        auto copy = std::make_unique<MemoAlgorithm>(inner_->clone(), memo_);
+        copy->parameters_ = parameters_;
+        copy->warm_started_ = warm_started_;
+        return copy;
+    }
+
+private:
+    hpoea::core::EvolutionaryAlgorithmPtr inner_;
+    MemberMemo *memo_;
+    hpoea::core::ParameterSet parameters_;
+    bool warm_started_{false};
+};
+
+class MemoFactory final : public hpoea::core::IEvolutionaryAlgorithmFactory {
+public:
+    MemoFactory(const hpoea::core::IEvolutionaryAlgorithmFactory &inner, MemberMemo &memo)
+        : inner_(inner), memo_(memo) {}
+
+    [[nodiscard]] hpoea::core::EvolutionaryAlgorithmPtr create() const override {
+        return std::make_unique<MemoAlgorithm>(inner_.create(), &memo_);
+    }
+
+    [[nodiscard]] const hpoea::core::ParameterSpace &parameter_space() const noexcept override {
+        return inner_.parameter_space();
+    }
+
+    [[nodiscard]] const hpoea::core::AlgorithmIdentity &identity() const noexcept override {
+        return inner_.identity();
+    }
+
+private:
+    const hpoea::core::IEvolutionaryAlgorithmFactory &inner_;
+    MemberMemo &memo_;
+};
+
+// lowest observed objective among trials, +inf without one
+double best_observed(const std::vector<hpoea::core::HyperparameterTrialRecord> &trials) {
+    auto best = std::numeric_limits<double>::infinity();
+    for (const auto &trial : trials) {
+        if (const auto objective = hpoea::core::observed_objective(trial)) {
+            best = std::min(best, *objective);
+        }
+    }
+    return best;
+}
+
+// splits total by share, handing what flooring leaves to the largest
+// remainders, lower index first on ties
+std::vector<std::size_t> split_by_share(std::size_t total, const std::vector<double> &shares) {
+    std::vector<std::size_t> slices(shares.size());
+    std::vector<double> remainders(shares.size());
+    std::size_t handed = 0;
+    for (std::size_t m = 0; m < shares.size(); ++m) {
+        const auto exact = static_cast<double>(total) * shares[m];
+        slices[m] = std::min(total - handed, static_cast<std::size_t>(std::floor(exact)));
+        remainders[m] = exact - static_cast<double>(slices[m]);
+        handed += slices[m];
+    }
+    std::vector<std::size_t> order(shares.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(),
+                     [&](std::size_t lhs, std::size_t rhs) { return remainders[lhs] > remainders[rhs]; });
+    for (std::size_t i = 0; handed < total; i = (i + 1) % order.size()) {
+        ++slices[order[i]];
+        ++handed;
+    }
+    return slices;
+}
+
+} // namespace
+
+namespace hpoea::core {
+
+PortfolioOptimizer::PortfolioOptimizer()
+    : HyperOptimizerBase(make_parameter_space(), {"Portfolio", "shared_memo_portfolio", "1.0"}) {}
+
+PortfolioOptimizer::PortfolioOptimizer(std::vector<HyperparameterOptimizerPtr> members) : PortfolioOptimizer() {
+    for (auto &member : members) {
+        add_member(std::move(member));
+    }
+}
+
+PortfolioOptimizer::PortfolioOptimizer(const PortfolioOptimizer &other) : HyperOptimizerBase(other) {
+    members_.reserve(other.members_.size());
+    for (const auto &member : other.members_) {
+        members_.push_back(member->clone());
+    }
+}
+
+void PortfolioOptimizer::add_member(HyperparameterOptimizerPtr member) {
+    if (!member) {
+        throw std::invalid_argument("portfolio member must not be null");
+    }
+    members_.push_back(std::move(member));
+}
+
+HyperparameterOptimizationResult PortfolioOptimizer::optimize(const IEvolutionaryAlgorithmFactory &algorithm_factory,
+                                                              const IProblem &problem,
+                                                              const Budget &optimizer_budget,
+                                                              const Budget &algorithm_budget, unsigned long seed) {
+    HyperparameterOptimizationResult result;
+    result.status = RunStatus::InternalError;
+    result.seed = seed;
+    result.effective_optimizer_parameters = configured_parameters_;
+
+    const auto start_time = std::chrono::steady_clock::now();
+
+    try {
+        const auto &algorithm_space = algorithm_factory.parameter_space();
+        if (algorithm_space.empty()) {
+            throw std::invalid_argument("algorithm has no tunable parameters");
+        }
+        if (search_space_) {
+            search_space_->validate(algorithm_space);
+        }
+        if (members_.empty()) {
+            throw std::invalid_argument("portfolio has no members");
+        }
+        if (optimizer_budget.generations.has_value()) {
+            throw std::invalid_argument(
+                "portfolio does not consume a generations budget; use optimizer_budget.function_evaluations");
+        }
+        if (!optimizer_budget.function_evaluations.has_value()) {
+            throw std::invalid_argument("portfolio requires optimizer_budget.function_evaluations");
+        }
+
+        const auto rounds = count_parameter(configured_parameters_, ROUNDS);
+        const auto min_share = real_parameter(configured_parameters_, MIN_SHARE);
+        const auto member_count = members_.size();
+        const auto workers = std::min(parallel_workers(configured_parameters_),
+                                      member_count);
+        const auto member_seed = static_cast<std::uint64_t>(seed) ^ member_stream_salt;
+        const auto call_seed = static_cast<std::uint64_t>(seed) ^ call_stream_salt;
+
+        // members look their priors up under the portfolio's key
+        const HistoryKey key{algorithm_factory.identity(), problem.metadata().id,
+                             search_space_fingerprint(algorithm_space, search_space_.get())};
+        TrialHistory history;
+        for (auto &prior : prior_trials(algorithm_factory, problem)) {
+            history.add(key, std::move(prior.parameters), prior.objective);
+        }
+
+        RunMemo memo;
+        std::vector<double> shares(member_count, 1.0 / static_cast<double>(member_count));
+        auto remaining = *optimizer_budget.function_evaluations;
+        std::size_t runs = 0;
+        std::size_t hits = 0;
+        std::size_t rounds_done = 0;
+        std::optional<HyperparameterOptimizationResult> first_failure;
+
+        for (std::size_t round = 0; round < rounds && remaining > 0u; ++round) {
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start_time);
+            if (optimizer_budget.wall_time.has_value() && elapsed >= *optimizer_budget.wall_time) {
+                break;
+            }
+            const auto round_budget = round + 1 == rounds ? remaining : remaining / (rounds - round);
+            if (round_budget == 0u) {
+                continue;
+            }
+            const auto slices = split_by_share(round_budget, shares);
+            const auto priors = std::make_shared<const TrialHistory>(history);
+
+            std::vector<MemberMemo> memos(member_count);
+            std::vector<std::optional<HyperparameterOptimizationResult>> outcomes(member_count);
+            run_indexed(
+                member_count, workers,
+                [&](std::size_t m) {
+                    if (slices[m] == 0u) {
+                        return;
+                    }
+                    auto member = members_[m]->clone();
+                    if (auto *configurable = dynamic_cast<HyperOptimizerBase *>(member.get())) {
+                        if (search_space_) {
+                            configurable->set_search_space(std::make_shared<SearchSpace>(*search_space_));
+                        }
+                        if (pruning_policy_) {
+                            configurable->set_pruning_policy(pruning_policy_);
+                        }
+                        configurable->set_trial_history(priors, prior_count_);
+                    }
+                    Budget member_budget;
+                    member_budget.function_evaluations = slices[m];
+                    if (optimizer_budget.wall_time.has_value()) {
+                        member_budget.wall_time = *optimizer_budget.wall_time - elapsed;
+                    }
+                    memos[m].earlier = &memo;
+                    memos[m].seed = call_seed;
+                    const MemoFactory factory(algorithm_factory, memos[m]);
+                    outcomes[m] = member->optimize(factory, problem, member_budget, algorithm_budget,
+                                                   static_cast<unsigned long>(
+                                                       derive_stream_seed(member_seed, round * member_count + m)));
+                },
+                [] { return false; });
+            ++rounds_done;
+
+            // credit goes to members that beat the incumbent, or in the
+            // first round the worst member that found anything
+            auto reference = best_observed(result.trials);
+            std::vector<double> bests(member_count, std::numeric_limits<double>::infinity());
+            for (std::size_t m = 0; m < member_count; ++m) {
+                if (outcomes[m]) {
+                    bests[m] = best_observed(outcomes[m]->trials);
+                }
+            }
+            if (!std::isfinite(reference)) {
+                reference = -std::numeric_limits<double>::infinity();
+                for (const auto best : bests) {
+                    if (std::isfinite(best)) {
+                        reference = std::max(reference, best);
+                    }
+                }
+            }
+
+            std::size_t round_trials = 0;
+            std::vector<double> gains(member_count, 0.0);
+            for (std::size_t m = 0; m < member_count; ++m) {
+                if (!outcomes[m]) {
+                    continue;
+                }
+                auto &outcome = *outcomes[m];
+                if (outcome.trials.empty() && outcome.status != RunStatus::Success && !first_failure) {
+                    first_failure = outcome;
+                }
+                if (std::isfinite(bests[m]) && std::isfinite(reference)) {
+                    gains[m] = std::max(0.0, reference - bests[m]);
+                }
+                for (auto &trial : outcome.trials) {
+                    trial.trial_index = result.trials.size();
+                    trial.lineage = TrialLineage{m, round, std::nullopt, false};
+                    if (const auto objective = observed_objective(trial)) {
+                        history.add(key, trial.parameters, *objective);
+                    }
+                    result.trials.push_back(std::move(trial));
+                    ++round_trials;
+                }
+                // earlier members win when two ran the same set
+                for (auto &[hash, entries] : memos[m].own) {
+                    for (auto &entry : entries) {
+                        if (!find_run(memo, hash, entry.key)) {
+                            memo[hash].push_back(std::move(entry));
+                        }
+                    }
+                }
+                runs += memos[m].runs;
+                hits += memos[m].hits;
+                remaining -= std::min(remaining, memos[m].runs);
+            }
+            if (round_trials == 0u) {
+                break;
+            }
+
+            const auto total_gain = std::accumulate(gains.begin(), gains.end(), 0.0);
+            if (total_gain > 0.0) {
+                for (std::size_t m = 0; m < member_count; ++m) {
+                    shares[m] = min_share / static_cast<double>(member_count) + (1.0 - min_share) * gains[m] / total_gain;
+                }
+            }
+        }
+
+        const auto end_time = std::chrono::steady_clock::now();
+        result.optimizer_usage.objective_calls = runs;
+        result.optimizer_usage.iterations = rounds_done;
+        result.optimizer_usage.proposed_configurations = result.trials.size();
+        result.optimizer_usage.duplicate_configurations = hits;
+        result.optimizer_usage.cached_objective_calls = hits;
+        result.optimizer_usage.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+        select_best_trial(result, "portfolio");
+        if (result.trials.empty() && first_failure) {
+            result.status = first_failure->status;
+            result.error_info = first_failure->error_info;
+            result.message = first_failure->message;
+        }
+        apply_optimizer_budget_status(optimizer_budget, result.optimizer_usage, result.status, result.message);
+    } catch (const std::exception &ex) {
+        const auto end_time = std::chrono::steady_clock::now();
+        const auto classified = classify_exception(ex);
+        result.status = classified.status;
+        result.error_info = classified.error_info;
+        result.message = ex.what();
+        result.optimizer_usage.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+    }
+
+    return result;
+}
+
+} // namespace hpoea::core
@@ -0,0 +1,293 @@
+#include "hpoea/core/problem_set.hpp"
+
+#include "hpoea/core/error_classification.hpp"
+#include "hpoea/core/initial_population_cache.hpp"
+#include "hpoea/core/seeding.hpp"
+#include "hpoea/core/trial_runner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using hpoea::core::Budget;
+using hpoea::core::EvolutionaryAlgorithmPtr;
+using hpoea::core::OptimizationResult;
+using hpoea::core::ParameterSet;
+using hpoea::core::ProblemSet;
+using hpoea::core::ProblemSetAggregation;
+using hpoea::core::RunStatus;
+
+Budget total_budget(const Budget &budget, std::size_t instances) {
+    Budget total = budget;
+    if (total.function_evaluations.has_value()) {
+        *total.function_evaluations *= instances;
+    }
+    if (total.generations.has_value()) {
+        *total.generations *= instances;
+    }
+    return total;
+}
+
+// midrank of value among the reference values and itself, in (0, 1).
+// reference is sorted
+double reference_midrank(const std::vector<double> &reference, double value) {
+    const auto [first, last] = std::equal_range(reference.begin(), reference.end(), value);
+    const auto below = static_cast<double>(first - reference.begin());
+    const auto ties = static_cast<double>(last - first);
+    return (below + 0.5 * (ties + 1.0)) / static_cast<double>(reference.size() + 1u);
+}
+
+class ProblemSetAlgorithm final : public hpoea::core::IEvolutionaryAlgorithm {
+public:
+    ProblemSetAlgorithm(std::vector<EvolutionaryAlgorithmPtr> algorithms,
+                        std::shared_ptr<const ProblemSet> problem_set)
+        : algorithms_(std::move(algorithms)), problem_set_(std::move(problem_set)) {
+        for (const auto &algorithm : algorithms_) {
+            if (!algorithm) {
+                throw std::runtime_error("problem set base factory returned a null algorithm");
+            }
+        }
+    }
+
+    [[nodiscard]] const hpoea::core::AlgorithmIdentity &identity() const noexcept override {
+        return algorithms_.front()->identity();
+    }
+
+    [[nodiscard]] const hpoea::core::ParameterSpace &parameter_space() const noexcept override {
+        return algorithms_.front()->parameter_space();
+    }
+
+    void configure(const ParameterSet &parameters) override {
+        for (auto &algorithm : algorithms_) {
+            algorithm->configure(parameters);
+        }
+        configured_parameters_ = parameters;
+    }
+
+    [[nodiscard]] OptimizationResult run(const hpoea::core::IProblem &, const Budget &budget,
+                                         unsigned long seed) override {
+        const auto start_time = std::chrono::steady_clock::now();
+        const auto &instances = problem_set_->instances();
+
+        std::vector<OptimizationResult> runs(instances.size());
+        hpoea::core::run_indexed(
+            instances.size(), hpoea::core::resolve_worker_count(problem_set_->parallel_instances()),
+            [&](std::size_t i) {
+                const auto instance_seed =
+                    static_cast<unsigned long>(hpoea::core::derive_stream_seed(static_cast<std::uint64_t>(seed), i));
+                auto &run = runs[i];
+                try {
+                    run = algorithms_[i]->run(*instances[i].problem, budget, instance_seed);
+                } catch (const std::exception &ex) {
+                    const auto classified = hpoea::core::classify_exception(ex);
+                    run.status = classified.status;
+                    run.error_info = classified.error_info;
+                    run.message = ex.what();
+                    run.requested_budget = budget;
+                }
+                run.seed = instance_seed;
+            },
+            [] { return false; });
+
+        OptimizationResult result;
+        result.status = RunStatus::Success;
+        result.seed = seed;
+        result.requested_budget = total_budget(budget, instances.size());
+        result.effective_budget = result.requested_budget;
+        result.effective_parameters =
+            runs.front().effective_parameters.empty() ? configured_parameters_ : runs.front().effective_parameters;
+
+        bool selectable = true;
+        std::vector<double> fitness;
+        fitness.reserve(runs.size());
+        for (std::size_t i = 0; i < runs.size(); ++i) {
+            const auto &run = runs[i];
+            result.algorithm_usage.function_evaluations += run.algorithm_usage.function_evaluations;
+            result.algorithm_usage.cached_function_evaluations += run.algorithm_usage.cached_function_evaluations;
+            result.algorithm_usage.generations += run.algorithm_usage.generations;
+            fitness.push_back(run.best_fitness);
+            if (!selectable) {
+                continue;
+            }
+            if (!hpoea::core::is_selectable_run(run)) {
+                selectable = false;
+                result.status = run.status != RunStatus::Success ? run.status
+                                : std::isfinite(run.best_fitness) ? RunStatus::BudgetExceeded
+                                                                  : RunStatus::InternalError;
+                result.error_info = run.error_info;
+                result.message = "instance '" + instances[i].problem->metadata().id + "': " +
+                                 (run.message.empty() ? std::string{"run is not selectable"} : run.message);
+            } else if (run.status == RunStatus::BudgetExceeded) {
+                result.status = RunStatus::BudgetExceeded;
+            }
+        }
+        if (selectable) {
+            result.best_fitness = aggregate(fitness);
+            result.message = "aggregated over " + std::to_string(runs.size()) + " instances";
+        }
+
+        if (report_final_population_) {
+            auto final_population = std::make_shared<hpoea::core::InitialPopulation>();
+            final_population->parts.resize(algorithms_.size());
+            for (std::size_t i = 0; i < runs.size(); ++i) {
+                final_population->parts[i] = runs[i].final_population;
+            }
+            result.final_population = std::move(final_population);
+        }
+        result.instance_results = std::move(runs);
+        result.algorithm_usage.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start_time);
+        return result;
+    }
+
+    void set_batch_evaluator(const hpoea::core::BatchEvaluatorConfig &config) override {
+        for (auto &algorithm : algorithms_) {
+            algorithm->set_batch_evaluator(config);
+        }
+    }
+
+    void set_initial_population_cache(std::shared_ptr<hpoea::core::InitialPopulationCache> cache) override {
+        for (auto &algorithm : algorithms_) {
+            algorithm->set_initial_population_cache(cache);
+        }
+    }
+
+    // start carries one part per instance, see InitialPopulation::parts. true
+    // when every instance accepted its part
+    bool set_warm_start(std::shared_ptr<const hpoea::core::InitialPopulation> start) override {
+        if (start && start->parts.size() != algorithms_.size()) {
+            return false;
+        }
+        bool accepted = true;
+        for (std::size_t i = 0; i < algorithms_.size(); ++i) {
+            accepted = algorithms_[i]->set_warm_start(start ? start->parts[i] : nullptr) && accepted;
+        }
+        report_final_population_ = accepted;
+        return accepted;
+    }
+
+    // every instance reports as its own stream
+    void set_progress_callback(hpoea::core::ProgressCallback callback) override {
+        auto callbacks = hpoea::core::split_progress(std::move(callback), algorithms_.size());
+        for (std::size_t i = 0; i < algorithms_.size(); ++i) {
+            algorithms_[i]->set_progress_callback(std::move(callbacks[i]));
+        }
+    }
+
+    [[nodiscard]] EvolutionaryAlgorithmPtr clone() const override {
+        std::vector<EvolutionaryAlgorithmPtr> algorithms;
+        algorithms.reserve(algorithms_.size());
+        for (const auto &algorithm : algorithms_) {
+            algorithms.push_back(algorithm->clone());
+        }
+        auto copy = std::make_unique<ProblemSetAlgorithm>(std::move(algorithms), problem_set_);
+        copy->configured_parameters_ = configured_parameters_;
+        copy->report_final_population_ = report_final_population_;
+        return copy;
+    }
+
+private:
+    [[nodiscard]] double aggregate(const std::vector<double> &fitness) const {
+        const auto &instances = problem_set_->instances();
+        const auto normalized = [&](std::size_t i) {
+            return (fitness[i] - instances[i].offset) / instances[i].scale;
+        };
+        switch (problem_set_->aggregation()) {
+            case ProblemSetAggregation::MeanRank: {
+                double sum = 0.0;
+                for (std::size_t i = 0; i < fitness.size(); ++i) {
+                    sum += reference_midrank(instances[i].reference, fitness[i]);
+                }
+                return sum / static_cast<double>(fitness.size());
+            }
+            case ProblemSetAggregation::MeanNormalized: {
+                double sum = 0.0;
+                for (std::size_t i = 0; i < fitness.size(); ++i) {
+                    sum += normalized(i);
+                }
+                return sum / static_cast<double>(fitness.size());
+            }
+            case ProblemSetAggregation::WorstCase: {
+                double worst = -std::numeric_limits<double>::infinity();
+                for (std::size_t i = 0; i < fitness.size(); ++i) {
+                    worst = std::max(worst, normalized(i));
+                }
+                return worst;
+            }
+        }
+        return std::numeric_limits<double>::infinity();
+    }
+
+    std::vector<EvolutionaryAlgorithmPtr> algorithms_;
+    std::shared_ptr<const ProblemSet> problem_set_;
+    ParameterSet configured_parameters_;
+    bool report_final_population_{false};
+};
+
+} // namespace
+
+namespace hpoea::core {
+
+ProblemSet::ProblemSet(std::string id,
+                       std::vector<ProblemSetInstance> instances,
+                       ProblemSetAggregation aggregation,
+                       std::size_t parallel_instances)
+    : id_(std::move(id)),
+      instances_(std::move(instances)),
+      aggregation_(aggregation),
+      parallel_instances_(parallel_instances) {
+    if (instances_.empty()) {
+        throw std::invalid_argument("problem set '" + id_ + "' has no instances");
+    }
+    for (const auto &instance : instances_) {
+        if (!instance.problem) {
+            throw std::invalid_argument("problem set '" + id_ + "' has a null instance");
+        }
+        if (!std::isfinite(instance.offset)) {
+            throw std::invalid_argument("problem set '" + id_ + "': offset of instance '" +
+                                        instance.problem->metadata().id + "' must be finite");
+        }
+        if (!std::isfinite(instance.scale) || instance.scale <= 0.0) {
+            throw std::invalid_argument("problem set '" + id_ + "': scale of instance '" +
+                                        instance.problem->metadata().id + "' must be finite and positive");
+        }
+        if (aggregation_ == ProblemSetAggregation::MeanRank &&
+            (instance.reference.empty() ||
+             !std::ranges::all_of(instance.reference, [](double value) { return std::isfinite(value); }))) {
+            throw std::invalid_argument("problem set '" + id_ + "': mean_rank needs finite reference values for "
+                                        "instance '" + instance.problem->metadata().id + "'");
+        }
+    }
+    for (auto &instance : instances_) {
+        std::ranges::sort(instance.reference);
+    }
+}
+
+ProblemSetFactory::ProblemSetFactory(const IEvolutionaryAlgorithmFactory &base_factory,
+                                     std::shared_ptr<const ProblemSet> problem_set)
+    : base_factory_(base_factory), problem_set_(std::move(problem_set)) {
+    if (!problem_set_) {
+        throw std::invalid_argument("problem set factory requires a problem set");
+    }
+}
+
+EvolutionaryAlgorithmPtr ProblemSetFactory::create() const {
+    std::vector<EvolutionaryAlgorithmPtr> algorithms;
+    algorithms.reserve(problem_set_->instances().size());
+    for (std::size_t i = 0; i < problem_set_->instances().size(); ++i) {
+        algorithms.push_back(base_factory_.create());
+    }
+    return std::make_unique<ProblemSetAlgorithm>(std::move(algorithms), problem_set_);
+}
+
+} // namespace hpoea::core
@@ -0,0 +1,118 @@
+#include "hpoea/core/pruning.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+// linear interpolation between closest ranks
+double percentile_of(std::vector<double> values, double percentile) {
+    std::sort(values.begin(), values.end());
+    const auto position = percentile / 100.0 * static_cast<double>(values.size() - 1u);
+    const auto lower = static_cast<std::size_t>(std::floor(position));
+    const auto upper = std::min(lower + 1u, values.size() - 1u);
+    if (values[upper] == values[lower]) {
+        return values[lower];
+    }
+    return values[lower] + (position - static_cast<double>(lower)) * (values[upper] - values[lower]);
+}
+
+} // namespace
+
+namespace hpoea::core {
+
+void validate_pruning_policy(const PruningPolicy &policy) {
+    if (policy.interval == 0u) {
+        throw std::invalid_argument("pruning interval must be positive");
+    }
+    if (!(policy.percentile >= 0.0 && policy.percentile <= 100.0)) {
+        throw std::invalid_argument("pruning percentile must be within [0, 100]");
+    }
+    if (!(policy.min_delta >= 0.0)) {
+        throw std::invalid_argument("pruning min_delta cannot be negative");
+    }
+}
+
+TrialPruner::TrialPruner(PruningPolicy policy) : policy_(policy) {
+    validate_pruning_policy(policy_);
+    if (policy_.rule == PruningRule::Median) {
+        policy_.percentile = 50.0;
+    }
+}
+
+ProgressCallback TrialPruner::monitor() {
+    struct RunState {
+        std::size_t next_checkpoint{0};
+        double best_at_improvement{std::numeric_limits<double>::infinity()};
+        std::size_t stale_checkpoints{0};
+    };
+    // one per report stream
+    auto states = std::make_shared<std::vector<RunState>>();
+    return [this, states](const ProgressReport &report) {
+        if (states->size() <= report.stream) {
+            states->resize(report.stream + 1u);
+        }
+        auto &state = (*states)[report.stream];
+        const auto first = state.next_checkpoint;
+        while ((state.next_checkpoint + 1u) * policy_.interval <= report.function_evaluations) {
+            if (!keep(report.stream, state.next_checkpoint++, report.best_fitness)) {
+                return false;
+            }
+        }
+        if (policy_.rule != PruningRule::Patience || state.next_checkpoint == first) {
+            return true;
+        }
+        // checkpoints crossed by one report count as one step
+        if (report.best_fitness < state.best_at_improvement - policy_.min_delta) {
+            state.best_at_improvement = report.best_fitness;
+            state.stale_checkpoints = 0;
+        } else if (++state.stale_checkpoints >= policy_.patience &&
+                   state.next_checkpoint > policy_.warmup_checkpoints) {
+            std::scoped_lock lock(mutex_);
+            ++pruned_;
+            return false;
+        }
+        return true;
+    };
+}
+
+bool TrialPruner::keep(std::size_t stream, std::size_t checkpoint, double value) {
+    std::scoped_lock lock(mutex_);
+    if (checkpoints_.size() <= stream) {
+        checkpoints_.resize(stream + 1u);
+    }
+    auto &checkpoints = checkpoints_[stream];
+    if (checkpoints.size() <= checkpoint) {
+        checkpoints.resize(checkpoint + 1u);
+    }
+    auto &others = checkpoints[checkpoint];
+    bool prune = false;
+    if ((policy_.rule == PruningRule::Median || policy_.rule == PruningRule::Percentile) &&
+        checkpoint >= policy_.warmup_checkpoints && others.size() >= std::max<std::size_t>(policy_.startup_trials, 1u)) {
+        // a failed run reports an infinite best and is always worse
+        prune = !(value <= percentile_of(others, policy_.percentile));
+    }
+    others.push_back(value);
+    if (prune) {
+        ++pruned_;
+    }
+    return !prune;
+}
+
+std::vector<double> TrialPruner::recorded(std::size_t checkpoint, std::size_t stream) const {
+    std::scoped_lock lock(mutex_);
+    if (stream >= checkpoints_.size() || checkpoint >= checkpoints_[stream].size()) {
+        return {};
+    }
+    return checkpoints_[stream][checkpoint];
+}
+
+std::size_t TrialPruner::pruned_count() const {
+    std::scoped_lock lock(mutex_);
+    return pruned_;
+}
+
+} // namespace hpoea::core
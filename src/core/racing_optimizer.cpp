@@ -0,0 +1,491 @@
+#include "hpoea/core/racing_optimizer.hpp"
+
+#include "hpoea/core/budget_checks.hpp"
+#include "hpoea/core/error_classification.hpp"
+#include "hpoea/core/parameter_sampling.hpp"
+#include "hpoea/core/seeding.hpp"
+#include "hpoea/core/trial_runner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace {
+
+constexpr const char *CANDIDATES = "candidates";
+constexpr const char *MAX_STEPS = "max_steps";
+constexpr const char *FIRST_TEST = "first_test";
+constexpr const char *TEST = "test";
+constexpr const char *CONFIDENCE = "confidence";
+constexpr const char *PARALLEL_WORKERS = "parallel_workers";
+// keeps candidate streams apart from the step seeds
+constexpr std::uint64_t candidate_stream_salt = 0x2c1b3c6d5e4f7a89ULL;
+
+hpoea::core::ParameterSpace make_parameter_space() {
+    hpoea::core::ParameterSpace space;
+
+    hpoea::core::ParameterDescriptor d;
+    d.name = CANDIDATES;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{2, 100000};
+    d.default_value = std::int64_t{32};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = MAX_STEPS;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{0, 100000};
+    d.default_value = std::int64_t{0};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = FIRST_TEST;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{2, 1000};
+    d.default_value = std::int64_t{5};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = TEST;
+    d.type = hpoea::core::ParameterType::Categorical;
+    d.categorical_choices = {"friedman", "t_test"};
+    d.default_value = std::string{"friedman"};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = CONFIDENCE;
+    d.type = hpoea::core::ParameterType::Continuous;
+    d.continuous_range = hpoea::core::ContinuousRange{0.5, 0.999};
+    d.default_value = 0.95;
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = PARALLEL_WORKERS;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{0, 1024};
+    d.default_value = std::int64_t{1};
+    space.add_descriptor(d);
+
+    return space;
+}
+
+bool uses_t_test(const hpoea::core::ParameterSet &parameters) {
+    const auto it = parameters.find(TEST);
+    return it != parameters.end() && std::holds_alternative<std::string>(it->second) &&
+           std::get<std::string>(it->second) == "t_test";
+}
+
+// acklam's rational approximation, relative error below 1.2e-9
+double normal_quantile(double p) {
+    constexpr double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                            1.383577518672690e+02,  -3.066479806614716e+01, 2.506628277459239e+00};
+    constexpr double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                            6.680131188771972e+01,  -1.328068155288572e+01};
+    constexpr double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                            -2.549732539343734e+00, 4.374664141464968e+00,  2.938163982698783e+00};
+    constexpr double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                            3.754408661907416e+00};
+    constexpr double low = 0.02425;
+    if (p < low) {
+        const auto q = std::sqrt(-2.0 * std::log(p));
+        return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+               ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+    if (p > 1.0 - low) {
+        return -normal_quantile(1.0 - p);
+    }
+    const auto q = p - 0.5;
+    const auto r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+           (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+}
+
+// exact for 1 and 2 degrees of freedom, cornish-fisher expansion above
+double student_t_quantile(double p, double df) {
+    if (df <= 1.0) {
+        return std::tan(std::numbers::pi * (p - 0.5));
+    }
+    if (df <= 2.0) {
+        return (2.0 * p - 1.0) / std::sqrt(2.0 * p * (1.0 - p));
+    }
+    const auto z = normal_quantile(p);
+    const auto z2 = z * z;
+    const auto g1 = (z2 + 1.0) * z / 4.0;
+    const auto g2 = ((5.0 * z2 + 16.0) * z2 + 3.0) * z / 96.0;
+    const auto g3 = (((3.0 * z2 + 19.0) * z2 + 17.0) * z2 - 15.0) * z / 384.0;
+    const auto g4 = ((((79.0 * z2 + 776.0) * z2 + 1482.0) * z2 - 1920.0) * z2 - 945.0) * z / 92160.0;
+    return z + g1 / df + g2 / (df * df) + g3 / (df * df * df) + g4 / (df * df * df * df);
+}
+
+// wilson-hilferty
+double chi_square_quantile(double p, double df) {
+    const auto h = 2.0 / (9.0 * df);
+    const auto cube = 1.0 - h + normal_quantile(p) * std::sqrt(h);
+    return df * cube * cube * cube;
+}
+
+// ranks within one step, ties share their mean rank; failed runs are
+// infinite and so rank last together
+std::vector<double> step_ranks(const std::vector<double> &values) {
+    std::vector<std::size_t> order(values.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return values[a] < values[b]; });
+    std::vector<double> ranks(values.size());
+    for (std::size_t first = 0; first < order.size();) {
+        auto last = first + 1;
+        while (last < order.size() && values[order[last]] == values[order[first]]) {
+            ++last;
+        }
+        const auto mean_rank = 0.5 * static_cast<double>(first + last + 1);
+        for (auto i = first; i < last; ++i) {
+            ranks[order[i]] = mean_rank;
+        }
+        first = last;
+    }
+    return ranks;
+}
+
+// results[c][step] for every live candidate c; the survivors in order
+// of increasing score, best first, and their scores
+struct RaceStanding {
+    std::vector<std::size_t> survivors;
+    std::vector<double> scores;
+};
+
+RaceStanding friedman_standing(const std::vector<std::vector<double>> &results, const std::vector<std::size_t> &alive,
+                               double confidence, bool test) {
+    const auto k = alive.size();
+    const auto n = results[alive.front()].size();
+    std::vector<double> rank_sums(k, 0.0);
+    double squared_ranks = 0.0;
+    double ties = 0.0;
+    std::vector<double> row(k);
+    for (std::size_t step = 0; step < n; ++step) {
+        for (std::size_t j = 0; j < k; ++j) {
+            row[j] = results[alive[j]][step];
+        }
+        const auto ranks = step_ranks(row);
+        auto sorted = ranks;
+        std::sort(sorted.begin(), sorted.end());
+        for (std::size_t first = 0; first < k;) {
+            auto last = first + 1;
+            while (last < k && sorted[last] == sorted[first]) {
+                ++last;
+            }
+            const auto t = static_cast<double>(last - first);
+            ties += t * t * t - t;
+            first = last;
+        }
+        for (std::size_t j = 0; j < k; ++j) {
+            rank_sums[j] += ranks[j];
+            squared_ranks += ranks[j] * ranks[j];
+        }
+    }
+
+    RaceStanding standing;
+    std::vector<std::size_t> order(k);
+    for (std::size_t j = 0; j < k; ++j) {
+        order[j] = j;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return rank_sums[a] < rank_sums[b]; });
+
+    const auto nd = static_cast<double>(n);
+    const auto kd = static_cast<double>(k);
+    double critical = std::numeric_limits<double>::infinity();
+    if (test && n >= 2u) {
+        double spread = 0.0;
+        double rank_sum_squares = 0.0;
+        for (const auto r : rank_sums) {
+            spread += (r - nd * (kd + 1.0) / 2.0) * (r - nd * (kd + 1.0) / 2.0);
+            rank_sum_squares += r * r;
+        }
+        const auto denominator = nd * kd * (kd + 1.0) - ties / (kd - 1.0);
+        const auto within = nd * squared_ranks - rank_sum_squares;
+        if (denominator > 0.0) {
+            const auto statistic = 12.0 * spread / denominator;
+            if (statistic > chi_square_quantile(confidence, kd - 1.0)) {
+                const auto df = (nd - 1.0) * (kd - 1.0);
+                critical = student_t_quantile(1.0 - (1.0 - confidence) / 2.0, df) *
+                           std::sqrt(std::max(2.0 * within / df, 0.0));
+            }
+        }
+    }
+    const auto best = rank_sums[order.front()];
+    for (const auto j : order) {
+        if (rank_sums[j] - best <= critical) {
+            standing.survivors.push_back(alive[j]);
+            standing.scores.push_back(rank_sums[j] / nd);
+        }
+    }
+    return standing;
+}
+
+RaceStanding t_test_standing(const std::vector<std::vector<double>> &results, const std::vector<std::size_t> &alive,
+                             double confidence, bool test) {
+    const auto k = alive.size();
+    const auto n = results[alive.front()].size();
+    // a failed run counts as the worst finite result of its step
+    std::vector<std::vector<double>> values(k, std::vector<double>(n, 0.0));
+    for (std::size_t step = 0; step < n; ++step) {
+        double worst = -std::numeric_limits<double>::infinity();
+        for (std::size_t j = 0; j < k; ++j) {
+            const auto value = results[alive[j]][step];
+            if (std::isfinite(value)) {
+                worst = std::max(worst, value);
+            }
+        }
+        for (std::size_t j = 0; j < k; ++j) {
+            const auto value = results[alive[j]][step];
+            values[j][step] = std::isfinite(value) ? value : (std::isfinite(worst) ? worst : 0.0);
+        }
+    }
+    std::vector<double> means(k, 0.0);
+    for (std::size_t j = 0; j < k; ++j) {
+        for (const auto value : values[j]) {
+            means[j] += value;
+        }
+        means[j] /= static_cast<double>(n);
+    }
+    std::vector<std::size_t> order(k);
+    for (std::size_t j = 0; j < k; ++j) {
+        order[j] = j;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return means[a] < means[b]; });
+
+    const auto best = order.front();
+    const auto threshold = n >= 2u ? student_t_quantile(confidence, static_cast<double>(n - 1u)) : 0.0;
+    RaceStanding standing;
+    for (const auto j : order) {
+        bool worse = false;
+        if (test && n >= 2u && j != best) {
+            double mean = 0.0;
+            for (std::size_t step = 0; step < n; ++step) {
+                mean += values[j][step] - values[best][step];
+            }
+            mean /= static_cast<double>(n);
+            double variance = 0.0;
+            for (std::size_t step = 0; step < n; ++step) {
+                const auto delta = values[j][step] - values[best][step] - mean;
+                variance += delta * delta;
+            }
+            variance /= static_cast<double>(n - 1u);
+            worse = variance > 0.0 ? mean / std::sqrt(variance / static_cast<double>(n)) > threshold : mean > 0.0;
+        }
+        if (!worse) {
+            standing.survivors.push_back(alive[j]);
+            standing.scores.push_back(means[j]);
+        }
+    }
+    return standing;
+}
+
+} // namespace
+
+namespace hpoea::core {
+
+RacingOptimizer::RacingOptimizer() : HyperOptimizerBase(make_parameter_space(), {"Racing", "f_race", "1.0"}) {}
+
+void RacingOptimizer::set_instances(std::vector<std::shared_ptr<const IProblem>> instances) {
+    for (const auto &instance : instances) {
+        if (!instance) {
+            throw std::invalid_argument("racing instances cannot be null");
+        }
+    }
+    instances_ = std::move(instances);
+}
+
+HyperparameterOptimizationResult RacingOptimizer::optimize(const IEvolutionaryAlgorithmFactory &algorithm_factory,
+                                                           const IProblem &problem,
+                                                           const Budget &optimizer_budget,
+                                                           const Budget &algorithm_budget, unsigned long seed) {
+
+    HyperparameterOptimizationResult result;
+    result.status = RunStatus::InternalError;
+    result.seed = seed;
+    result.effective_optimizer_parameters = configured_parameters_;
+
+    const auto start_time = std::chrono::steady_clock::now();
+
+    try {
+        const auto &algorithm_space = algorithm_factory.parameter_space();
+        if (algorithm_space.empty()) {
+            throw std::invalid_argument("algorithm has no tunable parameters");
+        }
+        if (search_space_) {
+            search_space_->validate(algorithm_space);
+        }
+        if (!has_tunable_dimension(algorithm_space, search_space_.get())) {
+            throw ParameterValidationError(
+                "all parameters are fixed or excluded; use BaselineOptimizer for fixed/default runs");
+        }
+        if (optimizer_budget.generations.has_value()) {
+            throw std::invalid_argument(
+                "racing does not consume a generations budget; use optimizer_budget.function_evaluations");
+        }
+
+        const auto max_steps = count_parameter(configured_parameters_, MAX_STEPS);
+        if (max_steps == 0u && !optimizer_budget.function_evaluations.has_value()) {
+            throw std::invalid_argument(
+                "racing max_steps is 0 and no optimizer_budget.function_evaluations is set; "
+                "set max_steps or provide a function_evaluations budget");
+        }
+        const auto first_test = std::max<std::size_t>(count_parameter(configured_parameters_, FIRST_TEST), 2u);
+        auto candidate_count = std::max<std::size_t>(count_parameter(configured_parameters_, CANDIDATES), 2u);
+        if (optimizer_budget.function_evaluations.has_value()) {
+            // leave room for every candidate to reach the first test
+            candidate_count =
+                std::min(candidate_count, std::max<std::size_t>(*optimizer_budget.function_evaluations / first_test, 2u));
+            if (*optimizer_budget.function_evaluations < candidate_count) {
+                const auto end_time = std::chrono::steady_clock::now();
+                result.status = RunStatus::BudgetExceeded;
+                result.message = "optimizer budget allows zero racing steps";
+                result.optimizer_usage.wall_time =
+                    std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+                return result;
+            }
+        }
+        result.effective_optimizer_parameters.insert_or_assign(CANDIDATES, static_cast<std::int64_t>(candidate_count));
+
+        const auto t_test = uses_t_test(configured_parameters_);
+        const auto confidence = real_parameter(configured_parameters_, CONFIDENCE);
+        const auto workers = parallel_workers(configured_parameters_);
+
+        std::vector<const IProblem *> race_instances{&problem};
+        for (const auto &instance : instances_) {
+            race_instances.push_back(instance.get());
+        }
+
+        // each candidate keeps one sample stream, so it is the same configuration on every step
+        const auto candidate_seed = static_cast<std::uint64_t>(seed) ^ candidate_stream_salt;
+        const auto candidate_parameters = [&](std::size_t candidate) {
+            std::mt19937_64 rng{derive_stream_seed(candidate_seed, candidate)};
+            return sample_parameters(algorithm_space, search_space_.get(), rng);
+        };
+        std::vector<std::optional<ParameterSet>> sampled(candidate_count);
+        std::vector<std::vector<double>> results(candidate_count);
+        std::vector<std::size_t> alive(candidate_count);
+        for (std::size_t c = 0; c < candidate_count; ++c) {
+            alive[c] = c;
+        }
+
+        std::atomic<std::size_t> calls{0};
+        const WallTimeLimit wall_time_spent{optimizer_budget, start_time};
+
+        bool stopped_for_wall_time = false;
+        std::size_t steps = 0;
+        while (alive.size() > 1u && (max_steps == 0u || steps < max_steps)) {
+            if (optimizer_budget.function_evaluations.has_value() &&
+                result.trials.size() + alive.size() > *optimizer_budget.function_evaluations) {
+                break;
+            }
+            if (wall_time_spent()) {
+                stopped_for_wall_time = true;
+                break;
+            }
+
+            // every candidate of a step sees the same instance and seed
+            const auto &instance = *race_instances[steps % race_instances.size()];
+            const auto step_seed =
+                static_cast<unsigned long>(derive_stream_seed(static_cast<std::uint64_t>(seed), steps));
+            const auto first_index = result.trials.size();
+            std::vector<std::optional<HyperparameterTrialRecord>> slots(alive.size());
+            run_indexed(
+                alive.size(), workers,
+                [&](std::size_t i) {
+                    const auto candidate = alive[i];
+                    bool started = false;
+                    slots[i] = run_trial(algorithm_factory, instance, algorithm_budget, step_seed, first_index + i,
+                                         [&] {
+                                             return sampled[candidate] ? *sampled[candidate]
+                                                                       : candidate_parameters(candidate);
+                                         },
+                                         &started);
+                    if (started) {
+                        calls.fetch_add(1, std::memory_order_relaxed);
+                    }
+                },
+                wall_time_spent);
+
+            bool complete = true;
+            for (std::size_t i = 0; i < alive.size(); ++i) {
+                if (!slots[i]) {
+                    complete = false;
+                    continue;
+                }
+                sampled[alive[i]] = slots[i]->parameters;
+                result.trials.push_back(std::move(*slots[i]));
+            }
+            if (!complete) {
+                // a partial step would unbalance the ranks, so it only shows in the trials
+                stopped_for_wall_time = true;
+                break;
+            }
+            for (std::size_t i = 0; i < alive.size(); ++i) {
+                const auto &trial = result.trials[first_index + i];
+                results[alive[i]].push_back(is_selectable_trial(trial) ? trial.optimization_result.best_fitness
+                                                                       : std::numeric_limits<double>::infinity());
+            }
+            ++steps;
+
+            const auto test = steps >= first_test;
+            alive = t_test ? t_test_standing(results, alive, confidence, test).survivors
+                           : friedman_standing(results, alive, confidence, test).survivors;
+        }
+
+        const auto end_time = std::chrono::steady_clock::now();
+        result.optimizer_usage.objective_calls = calls.load(std::memory_order_relaxed);
+        result.optimizer_usage.iterations = steps;
+        result.optimizer_usage.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+        select_best_trial(result, "racing");
+        if (steps > 0u) {
+            // the winner is the best-standing survivor with a finite mean
+            const auto standing = t_test ? t_test_standing(results, alive, confidence, false)
+                                         : friedman_standing(results, alive, confidence, false);
+            for (const auto candidate : standing.survivors) {
+                double sum = 0.0;
+                for (const auto value : results[candidate]) {
+                    sum += value;
+                }
+                if (std::isfinite(sum) && sampled[candidate]) {
+                    result.status = RunStatus::Success;
+                    result.best_parameters = *sampled[candidate];
+                    result.best_objective = sum / static_cast<double>(results[candidate].size());
+                    result.error_info = std::nullopt;
+                    result.message = "racing completed with " + std::to_string(alive.size()) + " of " +
+                                     std::to_string(candidate_count) + " candidates left";
+                    break;
+                }
+            }
+        }
+        if (stopped_for_wall_time) {
+            result.status = RunStatus::BudgetExceeded;
+            result.message = "wall-time budget exceeded";
+        }
+        apply_optimizer_budget_status(optimizer_budget, result.optimizer_usage, result.status, result.message);
+    } catch (const std::exception &ex) {
+        const auto end_time = std::chrono::steady_clock::now();
+        const auto classified = classify_exception(ex);
+        result.status = classified.status;
+        result.error_info = classified.error_info;
+        result.message = ex.what();
+        result.optimizer_usage.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+    }
+
+    return result;
+}
+
+} // namespace hpoea::core
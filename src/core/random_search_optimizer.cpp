@@ -2,23 +2,31 @@
 
 #include "hpoea/core/budget_checks.hpp"
 #include "hpoea/core/error_classification.hpp"
+#include "hpoea/core/parameter_sampling.hpp"
+#include "hpoea/core/point_sequence.hpp"
 #include "hpoea/core/seeding.hpp"
+#include "hpoea/core/trial_runner.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
-#include <cmath>
-#include <limits>
 #include <optional>
 #include <random>
 #include <stdexcept>
 #include <string>
 #include <utility>
 #include <variant>
+#include <vector>
 
 namespace {
 
 constexpr const char *SAMPLE_COUNT = "sample_count";
+constexpr const char *PARALLEL_WORKERS = "parallel_workers";
+constexpr const char *SAMPLER = "sampler";
+// keeps sample streams apart from the inner run seeds,
+// which use derive_stream_seed(seed, trial_index) directly
+constexpr std::uint64_t sample_stream_salt = 0x5a3b1e5eed5a3b1eULL;
 
 hpoea::core::ParameterSpace make_parameter_space() {
     hpoea::core::ParameterSpace space;
@@ -30,225 +38,36 @@ hpoea::core::ParameterSpace make_parameter_space() {
     d.default_value = std::int64_t{0};
     space.add_descriptor(d);
 
-    return space;
-}
-
-std::size_t get_sample_count(const hpoea::core::ParameterSet &parameters) {
-    const auto it = parameters.find(SAMPLE_COUNT);
-    if (it == parameters.end()) {
-        throw std::invalid_argument("missing parameter: sample_count");
-    }
-    if (!std::holds_alternative<std::int64_t>(it->second)) {
-        throw std::invalid_argument("parameter 'sample_count' type mismatch");
-    }
-    const auto value = std::get<std::int64_t>(it->second);
-    if (value < 0) {
-        throw std::invalid_argument("parameter 'sample_count' cannot be negative");
-    }
-    return static_cast<std::size_t>(value);
-}
-
-const hpoea::core::ParameterConfig *find_config(const hpoea::core::SearchSpace *search_space, const std::string &name) {
-    if (!search_space) {
-        return nullptr;
-    }
-    return search_space->get(name);
-}
-
-bool is_excluded(const hpoea::core::ParameterConfig *config) {
-    return config && config->mode == hpoea::core::SearchMode::exclude;
-}
-
-bool is_tunable(const hpoea::core::ParameterConfig *config) {
-    return !config || config->mode == hpoea::core::SearchMode::optimize;
-}
-
-bool has_tunable_dimension(const hpoea::core::ParameterSpace &space, const hpoea::core::SearchSpace *search_space) {
-    for (const auto &descriptor : space.descriptors()) {
-        if (is_tunable(find_config(search_space, descriptor.name))) {
-            return true;
-        }
-    }
-    return false;
-}
-
-hpoea::core::ContinuousRange resolve_continuous_range(const hpoea::core::ParameterDescriptor &descriptor,
-                                                      const hpoea::core::ParameterConfig *config) {
-    if (!descriptor.continuous_range.has_value()) {
-        throw std::logic_error("continuous parameter missing range: " + descriptor.name);
-    }
-    if (config && config->continuous_bounds.has_value()) {
-        return config->continuous_bounds.value();
-    }
-    return descriptor.continuous_range.value();
-}
-
-hpoea::core::IntegerRange resolve_integer_range(const hpoea::core::ParameterDescriptor &descriptor,
-                                                const hpoea::core::ParameterConfig *config) {
-    if (!descriptor.integer_range.has_value()) {
-        throw std::logic_error("integer parameter missing range: " + descriptor.name);
-    }
-    if (config && config->integer_bounds.has_value()) {
-        return config->integer_bounds.value();
-    }
-    return descriptor.integer_range.value();
-}
-
-template <typename Rng>
-hpoea::core::ParameterValue sample_choice(const std::vector<hpoea::core::ParameterValue> &choices, Rng &rng) {
-    if (choices.empty()) {
-        throw hpoea::core::ParameterValidationError("discrete choices cannot be empty");
-    }
-    std::uniform_int_distribution<std::size_t> dist{0, choices.size() - 1};
-    return choices[dist(rng)];
-}
-
-template <typename Rng>
-hpoea::core::ParameterValue sample_continuous(const hpoea::core::ParameterDescriptor &descriptor,
-                                              const hpoea::core::ParameterConfig *config, Rng &rng) {
-    const auto range = resolve_continuous_range(descriptor, config);
-    const auto transform = config ? config->transform : hpoea::core::Transform::none;
-    const auto transformed = hpoea::core::transform_bounds(range, transform);
-    std::uniform_real_distribution<double> dist{transformed.lower, transformed.upper};
-    const auto transformed_value = dist(rng);
-    const auto numeric = hpoea::core::inverse_transform(transformed_value, transform);
-    return std::clamp(numeric, range.lower, range.upper);
-}
-
-template <typename Rng>
-hpoea::core::ParameterValue sample_integer(const hpoea::core::ParameterDescriptor &descriptor,
-                                           const hpoea::core::ParameterConfig *config, Rng &rng) {
-    if (config && !config->discrete_choices.empty()) {
-        return sample_choice(config->discrete_choices, rng);
-    }
-    const auto range = resolve_integer_range(descriptor, config);
-    std::uniform_int_distribution<std::int64_t> dist{range.lower, range.upper};
-    return dist(rng);
-}
-
-template <typename Rng>
-hpoea::core::ParameterValue sample_categorical(const hpoea::core::ParameterDescriptor &descriptor,
-                                               const hpoea::core::ParameterConfig *config, Rng &rng) {
-    if (config && !config->discrete_choices.empty()) {
-        return sample_choice(config->discrete_choices, rng);
-    }
-    if (descriptor.categorical_choices.empty()) {
-        throw hpoea::core::ParameterValidationError("Categorical descriptor without choices: " + descriptor.name);
-    }
-    std::uniform_int_distribution<std::size_t> dist{0, descriptor.categorical_choices.size() - 1};
-    return std::string{descriptor.categorical_choices[dist(rng)]};
-}
-
-template <typename Rng>
-hpoea::core::ParameterValue sample_value(const hpoea::core::ParameterDescriptor &descriptor,
-                                         const hpoea::core::ParameterConfig *config, Rng &rng) {
-    switch (descriptor.type) {
-    case hpoea::core::ParameterType::Continuous:
-        return sample_continuous(descriptor, config, rng);
-    case hpoea::core::ParameterType::Integer:
-        return sample_integer(descriptor, config, rng);
-    case hpoea::core::ParameterType::Boolean: {
-        std::bernoulli_distribution dist{0.5};
-        return dist(rng);
-    }
-    case hpoea::core::ParameterType::Categorical:
-        return sample_categorical(descriptor, config, rng);
-    }
-    throw std::logic_error("unhandled ParameterType value");
-}
-
-template <typename Rng>
-hpoea::core::ParameterSet sample_parameters(const hpoea::core::ParameterSpace &space,
-                                            const hpoea::core::SearchSpace *search_space, Rng &rng) {
-    hpoea::core::ParameterSet parameters;
-    parameters.reserve(space.size());
-
-    for (const auto &descriptor : space.descriptors()) {
-        const auto *config = find_config(search_space, descriptor.name);
-        if (config && config->mode == hpoea::core::SearchMode::fixed) {
-            if (config->fixed_value.has_value()) {
-                parameters.emplace(descriptor.name, config->fixed_value.value());
-            }
-            continue;
-        }
-        if (is_excluded(config)) {
-            continue;
-        }
-        parameters.emplace(descriptor.name, sample_value(descriptor, config, rng));
-    }
-
-    for (const auto &descriptor : space.descriptors()) {
-        if (parameters.contains(descriptor.name)) {
-            continue;
-        }
-        const auto *config = find_config(search_space, descriptor.name);
-        if (is_excluded(config)) {
-            continue;
-        }
-        if (descriptor.default_value.has_value()) {
-            parameters.emplace(descriptor.name, descriptor.default_value.value());
-        }
-    }
-
-    for (const auto &[name, value] : parameters) {
-        space.validate_value(space.descriptor(name), value);
-    }
-    for (const auto &descriptor : space.descriptors()) {
-        if (descriptor.required && !parameters.contains(descriptor.name) &&
-            !is_excluded(find_config(search_space, descriptor.name))) {
-            throw hpoea::core::ParameterValidationError("missing required parameter: " + descriptor.name);
-        }
-    }
+    d = {};
+    d.name = PARALLEL_WORKERS;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{0, 1024};
+    d.default_value = std::int64_t{1};
+    space.add_descriptor(d);
 
-    return parameters;
-}
+    d = {};
+    d.name = SAMPLER;
+    d.type = hpoea::core::ParameterType::Categorical;
+    d.categorical_choices = hpoea::core::point_sequence_choices();
+    d.default_value = std::string{"uniform"};
+    space.add_descriptor(d);
 
-void mark_non_finite_success(hpoea::core::OptimizationResult &result) {
-    if (result.status != hpoea::core::RunStatus::Success || std::isfinite(result.best_fitness)) {
-        return;
-    }
-    result.status = hpoea::core::RunStatus::InternalError;
-    result.error_info =
-        hpoea::core::ErrorInfo{"internal_error", "non_finite_objective", "algorithm returned non-finite objective"};
-    if (result.message.empty()) {
-        result.message = "algorithm returned non-finite objective";
-    }
+    return space;
 }
 
-void fill_success_result(hpoea::core::HyperparameterOptimizationResult &result) {
-    auto best = result.trials.end();
-    for (auto it = result.trials.begin(); it != result.trials.end(); ++it) {
-        if (!hpoea::core::is_selectable_trial(*it)) {
-            continue;
-        }
-        if (best == result.trials.end() ||
-            it->optimization_result.best_fitness < best->optimization_result.best_fitness) {
-            best = it;
-        }
+hpoea::core::PointSequenceKind get_sampler(const hpoea::core::ParameterSet &parameters) {
+    const auto it = parameters.find(SAMPLER);
+    if (it == parameters.end()) {
+        return hpoea::core::PointSequenceKind::Uniform;
     }
-
-    if (best != result.trials.end()) {
-        result.status = hpoea::core::RunStatus::Success;
-        result.best_parameters = best->parameters;
-        result.best_objective = best->optimization_result.best_fitness;
-        result.error_info = std::nullopt;
-        result.message = "random search completed";
-        return;
+    if (!std::holds_alternative<std::string>(it->second)) {
+        throw std::invalid_argument("parameter 'sampler' type mismatch");
     }
-
-    if (!result.trials.empty()) {
-        const auto &first = result.trials.front().optimization_result;
-        result.status = first.status;
-        result.best_objective = std::numeric_limits<double>::infinity();
-        result.error_info = first.error_info;
-        result.message = first.message.empty() ? "random search produced no successful finite trial" : first.message;
-        return;
+    const auto kind = hpoea::core::parse_point_sequence_kind(std::get<std::string>(it->second));
+    if (!kind) {
+        throw std::invalid_argument("unknown sampler: " + std::get<std::string>(it->second));
     }
-
-    result.status = hpoea::core::RunStatus::InternalError;
-    result.best_objective = std::numeric_limits<double>::infinity();
-    result.error_info = hpoea::core::ErrorInfo{"internal_error", "no_valid_trial", "random search produced no trial"};
-    result.message = "random search produced no trial";
+    return *kind;
 }
 
 } // namespace
@@ -289,7 +108,7 @@ HyperparameterOptimizationResult RandomSearchOptimizer::optimize(const IEvolutio
                 "random search does not consume a generations budget; use optimizer_budget.function_evaluations");
         }
 
-        const auto configured_samples = get_sample_count(configured_parameters_);
+        const auto configured_samples = count_parameter(configured_parameters_, SAMPLE_COUNT);
         std::size_t planned_samples = configured_samples;
         if (configured_samples == 0u) {
             if (!optimizer_budget.function_evaluations.has_value()) {
@@ -311,54 +130,77 @@ HyperparameterOptimizationResult RandomSearchOptimizer::optimize(const IEvolutio
             return result;
         }
 
-        std::mt19937_64 rng{splitmix64(static_cast<std::uint64_t>(seed))};
-        result.trials.reserve(planned_samples);
-        bool stopped_for_wall_time = false;
-
-        for (std::size_t trial_index = 0; trial_index < planned_samples; ++trial_index) {
-            if (optimizer_budget.wall_time.has_value()) {
-                const auto now = std::chrono::steady_clock::now();
-                const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - start_time);
-                if (elapsed >= *optimizer_budget.wall_time) {
-                    stopped_for_wall_time = true;
-                    break;
-                }
+        // every sample draws from its own stream so trials do not depend
+        // on the order in which workers pick them up
+        const auto sample_seed = static_cast<std::uint64_t>(seed) ^ sample_stream_salt;
+        // the best earlier configurations are re-run first
+        const auto priors = prior_trials(algorithm_factory, problem);
+
+        // a low-discrepancy design is drawn whole before any trial runs,
+        // in the unit cube of the search space so transforms and discrete
+        // cells shape it; uniform keeps one independent stream per sample
+        const auto sampler = get_sampler(configured_parameters_);
+        std::optional<UnitCubeEncoding> encoding;
+        std::vector<std::vector<double>> design;
+        if (sampler != PointSequenceKind::Uniform) {
+            encoding.emplace(algorithm_space, search_space_.get());
+            const auto design_size = planned_samples - std::min(planned_samples, priors.size());
+            PointSequence sequence(sampler, encoding->dimension(), design_size, derive_stream_seed(sample_seed, 0));
+            design.resize(design_size);
+            for (auto &point : design) {
+                sequence.next(point);
             }
+        }
 
-            const auto trial_start = std::chrono::steady_clock::now();
+        const auto pruner = make_trial_pruner();
+        std::atomic<std::size_t> calls{0};
+        const auto sample_trial = [&](std::size_t trial_index) {
             const auto trial_seed =
                 static_cast<unsigned long>(derive_stream_seed(static_cast<std::uint64_t>(seed), trial_index));
-            HyperparameterTrialRecord trial;
-            trial.trial_index = trial_index;
-
-            try {
-                trial.parameters = sample_parameters(algorithm_space, search_space_.get(), rng);
-                auto algorithm = algorithm_factory.create();
-                algorithm->configure(trial.parameters);
-                ++objective_calls;
-                trial.optimization_result = algorithm->run(problem, algorithm_budget, trial_seed);
-                trial.optimization_result.seed = trial_seed;
-                mark_non_finite_success(trial.optimization_result);
-            } catch (const std::exception &ex) {
-                const auto trial_end = std::chrono::steady_clock::now();
-                const auto classified = classify_exception(ex);
-                trial.optimization_result.status = classified.status;
-                trial.optimization_result.error_info = classified.error_info;
-                trial.optimization_result.message = ex.what();
-                trial.optimization_result.seed = trial_seed;
-                trial.optimization_result.algorithm_usage.wall_time =
-                    std::chrono::duration_cast<std::chrono::milliseconds>(trial_end - trial_start);
+            bool started = false;
+            auto trial = run_trial(algorithm_factory, problem, algorithm_budget, trial_seed, trial_index,
+                                   [&] {
+                                       if (trial_index < priors.size()) {
+                                           return priors[trial_index].parameters;
+                                       }
+                                       if (encoding) {
+                                           return encoding->decode(design[trial_index - priors.size()]);
+                                       }
+                                       std::mt19937_64 rng{derive_stream_seed(sample_seed, trial_index)};
+                                       return sample_parameters(algorithm_space, search_space_.get(), rng);
+                                   },
+                                   &started, trial_progress(pruner));
+            if (started) {
+                calls.fetch_add(1, std::memory_order_relaxed);
             }
+            return trial;
+        };
+        const WallTimeLimit wall_time_spent{optimizer_budget, start_time};
+
+        // indices are handed out in order and every handed out trial
+        // finishes, so a wall-time stop still leaves a gap-free prefix
+        std::vector<std::optional<HyperparameterTrialRecord>> slots(planned_samples);
+        run_indexed(
+            planned_samples, parallel_workers(configured_parameters_),
+            [&](std::size_t trial_index) { slots[trial_index] = sample_trial(trial_index); }, wall_time_spent);
 
-            result.trials.push_back(std::move(trial));
+        bool stopped_for_wall_time = false;
+        result.trials.reserve(planned_samples);
+        for (auto &slot : slots) {
+            if (!slot) {
+                stopped_for_wall_time = true;
+                break;
+            }
+            result.trials.push_back(std::move(*slot));
         }
+        objective_calls = calls.load(std::memory_order_relaxed);
 
         const auto end_time = std::chrono::steady_clock::now();
         result.optimizer_usage.objective_calls = objective_calls;
         result.optimizer_usage.iterations = result.trials.size();
         result.optimizer_usage.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
 
-        fill_success_result(result);
+        select_best_trial(result, "random search");
         if (stopped_for_wall_time) {
             result.status = RunStatus::BudgetExceeded;
             result.message = "wall-time budget exceeded";
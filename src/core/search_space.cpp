@@ -217,6 +217,8 @@ SearchSpace::get_effective_bounds(const ParameterSpace &space) const {
           eb.integer_bounds = descriptor.integer_range;
         }
       }
+    } else if (!descriptor.tuned_by_default) {
+      eb.mode = SearchMode::fixed;
     } else {
       eb.mode = SearchMode::optimize;
       if (descriptor.type == ParameterType::Boolean) {
@@ -237,11 +239,19 @@ std::size_t
 SearchSpace::get_optimization_dimension(const ParameterSpace &space) const {
   return static_cast<std::size_t>(std::ranges::count_if(
       space.descriptors(), [this](const auto &descriptor) {
-        const auto *config = get(descriptor.name);
-        return !config || config->mode == SearchMode::optimize;
+        return effective_mode(descriptor, get(descriptor.name)) ==
+               SearchMode::optimize;
       }));
 }
 
+SearchMode effective_mode(const ParameterDescriptor &descriptor,
+                          const ParameterConfig *config) noexcept {
+  if (config) {
+    return config->mode;
+  }
+  return descriptor.tuned_by_default ? SearchMode::optimize : SearchMode::fixed;
+}
+
 void validate_transform_bounds(ContinuousRange bounds, Transform transform) {
   if (bounds.lower > bounds.upper) {
     throw ParameterValidationError("invalid bounds: lower > upper");
@@ -0,0 +1,278 @@
+#include "hpoea/core/seed_repeats.hpp"
+
+#include "hpoea/core/error_classification.hpp"
+#include "hpoea/core/initial_population_cache.hpp"
+#include "hpoea/core/seeding.hpp"
+#include "hpoea/core/trial_runner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpoea::core {
+
+// lowest mean of the runs that reached max_repeats
+class SeedRepeatIncumbent {
+public:
+    [[nodiscard]] std::optional<double> value() const {
+        std::scoped_lock lock(mutex_);
+        return value_;
+    }
+
+    void offer(double mean) {
+        std::scoped_lock lock(mutex_);
+        if (!value_ || mean < *value_) {
+            value_ = mean;
+        }
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::optional<double> value_;
+};
+
+} // namespace hpoea::core
+
+namespace {
+
+using hpoea::core::Budget;
+using hpoea::core::EvolutionaryAlgorithmPtr;
+using hpoea::core::OptimizationResult;
+using hpoea::core::ParameterSet;
+using hpoea::core::RunStatus;
+using hpoea::core::SeedRepeatIncumbent;
+using hpoea::core::SeedRepeatPolicy;
+
+Budget scaled_budget(const Budget &budget, std::size_t runs) {
+    Budget total = budget;
+    if (total.function_evaluations.has_value()) {
+        *total.function_evaluations *= runs;
+    }
+    if (total.generations.has_value()) {
+        *total.generations *= runs;
+    }
+    return total;
+}
+
+class SeedRepeatAlgorithm final : public hpoea::core::IEvolutionaryAlgorithm {
+public:
+    SeedRepeatAlgorithm(std::vector<EvolutionaryAlgorithmPtr> algorithms,
+                        SeedRepeatPolicy policy,
+                        std::shared_ptr<SeedRepeatIncumbent> incumbent)
+        : algorithms_(std::move(algorithms)), policy_(policy), incumbent_(std::move(incumbent)) {
+        for (const auto &algorithm : algorithms_) {
+            if (!algorithm) {
+                throw std::runtime_error("seed repeat base factory returned a null algorithm");
+            }
+        }
+    }
+
+    [[nodiscard]] const hpoea::core::AlgorithmIdentity &identity() const noexcept override {
+        return algorithms_.front()->identity();
+    }
+
+    [[nodiscard]] const hpoea::core::ParameterSpace &parameter_space() const noexcept override {
+        return algorithms_.front()->parameter_space();
+    }
+
+    void configure(const ParameterSet &parameters) override {
+        for (auto &algorithm : algorithms_) {
+            algorithm->configure(parameters);
+        }
+        configured_parameters_ = parameters;
+    }
+
+    [[nodiscard]] OptimizationResult run(const hpoea::core::IProblem &problem, const Budget &budget,
+                                         unsigned long seed) override {
+        const auto start_time = std::chrono::steady_clock::now();
+        const auto workers = hpoea::core::resolve_worker_count(policy_.parallel_repeats);
+
+        OptimizationResult result;
+        result.status = RunStatus::Success;
+        result.seed = seed;
+
+        std::vector<OptimizationResult> runs;
+        std::size_t target = policy_.min_repeats;
+        std::optional<std::size_t> failed;
+        bool stopped_early = false;
+        double sum = 0.0;
+        for (;;) {
+            const auto first = runs.size();
+            runs.resize(target);
+            hpoea::core::run_indexed(
+                target - first, workers,
+                [&](std::size_t offset) {
+                    const auto r = first + offset;
+                    const auto repeat_seed =
+                        static_cast<unsigned long>(hpoea::core::derive_stream_seed(static_cast<std::uint64_t>(seed), r));
+                    auto &run = runs[r];
+                    try {
+                        run = algorithms_[r]->run(problem, budget, repeat_seed);
+                    } catch (const std::exception &ex) {
+                        const auto classified = hpoea::core::classify_exception(ex);
+                        run.status = classified.status;
+                        run.error_info = classified.error_info;
+                        run.message = ex.what();
+                        run.requested_budget = budget;
+                    }
+                    run.seed = repeat_seed;
+                },
+                [] { return false; });
+
+            for (auto r = first; r < target; ++r) {
+                if (!hpoea::core::is_selectable_run(runs[r])) {
+                    failed = r;
+                    break;
+                }
+                sum += runs[r].best_fitness;
+            }
+            if (failed || target == policy_.max_repeats) {
+                break;
+            }
+            const auto incumbent = incumbent_->value();
+            const auto mean = sum / static_cast<double>(target);
+            if (incumbent &&
+                mean > *incumbent + policy_.relative_margin * std::abs(*incumbent) + policy_.absolute_margin) {
+                stopped_early = true;
+                break;
+            }
+            target = std::min(target * 2u, policy_.max_repeats);
+        }
+
+        result.requested_budget = scaled_budget(budget, runs.size());
+        result.effective_budget = result.requested_budget;
+        result.effective_parameters =
+            runs.front().effective_parameters.empty() ? configured_parameters_ : runs.front().effective_parameters;
+        for (const auto &run : runs) {
+            result.algorithm_usage.function_evaluations += run.algorithm_usage.function_evaluations;
+            result.algorithm_usage.cached_function_evaluations += run.algorithm_usage.cached_function_evaluations;
+            result.algorithm_usage.generations += run.algorithm_usage.generations;
+            if (run.status == RunStatus::BudgetExceeded && !failed) {
+                result.status = RunStatus::BudgetExceeded;
+            }
+        }
+
+        if (failed) {
+            const auto &run = runs[*failed];
+            result.status = run.status != RunStatus::Success ? run.status
+                            : std::isfinite(run.best_fitness) ? RunStatus::BudgetExceeded
+                                                              : RunStatus::InternalError;
+            result.error_info = run.error_info;
+            result.message = "repeat " + std::to_string(*failed) + ": " +
+                             (run.message.empty() ? std::string{"run is not selectable"} : run.message);
+        } else {
+            result.best_fitness = sum / static_cast<double>(runs.size());
+            result.message = "mean of " + std::to_string(runs.size()) + " of up to " +
+                             std::to_string(policy_.max_repeats) + " runs";
+            if (stopped_early) {
+                result.message += ", behind the incumbent";
+            } else {
+                incumbent_->offer(result.best_fitness);
+            }
+        }
+
+        if (report_final_population_) {
+            auto final_population = std::make_shared<hpoea::core::InitialPopulation>();
+            final_population->parts.resize(algorithms_.size());
+            for (std::size_t i = 0; i < runs.size(); ++i) {
+                final_population->parts[i] = runs[i].final_population;
+            }
+            result.final_population = std::move(final_population);
+        }
+        result.repeat_results = std::move(runs);
+        result.algorithm_usage.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start_time);
+        return result;
+    }
+
+    void set_batch_evaluator(const hpoea::core::BatchEvaluatorConfig &config) override {
+        for (auto &algorithm : algorithms_) {
+            algorithm->set_batch_evaluator(config);
+        }
+    }
+
+    void set_initial_population_cache(std::shared_ptr<hpoea::core::InitialPopulationCache> cache) override {
+        for (auto &algorithm : algorithms_) {
+            algorithm->set_initial_population_cache(cache);
+        }
+    }
+
+    // start carries one part per repeat, see InitialPopulation::parts. true
+    // when every repeat accepted its part
+    bool set_warm_start(std::shared_ptr<const hpoea::core::InitialPopulation> start) override {
+        if (start && start->parts.size() != algorithms_.size()) {
+            return false;
+        }
+        bool accepted = true;
+        for (std::size_t i = 0; i < algorithms_.size(); ++i) {
+            accepted = algorithms_[i]->set_warm_start(start ? start->parts[i] : nullptr) && accepted;
+        }
+        report_final_population_ = accepted;
+        return accepted;
+    }
+
+    // every repeat reports as its own stream
+    void set_progress_callback(hpoea::core::ProgressCallback callback) override {
+        auto callbacks = hpoea::core::split_progress(std::move(callback), algorithms_.size());
+        for (std::size_t i = 0; i < algorithms_.size(); ++i) {
+            algorithms_[i]->set_progress_callback(std::move(callbacks[i]));
+        }
+    }
+
+    [[nodiscard]] EvolutionaryAlgorithmPtr clone() const override {
+        std::vector<EvolutionaryAlgorithmPtr> algorithms;
+        algorithms.reserve(algorithms_.size());
+        for (const auto &algorithm : algorithms_) {
+            algorithms.push_back(algorithm->clone());
+        }
+        auto copy = std::make_unique<SeedRepeatAlgorithm>(std::move(algorithms), policy_, incumbent_);
+        copy->configured_parameters_ = configured_parameters_;
+        copy->report_final_population_ = report_final_population_;
+        return copy;
+    }
+
+private:
+    std::vector<EvolutionaryAlgorithmPtr> algorithms_;
+    SeedRepeatPolicy policy_;
+    std::shared_ptr<SeedRepeatIncumbent> incumbent_;
+    ParameterSet configured_parameters_;
+    bool report_final_population_{false};
+};
+
+} // namespace
+
+namespace hpoea::core {
+
+SeedRepeatFactory::SeedRepeatFactory(const IEvolutionaryAlgorithmFactory &base_factory, SeedRepeatPolicy policy)
+    : base_factory_(base_factory), policy_(policy), incumbent_(std::make_shared<SeedRepeatIncumbent>()) {
+    if (policy_.min_repeats == 0) {
+        throw std::invalid_argument("seed repeats: min_repeats must be at least 1");
+    }
+    if (policy_.max_repeats < policy_.min_repeats) {
+        throw std::invalid_argument("seed repeats: max_repeats must not be below min_repeats");
+    }
+    if (!std::isfinite(policy_.relative_margin) || policy_.relative_margin < 0.0 ||
+        !std::isfinite(policy_.absolute_margin) || policy_.absolute_margin < 0.0) {
+        throw std::invalid_argument("seed repeats: margins must be finite and non-negative");
+    }
+}
+
+EvolutionaryAlgorithmPtr SeedRepeatFactory::create() const {
+    std::vector<EvolutionaryAlgorithmPtr> algorithms;
+    algorithms.reserve(policy_.max_repeats);
+    for (std::size_t r = 0; r < policy_.max_repeats; ++r) {
+        algorithms.push_back(base_factory_.create());
+    }
+    return std::make_unique<SeedRepeatAlgorithm>(std::move(algorithms), policy_, incumbent_);
+}
+
+} // namespace hpoea::core
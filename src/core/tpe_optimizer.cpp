@@ -0,0 +1,470 @@
+#include "hpoea/core/tpe_optimizer.hpp"
+
+#include "hpoea/core/budget_checks.hpp"
+#include "hpoea/core/error_classification.hpp"
+#include "hpoea/core/parameter_sampling.hpp"
+#include "hpoea/core/seeding.hpp"
+#include "hpoea/core/trial_runner.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace {
+
+constexpr const char *SAMPLE_COUNT = "sample_count";
+constexpr const char *INITIAL_SAMPLES = "initial_samples";
+constexpr const char *GAMMA = "gamma";
+constexpr const char *CANDIDATE_COUNT = "candidate_count";
+constexpr const char *PRIOR_WEIGHT = "prior_weight";
+constexpr const char *BATCH_SIZE = "batch_size";
+constexpr const char *PARALLEL_WORKERS = "parallel_workers";
+// keeps proposal streams apart from the inner run seeds
+constexpr std::uint64_t proposal_stream_salt = 0x1f83d9abfb41bd6bULL;
+constexpr double min_bandwidth = 0.01;
+
+hpoea::core::ParameterSpace make_parameter_space() {
+    hpoea::core::ParameterSpace space;
+
+    hpoea::core::ParameterDescriptor d;
+    d.name = SAMPLE_COUNT;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{0, 100000};
+    d.default_value = std::int64_t{0};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = INITIAL_SAMPLES;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{1, 10000};
+    d.default_value = std::int64_t{10};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = GAMMA;
+    d.type = hpoea::core::ParameterType::Continuous;
+    d.continuous_range = hpoea::core::ContinuousRange{0.01, 0.5};
+    d.default_value = 0.25;
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = CANDIDATE_COUNT;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{1, 10000};
+    d.default_value = std::int64_t{24};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = PRIOR_WEIGHT;
+    d.type = hpoea::core::ParameterType::Continuous;
+    d.continuous_range = hpoea::core::ContinuousRange{0.0, 100.0};
+    d.default_value = 1.0;
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = BATCH_SIZE;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{1, 256};
+    d.default_value = std::int64_t{1};
+    space.add_descriptor(d);
+
+    d = {};
+    d.name = PARALLEL_WORKERS;
+    d.type = hpoea::core::ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{0, 1024};
+    d.default_value = std::int64_t{1};
+    space.add_descriptor(d);
+
+    return space;
+}
+
+double normal_cdf(double x) {
+    return 0.5 * std::erfc(-x / std::numbers::sqrt2);
+}
+
+// good and bad parzen densities, kept up to date one observation at a time.
+// observations stay ranked by (value, arrival); only the few ranks around
+// the gamma boundary change sets on an insert, and each set keeps running
+// moments and choice counts, so add() costs the rank insert and O(d).
+class ParzenModel {
+public:
+    ParzenModel(std::vector<std::size_t> choices, double gamma, double prior_weight)
+        : choices_(std::move(choices)), gamma_(gamma), prior_weight_(prior_weight),
+          moments_(choices_.size()), counts_(choices_.size()) {
+        for (std::size_t k = 0; k < choices_.size(); ++k) {
+            counts_[k][0].assign(choices_[k], 0.0);
+            counts_[k][1].assign(choices_[k], 0.0);
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return values_.size(); }
+
+    void add(const std::vector<double> &point, double value) {
+        const auto id = values_.size();
+        points_.insert(points_.end(), point.begin(), point.end());
+        values_.push_back(value);
+        good_.push_back(0);
+        const auto position = std::upper_bound(ranked_.begin(), ranked_.end(), id, [&](std::size_t a, std::size_t b) {
+            return values_[a] < values_[b] || (values_[a] == values_[b] && a < b);
+        });
+        const auto rank_of_id = static_cast<std::size_t>(ranked_.insert(position, id) - ranked_.begin());
+        const auto boundary = good_count();
+        move_to_set(id, rank_of_id < boundary);
+        // ranks shift by one past the insert and the boundary moves by at most
+        // one, so only the two ranks straddling it can change sets
+        for (std::size_t rank = boundary == 0u ? 0u : boundary - 1u; rank < std::min(boundary + 1u, ranked_.size());
+             ++rank) {
+            move_to_set(ranked_[rank], rank < boundary);
+        }
+    }
+
+    // draws count candidates from the good density, dimension-major
+    void sample(std::size_t count, std::mt19937_64 &rng, std::vector<double> &out) const {
+        const auto dimension = choices_.size();
+        const auto good = good_count();
+        out.assign(dimension * count, 0.0);
+        std::uniform_real_distribution<double> unit{0.0, 1.0};
+        for (std::size_t k = 0; k < dimension; ++k) {
+            auto *row = out.data() + k * count;
+            if (choices_[k] != 0u) {
+                const auto &counts = counts_[k][1];
+                std::vector<double> weights(counts.size());
+                for (std::size_t c = 0; c < counts.size(); ++c) {
+                    weights[c] = counts[c] + prior_weight_ / static_cast<double>(counts.size());
+                }
+                std::discrete_distribution<std::size_t> pick(weights.begin(), weights.end());
+                for (std::size_t j = 0; j < count; ++j) {
+                    row[j] = (static_cast<double>(pick(rng)) + 0.5) / static_cast<double>(choices_[k]);
+                }
+                continue;
+            }
+            const auto h = bandwidth(k, true);
+            std::uniform_real_distribution<double> component{0.0, static_cast<double>(good) + prior_weight_};
+            for (std::size_t j = 0; j < count; ++j) {
+                const auto u = component(rng);
+                if (u < prior_weight_ || good == 0u) {
+                    row[j] = unit(rng);
+                    continue;
+                }
+                const auto center = coordinate(ranked_[std::min(static_cast<std::size_t>(u - prior_weight_), good - 1u)], k);
+                std::normal_distribution<double> kernel{center, h};
+                double x = kernel(rng);
+                for (int attempt = 0; attempt < 16 && (x < 0.0 || x > 1.0); ++attempt) {
+                    x = kernel(rng);
+                }
+                row[j] = std::clamp(x, 0.0, 1.0);
+            }
+        }
+    }
+
+    // log l(x) - log g(x) for dimension-major candidates.
+    // loops run kernel-outer, candidate-inner over contiguous rows.
+    void score(const std::vector<double> &candidates, std::size_t count, std::vector<double> &out) const {
+        out.assign(count, 0.0);
+        std::vector<double> density(count);
+        const auto good = good_count();
+        for (std::size_t k = 0; k < choices_.size(); ++k) {
+            const auto *row = candidates.data() + k * count;
+            for (const bool in_good : {true, false}) {
+                const auto sign = in_good ? 1.0 : -1.0;
+                const auto members = in_good ? good : values_.size() - good;
+                const auto normalizer = static_cast<double>(members) + prior_weight_;
+                if (choices_[k] != 0u) {
+                    const auto &counts = counts_[k][in_good ? 1 : 0];
+                    const auto prior = prior_weight_ / static_cast<double>(choices_[k]);
+                    for (std::size_t j = 0; j < count; ++j) {
+                        const auto c = std::min(static_cast<std::size_t>(row[j] * static_cast<double>(choices_[k])),
+                                                choices_[k] - 1u);
+                        out[j] += sign * std::log((counts[c] + prior + 1e-300) / (normalizer + 1e-300));
+                    }
+                    continue;
+                }
+                const auto h = bandwidth(k, in_good);
+                std::fill(density.begin(), density.end(), prior_weight_);
+                const auto first = in_good ? 0u : good;
+                const auto last = in_good ? good : values_.size();
+                for (std::size_t rank = first; rank < last; ++rank) {
+                    const auto center = coordinate(ranked_[rank], k);
+                    const auto mass = normal_cdf((1.0 - center) / h) - normal_cdf(-center / h);
+                    const auto coefficient = 1.0 / (h * std::sqrt(2.0 * std::numbers::pi) * std::max(mass, 1e-12));
+                    const auto inverse = 1.0 / h;
+                    for (std::size_t j = 0; j < count; ++j) {
+                        const auto z = (row[j] - center) * inverse;
+                        density[j] += coefficient * std::exp(-0.5 * z * z);
+                    }
+                }
+                for (std::size_t j = 0; j < count; ++j) {
+                    out[j] += sign * std::log((density[j] + 1e-300) / (normalizer + 1e-300));
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] double worst_finite() const {
+        for (auto it = ranked_.rbegin(); it != ranked_.rend(); ++it) {
+            if (std::isfinite(values_[*it])) {
+                return values_[*it];
+            }
+        }
+        return std::numeric_limits<double>::infinity();
+    }
+
+private:
+    struct Moments {
+        double count{0.0};
+        double sum{0.0};
+        double sum_squares{0.0};
+    };
+
+    [[nodiscard]] std::size_t good_count() const {
+        return std::min(values_.size(), static_cast<std::size_t>(std::ceil(gamma_ * static_cast<double>(values_.size()))));
+    }
+
+    [[nodiscard]] double coordinate(std::size_t id, std::size_t k) const { return points_[id * choices_.size() + k]; }
+
+    void move_to_set(std::size_t id, bool good) {
+        // 0 new, 1 bad, 2 good
+        auto &state = good_[id];
+        const auto target = static_cast<char>(good ? 2 : 1);
+        if (state == target) {
+            return;
+        }
+        for (std::size_t k = 0; k < choices_.size(); ++k) {
+            const auto x = coordinate(id, k);
+            if (state != 0) {
+                update(k, x, state == 2, -1.0);
+            }
+            update(k, x, good, 1.0);
+        }
+        state = target;
+    }
+
+    void update(std::size_t k, double x, bool good, double weight) {
+        if (choices_[k] != 0u) {
+            const auto c = std::min(static_cast<std::size_t>(x * static_cast<double>(choices_[k])), choices_[k] - 1u);
+            counts_[k][good ? 1 : 0][c] += weight;
+            return;
+        }
+        auto &m = moments_[k][good ? 1 : 0];
+        m.count += weight;
+        m.sum += weight * x;
+        m.sum_squares += weight * x * x;
+    }
+
+    // scott's rule on the set's spread, floored so a tight set stays smooth
+    [[nodiscard]] double bandwidth(std::size_t k, bool good) const {
+        const auto &m = moments_[k][good ? 1 : 0];
+        if (m.count < 2.0) {
+            return 0.5;
+        }
+        const auto mean = m.sum / m.count;
+        const auto variance = std::max(m.sum_squares / m.count - mean * mean, 0.0);
+        const auto h = std::sqrt(variance) * std::pow(m.count, -0.2);
+        return std::clamp(h, min_bandwidth, 1.0);
+    }
+
+    std::vector<std::size_t> choices_;
+    double gamma_;
+    double prior_weight_;
+    std::vector<double> points_;
+    std::vector<double> values_;
+    std::vector<std::size_t> ranked_;
+    std::vector<char> good_;
+    // index 0 bad, 1 good
+    std::vector<std::array<Moments, 2>> moments_;
+    std::vector<std::array<std::vector<double>, 2>> counts_;
+};
+
+} // namespace
+
+namespace hpoea::core {
+
+TpeOptimizer::TpeOptimizer()
+    : HyperOptimizerBase(make_parameter_space(), {"TPE", "parzen_estimator", "1.0"}) {}
+
+HyperparameterOptimizationResult TpeOptimizer::optimize(const IEvolutionaryAlgorithmFactory &algorithm_factory,
+                                                        const IProblem &problem,
+                                                        const Budget &optimizer_budget,
+                                                        const Budget &algorithm_budget, unsigned long seed) {
+
+    HyperparameterOptimizationResult result;
+    result.status = RunStatus::InternalError;
+    result.seed = seed;
+    result.effective_optimizer_parameters = configured_parameters_;
+
+    const auto start_time = std::chrono::steady_clock::now();
+
+    try {
+        const auto &algorithm_space = algorithm_factory.parameter_space();
+        if (algorithm_space.empty()) {
+            throw std::invalid_argument("algorithm has no tunable parameters");
+        }
+        if (search_space_) {
+            search_space_->validate(algorithm_space);
+        }
+        if (!has_tunable_dimension(algorithm_space, search_space_.get())) {
+            throw ParameterValidationError(
+                "all parameters are fixed or excluded; use BaselineOptimizer for fixed/default runs");
+        }
+        if (optimizer_budget.generations.has_value()) {
+            throw std::invalid_argument(
+                "tpe does not consume a generations budget; use optimizer_budget.function_evaluations");
+        }
+
+        const auto configured_samples = count_parameter(configured_parameters_, SAMPLE_COUNT);
+        std::size_t planned_samples = configured_samples;
+        if (configured_samples == 0u) {
+            if (!optimizer_budget.function_evaluations.has_value()) {
+                throw std::invalid_argument(
+                    "tpe sample_count is 0 and no optimizer_budget.function_evaluations is set; "
+                    "set sample_count or provide a function_evaluations budget");
+            }
+            planned_samples = *optimizer_budget.function_evaluations;
+        } else if (optimizer_budget.function_evaluations.has_value()) {
+            planned_samples = std::min(planned_samples, *optimizer_budget.function_evaluations);
+        }
+        if (planned_samples == 0u) {
+            const auto end_time = std::chrono::steady_clock::now();
+            result.status = RunStatus::BudgetExceeded;
+            result.message = "optimizer budget allows zero tpe samples";
+            result.optimizer_usage.wall_time =
+                std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+            return result;
+        }
+
+        const UnitCubeEncoding encoding(algorithm_space, search_space_.get());
+        const auto dimension = encoding.dimension();
+        std::vector<std::size_t> choices(dimension);
+        for (std::size_t k = 0; k < dimension; ++k) {
+            choices[k] = encoding.choices(k);
+        }
+        const auto initial_samples = count_parameter(configured_parameters_, INITIAL_SAMPLES);
+        const auto candidate_count = std::max<std::size_t>(count_parameter(configured_parameters_, CANDIDATE_COUNT), 1u);
+        const auto batch_size = std::max<std::size_t>(count_parameter(configured_parameters_, BATCH_SIZE), 1u);
+        const auto workers = parallel_workers(configured_parameters_);
+        ParzenModel model(choices, real_parameter(configured_parameters_, GAMMA),
+                          real_parameter(configured_parameters_, PRIOR_WEIGHT));
+
+        // earlier trials enter the densities as observations and count toward initial_samples
+        for (const auto &prior : prior_trials(algorithm_factory, problem)) {
+            model.add(*encoding.encode(prior.parameters), prior.objective);
+        }
+
+        const auto proposal_seed = static_cast<std::uint64_t>(seed) ^ proposal_stream_salt;
+        // one stream per proposal, so a proposal depends only on the trials before it
+        const auto propose = [&](const ParzenModel &current, std::size_t trial_index) {
+            std::mt19937_64 rng{derive_stream_seed(proposal_seed, trial_index)};
+            std::vector<double> point(dimension);
+            if (current.size() < initial_samples) {
+                std::uniform_real_distribution<double> unit{0.0, 1.0};
+                for (std::size_t k = 0; k < dimension; ++k) {
+                    point[k] = choices[k] == 0u
+                                   ? unit(rng)
+                                   : (static_cast<double>(std::uniform_int_distribution<std::size_t>{
+                                          0, choices[k] - 1u}(rng)) +
+                                      0.5) / static_cast<double>(choices[k]);
+                }
+                return point;
+            }
+            std::vector<double> candidates;
+            std::vector<double> scores;
+            current.sample(candidate_count, rng, candidates);
+            current.score(candidates, candidate_count, scores);
+            const auto best = static_cast<std::size_t>(std::max_element(scores.begin(), scores.end()) - scores.begin());
+            for (std::size_t k = 0; k < dimension; ++k) {
+                point[k] = candidates[k * candidate_count + best];
+            }
+            return point;
+        };
+
+        const auto pruner = make_trial_pruner();
+        std::atomic<std::size_t> calls{0};
+        const auto run_point = [&](const std::vector<double> &point, std::size_t trial_index) {
+            const auto trial_seed =
+                static_cast<unsigned long>(derive_stream_seed(static_cast<std::uint64_t>(seed), trial_index));
+            bool started = false;
+            auto trial = run_trial(algorithm_factory, problem, algorithm_budget, trial_seed, trial_index,
+                                   [&] { return encoding.decode(point); }, &started, trial_progress(pruner));
+            if (started) {
+                calls.fetch_add(1, std::memory_order_relaxed);
+            }
+            return trial;
+        };
+        const WallTimeLimit wall_time_spent{optimizer_budget, start_time};
+
+        bool stopped_for_wall_time = false;
+        result.trials.reserve(planned_samples);
+        while (result.trials.size() < planned_samples) {
+            if (wall_time_spent()) {
+                stopped_for_wall_time = true;
+                break;
+            }
+            const auto first_index = result.trials.size();
+            const auto count = std::min(batch_size, planned_samples - first_index);
+
+            // constant liar: pending proposals count as the worst result so far
+            std::vector<std::vector<double>> batch;
+            std::optional<ParzenModel> liar;
+            for (std::size_t q = 0; q < count; ++q) {
+                batch.push_back(propose(liar ? *liar : model, first_index + q));
+                if (q + 1 < count) {
+                    if (!liar) {
+                        liar = model;
+                    }
+                    liar->add(batch.back(), model.worst_finite());
+                }
+            }
+
+            std::vector<std::optional<HyperparameterTrialRecord>> slots(batch.size());
+            run_indexed(
+                batch.size(), workers,
+                [&](std::size_t i) { slots[i] = run_point(batch[i], first_index + i); }, wall_time_spent);
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                if (!slots[i]) {
+                    stopped_for_wall_time = true;
+                    break;
+                }
+                model.add(batch[i], observed_objective(*slots[i]).value_or(std::numeric_limits<double>::infinity()));
+                result.trials.push_back(std::move(*slots[i]));
+            }
+            if (stopped_for_wall_time) {
+                break;
+            }
+        }
+
+        const auto end_time = std::chrono::steady_clock::now();
+        result.optimizer_usage.objective_calls = calls.load(std::memory_order_relaxed);
+        result.optimizer_usage.iterations = result.trials.size();
+        result.optimizer_usage.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+        select_best_trial(result, "tpe");
+        if (stopped_for_wall_time) {
+            result.status = RunStatus::BudgetExceeded;
+            result.message = "wall-time budget exceeded";
+        }
+        apply_optimizer_budget_status(optimizer_budget, result.optimizer_usage, result.status, result.message);
+    } catch (const std::exception &ex) {
+        const auto end_time = std::chrono::steady_clock::now();
+        const auto classified = classify_exception(ex);
+        result.status = classified.status;
+        result.error_info = classified.error_info;
+        result.message = ex.what();
+        result.optimizer_usage.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+    }
+
+    return result;
+}
+
+} // namespace hpoea::core
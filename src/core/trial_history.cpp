@@ -0,0 +1,822 @@
+#include "hpoea/core/trial_history.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <variant>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// file layout, native byte order:
+//   header   magic, key count, record count, reserved          4 x 8 bytes
+//   keys     name offset, name length, first record, count    4 x 8 bytes each
+//   records  objective, payload offset, payload length        3 x 8 bytes each
+//   blob     key names and parameter payloads; offsets are relative to it
+constexpr std::array<char, 8> file_magic{'H', 'P', 'O', 'E', 'A', 'T', 'H', '1'};
+constexpr std::size_t header_size = 32;
+constexpr std::size_t key_entry_size = 32;
+constexpr std::size_t record_entry_size = 24;
+
+// payload value tags
+constexpr std::uint8_t tag_double = 0;
+constexpr std::uint8_t tag_integer = 1;
+constexpr std::uint8_t tag_boolean = 2;
+constexpr std::uint8_t tag_string = 3;
+
+std::string key_text(const hpoea::core::HistoryKey &key) {
+    // unit separators keep the fields apart whatever they contain
+    std::string text;
+    for (const auto *field : {&key.algorithm.family, &key.algorithm.implementation, &key.algorithm.version,
+                              &key.problem_id}) {
+        text += std::to_string(field->size());
+        text += '\x1f';
+        text += *field;
+    }
+    text += std::to_string(key.space_fingerprint);
+    return text;
+}
+
+void put_word(std::string &out, std::uint64_t value) {
+    char buf[sizeof(value)];
+    std::memcpy(buf, &value, sizeof(value));
+    out.append(buf, sizeof(buf));
+}
+
+void put_text(std::string &out, std::string_view text) {
+    put_word(out, text.size());
+    out.append(text);
+}
+
+// parameters sorted by name, so equal sets encode equally
+std::string encode_parameters(const hpoea::core::ParameterSet &parameters) {
+    std::vector<const std::pair<const std::string, hpoea::core::ParameterValue> *> ordered;
+    ordered.reserve(parameters.size());
+    for (const auto &entry : parameters) {
+        ordered.push_back(&entry);
+    }
+    std::sort(ordered.begin(), ordered.end(), [](const auto *a, const auto *b) { return a->first < b->first; });
+
+    std::string out;
+    put_word(out, ordered.size());
+    for (const auto *entry : ordered) {
+        put_text(out, entry->first);
+        std::visit(
+            [&](const auto &v) {
+                using V = std::decay_t<decltype(v)>;
+                if constexpr (std::is_same_v<V, double>) {
+                    out += static_cast<char>(tag_double);
+                    std::uint64_t bits = 0;
+                    std::memcpy(&bits, &v, sizeof(bits));
+                    put_word(out, bits);
+                } else if constexpr (std::is_same_v<V, std::int64_t>) {
+                    out += static_cast<char>(tag_integer);
+                    put_word(out, static_cast<std::uint64_t>(v));
+                } else if constexpr (std::is_same_v<V, bool>) {
+                    out += static_cast<char>(tag_boolean);
+                    out += static_cast<char>(v ? 1 : 0);
+                } else {
+                    out += static_cast<char>(tag_string);
+                    put_text(out, v);
+                }
+            },
+            entry->second);
+    }
+    return out;
+}
+
+[[noreturn]] void corrupt(const std::string &what) {
+    throw std::runtime_error("corrupt trial history: " + what);
+}
+
+// bounds-checked reads from a byte range
+class Reader {
+public:
+    Reader(const char *data, std::size_t size) : data_(data), size_(size) {}
+
+    std::uint64_t word() {
+        need(sizeof(std::uint64_t));
+        std::uint64_t value = 0;
+        std::memcpy(&value, data_ + at_, sizeof(value));
+        at_ += sizeof(value);
+        return value;
+    }
+
+    std::uint8_t byte() {
+        need(1);
+        return static_cast<std::uint8_t>(data_[at_++]);
+    }
+
+    std::string text() {
+        const auto length = word();
+        need(length);
+        std::string value(data_ + at_, static_cast<std::size_t>(length));
+        at_ += static_cast<std::size_t>(length);
+        return value;
+    }
+
+private:
+    void need(std::uint64_t count) const {
+        if (count > size_ - at_) {
+            corrupt("payload ends early");
+        }
+    }
+
+    const char *data_;
+    std::size_t size_;
+    std::size_t at_{0};
+};
+
+hpoea::core::ParameterSet decode_parameters(const char *data, std::size_t size) {
+    Reader reader(data, size);
+    const auto count = reader.word();
+    if (count > size) {
+        corrupt("parameter count out of range");
+    }
+    hpoea::core::ParameterSet parameters;
+    parameters.reserve(static_cast<std::size_t>(count));
+    for (std::uint64_t i = 0; i < count; ++i) {
+        auto name = reader.text();
+        switch (reader.byte()) {
+        case tag_double: {
+            const auto bits = reader.word();
+            double value = 0.0;
+            std::memcpy(&value, &bits, sizeof(value));
+            parameters.emplace(std::move(name), value);
+            break;
+        }
+        case tag_integer:
+            parameters.emplace(std::move(name), static_cast<std::int64_t>(reader.word()));
+            break;
+        case tag_boolean:
+            parameters.emplace(std::move(name), reader.byte() != 0u);
+            break;
+        case tag_string:
+            parameters.emplace(std::move(name), reader.text());
+            break;
+        default:
+            corrupt("unknown value tag");
+        }
+    }
+    return parameters;
+}
+
+// the subset of json a run log uses
+struct JsonValue {
+    enum class Kind { Null, Boolean, Integer, Real, String, Array, Object };
+    Kind kind{Kind::Null};
+    bool boolean{false};
+    std::int64_t integer{0};
+    double real{0.0};
+    std::string string;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> members;
+
+    [[nodiscard]] const JsonValue *find(std::string_view name) const {
+        for (const auto &[key, value] : members) {
+            if (key == name) {
+                return &value;
+            }
+        }
+        return nullptr;
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(std::string_view text) : text_(text) {}
+
+    JsonValue parse() {
+        auto value = parse_value(0);
+        skip_space();
+        if (at_ != text_.size()) {
+            fail("trailing characters");
+        }
+        return value;
+    }
+
+private:
+    static constexpr std::size_t max_depth = 64;
+
+    [[noreturn]] void fail(const std::string &what) const {
+        throw std::runtime_error("malformed json at offset " + std::to_string(at_) + ": " + what);
+    }
+
+    void skip_space() {
+        while (at_ < text_.size() &&
+               (text_[at_] == ' ' || text_[at_] == '\t' || text_[at_] == '\r' || text_[at_] == '\n')) {
+            ++at_;
+        }
+    }
+
+    bool consume(std::string_view token) {
+        if (text_.substr(at_, token.size()) == token) {
+            at_ += token.size();
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char ch) {
+        skip_space();
+        if (at_ >= text_.size() || text_[at_] != ch) {
+            fail(std::string("expected '") + ch + "'");
+        }
+        ++at_;
+    }
+
+    JsonValue parse_value(std::size_t depth) {
+        if (depth > max_depth) {
+            fail("nesting too deep");
+        }
+        skip_space();
+        if (at_ >= text_.size()) {
+            fail("unexpected end");
+        }
+        JsonValue value;
+        const auto ch = text_[at_];
+        if (ch == '{') {
+            ++at_;
+            value.kind = JsonValue::Kind::Object;
+            skip_space();
+            if (at_ < text_.size() && text_[at_] == '}') {
+                ++at_;
+                return value;
+            }
+            while (true) {
+                skip_space();
+                auto name = parse_string();
+                expect(':');
+                value.members.emplace_back(std::move(name), parse_value(depth + 1));
+                skip_space();
+                if (at_ < text_.size() && text_[at_] == ',') {
+                    ++at_;
+                    continue;
+                }
+                expect('}');
+                return value;
+            }
+        }
+        if (ch == '[') {
+            ++at_;
+            value.kind = JsonValue::Kind::Array;
+            skip_space();
+            if (at_ < text_.size() && text_[at_] == ']') {
+                ++at_;
+                return value;
+            }
+            while (true) {
+                value.items.push_back(parse_value(depth + 1));
+                skip_space();
+                if (at_ < text_.size() && text_[at_] == ',') {
+                    ++at_;
+                    continue;
+                }
+                expect(']');
+                return value;
+            }
+        }
+        if (ch == '"') {
+            value.kind = JsonValue::Kind::String;
+            value.string = parse_string();
+            return value;
+        }
+        if (consume("null")) {
+            return value;
+        }
+        if (consume("true")) {
+            value.kind = JsonValue::Kind::Boolean;
+            value.boolean = true;
+            return value;
+        }
+        if (consume("false")) {
+            value.kind = JsonValue::Kind::Boolean;
+            return value;
+        }
+        return parse_number();
+    }
+
+    JsonValue parse_number() {
+        const auto begin = at_;
+        bool integral = true;
+        while (at_ < text_.size()) {
+            const auto c = text_[at_];
+            if (c == '.' || c == 'e' || c == 'E') {
+                integral = false;
+            } else if (!(c == '-' || c == '+' || (c >= '0' && c <= '9'))) {
+                break;
+            }
+            ++at_;
+        }
+        const auto *first = text_.data() + begin;
+        const auto *last = text_.data() + at_;
+        JsonValue value;
+        if (integral) {
+            value.kind = JsonValue::Kind::Integer;
+            if (std::from_chars(first, last, value.integer).ptr == last) {
+                return value;
+            }
+        }
+        value.kind = JsonValue::Kind::Real;
+        const auto parsed = std::from_chars(first, last, value.real);
+        if (first == last || parsed.ec != std::errc{} || parsed.ptr != last) {
+            fail("bad number");
+        }
+        return value;
+    }
+
+    std::string parse_string() {
+        if (at_ >= text_.size() || text_[at_] != '"') {
+            fail("expected string");
+        }
+        ++at_;
+        std::string out;
+        while (at_ < text_.size() && text_[at_] != '"') {
+            const auto c = text_[at_++];
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (at_ >= text_.size()) {
+                break;
+            }
+            const auto escape = text_[at_++];
+            switch (escape) {
+            case '"':
+            case '\\':
+            case '/':
+                out += escape;
+                break;
+            case 'b':
+                out += '\b';
+                break;
+            case 'f':
+                out += '\f';
+                break;
+            case 'n':
+                out += '\n';
+                break;
+            case 'r':
+                out += '\r';
+                break;
+            case 't':
+                out += '\t';
+                break;
+            case 'u': {
+                unsigned code = 0;
+                if (at_ + 4 > text_.size() ||
+                    std::from_chars(text_.data() + at_, text_.data() + at_ + 4, code, 16).ptr !=
+                        text_.data() + at_ + 4) {
+                    fail("bad unicode escape");
+                }
+                at_ += 4;
+                // the logger only escapes control characters; others pass as utf-8
+                if (code < 0x80) {
+                    out += static_cast<char>(code);
+                } else if (code < 0x800) {
+                    out += static_cast<char>(0xc0 | (code >> 6));
+                    out += static_cast<char>(0x80 | (code & 0x3f));
+                } else {
+                    out += static_cast<char>(0xe0 | (code >> 12));
+                    out += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+                    out += static_cast<char>(0x80 | (code & 0x3f));
+                }
+                break;
+            }
+            default:
+                fail("bad escape");
+            }
+        }
+        if (at_ >= text_.size()) {
+            fail("unterminated string");
+        }
+        ++at_;
+        return out;
+    }
+
+    std::string_view text_;
+    std::size_t at_{0};
+};
+
+const std::string *string_member(const JsonValue &object, std::string_view name) {
+    const auto *value = object.find(name);
+    return value && value->kind == JsonValue::Kind::String ? &value->string : nullptr;
+}
+
+std::optional<hpoea::core::ParameterValue> parameter_value(const JsonValue &value) {
+    switch (value.kind) {
+    case JsonValue::Kind::Boolean:
+        return value.boolean;
+    case JsonValue::Kind::Integer:
+        return value.integer;
+    case JsonValue::Kind::Real:
+        return value.real;
+    case JsonValue::Kind::String:
+        return value.string;
+    default:
+        return std::nullopt;
+    }
+}
+
+} // namespace
+
+namespace hpoea::core {
+
+// a read-only view of a whole file
+class TrialHistory::MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path &path) : path_(path) {
+#if defined(_WIN32)
+        file_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("failed to open trial history: " + path.string());
+        }
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file_, &size)) {
+            CloseHandle(file_);
+            throw std::runtime_error("failed to read trial history size: " + path.string());
+        }
+        size_ = static_cast<std::size_t>(size.QuadPart);
+        if (size_ > 0u) {
+            mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            const void *view = mapping_ ? MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+            if (!view) {
+                if (mapping_) {
+                    CloseHandle(mapping_);
+                }
+                CloseHandle(file_);
+                throw std::runtime_error("failed to map trial history: " + path.string());
+            }
+            data_ = static_cast<const char *>(view);
+        }
+#else
+        const auto fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("failed to open trial history: " + path.string());
+        }
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("failed to read trial history size: " + path.string());
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+        if (size_ > 0u) {
+            void *view = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("failed to map trial history: " + path.string());
+            }
+            data_ = static_cast<const char *>(view);
+        }
+        // the mapping outlives the descriptor
+        ::close(fd);
+#endif
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile() {
+#if defined(_WIN32)
+        if (data_) {
+            UnmapViewOfFile(data_);
+            CloseHandle(mapping_);
+        }
+        CloseHandle(file_);
+#else
+        if (data_) {
+            ::munmap(const_cast<char *>(data_), size_);
+        }
+#endif
+    }
+
+    [[nodiscard]] const std::filesystem::path &path() const noexcept { return path_; }
+    [[nodiscard]] const char *data() const noexcept { return data_; }
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    [[nodiscard]] std::uint64_t word(std::size_t offset) const {
+        std::uint64_t value = 0;
+        std::memcpy(&value, data_ + offset, sizeof(value));
+        return value;
+    }
+
+    // set by open() once the header checked out
+    std::size_t records_at{0};
+    std::size_t record_count{0};
+    std::size_t blob_at{0};
+
+    [[nodiscard]] double objective(std::size_t record) const {
+        double value = 0.0;
+        const auto bits = word(records_at + record * record_entry_size);
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    [[nodiscard]] HistoryTrial trial(std::size_t record) const {
+        const auto entry = records_at + record * record_entry_size;
+        const auto offset = word(entry + 8);
+        const auto length = word(entry + 16);
+        const auto blob_size = size_ - blob_at;
+        if (offset > blob_size || length > blob_size - offset) {
+            corrupt("payload out of range");
+        }
+        return {decode_parameters(data_ + blob_at + offset, static_cast<std::size_t>(length)), objective(record)};
+    }
+
+private:
+    std::filesystem::path path_;
+#if defined(_WIN32)
+    HANDLE file_{INVALID_HANDLE_VALUE};
+    HANDLE mapping_{nullptr};
+#endif
+    const char *data_{nullptr};
+    std::size_t size_{0};
+};
+
+std::uint64_t search_space_fingerprint(const ParameterSpace &space, const SearchSpace *search_space) {
+    Fnv1a hash;
+    for (const auto &descriptor : space.descriptors()) {
+        hash.text(descriptor.name);
+        hash.word(static_cast<std::uint64_t>(descriptor.type));
+        const auto *config = search_space ? search_space->get(descriptor.name) : nullptr;
+        const auto mode = effective_mode(descriptor, config);
+        hash.word(static_cast<std::uint64_t>(mode));
+        if (mode == SearchMode::exclude) {
+            continue;
+        }
+        if (mode == SearchMode::fixed) {
+            if (config && config->fixed_value) {
+                hash.value(*config->fixed_value);
+            }
+            continue;
+        }
+        if (config && !config->discrete_choices.empty()) {
+            hash.word(config->discrete_choices.size());
+            for (const auto &choice : config->discrete_choices) {
+                hash.value(choice);
+            }
+            continue;
+        }
+        switch (descriptor.type) {
+        case ParameterType::Continuous: {
+            const auto range = config && config->continuous_bounds ? *config->continuous_bounds
+                                                                   : descriptor.continuous_range.value_or(ContinuousRange{});
+            hash.real(range.lower);
+            hash.real(range.upper);
+            hash.word(static_cast<std::uint64_t>(config ? config->transform : Transform::none));
+            break;
+        }
+        case ParameterType::Integer: {
+            const auto range = config && config->integer_bounds ? *config->integer_bounds
+                                                                : descriptor.integer_range.value_or(IntegerRange{});
+            hash.word(static_cast<std::uint64_t>(range.lower));
+            hash.word(static_cast<std::uint64_t>(range.upper));
+            break;
+        }
+        case ParameterType::Boolean:
+            break;
+        case ParameterType::Categorical:
+            hash.word(descriptor.categorical_choices.size());
+            for (const auto &choice : descriptor.categorical_choices) {
+                hash.text(choice);
+            }
+            break;
+        }
+    }
+    return hash.digest();
+}
+
+TrialHistory::TrialHistory() = default;
+
+void TrialHistory::add(const HistoryKey &key, ParameterSet parameters, double objective) {
+    if (!std::isfinite(objective)) {
+        return;
+    }
+    buckets_[key_text(key)].added.push_back({std::move(parameters), objective});
+    ++size_;
+}
+
+std::size_t TrialHistory::load_jsonl(const std::filesystem::path &path, std::uint64_t space_fingerprint) {
+    std::ifstream stream(path);
+    if (!stream.is_open()) {
+        throw std::runtime_error("failed to open run log: " + path.string());
+    }
+    std::size_t added = 0;
+    std::size_t line_number = 0;
+    std::string line;
+    while (std::getline(stream, line)) {
+        ++line_number;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        JsonValue record;
+        try {
+            record = JsonParser(line).parse();
+        } catch (const std::runtime_error &ex) {
+            throw std::runtime_error(path.string() + ":" + std::to_string(line_number) + ": " + ex.what());
+        }
+        const auto *phase = string_member(record, "phase");
+        const auto *status = string_member(record, "status");
+        const auto *problem_id = string_member(record, "problem_id");
+        const auto *algorithm = record.find("evolutionary_algorithm");
+        const auto *parameters = record.find("algorithm_parameters");
+        const auto *objective = record.find("objective_value");
+        if (!phase || *phase != "tuning" || !status || (*status != "success" && *status != "budget_exceeded") ||
+            !problem_id || !algorithm || !parameters || parameters->kind != JsonValue::Kind::Object ||
+            !objective) {
+            continue;
+        }
+        double value = 0.0;
+        if (objective->kind == JsonValue::Kind::Real) {
+            value = objective->real;
+        } else if (objective->kind == JsonValue::Kind::Integer) {
+            value = static_cast<double>(objective->integer);
+        } else {
+            continue;
+        }
+
+        HistoryKey key;
+        const auto *family = string_member(*algorithm, "family");
+        const auto *implementation = string_member(*algorithm, "implementation");
+        const auto *version = string_member(*algorithm, "version");
+        if (!family || !implementation || !version) {
+            continue;
+        }
+        key.algorithm = {*family, *implementation, *version};
+        key.problem_id = *problem_id;
+        key.space_fingerprint = space_fingerprint;
+
+        // whole-valued doubles log without a fraction, so they read back as
+        // integers; optimizers convert them against the parameter space
+        ParameterSet set;
+        bool complete = true;
+        for (const auto &[name, member] : parameters->members) {
+            auto parsed = parameter_value(member);
+            if (!parsed) {
+                complete = false;
+                break;
+            }
+            set.emplace(name, std::move(*parsed));
+        }
+        if (!complete || !std::isfinite(value)) {
+            continue;
+        }
+        add(key, std::move(set), value);
+        ++added;
+    }
+    if (stream.bad()) {
+        throw std::runtime_error("failed to read run log: " + path.string());
+    }
+    return added;
+}
+
+void TrialHistory::save(const std::filesystem::path &path) const {
+    std::string keys;
+    std::string records;
+    std::string blob;
+    std::uint64_t record_count = 0;
+    for (const auto &[text, bucket] : buckets_) {
+        std::vector<HistoryTrial> trials;
+        trials.reserve(bucket.mapped_count + bucket.added.size());
+        for (std::size_t i = 0; i < bucket.mapped_count; ++i) {
+            trials.push_back(file_->trial(bucket.mapped_first + i));
+        }
+        trials.insert(trials.end(), bucket.added.begin(), bucket.added.end());
+        std::stable_sort(trials.begin(), trials.end(),
+                         [](const auto &a, const auto &b) { return a.objective < b.objective; });
+
+        put_word(keys, blob.size());
+        put_word(keys, text.size());
+        put_word(keys, record_count);
+        put_word(keys, trials.size());
+        blob += text;
+        for (const auto &trial : trials) {
+            const auto payload = encode_parameters(trial.parameters);
+            std::uint64_t bits = 0;
+            std::memcpy(&bits, &trial.objective, sizeof(bits));
+            put_word(records, bits);
+            put_word(records, blob.size());
+            put_word(records, payload.size());
+            blob += payload;
+        }
+        record_count += trials.size();
+    }
+
+#if defined(_WIN32)
+    // windows cannot replace a file while it is mapped
+    std::error_code ec;
+    if (file_ && std::filesystem::equivalent(path, file_->path(), ec)) {
+        throw std::invalid_argument("cannot save a trial history over the file it maps: " + path.string());
+    }
+#endif
+
+    // written beside path and renamed over it, so a failed save leaves the
+    // old file and a history mapping path keeps reading its old contents
+    auto temp_path = path;
+    temp_path += ".tmp";
+    {
+        std::ofstream stream(temp_path, std::ios::binary | std::ios::trunc);
+        if (!stream.is_open()) {
+            throw std::runtime_error("failed to open trial history for writing: " + temp_path.string());
+        }
+        std::string header(file_magic.begin(), file_magic.end());
+        put_word(header, buckets_.size());
+        put_word(header, record_count);
+        put_word(header, 0);
+        stream.write(header.data(), static_cast<std::streamsize>(header.size()));
+        stream.write(keys.data(), static_cast<std::streamsize>(keys.size()));
+        stream.write(records.data(), static_cast<std::streamsize>(records.size()));
+        stream.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+        stream.flush();
+        if (!stream.good()) {
+            throw std::runtime_error("failed to write trial history: " + temp_path.string());
+        }
+    }
+    std::filesystem::rename(temp_path, path);
+}
+
+TrialHistory TrialHistory::open(const std::filesystem::path &path) {
+    auto file = std::make_shared<MappedFile>(path);
+    if (file->size() < header_size || std::memcmp(file->data(), file_magic.data(), file_magic.size()) != 0) {
+        corrupt("missing header in " + path.string());
+    }
+    const auto key_count = file->word(8);
+    const auto record_count = file->word(16);
+    const auto available = file->size() - header_size;
+    if (key_count > available / key_entry_size ||
+        record_count > (available - key_count * key_entry_size) / record_entry_size) {
+        corrupt("tables exceed " + path.string());
+    }
+    file->records_at = header_size + static_cast<std::size_t>(key_count) * key_entry_size;
+    file->record_count = static_cast<std::size_t>(record_count);
+    file->blob_at = file->records_at + file->record_count * record_entry_size;
+    const auto blob_size = file->size() - file->blob_at;
+
+    TrialHistory history;
+    for (std::size_t k = 0; k < key_count; ++k) {
+        const auto entry = header_size + k * key_entry_size;
+        const auto name_offset = file->word(entry);
+        const auto name_length = file->word(entry + 8);
+        const auto first = file->word(entry + 16);
+        const auto count = file->word(entry + 24);
+        if (name_offset > blob_size || name_length > blob_size - name_offset || first > record_count ||
+            count > record_count - first) {
+            corrupt("key " + std::to_string(k) + " out of range in " + path.string());
+        }
+        auto &bucket = history.buckets_[std::string(file->data() + file->blob_at + name_offset,
+                                                    static_cast<std::size_t>(name_length))];
+        if (bucket.mapped_count != 0u) {
+            corrupt("duplicate key in " + path.string());
+        }
+        bucket.mapped_first = static_cast<std::size_t>(first);
+        bucket.mapped_count = static_cast<std::size_t>(count);
+        history.size_ += bucket.mapped_count;
+    }
+    history.file_ = std::move(file);
+    return history;
+}
+
+std::vector<HistoryTrial> TrialHistory::best(const HistoryKey &key, std::size_t count) const {
+    const auto it = buckets_.find(key_text(key));
+    if (it == buckets_.end() || count == 0u) {
+        return {};
+    }
+    const auto &bucket = it->second;
+
+    // mapped trials are sorted already, so at most count of them can make the cut
+    std::vector<HistoryTrial> trials;
+    const auto mapped = std::min(count, bucket.mapped_count);
+    trials.reserve(mapped + bucket.added.size());
+    for (std::size_t i = 0; i < mapped; ++i) {
+        trials.push_back(file_->trial(bucket.mapped_first + i));
+    }
+    trials.insert(trials.end(), bucket.added.begin(), bucket.added.end());
+    std::stable_sort(trials.begin(), trials.end(),
+                     [](const auto &a, const auto &b) { return a.objective < b.objective; });
+    if (trials.size() > count) {
+        trials.resize(count);
+    }
+    return trials;
+}
+
+} // namespace hpoea::core
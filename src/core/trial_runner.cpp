@@ -0,0 +1,246 @@
+#include "hpoea/core/trial_runner.hpp"
+
+#include "hpoea/core/error_classification.hpp"
+#include "hpoea/core/pruning.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace {
+
+void mark_non_finite_success(hpoea::core::OptimizationResult &result) {
+    if (result.status != hpoea::core::RunStatus::Success || std::isfinite(result.best_fitness)) {
+        return;
+    }
+    result.status = hpoea::core::RunStatus::InternalError;
+    result.error_info =
+        hpoea::core::ErrorInfo{"internal_error", "non_finite_objective", "algorithm returned non-finite objective"};
+    if (result.message.empty()) {
+        result.message = "algorithm returned non-finite objective";
+    }
+}
+
+} // namespace
+
+namespace hpoea::core {
+
+HyperparameterTrialRecord run_trial(const IEvolutionaryAlgorithmFactory &algorithm_factory,
+                                    const IProblem &problem,
+                                    const Budget &algorithm_budget,
+                                    unsigned long seed,
+                                    std::size_t trial_index,
+                                    const std::function<ParameterSet()> &parameters,
+                                    bool *started,
+                                    ProgressCallback progress,
+                                    const std::function<void(IEvolutionaryAlgorithm &)> &prepare) {
+    const auto trial_start = std::chrono::steady_clock::now();
+    HyperparameterTrialRecord trial;
+    trial.trial_index = trial_index;
+    if (started) {
+        *started = false;
+    }
+
+    try {
+        trial.parameters = parameters();
+        auto algorithm = algorithm_factory.create();
+        algorithm->configure(trial.parameters);
+        if (progress) {
+            algorithm->set_progress_callback(std::move(progress));
+        }
+        if (prepare) {
+            prepare(*algorithm);
+        }
+        if (started) {
+            *started = true;
+        }
+        trial.optimization_result = algorithm->run(problem, algorithm_budget, seed);
+        trial.optimization_result.seed = seed;
+        mark_non_finite_success(trial.optimization_result);
+    } catch (const std::exception &ex) {
+        const auto trial_end = std::chrono::steady_clock::now();
+        const auto classified = classify_exception(ex);
+        trial.optimization_result.status = classified.status;
+        trial.optimization_result.error_info = classified.error_info;
+        trial.optimization_result.message = ex.what();
+        trial.optimization_result.seed = seed;
+        trial.optimization_result.algorithm_usage.wall_time =
+            std::chrono::duration_cast<std::chrono::milliseconds>(trial_end - trial_start);
+    }
+    return trial;
+}
+
+ProgressCallback trial_progress(const std::shared_ptr<TrialPruner> &pruner) {
+    return pruner ? pruner->monitor() : ProgressCallback{};
+}
+
+std::vector<ProgressCallback> split_progress(ProgressCallback callback, std::size_t count) {
+    if (!callback) {
+        return std::vector<ProgressCallback>(count);
+    }
+    struct Shared {
+        ProgressCallback callback;
+        std::mutex mutex;
+        bool stopped{false};
+    };
+    auto shared = std::make_shared<Shared>();
+    shared->callback = std::move(callback);
+    std::vector<ProgressCallback> callbacks;
+    callbacks.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        callbacks.emplace_back([shared, i, count](const ProgressReport &report) {
+            std::scoped_lock lock(shared->mutex);
+            if (shared->stopped) {
+                return false;
+            }
+            // a nested wrapper's streams stay apart
+            auto tagged = report;
+            tagged.stream = report.stream * count + i;
+            shared->stopped = !shared->callback(tagged);
+            return !shared->stopped;
+        });
+    }
+    return callbacks;
+}
+
+void select_best_trial(HyperparameterOptimizationResult &result, std::string_view optimizer_name) {
+    const std::string name{optimizer_name};
+    auto best = result.trials.end();
+    for (auto it = result.trials.begin(); it != result.trials.end(); ++it) {
+        if (!is_selectable_trial(*it)) {
+            continue;
+        }
+        if (best == result.trials.end() ||
+            it->optimization_result.best_fitness < best->optimization_result.best_fitness) {
+            best = it;
+        }
+    }
+
+    if (best != result.trials.end()) {
+        result.status = RunStatus::Success;
+        result.best_parameters = best->parameters;
+        result.best_objective = best->optimization_result.best_fitness;
+        result.error_info = std::nullopt;
+        result.message = name + " completed";
+        return;
+    }
+
+    if (!result.trials.empty()) {
+        const auto &first = result.trials.front().optimization_result;
+        result.status = first.status;
+        result.best_objective = std::numeric_limits<double>::infinity();
+        result.error_info = first.error_info;
+        result.message = first.message.empty() ? name + " produced no successful finite trial" : first.message;
+        return;
+    }
+
+    result.status = RunStatus::InternalError;
+    result.best_objective = std::numeric_limits<double>::infinity();
+    result.error_info = ErrorInfo{"internal_error", "no_valid_trial", name + " produced no trial"};
+    result.message = name + " produced no trial";
+}
+
+std::size_t resolve_worker_count(std::size_t configured) noexcept {
+    if (configured == 0u) {
+        return std::max<std::size_t>(std::thread::hardware_concurrency(), 1u);
+    }
+    return configured;
+}
+
+std::size_t count_parameter(const ParameterSet &parameters, const std::string &name) {
+    const auto it = parameters.find(name);
+    if (it == parameters.end()) {
+        throw std::invalid_argument("missing parameter: " + name);
+    }
+    if (!std::holds_alternative<std::int64_t>(it->second)) {
+        throw std::invalid_argument("parameter '" + name + "' type mismatch");
+    }
+    const auto value = std::get<std::int64_t>(it->second);
+    if (value < 0) {
+        throw std::invalid_argument("parameter '" + name + "' cannot be negative");
+    }
+    return static_cast<std::size_t>(value);
+}
+
+double real_parameter(const ParameterSet &parameters, const std::string &name) {
+    const auto it = parameters.find(name);
+    if (it == parameters.end() || !std::holds_alternative<double>(it->second)) {
+        throw std::invalid_argument("missing parameter: " + name);
+    }
+    return std::get<double>(it->second);
+}
+
+std::size_t parallel_workers(const ParameterSet &parameters) {
+    constexpr const char *PARALLEL_WORKERS = "parallel_workers";
+    if (!parameters.contains(PARALLEL_WORKERS)) {
+        return 1u;
+    }
+    return resolve_worker_count(count_parameter(parameters, PARALLEL_WORKERS));
+}
+
+void run_indexed(std::size_t count,
+                 std::size_t workers,
+                 const std::function<void(std::size_t)> &job,
+                 const std::function<bool()> &stop) {
+    workers = std::min(workers, count);
+    if (workers <= 1u) {
+        for (std::size_t index = 0; index < count; ++index) {
+            if (stop()) {
+                return;
+            }
+            job(index);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next_index{0};
+    std::atomic<bool> stopped{false};
+    std::mutex error_mutex;
+    std::exception_ptr worker_error;
+    const auto work = [&] {
+        try {
+            while (!stopped.load(std::memory_order_relaxed)) {
+                if (stop()) {
+                    stopped.store(true, std::memory_order_relaxed);
+                    break;
+                }
+                const auto index = next_index.fetch_add(1, std::memory_order_relaxed);
+                if (index >= count) {
+                    break;
+                }
+                job(index);
+            }
+        } catch (...) {
+            stopped.store(true, std::memory_order_relaxed);
+            std::scoped_lock lock(error_mutex);
+            if (!worker_error) {
+                worker_error = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        threads.emplace_back(work);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    if (worker_error) {
+        std::rethrow_exception(worker_error);
+    }
+}
+
+} // namespace hpoea::core
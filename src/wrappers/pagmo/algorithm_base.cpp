@@ -1,5 +1,6 @@
 #include "hpoea/wrappers/pagmo/algorithm_base.hpp"
 
+#include <stdexcept>
 #include <utility>
 
 namespace hpoea::pagmo_wrappers {
@@ -15,6 +16,39 @@ void PagmoAlgorithmBase::configure(const core::ParameterSet &parameters) {
     parameter_space_.validate(configured_parameters_);
 }
 
+void PagmoAlgorithmBase::set_checkpoint_policy(std::optional<core::CheckpointPolicy> policy) {
+    if (policy) {
+        if (policy->path.empty()) {
+            throw std::invalid_argument("checkpoint path must not be empty");
+        }
+        if (policy->every_generations && *policy->every_generations == 0) {
+            throw std::invalid_argument("checkpoint every_generations must be positive");
+        }
+    }
+    run_options_.checkpoint = std::move(policy);
+}
+
+void PagmoAlgorithmBase::set_batch_evaluator(const core::BatchEvaluatorConfig &config) {
+    if (config.kind == core::BatchEvaluatorKind::Custom && !config.evaluate) {
+        throw std::invalid_argument("custom batch evaluator requires an evaluate function");
+    }
+    run_options_.batch_evaluator = config;
+}
+
+void PagmoAlgorithmBase::set_initial_population_cache(std::shared_ptr<core::InitialPopulationCache> cache) {
+    run_options_.initial_population_cache = std::move(cache);
+}
+
+void PagmoAlgorithmBase::set_progress_callback(core::ProgressCallback callback) {
+    run_options_.progress = std::move(callback);
+}
+
+bool PagmoAlgorithmBase::set_warm_start(std::shared_ptr<const core::InitialPopulation> start) {
+    run_options_.warm_start = std::move(start);
+    run_options_.report_final_population = true;
+    return true;
+}
+
 PagmoAlgorithmFactoryBase::PagmoAlgorithmFactoryBase(core::ParameterSpace space,
                                                      core::AlgorithmIdentity identity)
     : parameter_space_(std::move(space)),
@@ -4,8 +4,11 @@
 #include "hpoea/core/error_classification.hpp"
 #include "hpoea/core/evolution_algorithm.hpp"
 #include "hpoea/core/parameters.hpp"
+#include "hpoea/core/point_sequence.hpp"
 #include "hpoea/core/seeding.hpp"
 #include "hpoea/core/types.hpp"
+#include "hpoea/wrappers/pagmo/algorithm_base.hpp"
+#include "checkpoint.hpp"
 #include "problem_adapter.hpp"
 
 #include <algorithm>
@@ -15,8 +18,12 @@
 #include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <pagmo/algorithm.hpp>
+#include <pagmo/batch_evaluators/member_bfe.hpp>
+#include <pagmo/batch_evaluators/thread_bfe.hpp>
+#include <pagmo/bfe.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/problem.hpp>
 #include <random>
@@ -24,6 +31,7 @@
 #include <string>
 #include <type_traits>
 #include <variant>
+#include <vector>
 
 namespace hpoea::pagmo_wrappers {
 
@@ -138,12 +146,398 @@ inline void apply_budget_status(const core::Budget &budget,
                                                status, message);
 }
 
+// what run_population asks a wrapper's algorithm builder for
+struct AlgorithmRequest {
+    unsigned generations{0};
+    unsigned seed32{0};
+    // evolved one generation per call, or continued by a later warm
+    // start, so it must keep its adaptation state between calls (pagmo's
+    // memory on) and the calls add up to one evolve() over all of them. a
+    // run evolves only once, so the configured memory flag changes nothing
+    // within a single run either
+    bool stepped{false};
+    // set when generations should be batch evaluated
+    const pagmo::bfe *bfe{nullptr};
+};
+
+// nullopt for BatchEvaluatorKind::None.
+// custom evaluators run through ProblemAdapter::batch_fitness.
+inline std::optional<pagmo::bfe> make_batch_evaluator(const core::BatchEvaluatorConfig &config) {
+    switch (config.kind) {
+        case core::BatchEvaluatorKind::None:
+            return std::nullopt;
+        case core::BatchEvaluatorKind::Thread:
+            return pagmo::bfe{pagmo::thread_bfe{}};
+        case core::BatchEvaluatorKind::Custom:
+            return pagmo::bfe{pagmo::member_bfe{}};
+    }
+    return std::nullopt;
+}
+
+// reads population_init, uniform when the space has no such parameter
+inline core::PointSequenceKind population_init_kind(const core::ParameterSet &params) {
+    if (params.find("population_init") == params.end()) {
+        return core::PointSequenceKind::Uniform;
+    }
+    const auto name = get_param<std::string>(params, "population_init");
+    const auto kind = core::parse_point_sequence_kind(name);
+    if (!kind) {
+        throw std::invalid_argument("unknown population_init: " + name);
+    }
+    return *kind;
+}
+
+// population_size individuals spread over the problem's bounds per kind.
+// uniform defers to pagmo so existing seeds keep their populations; the
+// other kinds draw from a PointSequence seeded from seed32. evaluated
+// through bfe when given, one point at a time otherwise. the first
+// individuals are taken from seeds when given, e.g. earlier trials; a
+// seeded uniform population draws the rest from a uniform PointSequence.
+inline pagmo::population make_population(const pagmo::problem &pg_problem,
+                                         std::size_t population_size,
+                                         unsigned seed32,
+                                         core::PointSequenceKind kind,
+                                         const pagmo::bfe *bfe = nullptr,
+                                         const std::vector<pagmo::vector_double> &seeds = {}) {
+    if (kind == core::PointSequenceKind::Uniform && seeds.empty()) {
+        return bfe ? pagmo::population{pg_problem, *bfe, population_size, seed32}
+                   : pagmo::population{pg_problem, population_size, seed32};
+    }
+
+    pagmo::population population{pg_problem, 0u, seed32};
+    const auto [lower, upper] = pg_problem.get_bounds();
+    const auto nx = static_cast<std::size_t>(pg_problem.get_nx());
+    core::PointSequence sequence{kind, nx, population_size, core::derive_stream_seed(seed32, 0)};
+    const auto next_point = [&](std::size_t i, pagmo::vector_double &x) {
+        if (i < seeds.size()) {
+            x = seeds[i];
+        } else {
+            sequence.next_in_box(lower, upper, x);
+        }
+    };
+
+    if (bfe == nullptr) {
+        pagmo::vector_double x(nx);
+        for (std::size_t i = 0; i < population_size; ++i) {
+            next_point(i, x);
+            population.push_back(x);
+        }
+        return population;
+    }
+
+    pagmo::vector_double dvs(nx * population_size);
+    pagmo::vector_double x(nx);
+    for (std::size_t i = 0; i < population_size; ++i) {
+        next_point(i, x);
+        std::copy(x.begin(), x.end(), dvs.begin() + static_cast<std::ptrdiff_t>(i * nx));
+    }
+    const auto fvs = (*bfe)(population.get_problem(), dvs);
+    const auto nf = static_cast<std::size_t>(pg_problem.get_nf());
+    for (std::size_t i = 0; i < population_size; ++i) {
+        const auto xb = dvs.begin() + static_cast<std::ptrdiff_t>(i * nx);
+        const auto fb = fvs.begin() + static_cast<std::ptrdiff_t>(i * nf);
+        population.push_back(pagmo::vector_double(xb, xb + static_cast<std::ptrdiff_t>(nx)),
+                             pagmo::vector_double(fb, fb + static_cast<std::ptrdiff_t>(nf)));
+    }
+    return population;
+}
+
+// evaluates population_size points drawn with pop_seed, or takes them
+// from the options' cache. the result always comes from the drawn points
+// so hits and misses evolve identically; cached evaluations are still
+// charged to the population's feval count and reported through reused.
+template <typename MakePopulation>
+inline pagmo::population make_shared_population(
+    const PopulationRunOptions &options,
+    const core::IProblem &problem,
+    const pagmo::problem &pg_problem,
+    std::size_t population_size,
+    unsigned pop_seed,
+    core::PointSequenceKind init_kind,
+    MakePopulation &&make_population,
+    std::size_t &reused) {
+    if (!options.initial_population_cache) {
+        return make_population(pop_seed);
+    }
+    auto &cache = *options.initial_population_cache;
+    const auto shared_seed = derive_seed32(cache.seed_for(population_size), 0);
+    bool built = false;
+    const auto shared = cache.get_or_build(problem, population_size, static_cast<std::size_t>(init_kind), [&] {
+        const auto fresh = make_population(shared_seed);
+        core::InitialPopulation initial;
+        initial.decision_vectors.reserve(fresh.size());
+        initial.fitness.reserve(fresh.size());
+        for (std::size_t i = 0; i < fresh.size(); ++i) {
+            initial.decision_vectors.push_back(fresh.get_x()[i]);
+            initial.fitness.push_back(fresh.get_f()[i].front());
+        }
+        return initial;
+    }, &built);
+
+    pagmo::population population{pg_problem, 0u, shared_seed};
+    for (std::size_t i = 0; i < shared->decision_vectors.size(); ++i) {
+        population.push_back(shared->decision_vectors[i], pagmo::vector_double{shared->fitness[i]});
+    }
+    population.get_problem().increment_fevals(shared->fitness.size());
+    reused = built ? 0u : shared->fitness.size();
+    return population;
+}
+
+// population_size individuals continuing from start: its best ones keep
+// their fitness and are charged like cache hits through reused, and a
+// start smaller than population_size is topped up with points drawn per
+// kind, evaluated as usual
+inline pagmo::population make_warm_population(const pagmo::problem &pg_problem,
+                                              const core::InitialPopulation &start,
+                                              std::size_t population_size,
+                                              unsigned seed32,
+                                              core::PointSequenceKind kind,
+                                              std::size_t &reused) {
+    const auto nx = static_cast<std::size_t>(pg_problem.get_nx());
+    if (start.decision_vectors.size() != start.fitness.size()) {
+        throw std::invalid_argument("warm start population has mismatched fitness values");
+    }
+    std::vector<std::size_t> order(start.fitness.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        if (start.decision_vectors[i].size() != nx) {
+            throw std::invalid_argument("warm start population does not match the problem dimension");
+        }
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&](std::size_t a, std::size_t b) { return start.fitness[a] < start.fitness[b]; });
+    const auto carried = std::min(order.size(), population_size);
+
+    pagmo::population population{pg_problem, 0u, seed32};
+    for (std::size_t i = 0; i < carried; ++i) {
+        population.push_back(start.decision_vectors[order[i]], pagmo::vector_double{start.fitness[order[i]]});
+    }
+    population.get_problem().increment_fevals(carried);
+    reused = carried;
+
+    if (carried < population_size) {
+        const auto [lower, upper] = pg_problem.get_bounds();
+        core::PointSequence sequence{kind, nx, population_size - carried, core::derive_stream_seed(seed32, 0)};
+        pagmo::vector_double x(nx);
+        for (auto i = carried; i < population_size; ++i) {
+            sequence.next_in_box(lower, upper, x);
+            population.push_back(x);
+        }
+    }
+    return population;
+}
+
+// the individuals of a resumed run's population in their order, so
+// per-individual adaptation state of the resumed algorithm still lines
+// up. charged like make_warm_population's carried individuals.
+inline pagmo::population resume_population(const pagmo::problem &pg_problem,
+                                           const pagmo::population &from,
+                                           unsigned seed32,
+                                           std::size_t &reused) {
+    pagmo::population population{pg_problem, 0u, seed32};
+    for (std::size_t i = 0; i < from.size(); ++i) {
+        population.push_back(from.get_x()[i], from.get_f()[i]);
+    }
+    population.get_problem().increment_fevals(from.size());
+    reused = from.size();
+    return population;
+}
+
+// the evaluated individuals of population, in population order
+inline std::shared_ptr<core::InitialPopulation> snapshot_population(const pagmo::population &population) {
+    auto snapshot = std::make_shared<core::InitialPopulation>();
+    snapshot->decision_vectors = population.get_x();
+    snapshot->fitness.reserve(population.size());
+    for (const auto &f : population.get_f()) {
+        snapshot->fitness.push_back(f.front());
+    }
+    return snapshot;
+}
+
+// reports the population's best-so-far; true when the run may go on
+inline bool report_progress(const core::ProgressCallback &progress,
+                            const pagmo::population &population,
+                            std::size_t generations) {
+    if (!progress) {
+        return true;
+    }
+    core::ProgressReport report;
+    report.function_evaluations = read_fevals(population, population.size() * (generations + 1));
+    report.generations = generations;
+    if (population.size() > 0) {
+        report.best_fitness = population.champion_f().front();
+    }
+    return progress(report);
+}
+
+// follows a one-shot evolve through its evaluations, so the evolve (and
+// pagmo's memory semantics) stay as they are. every wrapped algorithm
+// evaluates population_size points per generation, so after arm() each
+// population_size-th evaluation closes a generation: the watch reports it
+// with the best point so far and ends the evolve by throwing RunStopped
+// once the callback prunes or the deadline has passed.
+class GenerationWatch {
+public:
+    GenerationWatch(core::ProgressCallback progress,
+                    std::optional<std::chrono::steady_clock::time_point> deadline,
+                    std::size_t population_size)
+        : progress_(std::move(progress)), deadline_(deadline), population_size_(population_size) {}
+
+    // starts from the evaluated initial population, reported as generation
+    // 0. false when the run should not evolve at all
+    bool arm(const pagmo::population &population) {
+        std::scoped_lock lock(mutex_);
+        fevals_ = read_fevals(population, population.size());
+        if (population.size() > 0) {
+            best_fitness_ = population.champion_f().front();
+            best_solution_ = population.champion_x();
+        }
+        armed_ = true;
+        return proceed();
+    }
+
+    void observe(const pagmo::vector_double &decision_vector, double fitness) {
+        std::scoped_lock lock(mutex_);
+        if (!armed_ || stopped_) {
+            return;
+        }
+        ++fevals_;
+        if (fitness < best_fitness_) {
+            best_fitness_ = fitness;
+            best_solution_ = decision_vector;
+        }
+        if (++in_generation_ < population_size_) {
+            return;
+        }
+        in_generation_ = 0;
+        ++generations_;
+        if (!proceed()) {
+            throw RunStopped{};
+        }
+    }
+
+    [[nodiscard]] bool stopped() const { return stopped_; }
+    [[nodiscard]] bool pruned() const { return pruned_; }
+    [[nodiscard]] std::size_t function_evaluations() const { return fevals_; }
+    [[nodiscard]] double best_fitness() const { return best_fitness_; }
+    [[nodiscard]] const pagmo::vector_double &best_solution() const { return best_solution_; }
+
+private:
+    bool proceed() {
+        if (progress_) {
+            core::ProgressReport report;
+            report.function_evaluations = fevals_;
+            report.generations = generations_;
+            report.best_fitness = best_fitness_;
+            if (!progress_(report)) {
+                pruned_ = stopped_ = true;
+                return false;
+            }
+        }
+        if (deadline_ && std::chrono::steady_clock::now() >= *deadline_) {
+            stopped_ = true;
+            return false;
+        }
+        return true;
+    }
+
+    core::ProgressCallback progress_;
+    std::optional<std::chrono::steady_clock::time_point> deadline_;
+    std::size_t population_size_;
+    std::mutex mutex_;
+    bool armed_{false};
+    bool stopped_{false};
+    bool pruned_{false};
+    std::size_t fevals_{0};
+    std::size_t generations_{0};
+    std::size_t in_generation_{0};
+    double best_fitness_{std::numeric_limits<double>::infinity()};
+    pagmo::vector_double best_solution_;
+};
+
+struct SteppedEvolution {
+    pagmo::algorithm algorithm;
+    pagmo::population population;
+    std::chrono::milliseconds restored_wall_time{0};
+    bool pruned{false};
+};
+
+// evolves one generation per step and saves the state per the policy.
+// resumes from the policy's file when it holds this run's state; the
+// initial population is only built (and evaluated) on a fresh start.
+template <typename InitialPopulation>
+inline SteppedEvolution evolve_with_checkpoints(
+    const core::CheckpointPolicy &policy,
+    const ProblemAdapter &adapter,
+    const core::Budget &budget,
+    std::size_t generations,
+    const std::shared_ptr<std::atomic<std::size_t>> &eval_counter,
+    pagmo::algorithm algorithm,
+    const std::string &fingerprint,
+    InitialPopulation &&make_initial_population,
+    const core::ProgressCallback &progress = {}) {
+    using clock = std::chrono::steady_clock;
+    const auto session_start = clock::now();
+
+    PopulationState state;
+    if (auto restored = load_population_state(policy.path)) {
+        if (restored->fingerprint != fingerprint) {
+            throw std::invalid_argument("checkpoint " + policy.path.string() + " belongs to a different run");
+        }
+        rebind_population_problem(restored->population, adapter);
+        eval_counter->store(static_cast<std::size_t>(restored->population.get_problem().get_fevals()),
+                            std::memory_order_relaxed);
+        state = std::move(*restored);
+    } else {
+        state.fingerprint = fingerprint;
+        state.algorithm = std::move(algorithm);
+        state.population = make_initial_population();
+        save_population_state(policy.path, state);
+    }
+
+    const auto restored_wall_time = state.wall_time;
+    const auto elapsed = [&] {
+        return restored_wall_time +
+               std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - session_start);
+    };
+    const bool every_step = !policy.every_generations && !policy.every_wall_time;
+
+    auto last_write = clock::now();
+    std::size_t since_write = 0;
+    bool pruned = !report_progress(progress, state.population, state.generations_done);
+    while (!pruned && state.generations_done < generations) {
+        if (budget.wall_time && elapsed() >= *budget.wall_time) {
+            break;
+        }
+        state.population = state.algorithm.evolve(state.population);
+        ++state.generations_done;
+        ++since_write;
+        pruned = !report_progress(progress, state.population, state.generations_done);
+
+        const bool generations_due = policy.every_generations && since_write >= *policy.every_generations;
+        const bool time_due = policy.every_wall_time && clock::now() - last_write >= *policy.every_wall_time;
+        if (every_step || generations_due || time_due) {
+            state.wall_time = elapsed();
+            save_population_state(policy.path, state);
+            last_write = clock::now();
+            since_write = 0;
+        }
+    }
+    if (since_write > 0) {
+        state.wall_time = elapsed();
+        save_population_state(policy.path, state);
+    }
+
+    return SteppedEvolution{std::move(state.algorithm), std::move(state.population), restored_wall_time, pruned};
+}
+
 template <typename AlgorithmBuilder>
 inline core::OptimizationResult run_population(
     const core::IProblem &problem,
     const core::Budget &budget,
     const core::ParameterSet &configured_parameters,
     unsigned long seed,
+    const PopulationRunOptions &options,
     AlgorithmBuilder &&make_algorithm) {
     core::OptimizationResult result;
     result.status = core::RunStatus::InternalError;
@@ -154,13 +548,11 @@ inline core::OptimizationResult run_population(
     // so the catch path can still recover the fevals
     auto eval_counter = std::make_shared<std::atomic<std::size_t>>(0);
     std::size_t population_size = 0;
+    std::size_t reused_fevals = 0;
 
     try {
-        static_assert(std::is_invocable_r_v<pagmo::algorithm,
-                                             AlgorithmBuilder,
-                                             unsigned,
-                                             unsigned>,
-                      "AlgorithmBuilder must be callable as pagmo::algorithm(unsigned generations, unsigned seed32)");
+        static_assert(std::is_invocable_r_v<pagmo::algorithm, AlgorithmBuilder, const AlgorithmRequest &>,
+                      "AlgorithmBuilder must be callable as pagmo::algorithm(const AlgorithmRequest &)");
 
         population_size = get_param<std::int64_t>(configured_parameters, "population_size");
 
@@ -169,26 +561,105 @@ inline core::OptimizationResult run_population(
         const auto algo_seed = to_seed32(seed);
         const auto pop_seed = derive_seed32(seed, 0);
         constexpr auto uint_max = static_cast<std::size_t>(std::numeric_limits<unsigned>::max());
-        pagmo::algorithm algorithm = make_algorithm(
-            static_cast<unsigned>(std::min(generations, uint_max)), algo_seed);
-        pagmo::problem pg_problem{ProblemAdapter{problem, eval_counter}};
-        pagmo::population population{pg_problem, population_size, pop_seed};
+        const auto bfe = make_batch_evaluator(options.batch_evaluator);
+        ProblemAdapter adapter{problem, eval_counter,
+                               options.batch_evaluator.kind == core::BatchEvaluatorKind::Custom
+                                   ? options.batch_evaluator.evaluate
+                                   : core::BatchEvaluateFn{}};
+        // a checkpointed run steps and checks both between its steps
+        std::shared_ptr<GenerationWatch> watch;
+        if (!options.checkpoint && (options.progress || budget.wall_time)) {
+            std::optional<std::chrono::steady_clock::time_point> deadline;
+            if (budget.wall_time) {
+                deadline = start_time + *budget.wall_time;
+            }
+            watch = std::make_shared<GenerationWatch>(options.progress, deadline, population_size);
+            adapter.set_observer([watch](const pagmo::vector_double &x, double f) { watch->observe(x, f); });
+        }
+        pagmo::problem pg_problem{adapter};
+        const auto init_kind = population_init_kind(configured_parameters);
 
-        if (generations > 0) {
-            population = algorithm.evolve(population);
+        // a run that reports its final population keeps its algorithm's
+        // state for the next warm start, and a warm start from the same
+        // configuration resumes that algorithm with its individuals
+        const bool stepped = options.checkpoint.has_value();
+        pagmo::algorithm algorithm = make_algorithm(AlgorithmRequest{
+            stepped ? 1u : static_cast<unsigned>(std::min(generations, uint_max)), algo_seed,
+            stepped || options.report_final_population, bfe ? &*bfe : nullptr});
+        std::string continuation;
+        std::optional<PopulationState> resumed;
+        if (options.report_final_population) {
+            continuation = continuation_fingerprint(problem, configured_parameters, budget, algorithm.get_name(),
+                                                    stepped);
+            if (options.warm_start && !options.warm_start->state.empty()) {
+                auto state = decode_population_state(options.warm_start->state);
+                if (state.fingerprint == continuation && state.population.size() == population_size) {
+                    algorithm = std::move(state.algorithm);
+                    resumed = std::move(state);
+                }
+            }
         }
-        const auto end_time = std::chrono::steady_clock::now();
+        const auto make_initial_population = [&] {
+            if (resumed) {
+                return resume_population(pg_problem, resumed->population, pop_seed, reused_fevals);
+            }
+            if (options.warm_start) {
+                return make_warm_population(pg_problem, *options.warm_start, population_size, pop_seed, init_kind,
+                                            reused_fevals);
+            }
+            return make_shared_population(
+                options, problem, pg_problem, population_size, pop_seed, init_kind,
+                [&](unsigned seed32) {
+                    return make_population(pg_problem, population_size, seed32, init_kind, bfe ? &*bfe : nullptr);
+                },
+                reused_fevals);
+        };
+        pagmo::population population;
+        std::chrono::milliseconds restored_wall_time{0};
+        bool pruned = false;
 
-        const auto &champion_f = population.champion_f();
-        if (champion_f.empty()) {
-            throw std::runtime_error("pagmo population has empty champion fitness");
+        if (stepped) {
+            const auto fingerprint = run_fingerprint(problem, configured_parameters, budget, seed,
+                                                     algorithm.get_name());
+            auto evolution = evolve_with_checkpoints(
+                *options.checkpoint, adapter, budget, generations, eval_counter, std::move(algorithm), fingerprint,
+                make_initial_population, options.progress);
+            algorithm = std::move(evolution.algorithm);
+            population = std::move(evolution.population);
+            restored_wall_time = evolution.restored_wall_time;
+            pruned = evolution.pruned;
+        } else {
+            population = make_initial_population();
+            const bool go_on = !watch || watch->arm(population);
+            if (generations > 0 && go_on) {
+                try {
+                    population = algorithm.evolve(population);
+                } catch (const RunStopped &) {
+                }
+            }
+            pruned = watch && watch->pruned();
         }
+        const auto end_time = std::chrono::steady_clock::now();
+        // a stopped evolve leaves no population behind; the watch kept its
+        // best point and evaluation count
+        const bool stopped = watch && watch->stopped();
 
-        result.best_fitness = champion_f[0];
-        result.best_solution = population.champion_x();
-        result.algorithm_usage.function_evaluations = read_fevals(
-            population,
-            population_size * (generations + 1));
+        if (stopped) {
+            result.best_fitness = watch->best_fitness();
+            result.best_solution = watch->best_solution();
+            result.algorithm_usage.function_evaluations = watch->function_evaluations();
+        } else {
+            const auto &champion_f = population.champion_f();
+            if (champion_f.empty()) {
+                throw std::runtime_error("pagmo population has empty champion fitness");
+            }
+            result.best_fitness = champion_f[0];
+            result.best_solution = population.champion_x();
+            result.algorithm_usage.function_evaluations = read_fevals(
+                population,
+                population_size * (generations + 1));
+        }
+        result.algorithm_usage.cached_function_evaluations = reused_fevals;
         // back-derive generations from fevals
         // every wrapped algorithm does exactly population_size evals per generation
         const auto actual_fevals = result.algorithm_usage.function_evaluations;
@@ -197,15 +668,27 @@ inline core::OptimizationResult run_population(
             : 0u;
         result.algorithm_usage.generations = actual_generations;
         result.algorithm_usage.wall_time =
-            std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+            restored_wall_time + std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
         auto budget_fields = compute_budget_fields(budget, actual_generations, population_size);
         result.requested_budget = budget_fields.requested_budget;
         result.effective_budget = budget_fields.effective_budget;
         // effective_parameters keeps configured values
         // algorithm_usage holds actual work
         result.effective_parameters = configured_parameters;
+        if (options.report_final_population && !stopped) {
+            auto snapshot = snapshot_population(population);
+            snapshot->state = encode_population_state(PopulationState{
+                continuation, actual_generations, result.algorithm_usage.wall_time, algorithm, population});
+            result.final_population = std::move(snapshot);
+        }
 
-        if (generations == 0) {
+        if (pruned) {
+            result.status = core::RunStatus::Pruned;
+            result.message = "pruned after " + std::to_string(actual_fevals) + " function evaluations";
+        } else if (stopped) {
+            result.status = core::RunStatus::BudgetExceeded;
+            result.message = "wall-time budget exceeded";
+        } else if (generations == 0) {
             result.status = core::RunStatus::BudgetExceeded;
             result.message = "budget insufficient for any generations; only initial population evaluated";
         } else {
@@ -220,8 +703,9 @@ inline core::OptimizationResult run_population(
         // population is gone on throw
         // recover fevals from the shared counter
         // back-derive generations from that
-        const auto performed = eval_counter->load(std::memory_order_relaxed);
+        const auto performed = eval_counter->load(std::memory_order_relaxed) + reused_fevals;
         result.algorithm_usage.function_evaluations = performed;
+        result.algorithm_usage.cached_function_evaluations = reused_fevals;
         result.algorithm_usage.generations =
             (population_size > 0 && performed > population_size)
                 ? (performed - population_size) / population_size
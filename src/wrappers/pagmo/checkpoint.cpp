@@ -0,0 +1,172 @@
+#include "checkpoint.hpp"
+
+#include <boost/archive/archive_exception.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/string.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/s11n.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+PAGMO_S11N_PROBLEM_EXPORT(hpoea::pagmo_wrappers::ProblemAdapter)
+
+namespace {
+
+constexpr const char *checkpoint_magic = "hpoea-population-checkpoint";
+constexpr unsigned checkpoint_format_version = 1;
+
+void describe_value(std::ostream &out, const hpoea::core::ParameterValue &value) {
+    std::visit([&out](const auto &v) {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<T, bool>) {
+            out << (v ? "true" : "false");
+        } else {
+            out << v;
+        }
+    }, value);
+}
+
+} // namespace
+
+namespace hpoea::pagmo_wrappers {
+
+void write_population_state(std::ostream &out, const PopulationState &state) {
+    boost::archive::binary_oarchive archive(out);
+    const std::string magic = checkpoint_magic;
+    const unsigned version = checkpoint_format_version;
+    const unsigned long long generations_done = state.generations_done;
+    const long long wall_time_ms = state.wall_time.count();
+    archive << magic << version << state.fingerprint << generations_done << wall_time_ms;
+    archive << state.algorithm << state.population;
+}
+
+PopulationState read_population_state(std::istream &in) {
+    PopulationState state;
+    try {
+        boost::archive::binary_iarchive archive(in);
+        std::string magic;
+        unsigned version = 0;
+        archive >> magic;
+        if (magic != checkpoint_magic) {
+            throw std::invalid_argument("not a population checkpoint");
+        }
+        archive >> version;
+        if (version != checkpoint_format_version) {
+            throw std::invalid_argument("unsupported checkpoint format version " + std::to_string(version));
+        }
+        unsigned long long generations_done = 0;
+        long long wall_time_ms = 0;
+        archive >> state.fingerprint >> generations_done >> wall_time_ms;
+        archive >> state.algorithm >> state.population;
+        state.generations_done = static_cast<std::size_t>(generations_done);
+        state.wall_time = std::chrono::milliseconds{wall_time_ms};
+    } catch (const boost::archive::archive_exception &ex) {
+        throw std::invalid_argument(std::string("corrupt population checkpoint: ") + ex.what());
+    }
+    return state;
+}
+
+std::string encode_population_state(const PopulationState &state) {
+    std::ostringstream out(std::ios::binary);
+    write_population_state(out, state);
+    return out.str();
+}
+
+PopulationState decode_population_state(const std::string &bytes) {
+    std::istringstream in(bytes, std::ios::binary);
+    return read_population_state(in);
+}
+
+void save_population_state(const std::filesystem::path &path, const PopulationState &state) {
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path());
+    }
+    auto temp_path = path;
+    temp_path += ".tmp";
+    {
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("cannot open checkpoint for writing: " + temp_path.string());
+        }
+        write_population_state(out, state);
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("failed to write checkpoint: " + temp_path.string());
+        }
+    }
+    std::filesystem::rename(temp_path, path);
+}
+
+std::optional<PopulationState> load_population_state(const std::filesystem::path &path) {
+    if (!std::filesystem::exists(path)) {
+        return std::nullopt;
+    }
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("cannot open checkpoint: " + path.string());
+    }
+    return read_population_state(in);
+}
+
+void rebind_population_problem(pagmo::population &population, const ProblemAdapter &bound) {
+    auto *adapter = population.get_problem().extract<ProblemAdapter>();
+    if (adapter == nullptr) {
+        throw std::invalid_argument("checkpoint population does not wrap an hpoea problem");
+    }
+    adapter->rebind(bound);
+}
+
+std::string run_fingerprint(const core::IProblem &problem,
+                            const core::ParameterSet &parameters,
+                            const core::Budget &budget,
+                            unsigned long seed,
+                            const std::string &algorithm_name) {
+    std::ostringstream out;
+    out << std::setprecision(17);
+    out << "algorithm=" << algorithm_name
+        << ";problem=" << problem.metadata().id
+        << ";dimension=" << problem.dimension()
+        << ";seed=" << seed;
+    if (budget.function_evaluations) {
+        out << ";function_evaluations=" << *budget.function_evaluations;
+    }
+    if (budget.generations) {
+        out << ";generations=" << *budget.generations;
+    }
+    if (budget.wall_time) {
+        out << ";wall_time_ms=" << budget.wall_time->count();
+    }
+
+    std::vector<std::string> names;
+    names.reserve(parameters.size());
+    for (const auto &[name, _] : parameters) {
+        names.push_back(name);
+    }
+    std::sort(names.begin(), names.end());
+    for (const auto &name : names) {
+        out << ';' << name << '=';
+        describe_value(out, parameters.at(name));
+    }
+    return out.str();
+}
+
+std::string continuation_fingerprint(const core::IProblem &problem,
+                                     const core::ParameterSet &parameters,
+                                     const core::Budget &budget,
+                                     const std::string &algorithm_name,
+                                     bool stepped) {
+    return std::string(stepped ? "continue-stepped;" : "continue;") +
+           run_fingerprint(problem, parameters, budget, 0, algorithm_name);
+}
+
+} // namespace hpoea::pagmo_wrappers
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "hpoea/core/parameters.hpp"
+#include "hpoea/core/problem.hpp"
+#include "hpoea/core/types.hpp"
+#include "problem_adapter.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <iosfwd>
+#include <optional>
+#include <pagmo/algorithm.hpp>
+#include <pagmo/population.hpp>
+#include <string>
+
+namespace hpoea::pagmo_wrappers {
+
+// everything a stepped population run needs to continue.
+// the algorithm carries its rng and adaptation state, the population its
+// individuals, champion, rng and the problem's feval count.
+struct PopulationState {
+    std::string fingerprint;
+    std::size_t generations_done{0};
+    std::chrono::milliseconds wall_time{0};
+    pagmo::algorithm algorithm;
+    pagmo::population population;
+};
+
+// compact boost binary archive
+void write_population_state(std::ostream &out, const PopulationState &state);
+[[nodiscard]] PopulationState read_population_state(std::istream &in);
+
+// the same archive in memory, carried by warm starts
+[[nodiscard]] std::string encode_population_state(const PopulationState &state);
+[[nodiscard]] PopulationState decode_population_state(const std::string &bytes);
+
+// writes a sibling temp file and renames it over path
+// so an interrupted write never leaves a torn checkpoint
+void save_population_state(const std::filesystem::path &path, const PopulationState &state);
+
+// nullopt when path does not exist yet
+[[nodiscard]] std::optional<PopulationState> load_population_state(const std::filesystem::path &path);
+
+// a restored population holds an unbound ProblemAdapter,
+// bound supplies the problem, counter and batch evaluator
+void rebind_population_problem(pagmo::population &population, const ProblemAdapter &bound);
+
+// identifies the run a checkpoint belongs to
+[[nodiscard]] std::string run_fingerprint(const core::IProblem &problem,
+                                          const core::ParameterSet &parameters,
+                                          const core::Budget &budget,
+                                          unsigned long seed,
+                                          const std::string &algorithm_name);
+
+// identifies the runs a warm start state may resume: same problem,
+// parameters, budget and stepping. the seed is left out because the
+// resumed algorithm and population bring their own rngs.
+[[nodiscard]] std::string continuation_fingerprint(const core::IProblem &problem,
+                                                   const core::ParameterSet &parameters,
+                                                   const core::Budget &budget,
+                                                   const std::string &algorithm_name,
+                                                   bool stepped);
+
+} // namespace hpoea::pagmo_wrappers
@@ -29,6 +29,8 @@ ParameterSpace make_parameter_space() {
     space.add_descriptor(hpoea::pagmo_wrappers::make_ftol_descriptor());
     space.add_descriptor(hpoea::pagmo_wrappers::make_xtol_descriptor());
 
+    space.add_descriptor(hpoea::pagmo_wrappers::make_population_init_descriptor());
+
     return space;
 }
 
@@ -55,10 +57,12 @@ core::OptimizationResult PagmoCmaes::run(const core::IProblem &problem,
         budget,
         configured_parameters_,
         seed,
-        [=](unsigned generations, unsigned algo_seed) {
+        run_options_,
+        // memory is always on, so stepped runs keep their adaptation state
+        [=](const AlgorithmRequest &request) {
             return pagmo::algorithm{
-                pagmo::cmaes(generations, -1, -1, -1, -1, sigma0, ftol, xtol,
-                             true, true, algo_seed)};
+                pagmo::cmaes(request.generations, -1, -1, -1, -1, sigma0, ftol, xtol,
+                             true, true, request.seed32)};
         });
 }
 
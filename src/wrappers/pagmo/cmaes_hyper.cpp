@@ -79,6 +79,10 @@ ParameterSpace make_parameter_space() {
     d.default_value = false;
     space.add_descriptor(d);
 
+    space.add_descriptor(hpoea::pagmo_wrappers::make_population_init_descriptor());
+    space.add_descriptor(hpoea::pagmo_wrappers::make_parallel_workers_descriptor());
+    space.add_descriptor(hpoea::pagmo_wrappers::make_duplicate_policy_descriptor());
+
     return space;
 }
 
@@ -106,13 +110,16 @@ core::HyperparameterOptimizationResult PagmoCmaesHyperOptimizer::optimize(
 
     return run_hyper_optimization(
         algorithm_factory, problem, optimizer_budget, algorithm_budget,
-        seed, search_space_,
+        seed, search_space_, make_trial_pruner(),
+        [&] { return prior_trials(algorithm_factory, problem); },
         [&](pagmo::problem &tuning_problem,
             const auto &bounds,
             const core::Budget &budget,
             std::chrono::steady_clock::time_point start,
             HyperparameterTuningProblem::Context &ctx) -> HyperEvolveOutcome {
 
+            apply_duplicate_policy(ctx, configured_parameters_);
+
             const auto seed32 = to_seed32(seed);
             const auto dim = bounds.first.size();
             // pagmo::cmaes requires at least 5 individuals
@@ -144,14 +151,19 @@ core::HyperparameterOptimizationResult PagmoCmaesHyperOptimizer::optimize(
                 get_param<bool>(configured_parameters_, "force_bounds"),
                 seed32}};
 
-            pagmo::population population{tuning_problem, pop_size, derive_seed32(seed, 0)};
+            // pagmo::cmaes has no batch hook, only the initial population
+            // is evaluated in parallel
+            const auto bfe = make_hyper_batch_evaluator(ctx, configured_parameters_);
+            auto population = make_population(tuning_problem, pop_size, derive_seed32(seed, 0),
+                                              population_init_kind(configured_parameters_), &bfe,
+                                              ctx.prior_points);
 
             std::size_t actual_iterations = 0;
             for (std::size_t g = 0; g < generations; ++g) {
-                const auto before = ctx.get_evaluations();
+                const auto before = ctx.get_proposed();
                 population = algorithm.evolve(population);
-                if (ctx.get_evaluations() == before) {
-                    // no new evaluations means ftol/xtol converged
+                if (ctx.get_proposed() == before) {
+                    // no new candidates means ftol/xtol converged
                     // don't count a no-op generation
                     break;
                 }
@@ -163,7 +175,7 @@ core::HyperparameterOptimizationResult PagmoCmaesHyperOptimizer::optimize(
                         break;
                 }
                 if (budget.function_evaluations &&
-                    ctx.get_evaluations() >= *budget.function_evaluations)
+                    ctx.get_objective_calls() >= *budget.function_evaluations)
                     break;
             }
 
@@ -37,6 +37,8 @@ ParameterSpace make_parameter_space() {
     d.default_value = false;
     space.add_descriptor(d);
 
+    space.add_descriptor(hpoea::pagmo_wrappers::make_population_init_descriptor());
+
     return space;
 }
 
@@ -65,9 +67,10 @@ core::OptimizationResult PagmoDe1220::run(const core::IProblem &problem,
         budget,
         configured_parameters_,
         seed,
-        [=, allowed_variants = std::move(allowed_variants)](unsigned generations, unsigned algo_seed) mutable {
-            return pagmo::algorithm{
-                pagmo::de1220(generations, allowed_variants, variant_adaptation, ftol, xtol, memory, algo_seed)};
+        run_options_,
+        [=, allowed_variants = std::move(allowed_variants)](const AlgorithmRequest &request) mutable {
+            return pagmo::algorithm{pagmo::de1220(request.generations, allowed_variants, variant_adaptation, ftol,
+                                                  xtol, memory || request.stepped, request.seed32)};
         });
 }
 
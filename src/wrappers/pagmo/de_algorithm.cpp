@@ -43,6 +43,8 @@ ParameterSpace make_parameter_space() {
     space.add_descriptor(hpoea::pagmo_wrappers::make_ftol_descriptor());
     space.add_descriptor(hpoea::pagmo_wrappers::make_xtol_descriptor());
 
+    space.add_descriptor(hpoea::pagmo_wrappers::make_population_init_descriptor());
+
     return space;
 }
 
@@ -71,9 +73,10 @@ core::OptimizationResult PagmoDifferentialEvolution::run(const core::IProblem &p
         budget,
         configured_parameters_,
         seed,
-        [=](unsigned generations, unsigned algo_seed) {
-            return pagmo::algorithm{
-                pagmo::de(generations, scaling_factor, crossover_rate, variant, ftol, xtol, algo_seed)};
+        run_options_,
+        [=](const AlgorithmRequest &request) {
+            return pagmo::algorithm{pagmo::de(request.generations, scaling_factor, crossover_rate, variant, ftol,
+                                              xtol, request.seed32)};
         });
 }
 
@@ -0,0 +1,244 @@
+#pragma once
+
+#include "hpoea/core/parameters.hpp"
+#include "hpoea/core/search_space.hpp"
+#include "hpoea/core/types.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace hpoea::pagmo_wrappers {
+
+// a parameter space and search space compiled into one op per tunable
+// parameter, with ranges, transforms and choice tables resolved, so that
+// decoding a candidate does no search-space lookups. fixed values and
+// the defaults of value-less fixed parameters form a template every
+// decoded set starts from. the plan copies what it uses from both spaces.
+class DecodePlan {
+public:
+  DecodePlan(const core::ParameterSpace &space, const core::SearchSpace *search_space) {
+    for (const auto &descriptor : space.descriptors()) {
+      const core::ParameterConfig *config = search_space ? search_space->get(descriptor.name) : nullptr;
+      const auto mode = core::effective_mode(descriptor, config);
+      if (mode == core::SearchMode::exclude) {
+        continue;
+      }
+      if (mode == core::SearchMode::fixed) {
+        if (config && config->fixed_value.has_value()) {
+          fixed_.emplace(descriptor.name, *config->fixed_value);
+        } else if (descriptor.default_value.has_value()) {
+          fixed_.emplace(descriptor.name, *descriptor.default_value);
+        }
+        continue;
+      }
+      ops_.push_back(compile(descriptor, config));
+    }
+  }
+
+  [[nodiscard]] std::size_t dimension() const noexcept { return ops_.size(); }
+
+  [[nodiscard]] std::vector<double> lower_bounds() const {
+    std::vector<double> lower;
+    lower.reserve(ops_.size());
+    for (const auto &op : ops_) {
+      lower.push_back(op.lower);
+    }
+    return lower;
+  }
+
+  [[nodiscard]] std::vector<double> upper_bounds() const {
+    std::vector<double> upper;
+    upper.reserve(ops_.size());
+    for (const auto &op : ops_) {
+      upper.push_back(op.upper);
+    }
+    return upper;
+  }
+
+  // throws std::invalid_argument unless candidate has dimension() values
+  [[nodiscard]] core::ParameterSet decode(const std::vector<double> &candidate) const {
+    if (candidate.size() != ops_.size()) {
+      throw std::invalid_argument(
+          "HyperparameterTuningProblem candidate dimension mismatch: expected " +
+          std::to_string(ops_.size()) + ", got " + std::to_string(candidate.size()));
+    }
+    return decode_row(candidate.data());
+  }
+
+  // one parameter set per row of a flat row-major candidate matrix;
+  // throws std::invalid_argument unless the size is a multiple of dimension()
+  [[nodiscard]] std::vector<core::ParameterSet> decode_batch(const std::vector<double> &candidates) const {
+    if (ops_.empty() || candidates.size() % ops_.size() != 0) {
+      throw std::invalid_argument(
+          "HyperparameterTuningProblem batch size " + std::to_string(candidates.size()) +
+          " is not a multiple of dimension " + std::to_string(ops_.size()));
+    }
+    const auto rows = candidates.size() / ops_.size();
+    std::vector<core::ParameterSet> decoded;
+    decoded.reserve(rows);
+    for (std::size_t row = 0; row < rows; ++row) {
+      decoded.push_back(decode_row(candidates.data() + row * ops_.size()));
+    }
+    return decoded;
+  }
+
+  // the candidate that decodes to parameters, nullopt when a tunable
+  // parameter is missing, has the wrong type or lies outside its bounds
+  [[nodiscard]] std::optional<std::vector<double>> encode(const core::ParameterSet &parameters) const {
+    std::vector<double> candidate;
+    candidate.reserve(ops_.size());
+    for (const auto &op : ops_) {
+      const auto it = parameters.find(op.name);
+      if (it == parameters.end()) {
+        return std::nullopt;
+      }
+      const auto &value = it->second;
+      switch (op.kind) {
+      case Kind::continuous: {
+        if (!std::holds_alternative<double>(value)) {
+          return std::nullopt;
+        }
+        const auto numeric = std::get<double>(value);
+        if (!(numeric >= op.range.lower && numeric <= op.range.upper)) {
+          return std::nullopt;
+        }
+        candidate.push_back(core::transform_bounds({numeric, numeric}, op.transform).lower);
+        break;
+      }
+      case Kind::integer: {
+        if (!std::holds_alternative<std::int64_t>(value) ||
+            std::get<std::int64_t>(value) < op.integer_range.lower ||
+            std::get<std::int64_t>(value) > op.integer_range.upper) {
+          return std::nullopt;
+        }
+        candidate.push_back(static_cast<double>(std::get<std::int64_t>(value)));
+        break;
+      }
+      case Kind::boolean:
+        if (!std::holds_alternative<bool>(value)) {
+          return std::nullopt;
+        }
+        candidate.push_back(std::get<bool>(value) ? 1.0 : 0.0);
+        break;
+      case Kind::choice: {
+        const auto found = std::find(op.choices.begin(), op.choices.end(), value);
+        if (found == op.choices.end()) {
+          return std::nullopt;
+        }
+        candidate.push_back(static_cast<double>(found - op.choices.begin()));
+        break;
+      }
+      }
+    }
+    return candidate;
+  }
+
+private:
+  enum class Kind { continuous, integer, boolean, choice };
+
+  struct Op {
+    Kind kind{Kind::continuous};
+    std::string name;
+    // decision-space bounds, transformed for continuous parameters
+    double lower{0.0};
+    double upper{0.0};
+    core::ContinuousRange range{};
+    core::Transform transform{core::Transform::none};
+    core::IntegerRange integer_range{};
+    // search-space choices, or a categorical descriptor's choices
+    std::vector<core::ParameterValue> choices;
+  };
+
+  [[nodiscard]] static Op compile(const core::ParameterDescriptor &descriptor, const core::ParameterConfig *config) {
+    Op op;
+    op.name = descriptor.name;
+    const bool has_choices = config && !config->discrete_choices.empty();
+    switch (descriptor.type) {
+    case core::ParameterType::Continuous: {
+      if (!descriptor.continuous_range.has_value()) {
+        throw std::logic_error("continuous parameter missing range: " + descriptor.name);
+      }
+      op.kind = Kind::continuous;
+      op.range = config && config->continuous_bounds ? *config->continuous_bounds : *descriptor.continuous_range;
+      op.transform = config ? config->transform : core::Transform::none;
+      const auto transformed = core::transform_bounds(op.range, op.transform);
+      op.lower = transformed.lower;
+      op.upper = transformed.upper;
+      return op;
+    }
+    case core::ParameterType::Integer:
+      if (has_choices) {
+        break;
+      }
+      if (!descriptor.integer_range.has_value()) {
+        throw std::logic_error("integer parameter missing range: " + descriptor.name);
+      }
+      op.kind = Kind::integer;
+      op.integer_range = config && config->integer_bounds ? *config->integer_bounds : *descriptor.integer_range;
+      op.lower = static_cast<double>(op.integer_range.lower);
+      op.upper = static_cast<double>(op.integer_range.upper);
+      return op;
+    case core::ParameterType::Boolean:
+      op.kind = Kind::boolean;
+      op.upper = 1.0;
+      return op;
+    case core::ParameterType::Categorical:
+      if (has_choices) {
+        break;
+      }
+      if (descriptor.categorical_choices.empty()) {
+        throw core::ParameterValidationError("categorical parameter '" + descriptor.name + "' has zero choices");
+      }
+      for (const auto &choice : descriptor.categorical_choices) {
+        op.choices.emplace_back(std::string{choice});
+      }
+      break;
+    }
+    if (has_choices) {
+      op.choices = config->discrete_choices;
+    }
+    op.kind = Kind::choice;
+    op.upper = static_cast<double>(op.choices.size() - 1);
+    return op;
+  }
+
+  [[nodiscard]] core::ParameterSet decode_row(const double *values) const {
+    core::ParameterSet parameters = fixed_;
+    parameters.reserve(fixed_.size() + ops_.size());
+    for (std::size_t i = 0; i < ops_.size(); ++i) {
+      const auto &op = ops_[i];
+      const auto value = values[i];
+      switch (op.kind) {
+      case Kind::continuous:
+        parameters.emplace(op.name, std::clamp(core::inverse_transform(value, op.transform),
+                                               op.range.lower, op.range.upper));
+        break;
+      case Kind::integer:
+        parameters.emplace(op.name, std::clamp(static_cast<std::int64_t>(std::llround(value)),
+                                               op.integer_range.lower, op.integer_range.upper));
+        break;
+      case Kind::boolean:
+        parameters.emplace(op.name, value > 0.5);
+        break;
+      case Kind::choice:
+        parameters.emplace(op.name, op.choices[static_cast<std::size_t>(std::clamp<std::int64_t>(
+                                        std::llround(value), 0, static_cast<std::int64_t>(op.choices.size() - 1)))]);
+        break;
+      }
+    }
+    return parameters;
+  }
+
+  std::vector<Op> ops_;
+  core::ParameterSet fixed_;
+};
+
+} // namespace hpoea::pagmo_wrappers
@@ -1,27 +1,66 @@
 #pragma once
 
 #include "budget_util.hpp"
+#include "decode_plan.hpp"
 #include "hpoea/core/evolution_algorithm.hpp"
 #include "hpoea/core/hyperparameter_optimizer.hpp"
 #include "hpoea/core/parameters.hpp"
 #include "hpoea/core/problem.hpp"
+#include "hpoea/core/pruning.hpp"
 #include "hpoea/core/search_space.hpp"
 #include "hpoea/core/types.hpp"
 
 #include <algorithm>
 #include <atomic>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <pagmo/threading.hpp>
 #include <pagmo/types.hpp>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <variant>
 #include <vector>
 
 namespace hpoea::pagmo_wrappers {
 
+// what a candidate costs when it decodes to a parameter set proposed before,
+// which integer, boolean and categorical parameters make common
+enum class DuplicatePolicy {
+  // run it again with its own seed
+  rerun,
+  // answer with the earlier result; not an objective call
+  reuse,
+  // answer with the earlier result and charge it as an objective call
+  reuse_counted,
+  // run it again and answer with the mean over its runs
+  average
+};
+
+[[nodiscard]] inline std::optional<DuplicatePolicy> parse_duplicate_policy(std::string_view name) {
+  if (name == "rerun") return DuplicatePolicy::rerun;
+  if (name == "reuse") return DuplicatePolicy::reuse;
+  if (name == "reuse_counted") return DuplicatePolicy::reuse_counted;
+  if (name == "average") return DuplicatePolicy::average;
+  return std::nullopt;
+}
+
 struct HyperparameterTuningProblem {
+  // a proposed parameter set and the fitness of its finished runs
+  struct SeenConfiguration {
+    core::ParameterSet parameters;
+    std::size_t runs{0};
+    double fitness_sum{0.0};
+  };
+
   struct Context {
     const core::IEvolutionaryAlgorithmFactory *factory{nullptr};
     const core::IProblem *problem{nullptr};
@@ -29,9 +68,33 @@ struct HyperparameterTuningProblem {
     unsigned long base_seed{0};
     std::shared_ptr<std::vector<core::HyperparameterTrialRecord>> trials;
     std::shared_ptr<core::SearchSpace> search_space;
+    // null when runs are never stopped early
+    std::shared_ptr<core::TrialPruner> pruner;
     mutable std::optional<core::HyperparameterTrialRecord> best_trial;
     mutable std::atomic<std::size_t> evaluations{0};
     mutable std::mutex mutex;
+    // threads batch_fitness may use
+    std::size_t workers{1};
+    // decision vectors of earlier trials, best first, for initial populations
+    std::vector<pagmo::vector_double> prior_points;
+    DuplicatePolicy duplicate_policy{DuplicatePolicy::rerun};
+    // every proposed parameter set, bucketed by core::hash_parameter_set;
+    // guarded by mutex
+    mutable std::unordered_map<std::uint64_t, std::vector<SeenConfiguration>> seen;
+    mutable std::atomic<std::size_t> proposed{0};
+    mutable std::atomic<std::size_t> duplicates{0};
+    mutable std::atomic<std::size_t> cached{0};
+    // compiled on first use; factory and search_space must not change after
+    mutable std::mutex plan_mutex;
+    mutable std::unique_ptr<const DecodePlan> plan;
+
+    [[nodiscard]] const DecodePlan &decode_plan() const {
+      std::scoped_lock lock(plan_mutex);
+      if (!plan) {
+        plan = std::make_unique<const DecodePlan>(factory->parameter_space(), search_space.get());
+      }
+      return *plan;
+    }
 
     [[nodiscard]] std::optional<core::HyperparameterTrialRecord>
     get_best_trial() const {
@@ -42,6 +105,18 @@ struct HyperparameterTuningProblem {
     [[nodiscard]] std::size_t get_evaluations() const {
       return evaluations.load(std::memory_order_relaxed);
     }
+
+    // ea runs plus the cache hits the policy charges
+    [[nodiscard]] std::size_t get_objective_calls() const {
+      const auto charged = duplicate_policy == DuplicatePolicy::reuse_counted
+          ? cached.load(std::memory_order_relaxed) : std::size_t{0};
+      return get_evaluations() + charged;
+    }
+
+    // candidates scored, cache hits included
+    [[nodiscard]] std::size_t get_proposed() const {
+      return proposed.load(std::memory_order_relaxed);
+    }
   };
 
   HyperparameterTuningProblem() = default;
@@ -52,178 +127,160 @@ struct HyperparameterTuningProblem {
   [[nodiscard]] std::pair<pagmo::vector_double, pagmo::vector_double>
   get_bounds() const {
     const auto &ctx = ensure_context();
-    const auto &space = ctx.factory->parameter_space();
-    const auto &descriptors = space.descriptors();
-    if (descriptors.empty()) {
+    if (ctx.factory->parameter_space().empty()) {
       throw core::ParameterValidationError(
           "Algorithm parameter space is empty. Hyperparameter optimizer "
           "requires at least one parameter.");
     }
 
-    pagmo::vector_double lower;
-    pagmo::vector_double upper;
-    lower.reserve(descriptors.size());
-    upper.reserve(descriptors.size());
-
-    for (const auto &descriptor : descriptors) {
-      const core::ParameterConfig *config = nullptr;
-      if (ctx.search_space) {
-        config = ctx.search_space->get(descriptor.name);
-      }
-
-      if (config) {
-        if (config->mode == core::SearchMode::fixed ||
-            config->mode == core::SearchMode::exclude) {
-          continue;
-        }
-      }
-
-      switch (descriptor.type) {
-      case core::ParameterType::Continuous: {
-        auto [range, transform] = resolve_continuous(descriptor, config);
-        const auto transformed = core::transform_bounds(range, transform);
-        lower.push_back(transformed.lower);
-        upper.push_back(transformed.upper);
-        break;
-      }
-      case core::ParameterType::Integer: {
-        if (config && !config->discrete_choices.empty()) {
-          lower.push_back(0.0);
-          upper.push_back(static_cast<double>(config->discrete_choices.size() - 1));
-        } else {
-          auto range = resolve_integer_range(descriptor, config);
-          lower.push_back(static_cast<double>(range.lower));
-          upper.push_back(static_cast<double>(range.upper));
-        }
-        break;
-      }
-      case core::ParameterType::Boolean: {
-        lower.push_back(0.0);
-        upper.push_back(1.0);
-        break;
-      }
-      case core::ParameterType::Categorical: {
-        const auto count = (config && !config->discrete_choices.empty())
-            ? config->discrete_choices.size()
-            : descriptor.categorical_choices.size();
-        if (count == 0) {
-          throw core::ParameterValidationError(
-              "categorical parameter '" + descriptor.name + "' has zero choices");
-        }
-        lower.push_back(0.0);
-        upper.push_back(static_cast<double>(count - 1));
-        break;
-      }
-      }
-    }
-
-    if (lower.empty()) {
+    const auto &plan = ctx.decode_plan();
+    if (plan.dimension() == 0) {
       throw core::ParameterValidationError(
           "All parameters are fixed or excluded. At least one parameter "
           "must be optimized.");
     }
 
-    return {lower, upper};
+    return {plan.lower_bounds(), plan.upper_bounds()};
   }
 
   [[nodiscard]] pagmo::vector_double
   fitness(const pagmo::vector_double &candidate) const {
-    const auto &ctx = ensure_context();
-    const auto &space = ctx.factory->parameter_space();
-    const auto &descriptors = space.descriptors();
-    const auto expected_dim = compute_candidate_dimension(ctx, descriptors);
-
-    if (candidate.size() != expected_dim) {
-      throw std::invalid_argument(
-          "HyperparameterTuningProblem candidate dimension mismatch: expected " +
-          std::to_string(expected_dim) + ", got " +
-          std::to_string(candidate.size()));
-    }
-
-    core::ParameterSet parameters;
-    parameters.reserve(descriptors.size());
-
-    std::size_t candidate_index = 0;
+    return fitness_with(candidate, std::nullopt);
+  }
 
-    for (const auto &descriptor : descriptors) {
-      const core::ParameterConfig *config = nullptr;
-      if (ctx.search_space) {
-        config = ctx.search_space->get(descriptor.name);
-      }
+  // fitness with the trial index, and so the inner seed, chosen by the
+  // caller rather than drawn from evaluations, for concurrent solves that
+  // must not depend on each other's timing. the run still counts towards
+  // evaluations
+  [[nodiscard]] pagmo::vector_double
+  fitness_at(const pagmo::vector_double &candidate, std::size_t trial_index) const {
+    return fitness_with(candidate, trial_index);
+  }
 
-      if (config) {
-        if (config->mode == core::SearchMode::fixed) {
-          if (config->fixed_value.has_value()) {
-            parameters.emplace(descriptor.name, config->fixed_value.value());
-          }
+  // evaluates a flat block of candidates on ctx.workers threads.
+  // trial indices and seeds follow candidate order and the trials are
+  // recorded in that order, so the outcome does not depend on the thread
+  // count. a candidate that fails to configure ends the batch there, as
+  // it would in a serial loop. under the reuse policies a repeat of an
+  // earlier candidate in the same batch waits for that candidate's run.
+  [[nodiscard]] pagmo::vector_double
+  batch_fitness(const pagmo::vector_double &dvs) const {
+    const auto &ctx = ensure_context();
+    auto decoded_rows = ctx.decode_plan().decode_batch(dvs);
+    const auto count = decoded_rows.size();
+
+    // each candidate reads a cached fitness or the result of a run
+    struct Slot {
+      std::size_t run{0};
+      std::optional<double> cached;
+    };
+    const auto reuse = ctx.duplicate_policy == DuplicatePolicy::reuse ||
+                       ctx.duplicate_policy == DuplicatePolicy::reuse_counted;
+    std::vector<Slot> slots;
+    std::vector<core::ParameterSet> parameters;
+    std::vector<core::EvolutionaryAlgorithmPtr> algorithms;
+    slots.reserve(count);
+    parameters.reserve(count);
+    algorithms.reserve(count);
+    std::exception_ptr configure_error;
+    for (std::size_t i = 0; i < count; ++i) {
+      try {
+        auto decoded = std::move(decoded_rows[i]);
+        if (auto cached = propose(ctx, decoded)) {
+          slots.push_back({0, cached});
           continue;
         }
-        if (config->mode == core::SearchMode::exclude) {
-          continue;
+        if (reuse) {
+          const auto earlier = std::find(parameters.begin(), parameters.end(), decoded);
+          if (earlier != parameters.end()) {
+            ctx.cached.fetch_add(1, std::memory_order_relaxed);
+            slots.push_back({static_cast<std::size_t>(earlier - parameters.begin()), std::nullopt});
+            continue;
+          }
         }
-      }
-
-      const auto value = candidate[candidate_index++];
-
-      switch (descriptor.type) {
-      case core::ParameterType::Continuous:
-        parameters.emplace(descriptor.name, decode_continuous(value, descriptor, config));
-        break;
-      case core::ParameterType::Integer:
-        parameters.emplace(descriptor.name, decode_integer(value, descriptor, config));
-        break;
-      case core::ParameterType::Boolean:
-        parameters.emplace(descriptor.name, value > 0.5);
-        break;
-      case core::ParameterType::Categorical:
-        parameters.emplace(descriptor.name, decode_categorical(value, descriptor, config));
+        auto algorithm = ctx.factory->create();
+        algorithm->configure(decoded);
+        watch_progress(ctx, *algorithm);
+        slots.push_back({parameters.size(), std::nullopt});
+        parameters.push_back(std::move(decoded));
+        algorithms.push_back(std::move(algorithm));
+      } catch (...) {
+        configure_error = std::current_exception();
         break;
       }
     }
 
-    for (const auto &desc : descriptors) {
-      if (parameters.contains(desc.name)) continue;
-      const core::ParameterConfig *pc = nullptr;
-      if (ctx.search_space) pc = ctx.search_space->get(desc.name);
-      if (pc && pc->mode == core::SearchMode::exclude) continue;
-      if (desc.default_value.has_value()) {
-        parameters.emplace(desc.name, *desc.default_value);
+    const auto ready = algorithms.size();
+    const auto first_index = ctx.evaluations.fetch_add(ready, std::memory_order_relaxed);
+    std::vector<core::HyperparameterTrialRecord> records(ready);
+    std::vector<std::exception_ptr> errors(ready);
+    std::atomic<std::size_t> next{0};
+    const auto work = [&] {
+      for (auto i = next.fetch_add(1, std::memory_order_relaxed); i < ready;
+           i = next.fetch_add(1, std::memory_order_relaxed)) {
+        try {
+          records[i] = run_trial(ctx, *algorithms[i], parameters[i], first_index + i);
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+      }
+    };
+
+    const auto workers = std::min(std::max<std::size_t>(ctx.workers, 1), ready);
+    if (workers <= 1) {
+      work();
+    } else {
+      std::vector<std::thread> threads;
+      threads.reserve(workers - 1);
+      for (std::size_t t = 1; t < workers; ++t) {
+        threads.emplace_back(work);
+      }
+      work();
+      for (auto &thread : threads) {
+        thread.join();
       }
     }
 
-    auto algorithm = ctx.factory->create();
-    algorithm->configure(parameters);
-    const auto eval_index =
-      ctx.evaluations.fetch_add(1, std::memory_order_relaxed);
-    const unsigned long eval_seed =
-      derive_seed32(ctx.base_seed, static_cast<unsigned long>(eval_index));
-
-    const auto result =
-        algorithm->run(*ctx.problem, ctx.algorithm_budget, eval_seed);
-
-    core::HyperparameterTrialRecord record;
-    record.parameters = parameters;
-    record.optimization_result = result;
-    record.trial_index = eval_index;
-
-    {
-      std::scoped_lock lock(ctx.mutex);
-      if (ctx.trials) {
-        ctx.trials->push_back(record);
-      }
-      if (core::is_selectable_trial(record) &&
-          (!ctx.best_trial ||
-           record.optimization_result.best_fitness <
-               ctx.best_trial->optimization_result.best_fitness)) {
-        ctx.best_trial = record;
+    // every completed run is recorded before the first error surfaces,
+    // so a failure does not lose the trials that ran next to it
+    std::vector<double> run_fitness(ready);
+    std::exception_ptr first_error;
+    for (std::size_t i = 0; i < ready; ++i) {
+      if (errors[i]) {
+        if (!first_error) {
+          first_error = errors[i];
+        }
+        continue;
       }
+      run_fitness[i] = settle(ctx, records[i].parameters, trial_fitness(records[i]));
+      commit_trial(ctx, std::move(records[i]));
+    }
+    if (!first_error) {
+      first_error = configure_error;
+    }
+    if (first_error) {
+      std::rethrow_exception(first_error);
     }
 
-    constexpr double FAILED_TRIAL_PENALTY = 1e20;
-    const auto fitness = core::is_selectable_trial(record)
-        ? record.optimization_result.best_fitness
-        : FAILED_TRIAL_PENALTY;
-    return pagmo::vector_double{fitness};
+    pagmo::vector_double fitness;
+    fitness.reserve(slots.size());
+    for (const auto &slot : slots) {
+      fitness.push_back(slot.cached ? *slot.cached : run_fitness[slot.run]);
+    }
+    return fitness;
+  }
+
+  // the decision vector that decodes to parameters, nullopt when a tunable
+  // parameter is missing, has the wrong type or lies outside its bounds
+  [[nodiscard]] static std::optional<pagmo::vector_double>
+  encode(const Context &ctx, const core::ParameterSet &parameters) {
+    return ctx.decode_plan().encode(parameters);
+  }
+
+  // fitness and batch_fitness only touch the context under its mutex or
+  // through atomics; the inner problem must allow concurrent evaluate()
+  [[nodiscard]] pagmo::thread_safety get_thread_safety() const {
+    return pagmo::thread_safety::constant;
   }
 
   [[nodiscard]] bool has_gradient() const { return false; }
@@ -233,93 +290,108 @@ struct HyperparameterTuningProblem {
   [[nodiscard]] std::string get_name() const { return "HyperparameterTuningProblem"; }
 
 private:
-  struct ResolvedContinuous {
-    core::ContinuousRange range;
-    core::Transform transform;
-  };
-
-  [[nodiscard]] static ResolvedContinuous resolve_continuous(
-      const core::ParameterDescriptor &desc,
-      const core::ParameterConfig *config) {
-    if (!desc.continuous_range.has_value()) {
-      throw std::logic_error("continuous parameter missing range: " + desc.name);
-    }
-    auto range = *desc.continuous_range;
-    auto transform = core::Transform::none;
-    if (config) {
-      if (config->continuous_bounds.has_value()) {
-        range = config->continuous_bounds.value();
-      }
-      transform = config->transform;
+  [[nodiscard]] pagmo::vector_double
+  fitness_with(const pagmo::vector_double &candidate, std::optional<std::size_t> trial_index) const {
+    const auto &ctx = ensure_context();
+    const auto parameters = ctx.decode_plan().decode(candidate);
+    if (const auto cached = propose(ctx, parameters)) {
+      return pagmo::vector_double{*cached};
     }
-    return {range, transform};
+
+    auto algorithm = ctx.factory->create();
+    algorithm->configure(parameters);
+    watch_progress(ctx, *algorithm);
+    const auto eval_index =
+      ctx.evaluations.fetch_add(1, std::memory_order_relaxed);
+
+    auto record = run_trial(ctx, *algorithm, parameters, trial_index.value_or(eval_index));
+    const auto fitness = settle(ctx, record.parameters, trial_fitness(record));
+    commit_trial(ctx, std::move(record));
+    return pagmo::vector_double{fitness};
   }
 
-  [[nodiscard]] static core::IntegerRange resolve_integer_range(
-      const core::ParameterDescriptor &desc,
-      const core::ParameterConfig *config) {
-    if (!desc.integer_range.has_value()) {
-      throw std::logic_error("integer parameter missing range: " + desc.name);
-    }
-    auto range = *desc.integer_range;
-    if (config && config->integer_bounds.has_value()) {
-      range = config->integer_bounds.value();
+  static void watch_progress(const Context &ctx, core::IEvolutionaryAlgorithm &algorithm) {
+    if (ctx.pruner) {
+      algorithm.set_progress_callback(ctx.pruner->monitor());
     }
-    return range;
   }
 
-  [[nodiscard]] static core::ParameterValue decode_discrete_choice(
-      double value, const std::vector<core::ParameterValue> &choices) {
-    auto index = static_cast<std::size_t>(
-        std::clamp<std::int64_t>(std::llround(value), 0,
-                                 static_cast<std::int64_t>(choices.size() - 1)));
-    return choices[index];
-  }
+  [[nodiscard]] static core::HyperparameterTrialRecord run_trial(
+      const Context &ctx,
+      core::IEvolutionaryAlgorithm &algorithm,
+      const core::ParameterSet &parameters,
+      std::size_t eval_index) {
+    const unsigned long eval_seed =
+      derive_seed32(ctx.base_seed, static_cast<unsigned long>(eval_index));
 
-  [[nodiscard]] static core::ParameterValue decode_continuous(
-      double value, const core::ParameterDescriptor &desc,
-      const core::ParameterConfig *config) {
-    auto [range, transform] = resolve_continuous(desc, config);
-    double numeric = core::inverse_transform(value, transform);
-    return std::clamp(numeric, range.lower, range.upper);
+    core::HyperparameterTrialRecord record;
+    record.parameters = parameters;
+    record.optimization_result =
+        algorithm.run(*ctx.problem, ctx.algorithm_budget, eval_seed);
+    record.trial_index = eval_index;
+    return record;
   }
 
-  [[nodiscard]] static core::ParameterValue decode_integer(
-      double value, const core::ParameterDescriptor &desc,
-      const core::ParameterConfig *config) {
-    if (config && !config->discrete_choices.empty()) {
-      return decode_discrete_choice(value, config->discrete_choices);
+  // records a proposal of parameters; returns the fitness to answer with
+  // when it repeats a finished configuration under a reuse policy
+  [[nodiscard]] static std::optional<double> propose(const Context &ctx,
+                                                     const core::ParameterSet &parameters) {
+    ctx.proposed.fetch_add(1, std::memory_order_relaxed);
+    std::scoped_lock lock(ctx.mutex);
+    auto &bucket = ctx.seen[core::hash_parameter_set(parameters)];
+    const auto it = std::find_if(bucket.begin(), bucket.end(),
+                                 [&](const SeenConfiguration &seen) { return seen.parameters == parameters; });
+    if (it == bucket.end()) {
+      bucket.push_back({parameters, 0, 0.0});
+      return std::nullopt;
+    }
+    ctx.duplicates.fetch_add(1, std::memory_order_relaxed);
+    const auto reuse = ctx.duplicate_policy == DuplicatePolicy::reuse ||
+                       ctx.duplicate_policy == DuplicatePolicy::reuse_counted;
+    // a repeat of a run still in flight elsewhere runs itself
+    if (!reuse || it->runs == 0) {
+      return std::nullopt;
     }
-    auto range = resolve_integer_range(desc, config);
-    auto rounded = static_cast<std::int64_t>(std::llround(value));
-    return std::clamp(rounded, range.lower, range.upper);
+    ctx.cached.fetch_add(1, std::memory_order_relaxed);
+    return it->fitness_sum / static_cast<double>(it->runs);
   }
 
-  [[nodiscard]] static core::ParameterValue decode_categorical(
-      double value, const core::ParameterDescriptor &desc,
-      const core::ParameterConfig *config) {
-    if (config && !config->discrete_choices.empty()) {
-      return decode_discrete_choice(value, config->discrete_choices);
+  // adds a finished run of parameters; returns the fitness to answer with,
+  // the mean over the configuration's runs under the average policy
+  [[nodiscard]] static double settle(const Context &ctx, const core::ParameterSet &parameters,
+                                     double fitness) {
+    std::scoped_lock lock(ctx.mutex);
+    auto &bucket = ctx.seen[core::hash_parameter_set(parameters)];
+    auto it = std::find_if(bucket.begin(), bucket.end(),
+                           [&](const SeenConfiguration &seen) { return seen.parameters == parameters; });
+    if (it == bucket.end()) {
+      it = bucket.insert(bucket.end(), SeenConfiguration{parameters, 0, 0.0});
     }
-    const auto &choices = desc.categorical_choices;
-    if (choices.empty()) {
-      throw core::ParameterValidationError(
-          "Categorical descriptor without choices: " + desc.name);
+    ++it->runs;
+    it->fitness_sum += fitness;
+    if (ctx.duplicate_policy == DuplicatePolicy::average) {
+      return it->fitness_sum / static_cast<double>(it->runs);
     }
-    auto index = static_cast<std::size_t>(
-        std::clamp<std::int64_t>(std::llround(value), 0,
-                                 static_cast<std::int64_t>(choices.size() - 1)));
-    return std::string{choices[index]};
+    return fitness;
   }
 
-  [[nodiscard]] static std::size_t compute_candidate_dimension(
-      const Context &ctx,
-      const std::vector<core::ParameterDescriptor> &descriptors) {
-    if (ctx.search_space) {
-      return ctx.search_space->get_optimization_dimension(
-          ctx.factory->parameter_space());
+  // pruned trials feed back their best-so-far, failed ones the penalty
+  [[nodiscard]] static double trial_fitness(const core::HyperparameterTrialRecord &record) {
+    constexpr double FAILED_TRIAL_PENALTY = 1e20;
+    return core::observed_objective(record).value_or(FAILED_TRIAL_PENALTY);
+  }
+
+  static void commit_trial(const Context &ctx, core::HyperparameterTrialRecord record) {
+    std::scoped_lock lock(ctx.mutex);
+    if (core::is_selectable_trial(record) &&
+        (!ctx.best_trial ||
+         record.optimization_result.best_fitness <
+             ctx.best_trial->optimization_result.best_fitness)) {
+      ctx.best_trial = record;
+    }
+    if (ctx.trials) {
+      ctx.trials->push_back(std::move(record));
     }
-    return descriptors.size();
   }
 
   [[nodiscard]] const Context &ensure_context() const {
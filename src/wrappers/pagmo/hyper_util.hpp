@@ -2,17 +2,22 @@
 
 #include "hpoea/core/budget_checks.hpp"
 #include "hpoea/core/error_classification.hpp"
+#include "hpoea/core/trial_history.hpp"
 #include "hyper_tuning_udp.hpp"
 
 #include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <functional>
 #include <limits>
 #include <memory>
+#include <pagmo/batch_evaluators/member_bfe.hpp>
+#include <pagmo/bfe.hpp>
 #include <pagmo/population.hpp>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -24,7 +29,8 @@ make_hyper_context(const core::IEvolutionaryAlgorithmFactory &factory,
                    const core::IProblem &problem,
                    const core::Budget &algorithm_budget,
                    unsigned long seed,
-                   std::shared_ptr<core::SearchSpace> search_space = nullptr) {
+                   std::shared_ptr<core::SearchSpace> search_space = nullptr,
+                   std::shared_ptr<core::TrialPruner> pruner = nullptr) {
     if (factory.parameter_space().empty()) {
         throw std::invalid_argument("algorithm has no tunable parameters");
     }
@@ -39,9 +45,72 @@ make_hyper_context(const core::IEvolutionaryAlgorithmFactory &factory,
     ctx->base_seed = seed;
     ctx->trials = std::make_shared<std::vector<core::HyperparameterTrialRecord>>();
     ctx->search_space = std::move(search_space);
+    ctx->pruner = std::move(pruner);
     return ctx;
 }
 
+// threads for evaluating an outer population, 0 means one per core.
+// results do not depend on the value, except for nelder-mead, which runs
+// that many restarts at once.
+inline core::ParameterDescriptor make_parallel_workers_descriptor() {
+    core::ParameterDescriptor d;
+    d.name = "parallel_workers";
+    d.type = core::ParameterType::Integer;
+    d.integer_range = core::IntegerRange{0, 1024};
+    d.default_value = std::int64_t{1};
+    return d;
+}
+
+// the configured parallel_workers, 0 resolved to one per core
+[[nodiscard]] inline std::size_t resolve_parallel_workers(const core::ParameterSet &configured) {
+    const auto workers = get_param<std::int64_t>(configured, "parallel_workers");
+    if (workers == 0) {
+        return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    return static_cast<std::size_t>(workers);
+}
+
+// applies parallel_workers to ctx and returns the batch evaluator that
+// routes outer populations through HyperparameterTuningProblem::batch_fitness
+inline pagmo::bfe make_hyper_batch_evaluator(HyperparameterTuningProblem::Context &ctx,
+                                             const core::ParameterSet &configured) {
+    ctx.workers = resolve_parallel_workers(configured);
+    return pagmo::bfe{pagmo::member_bfe{}};
+}
+
+// how candidates that repeat an earlier parameter set are scored,
+// see DuplicatePolicy
+inline core::ParameterDescriptor make_duplicate_policy_descriptor() {
+    core::ParameterDescriptor d;
+    d.name = "duplicate_policy";
+    d.type = core::ParameterType::Categorical;
+    d.categorical_choices = {"rerun", "reuse", "reuse_counted", "average"};
+    d.default_value = std::string{"rerun"};
+    return d;
+}
+
+// applies duplicate_policy to ctx, rerun when the space has no such parameter
+inline void apply_duplicate_policy(HyperparameterTuningProblem::Context &ctx,
+                                   const core::ParameterSet &configured) {
+    if (configured.find("duplicate_policy") == configured.end()) {
+        return;
+    }
+    const auto name = get_param<std::string>(configured, "duplicate_policy");
+    const auto policy = parse_duplicate_policy(name);
+    if (!policy) {
+        throw std::invalid_argument("unknown duplicate_policy: " + name);
+    }
+    ctx.duplicate_policy = *policy;
+}
+
+inline void fill_duplicate_usage(const HyperparameterTuningProblem::Context &ctx,
+                                 core::OptimizerRunUsage &usage) {
+    usage.objective_calls = ctx.get_objective_calls();
+    usage.proposed_configurations = ctx.get_proposed();
+    usage.duplicate_configurations = ctx.duplicates.load(std::memory_order_relaxed);
+    usage.cached_objective_calls = ctx.cached.load(std::memory_order_relaxed);
+}
+
 // outcome of an optimizer's evolve lambda
 // consumed by fill_hyper_result
 struct HyperEvolveOutcome {
@@ -97,7 +166,7 @@ inline core::HyperparameterOptimizationResult fill_hyper_result(
     result.optimizer_usage.wall_time =
         std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
     result.optimizer_usage.iterations = outcome.iterations;
-    result.optimizer_usage.objective_calls = ctx.get_evaluations();
+    fill_duplicate_usage(ctx, result.optimizer_usage);
     result.effective_optimizer_parameters = std::move(outcome.effective_parameters);
     return result;
 }
@@ -123,6 +192,8 @@ inline core::HyperparameterOptimizationResult fill_hyper_result(
 }
 
 // main entry point for running a hyper-optimization loop.
+// priors returns earlier trials, best first; the ones that fit the search
+// space become ctx.prior_points.
 //
 // AlgorithmSetup is a callable:
 //   (pagmo::problem &tuning_problem, const std::pair<pagmo::vector_double, pagmo::vector_double> &bounds,
@@ -137,6 +208,8 @@ core::HyperparameterOptimizationResult run_hyper_optimization(
     const core::Budget &algorithm_budget,
     unsigned long seed,
     const std::shared_ptr<core::SearchSpace> &search_space,
+    const std::shared_ptr<core::TrialPruner> &pruner,
+    const std::function<std::vector<core::HistoryTrial>()> &priors,
     AlgorithmSetup &&setup) {
 
     static_assert(
@@ -163,7 +236,12 @@ core::HyperparameterOptimizationResult run_hyper_optimization(
             search_space->validate(algorithm_factory.parameter_space());
         }
 
-        ctx = make_hyper_context(algorithm_factory, problem, algorithm_budget, seed, search_space);
+        ctx = make_hyper_context(algorithm_factory, problem, algorithm_budget, seed, search_space, pruner);
+        for (const auto &prior : priors()) {
+            if (auto point = HyperparameterTuningProblem::encode(*ctx, prior.parameters)) {
+                ctx->prior_points.push_back(std::move(*point));
+            }
+        }
         HyperparameterTuningProblem udp{ctx};
 
         const auto bounds = udp.get_bounds();
@@ -186,7 +264,7 @@ core::HyperparameterOptimizationResult run_hyper_optimization(
             std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
         // recover evals done before throw so crashed run still counts them
         if (ctx) {
-            result.optimizer_usage.objective_calls = ctx->get_evaluations();
+            fill_duplicate_usage(*ctx, result.optimizer_usage);
         }
         result.message = ex.what();
 
@@ -1,12 +1,20 @@
 #include "hpoea/wrappers/pagmo/nm_hyper.hpp"
 
+#include "hpoea/core/trial_runner.hpp"
 #include "budget_util.hpp"
 #include "hyper_util.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <limits>
-#include <string>
+#include <memory>
+#include <optional>
 #include <pagmo/algorithms/nlopt.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace {
 
@@ -39,6 +47,19 @@ ParameterSpace make_parameter_space() {
     d.default_value = 1e-8;
     space.add_descriptor(d);
 
+    // solves per wave under a function_evaluations budget; parallel_workers
+    // only sets the threads that run them
+    d = {};
+    d.name = "restarts_per_wave";
+    d.type = ParameterType::Integer;
+    d.integer_range = hpoea::core::IntegerRange{1, 1024};
+    d.default_value = std::int64_t{1};
+    space.add_descriptor(d);
+
+    space.add_descriptor(hpoea::pagmo_wrappers::make_population_init_descriptor());
+    space.add_descriptor(hpoea::pagmo_wrappers::make_parallel_workers_descriptor());
+    space.add_descriptor(hpoea::pagmo_wrappers::make_duplicate_policy_descriptor());
+
     return space;
 }
 
@@ -46,6 +67,54 @@ AlgorithmIdentity make_identity() {
     return {"NelderMead", "nlopt::neldermead", "2.x"};
 }
 
+// nlopt's NLOPT_MAXEVAL_REACHED
+constexpr int nlopt_maxeval_reached = 5;
+
+// stops a solve between two objective calls once the wall time is spent
+struct WallTimeSpent : std::runtime_error {
+    WallTimeSpent() : std::runtime_error("nelder-mead wall-time budget spent") {}
+};
+
+// the best point of one solve so far
+struct SolveProbe {
+    pagmo::vector_double best_x;
+    double best_f{std::numeric_limits<double>::infinity()};
+};
+
+// the tuning problem as one solve sees it: checks the deadline before
+// every objective call and reports to the solve's probe. with next_index
+// set, the solve numbers its trials from it instead of the shared counter.
+// a probe and next_index belong to one thread; the probe is read once its
+// solve has returned.
+struct ProbedTuningProblem {
+    hpoea::pagmo_wrappers::HyperparameterTuningProblem inner;
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    std::shared_ptr<SolveProbe> probe;
+    std::shared_ptr<std::size_t> next_index;
+
+    [[nodiscard]] std::pair<pagmo::vector_double, pagmo::vector_double> get_bounds() const {
+        return inner.get_bounds();
+    }
+
+    [[nodiscard]] pagmo::vector_double fitness(const pagmo::vector_double &candidate) const {
+        if (deadline && std::chrono::steady_clock::now() > *deadline) {
+            throw WallTimeSpent{};
+        }
+        auto fitness = next_index ? inner.fitness_at(candidate, (*next_index)++) : inner.fitness(candidate);
+        if (probe) {
+            if (fitness.front() < probe->best_f) {
+                probe->best_f = fitness.front();
+                probe->best_x = candidate;
+            }
+        }
+        return fitness;
+    }
+
+    [[nodiscard]] pagmo::thread_safety get_thread_safety() const { return pagmo::thread_safety::basic; }
+
+    [[nodiscard]] std::string get_name() const { return inner.get_name(); }
+};
+
 } // namespace
 
 namespace hpoea::pagmo_wrappers {
@@ -66,39 +135,57 @@ core::HyperparameterOptimizationResult PagmoNelderMeadHyperOptimizer::optimize(
 
     return run_hyper_optimization(
         algorithm_factory, problem, optimizer_budget, algorithm_budget,
-        seed, search_space_,
+        seed, search_space_, make_trial_pruner(),
+        [&] { return prior_trials(algorithm_factory, problem); },
         [&](pagmo::problem &tuning_problem,
             const auto &bounds,
             const core::Budget &budget,
-            std::chrono::steady_clock::time_point,
+            std::chrono::steady_clock::time_point start,
             HyperparameterTuningProblem::Context &ctx) -> HyperEvolveOutcome {
 
+            apply_duplicate_policy(ctx, configured_parameters_);
+
             const auto dim = bounds.first.size();
             const auto pop_size = static_cast<pagmo::population::size_type>(dim + 1);
 
-            // nlopt neldermead has no per-generation stepping
-            // so wall time can't bound it mid-run
             const auto configured_max_fevals =
                 get_param<std::int64_t>(configured_parameters_, "max_fevals");
             const auto xtol_rel = get_param<double>(configured_parameters_, "xtol_rel");
             const auto ftol_rel = get_param<double>(configured_parameters_, "ftol_rel");
+            const auto workers = resolve_parallel_workers(configured_parameters_);
+            const auto wave_width = static_cast<std::size_t>(
+                get_param<std::int64_t>(configured_parameters_, "restarts_per_wave"));
 
             const auto simplex = static_cast<std::size_t>(pop_size);
+            const auto init_kind = population_init_kind(configured_parameters_);
+
+            // nlopt neldermead has no per-generation stepping, so every
+            // objective call checks the wall time instead
+            std::optional<std::chrono::steady_clock::time_point> deadline;
+            if (budget.wall_time) {
+                deadline = start + *budget.wall_time;
+            }
+            const auto inner = *tuning_problem.extract<HyperparameterTuningProblem>();
 
-            // nlopt neldermead stops on its own tolerances before maxeval
-            // one capped solve underspends run budget so restart simplex from fresh seed until budget spent
-            // every solve reserves simplex plus nlopt's final re evaluation
-            // remainder below one solve stays unspent
-            auto solve_once = [&](std::size_t max_fevals_this, unsigned long restart) {
+            // one capped solve from start, the earlier points first; true
+            // when it was cut off at its cap rather than converged
+            auto solve_once = [&](std::size_t max_fevals_this, unsigned long restart,
+                                  const std::vector<pagmo::vector_double> &start_points,
+                                  const std::shared_ptr<SolveProbe> &probe,
+                                  std::shared_ptr<std::size_t> next_index) {
                 constexpr auto int_max = static_cast<std::size_t>(std::numeric_limits<int>::max());
                 const auto max_fevals_int = static_cast<int>(std::min(max_fevals_this, int_max));
-                pagmo::population population{tuning_problem, pop_size, derive_seed32(seed, restart)};
+                pagmo::problem solve_problem{ProbedTuningProblem{inner, deadline, probe, std::move(next_index)}};
+                auto population = make_population(solve_problem, pop_size, derive_seed32(seed, restart), init_kind,
+                                                  nullptr, start_points);
                 pagmo::nlopt nm_alg("neldermead");
                 nm_alg.set_maxeval(max_fevals_int);
                 nm_alg.set_xtol_rel(xtol_rel);
                 nm_alg.set_ftol_rel(ftol_rel);
                 pagmo::algorithm algorithm{nm_alg};
                 algorithm.evolve(population);
+                return static_cast<int>(algorithm.extract<pagmo::nlopt>()->get_last_opt_result()) ==
+                       nlopt_maxeval_reached;
             };
 
             std::size_t restarts = 0;
@@ -107,23 +194,94 @@ core::HyperparameterOptimizationResult PagmoNelderMeadHyperOptimizer::optimize(
             if (!budget.function_evaluations) {
                 // one solve capped by configured max_fevals
                 first_max_fevals = static_cast<std::size_t>(configured_max_fevals);
-                solve_once(first_max_fevals, 0);
                 restarts = 1;
+                try {
+                    (void)solve_once(first_max_fevals, 0, ctx.prior_points, std::make_shared<SolveProbe>(), nullptr);
+                } catch (const WallTimeSpent &) {
+                }
             } else {
+                // nlopt neldermead stops on its own tolerances before maxeval
+                // one capped solve underspends run budget so restart simplex from fresh seed until budget spent
+                // every solve reserves simplex plus nlopt's final re evaluation
+                // remainder below one solve stays unspent
+                // solves run in waves of up to restarts_per_wave on up to
+                // workers threads. a wave splits what is left evenly and
+                // ends when all its solves have, so a converged solve hands
+                // its unspent share to the next wave. solve k of a wave
+                // numbers its trials, and so seeds its runs, from its own
+                // range of indices. grants, start points and seeds thus
+                // follow from the finished waves alone, never from the
+                // thread count or timing
                 const auto target = *budget.function_evaluations;
                 const auto reserve = simplex + 1;  // construction + nlopt final re evaluation
+                // best point of the best solve cut off at its cap, which the
+                // next wave continues from while it holds the best so far
+                std::shared_ptr<SolveProbe> leader;
+                double best = std::numeric_limits<double>::infinity();
+                auto next_base = ctx.get_evaluations();
+
                 while (true) {
-                    const auto spent = ctx.get_evaluations();
-                    if (spent >= target) break;
-                    const auto remaining = target - spent;
+                    const auto spent = ctx.get_objective_calls();
+                    const auto remaining = target - std::min(target, spent);
                     // room for simplex, one internal step and final re eval
                     // nlopt reads set_maxeval(0) as "no cap"
-                    if (remaining < reserve + 1) break;
+                    const auto wave = std::min(wave_width, remaining / (reserve + 1));
+                    if (wave == 0) {
+                        break;
+                    }
                     const auto max_fevals_this = std::min<std::size_t>(
-                        static_cast<std::size_t>(configured_max_fevals), remaining - reserve);
-                    if (restarts == 0) first_max_fevals = max_fevals_this;
-                    solve_once(max_fevals_this, static_cast<unsigned long>(restarts));
-                    ++restarts;
+                        static_cast<std::size_t>(configured_max_fevals), remaining / wave - reserve);
+                    const auto first_restart = restarts;
+                    if (first_restart == 0) first_max_fevals = max_fevals_this;
+
+                    std::vector<std::vector<pagmo::vector_double>> start_points(wave);
+                    if (leader && leader->best_f <= best) {
+                        start_points[0].push_back(leader->best_x);
+                    } else if (first_restart == 0) {
+                        // the first simplex starts from the earlier trials
+                        start_points[0] = ctx.prior_points;
+                    }
+                    std::vector<std::shared_ptr<SolveProbe>> probes(wave);
+                    std::vector<char> capped(wave, 0);
+                    std::atomic<bool> out_of_time{false};
+                    // a solve makes at most its simplex, max_fevals_this
+                    // steps and the final re evaluation
+                    const auto range = max_fevals_this + reserve;
+                    core::run_indexed(
+                        wave, workers,
+                        [&](std::size_t k) {
+                            probes[k] = std::make_shared<SolveProbe>();
+                            try {
+                                capped[k] = solve_once(max_fevals_this, static_cast<unsigned long>(first_restart + k),
+                                                       start_points[k], probes[k],
+                                                       std::make_shared<std::size_t>(next_base + k * range));
+                            } catch (const WallTimeSpent &) {
+                                out_of_time.store(true, std::memory_order_relaxed);
+                            }
+                        },
+                        [] { return false; });
+                    restarts += wave;
+                    next_base += wave * range;
+
+                    // ties go to the earlier restart
+                    leader.reset();
+                    for (std::size_t k = 0; k < wave; ++k) {
+                        best = std::min(best, probes[k]->best_f);
+                        if (capped[k] && (!leader || probes[k]->best_f < leader->best_f)) {
+                            leader = probes[k];
+                        }
+                    }
+                    // a wave answered wholly from reused results would repeat forever
+                    if (out_of_time.load(std::memory_order_relaxed) || ctx.get_objective_calls() == spent) {
+                        break;
+                    }
+                }
+                // concurrent solves commit trials in completion order; the
+                // ranges leave gaps, so the trials are numbered afresh
+                std::stable_sort(ctx.trials->begin(), ctx.trials->end(),
+                                 [](const auto &lhs, const auto &rhs) { return lhs.trial_index < rhs.trial_index; });
+                for (std::size_t i = 0; i < ctx.trials->size(); ++i) {
+                    (*ctx.trials)[i].trial_index = i;
                 }
             }
 
@@ -1,19 +1,33 @@
 #pragma once
 
+#include "hpoea/core/batch_evaluator.hpp"
 #include "hpoea/core/error_classification.hpp"
 #include "hpoea/core/problem.hpp"
 
 #include <atomic>
 #include <cmath>
 #include <cstddef>
+#include <functional>
 #include <memory>
+#include <pagmo/threading.hpp>
 #include <pagmo/types.hpp>
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace hpoea::pagmo_wrappers {
 
+// thrown by an evaluation observer to end the evolve it runs in; passes
+// through the adapter unwrapped
+struct RunStopped : std::runtime_error {
+    RunStopped() : std::runtime_error("population run stopped") {}
+};
+
+// sees every successful evaluation with its decision vector, possibly from
+// several threads at once; may throw RunStopped
+using EvaluationObserver = std::function<void(const pagmo::vector_double &, double)>;
+
 class ProblemAdapter {
 public:
     ProblemAdapter() = default;
@@ -26,16 +40,25 @@ public:
                    std::shared_ptr<std::atomic<std::size_t>> eval_counter)
         : problem_(&problem), eval_counter_(std::move(eval_counter)) {}
 
+    // batch_evaluate backs pagmo's batch_fitness, picked up by member_bfe
+    ProblemAdapter(const hpoea::core::IProblem &problem,
+                   std::shared_ptr<std::atomic<std::size_t>> eval_counter,
+                   hpoea::core::BatchEvaluateFn batch_evaluate)
+        : problem_(&problem), eval_counter_(std::move(eval_counter)), batch_evaluate_(std::move(batch_evaluate)) {}
+
+    // set before the adapter is copied into a pagmo::problem
+    void set_observer(EvaluationObserver observer) { observer_ = std::move(observer); }
+
     [[nodiscard]] pagmo::vector_double fitness(const pagmo::vector_double &decision_vector) const {
+        double value = 0.0;
         try {
-            const auto value = problem().evaluate(decision_vector);
+            value = problem().evaluate(decision_vector);
             if (!std::isfinite(value)) {
                 throw core::EvaluationFailure("problem evaluation returned non-finite value");
             }
             if (eval_counter_) {
                 eval_counter_->fetch_add(1, std::memory_order_relaxed);
             }
-            return {value};
         } catch (const core::EvaluationFailure &) {
             throw;
         } catch (const std::exception &ex) {
@@ -43,8 +66,59 @@ public:
         } catch (...) {
             throw core::EvaluationFailure("problem evaluation failed with unknown error");
         }
+        if (observer_) {
+            observer_(decision_vector, value);
+        }
+        return {value};
     }
 
+    // dvs holds the decision vectors back to back
+    [[nodiscard]] pagmo::vector_double batch_fitness(const pagmo::vector_double &dvs) const {
+        if (!batch_evaluate_) {
+            throw std::logic_error("ProblemAdapter has no batch evaluator");
+        }
+        const auto &reference = problem();
+        const auto dimension = reference.dimension();
+        std::vector<std::vector<double>> batch;
+        if (dimension > 0) {
+            batch.reserve(dvs.size() / dimension);
+            for (auto it = dvs.begin(); it != dvs.end(); it += static_cast<std::ptrdiff_t>(dimension)) {
+                batch.emplace_back(it, it + static_cast<std::ptrdiff_t>(dimension));
+            }
+        }
+        std::vector<double> values;
+        try {
+            values = batch_evaluate_(reference, batch);
+            if (values.size() != batch.size()) {
+                throw core::EvaluationFailure("batch evaluator returned " + std::to_string(values.size()) +
+                                              " fitness values for " + std::to_string(batch.size()) +
+                                              " candidates");
+            }
+            for (const auto value : values) {
+                if (!std::isfinite(value)) {
+                    throw core::EvaluationFailure("problem evaluation returned non-finite value");
+                }
+            }
+            if (eval_counter_) {
+                eval_counter_->fetch_add(values.size(), std::memory_order_relaxed);
+            }
+        } catch (const core::EvaluationFailure &) {
+            throw;
+        } catch (const std::exception &ex) {
+            throw core::EvaluationFailure(ex.what());
+        } catch (...) {
+            throw core::EvaluationFailure("batch evaluation failed with unknown error");
+        }
+        if (observer_) {
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                observer_(batch[i], values[i]);
+            }
+        }
+        return values;
+    }
+
+    [[nodiscard]] bool has_batch_fitness() const { return static_cast<bool>(batch_evaluate_); }
+
     [[nodiscard]] std::pair<pagmo::vector_double, pagmo::vector_double> get_bounds() const {
         const auto &reference = problem();
         auto lower = reference.lower_bounds();
@@ -73,6 +147,22 @@ public:
 
     [[nodiscard]] bool is_stochastic() const { return problem().is_stochastic(); }
 
+    // IProblem::evaluate is const and already shared across trial threads,
+    // the counter is atomic, so thread_bfe may call fitness on one instance
+    [[nodiscard]] pagmo::thread_safety get_thread_safety() const { return pagmo::thread_safety::constant; }
+
+    // the problem pointer, batch evaluator and observer are not serialized
+    // a restored adapter must be rebound before use
+    void rebind(const ProblemAdapter &bound) {
+        problem_ = bound.problem_;
+        eval_counter_ = bound.eval_counter_;
+        batch_evaluate_ = bound.batch_evaluate_;
+        observer_ = bound.observer_;
+    }
+
+    template <typename Archive>
+    void serialize(Archive &, unsigned) {}
+
 private:
     [[nodiscard]] const hpoea::core::IProblem &problem() const {
         if (problem_ == nullptr) {
@@ -83,6 +173,8 @@ private:
 
     const hpoea::core::IProblem *problem_{nullptr};
     std::shared_ptr<std::atomic<std::size_t>> eval_counter_;
+    hpoea::core::BatchEvaluateFn batch_evaluate_;
+    EvaluationObserver observer_;
 };
 
 } // namespace hpoea::pagmo_wrappers
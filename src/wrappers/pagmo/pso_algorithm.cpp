@@ -5,6 +5,7 @@
 
 #include <pagmo/algorithm.hpp>
 #include <pagmo/algorithms/pso.hpp>
+#include <pagmo/algorithms/pso_gen.hpp>
 
 namespace {
 
@@ -56,6 +57,8 @@ ParameterSpace make_parameter_space() {
 
     space.add_descriptor(hpoea::pagmo_wrappers::make_generations_descriptor());
 
+    space.add_descriptor(hpoea::pagmo_wrappers::make_population_init_descriptor());
+
     return space;
 }
 
@@ -63,6 +66,11 @@ AlgorithmIdentity make_identity() {
     return {"ParticleSwarmOptimization", "pagmo::pso", "2.x"};
 }
 
+// pagmo::pso has no batch hook, so batching every generation means pso_gen
+bool batches_generations(const hpoea::core::BatchEvaluatorConfig &config) {
+    return config.kind != hpoea::core::BatchEvaluatorKind::None && !config.keep_trajectory;
+}
+
 } // namespace
 
 namespace hpoea::pagmo_wrappers {
@@ -78,19 +86,33 @@ core::OptimizationResult PagmoParticleSwarmOptimization::run(const core::IProble
     const auto eta2 = get_param<double>(configured_parameters_, "eta2");
     const auto max_velocity = get_param<double>(configured_parameters_, "max_velocity");
     const auto variant = static_cast<unsigned>(get_param<std::int64_t>(configured_parameters_, "variant"));
+    const auto generational = batches_generations(run_options_.batch_evaluator);
 
     return run_population(
         problem,
         budget,
         configured_parameters_,
         seed,
-        [=](unsigned generations, unsigned algo_seed) {
+        run_options_,
+        [=](const AlgorithmRequest &request) {
+            if (generational && request.bfe != nullptr) {
+                // generational variant, evaluates the whole swarm in one batch
+                pagmo::pso_gen algorithm{request.generations, omega, eta1, eta2, max_velocity,
+                                         variant, 2u, 4u, request.stepped, request.seed32};
+                algorithm.set_bfe(*request.bfe);
+                return pagmo::algorithm{std::move(algorithm)};
+            }
             return pagmo::algorithm{
-                pagmo::pso(generations, omega, eta1, eta2, max_velocity,
-                           variant, 2u, 4u, false, algo_seed)};
+                pagmo::pso(request.generations, omega, eta1, eta2, max_velocity,
+                           variant, 2u, 4u, request.stepped, request.seed32)};
         });
 }
 
+void PagmoParticleSwarmOptimization::set_batch_evaluator(const core::BatchEvaluatorConfig &config) {
+    PagmoAlgorithmBase::set_batch_evaluator(config);
+    identity_.implementation = batches_generations(config) ? "pagmo::pso_gen" : "pagmo::pso";
+}
+
 std::unique_ptr<core::IEvolutionaryAlgorithm> PagmoParticleSwarmOptimization::clone() const {
     return std::make_unique<PagmoParticleSwarmOptimization>(*this);
 }
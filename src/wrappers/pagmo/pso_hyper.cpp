@@ -4,8 +4,13 @@
 #include "hyper_util.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <limits>
+#include <memory>
+#include <optional>
 #include <pagmo/algorithms/pso.hpp>
+#include <pagmo/algorithms/pso_gen.hpp>
+#include <stdexcept>
 
 namespace {
 
@@ -60,6 +65,10 @@ ParameterSpace make_parameter_space() {
     d.default_value = 0.5;
     space.add_descriptor(d);
 
+    space.add_descriptor(hpoea::pagmo_wrappers::make_population_init_descriptor());
+    space.add_descriptor(hpoea::pagmo_wrappers::make_parallel_workers_descriptor());
+    space.add_descriptor(hpoea::pagmo_wrappers::make_duplicate_policy_descriptor());
+
     return space;
 }
 
@@ -67,6 +76,70 @@ AlgorithmIdentity make_identity() {
     return {"PSOHyperOptimizer", "pagmo::pso", "2.x"};
 }
 
+// stops the swarm between two generations once a budget is spent
+struct GenerationBudgetSpent : std::runtime_error {
+    GenerationBudgetSpent() : std::runtime_error("pso optimizer budget spent") {}
+};
+
+// checks the budgets before a generation of batch candidates is
+// evaluated and counts the generations let through
+struct GenerationGate {
+    const hpoea::pagmo_wrappers::HyperparameterTuningProblem::Context *ctx{nullptr};
+    std::optional<std::size_t> function_evaluations;
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    std::shared_ptr<std::size_t> generations;
+
+    void admit(std::size_t batch) const {
+        if (deadline && std::chrono::steady_clock::now() > *deadline) {
+            throw GenerationBudgetSpent{};
+        }
+        if (function_evaluations && ctx->get_objective_calls() + batch > *function_evaluations) {
+            throw GenerationBudgetSpent{};
+        }
+        ++*generations;
+    }
+};
+
+// pso_gen's batch evaluator, member_bfe behind the gate. pso_gen
+// evaluates one whole generation per call
+struct GatedBatchEvaluator {
+    GenerationGate gate;
+
+    [[nodiscard]] pagmo::vector_double operator()(pagmo::problem &problem,
+                                                  const pagmo::vector_double &candidates) const {
+        gate.admit(candidates.size() / problem.get_nx());
+        return pagmo::member_bfe{}(problem, candidates);
+    }
+
+    [[nodiscard]] std::string get_name() const { return "pso generation gate"; }
+};
+
+// the tuning problem behind the gate for the serial pagmo::pso, which
+// evaluates its particles one at a time: the first particle of every
+// generation passes the gate for the whole swarm
+struct GatedTuningProblem {
+    hpoea::pagmo_wrappers::HyperparameterTuningProblem inner;
+    GenerationGate gate;
+    std::size_t swarm_size{1};
+    std::shared_ptr<std::size_t> calls;
+
+    [[nodiscard]] std::pair<pagmo::vector_double, pagmo::vector_double> get_bounds() const {
+        return inner.get_bounds();
+    }
+
+    [[nodiscard]] pagmo::vector_double fitness(const pagmo::vector_double &candidate) const {
+        if (*calls % swarm_size == 0) {
+            gate.admit(swarm_size);
+        }
+        ++*calls;
+        return inner.fitness(candidate);
+    }
+
+    [[nodiscard]] pagmo::thread_safety get_thread_safety() const { return pagmo::thread_safety::basic; }
+
+    [[nodiscard]] std::string get_name() const { return inner.get_name(); }
+};
+
 } // namespace
 
 namespace hpoea::pagmo_wrappers {
@@ -78,6 +151,12 @@ core::HyperparameterOptimizerPtr PagmoPsoHyperOptimizer::clone() const {
     return std::make_unique<PagmoPsoHyperOptimizer>(*this);
 }
 
+void PagmoPsoHyperOptimizer::configure(const core::ParameterSet &parameters) {
+    PagmoHyperOptimizerBase::configure(parameters);
+    identity_.implementation =
+        resolve_parallel_workers(configured_parameters_) > 1 ? "pagmo::pso_gen" : "pagmo::pso";
+}
+
 core::HyperparameterOptimizationResult PagmoPsoHyperOptimizer::optimize(
     const core::IEvolutionaryAlgorithmFactory &algorithm_factory,
     const core::IProblem &problem,
@@ -87,12 +166,15 @@ core::HyperparameterOptimizationResult PagmoPsoHyperOptimizer::optimize(
 
     return run_hyper_optimization(
         algorithm_factory, problem, optimizer_budget, algorithm_budget,
-        seed, search_space_,
+        seed, search_space_, make_trial_pruner(),
+        [&] { return prior_trials(algorithm_factory, problem); },
         [&](pagmo::problem &tuning_problem,
             const auto &bounds,
             const core::Budget &budget,
-            std::chrono::steady_clock::time_point,
-            HyperparameterTuningProblem::Context &) -> HyperEvolveOutcome {
+            std::chrono::steady_clock::time_point start,
+            HyperparameterTuningProblem::Context &ctx) -> HyperEvolveOutcome {
+
+            apply_duplicate_policy(ctx, configured_parameters_);
 
             const auto omega = get_param<double>(configured_parameters_, "omega");
             const auto eta1 = get_param<double>(configured_parameters_, "eta1");
@@ -120,21 +202,50 @@ core::HyperparameterOptimizationResult PagmoPsoHyperOptimizer::optimize(
                 configured_generations, budget, static_cast<std::size_t>(pop_size));
             const auto gen_u = static_cast<unsigned>(std::min(generations, uint_max));
 
-            // pso must run as one N-generation evolve
-            // so only the pre-run clamp can bound it
-            pagmo::algorithm algorithm{
-                pagmo::pso(gen_u, omega, eta1, eta2, max_vel, variant, 2u, 4u, false, seed32)};
+            // pso runs as one N-generation evolve: pso_gen's memory mode
+            // restarts the particles from their best positions, so
+            // stepping it would change the run. a gate checks the budgets
+            // between generations instead and the trials made so far keep
+            // the best-so-far. one worker keeps pagmo::pso, more switch to
+            // pso_gen, which hands each whole swarm to the batch evaluator
+            const auto bfe = make_hyper_batch_evaluator(ctx, configured_parameters_);
+            auto generations_run = std::make_shared<std::size_t>(0);
+            GenerationGate gate{&ctx, budget.function_evaluations, std::nullopt, generations_run};
+            if (budget.wall_time) {
+                gate.deadline = start + *budget.wall_time;
+            }
 
-            pagmo::population population{tuning_problem, pop_size, derive_seed32(seed, 0)};
+            auto population = make_population(tuning_problem, pop_size, derive_seed32(seed, 0),
+                                              population_init_kind(configured_parameters_), &bfe,
+                                              ctx.prior_points);
             if (gen_u > 0) {
-                population = algorithm.evolve(population);
+                try {
+                    if (ctx.workers > 1) {
+                        pagmo::pso_gen pso{gen_u, omega, eta1, eta2, max_vel, variant, 2u, 4u, false, seed32};
+                        pso.set_bfe(pagmo::bfe{GatedBatchEvaluator{gate}});
+                        (void)pagmo::algorithm{pso}.evolve(population);
+                    } else {
+                        pagmo::population swarm{
+                            pagmo::problem{GatedTuningProblem{*tuning_problem.extract<HyperparameterTuningProblem>(),
+                                                              gate, static_cast<std::size_t>(pop_size),
+                                                              std::make_shared<std::size_t>(0)}},
+                            0u, derive_seed32(seed, 0)};
+                        for (pagmo::population::size_type i = 0; i < population.size(); ++i) {
+                            swarm.push_back(population.get_x()[i], population.get_f()[i]);
+                        }
+                        pagmo::algorithm algorithm{
+                            pagmo::pso(gen_u, omega, eta1, eta2, max_vel, variant, 2u, 4u, false, seed32)};
+                        (void)algorithm.evolve(swarm);
+                    }
+                } catch (const GenerationBudgetSpent &) {
+                }
             }
 
             auto effective_parameters = configured_parameters_;
             effective_parameters.insert_or_assign("generations", static_cast<std::int64_t>(generations));
 
             HyperEvolveOutcome outcome;
-            outcome.iterations = generations;
+            outcome.iterations = *generations_run;
             outcome.effective_parameters = std::move(effective_parameters);
             if (generations == 0 && configured_generations > 0) {
                 outcome.starved_message =
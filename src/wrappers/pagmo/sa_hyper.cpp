@@ -67,6 +67,8 @@ ParameterSpace make_parameter_space() {
     d.default_value = 1.0;
     space.add_descriptor(d);
 
+    space.add_descriptor(hpoea::pagmo_wrappers::make_duplicate_policy_descriptor());
+
     return space;
 }
 
@@ -102,13 +104,16 @@ PagmoSimulatedAnnealingHyperOptimizer::optimize(
 
     return run_hyper_optimization(
         algorithm_factory, problem, optimizer_budget, algorithm_budget,
-        seed, search_space_,
+        seed, search_space_, make_trial_pruner(),
+        [&] { return prior_trials(algorithm_factory, problem); },
         [&](pagmo::problem &tuning_problem,
             const auto &bounds,
             const core::Budget &budget,
             std::chrono::steady_clock::time_point start,
             HyperparameterTuningProblem::Context &ctx) -> HyperEvolveOutcome {
 
+            apply_duplicate_policy(ctx, configured_parameters_);
+
             if (starves_initial_population(budget, 1)) {
                 return starved_outcome(configured_parameters_, "iterations", 1, "initial evaluation");
             }
@@ -133,7 +138,11 @@ PagmoSimulatedAnnealingHyperOptimizer::optimize(
             pagmo::simulated_annealing sa_alg(ts, tf, n_T_adj, n_range_adj, bin_size, start_range, seed32);
             pagmo::algorithm algorithm{sa_alg};
 
-            pagmo::population population{tuning_problem, 1, derive_seed32(seed, 0)};
+            // annealing starts from the best earlier trial when there is one
+            pagmo::population population{tuning_problem, ctx.prior_points.empty() ? 1u : 0u, derive_seed32(seed, 0)};
+            if (!ctx.prior_points.empty()) {
+                population.push_back(ctx.prior_points.front());
+            }
 
             const auto configured_iterations =
                 get_param<std::int64_t>(configured_parameters_, "iterations");
@@ -173,7 +182,7 @@ PagmoSimulatedAnnealingHyperOptimizer::optimize(
                         break;
                 }
                 if (budget.function_evaluations &&
-                    ctx.get_evaluations() >= *budget.function_evaluations)
+                    ctx.get_objective_calls() >= *budget.function_evaluations)
                     break;
             }
 
@@ -46,6 +46,8 @@ ParameterSpace make_parameter_space() {
     d.default_value = false;
     space.add_descriptor(d);
 
+    space.add_descriptor(hpoea::pagmo_wrappers::make_population_init_descriptor());
+
     return space;
 }
 
@@ -74,10 +76,11 @@ core::OptimizationResult PagmoSelfAdaptiveDE::run(const core::IProblem &problem,
         budget,
         configured_parameters_,
         seed,
-        [=](unsigned generations, unsigned algo_seed) {
+        run_options_,
+        [=](const AlgorithmRequest &request) {
             return pagmo::algorithm{
-                pagmo::sade(generations, variant, variant_adptv, ftol, xtol,
-                            memory, algo_seed)};
+                pagmo::sade(request.generations, variant, variant_adptv, ftol, xtol,
+                            memory || request.stepped, request.seed32)};
         });
 }
 
@@ -33,6 +33,8 @@ ParameterSpace make_parameter_space() {
     d.default_value = 0.02;
     space.add_descriptor(d);
 
+    space.add_descriptor(hpoea::pagmo_wrappers::make_population_init_descriptor());
+
     return space;
 }
 
@@ -58,9 +60,10 @@ core::OptimizationResult PagmoSga::run(const core::IProblem &problem,
         budget,
         configured_parameters_,
         seed,
-        [=](unsigned generations, unsigned algo_seed) {
-            return pagmo::algorithm{
-                pagmo::sga(generations, cr, 1.0, mp, 1.0, 2u, "exponential", "polynomial", "tournament", algo_seed)};
+        run_options_,
+        [=](const AlgorithmRequest &request) {
+            return pagmo::algorithm{pagmo::sga(request.generations, cr, 1.0, mp, 1.0, 2u, "exponential",
+                                               "polynomial", "tournament", request.seed32)};
         });
 }
 
@@ -0,0 +1,278 @@
+#include "test_harness.hpp"
+#include "test_fixtures.hpp"
+
+#include "hpoea/core/ask_tell.hpp"
+#include "hpoea/core/error_classification.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// evaluates budget.function_evaluations seeded random points in
+// generations of the given size; generations go through a custom batch
+// evaluator when one is set, otherwise one point at a time
+class ProbeAlgorithm final : public hpoea::core::IEvolutionaryAlgorithm {
+public:
+    explicit ProbeAlgorithm(std::size_t generation = 1) : generation_(generation) {}
+
+    [[nodiscard]] const hpoea::core::AlgorithmIdentity &identity() const noexcept override { return identity_; }
+
+    [[nodiscard]] const hpoea::core::ParameterSpace &parameter_space() const noexcept override { return space_; }
+
+    void configure(const hpoea::core::ParameterSet &) override {}
+
+    void set_batch_evaluator(const hpoea::core::BatchEvaluatorConfig &config) override {
+        if (generation_ == 1u) {
+            IEvolutionaryAlgorithm::set_batch_evaluator(config);
+            return;
+        }
+        batch_ = config;
+    }
+
+    [[nodiscard]] hpoea::core::OptimizationResult run(const hpoea::core::IProblem &problem,
+                                                      const hpoea::core::Budget &budget, unsigned long seed) override {
+        hpoea::core::OptimizationResult result;
+        result.seed = seed;
+        result.requested_budget = budget;
+        std::mt19937_64 rng{seed};
+        std::uniform_real_distribution<double> unit{-1.0, 1.0};
+        try {
+            const auto total = budget.function_evaluations.value_or(10u);
+            for (std::size_t done = 0; done < total;) {
+                std::vector<std::vector<double>> generation(std::min(generation_, total - done),
+                                                            std::vector<double>(problem.dimension()));
+                for (auto &x : generation) {
+                    for (auto &v : x) {
+                        v = unit(rng);
+                    }
+                }
+                std::vector<double> fitness;
+                if (batch_.kind == hpoea::core::BatchEvaluatorKind::Custom) {
+                    fitness = batch_.evaluate(problem, generation);
+                } else {
+                    for (const auto &x : generation) {
+                        fitness.push_back(problem.evaluate(x));
+                    }
+                }
+                for (std::size_t i = 0; i < generation.size(); ++i) {
+                    ++result.algorithm_usage.function_evaluations;
+                    if (fitness[i] < result.best_fitness) {
+                        result.best_fitness = fitness[i];
+                        result.best_solution = generation[i];
+                    }
+                }
+                done += generation.size();
+            }
+            result.status = hpoea::core::RunStatus::Success;
+        } catch (const std::exception &ex) {
+            const auto classified = hpoea::core::classify_exception(ex);
+            result.status = classified.status;
+            result.error_info = classified.error_info;
+            result.message = ex.what();
+        }
+        return result;
+    }
+
+    [[nodiscard]] hpoea::core::EvolutionaryAlgorithmPtr clone() const override {
+        return std::make_unique<ProbeAlgorithm>(*this);
+    }
+
+private:
+    hpoea::core::AlgorithmIdentity identity_{"Probe", "tests", "1.0"};
+    hpoea::core::ParameterSpace space_;
+    std::size_t generation_;
+    hpoea::core::BatchEvaluatorConfig batch_;
+};
+
+std::vector<double> evaluate_all(const hpoea::core::IProblem &problem, const std::vector<std::vector<double>> &batch) {
+    std::vector<double> fitness;
+    for (const auto &x : batch) {
+        fitness.push_back(problem.evaluate(x));
+    }
+    return fitness;
+}
+
+void test_stepped_run_matches_run(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(3);
+    hpoea::core::Budget budget;
+    budget.function_evaluations = 25u;
+
+    ProbeAlgorithm algorithm;
+    const auto direct = algorithm.run(problem, budget, 7UL);
+    auto run = algorithm.start(problem, budget, 7UL);
+    const auto stepped = hpoea::core::drive_ask_tell(*run, problem);
+    HPOEA_V2_CHECK(runner, stepped.status == hpoea::core::RunStatus::Success, "stepped run succeeds");
+    HPOEA_V2_CHECK(runner, stepped.best_fitness == direct.best_fitness, "stepped run matches run()");
+    HPOEA_V2_CHECK(runner, stepped.best_solution == direct.best_solution, "stepped solution matches run()");
+    HPOEA_V2_CHECK(runner, stepped.algorithm_usage.function_evaluations == 25u, "stepped run spends budget");
+}
+
+void test_interleaved_batches_runs(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(3);
+    hpoea::core::Budget budget;
+    budget.function_evaluations = 25u;
+
+    ProbeAlgorithm algorithm;
+    std::vector<hpoea::core::AskTellRunPtr> runs;
+    for (unsigned long seed = 1; seed <= 4; ++seed) {
+        runs.push_back(algorithm.start(problem, budget, seed));
+    }
+    std::vector<std::size_t> batch_sizes;
+    const auto results = hpoea::core::run_interleaved(
+        runs, problem, [&](const hpoea::core::IProblem &p, const std::vector<std::vector<double>> &batch) {
+            batch_sizes.push_back(batch.size());
+            return evaluate_all(p, batch);
+        },
+        4u);
+    HPOEA_V2_REQUIRE(runner, results.size() == 4u, "interleaved returns one result per run");
+    HPOEA_V2_CHECK(runner, batch_sizes.size() == 25u, "interleaved rounds match per-run evaluations");
+    bool all_full = true;
+    for (auto size : batch_sizes) {
+        all_full = all_full && size == 4u;
+    }
+    HPOEA_V2_CHECK(runner, all_full, "each round batches one candidate from every run");
+    for (unsigned long seed = 1; seed <= 4; ++seed) {
+        const auto direct = algorithm.run(problem, budget, seed);
+        HPOEA_V2_CHECK(runner, results[seed - 1].best_fitness == direct.best_fitness,
+                       "interleaved result matches run()");
+        HPOEA_V2_CHECK(runner, results[seed - 1].seed == seed, "interleaved results keep run order");
+    }
+}
+
+void test_interleaved_bounds_active_runs(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(3);
+    hpoea::core::Budget budget;
+    budget.function_evaluations = 10u;
+
+    ProbeAlgorithm algorithm;
+    std::vector<hpoea::core::AskTellRunPtr> runs;
+    for (unsigned long seed = 1; seed <= 7; ++seed) {
+        runs.push_back(algorithm.start(problem, budget, seed));
+    }
+    std::vector<std::size_t> batch_sizes;
+    const auto results = hpoea::core::run_interleaved(
+        runs, problem,
+        [&](const hpoea::core::IProblem &p, const std::vector<std::vector<double>> &batch) {
+            batch_sizes.push_back(batch.size());
+            return evaluate_all(p, batch);
+        },
+        2u);
+    HPOEA_V2_REQUIRE(runner, results.size() == 7u, "bounded interleave returns one result per run");
+    std::size_t evaluated = 0;
+    bool bounded = true;
+    for (auto size : batch_sizes) {
+        evaluated += size;
+        bounded = bounded && size <= 2u;
+    }
+    HPOEA_V2_CHECK(runner, bounded, "no round steps more than max_active runs");
+    HPOEA_V2_CHECK(runner, evaluated == 70u, "every run still spends its budget");
+    HPOEA_V2_CHECK(runner, batch_sizes.size() == 40u, "a finished run frees its slot for the next");
+    for (unsigned long seed = 1; seed <= 7; ++seed) {
+        const auto direct = algorithm.run(problem, budget, seed);
+        HPOEA_V2_CHECK(runner, results[seed - 1].best_fitness == direct.best_fitness,
+                       "bounded interleave matches run()");
+    }
+}
+
+void test_interleaved_batches_generations(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(3);
+    hpoea::core::Budget budget;
+    budget.function_evaluations = 12u;
+
+    ProbeAlgorithm algorithm(5);
+    std::vector<hpoea::core::AskTellRunPtr> runs;
+    runs.push_back(algorithm.start(problem, budget, 1UL));
+    runs.push_back(algorithm.start(problem, budget, 2UL));
+    std::vector<std::size_t> batch_sizes;
+    const auto results = hpoea::core::run_interleaved(
+        runs, problem,
+        [&](const hpoea::core::IProblem &p, const std::vector<std::vector<double>> &batch) {
+            batch_sizes.push_back(batch.size());
+            return evaluate_all(p, batch);
+        },
+        2u);
+    HPOEA_V2_CHECK(runner, (batch_sizes == std::vector<std::size_t>{10u, 10u, 4u}),
+                   "each round batches a whole generation from every run");
+    for (unsigned long seed = 1; seed <= 2; ++seed) {
+        const auto direct = algorithm.run(problem, budget, seed);
+        HPOEA_V2_CHECK(runner, results[seed - 1].best_fitness == direct.best_fitness,
+                       "generation batches match run()");
+        HPOEA_V2_CHECK(runner, results[seed - 1].algorithm_usage.function_evaluations == 12u,
+                       "generation batches spend the budget");
+    }
+}
+
+void test_batch_failure_fails_runs(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(3);
+    hpoea::core::Budget budget;
+    budget.function_evaluations = 25u;
+
+    ProbeAlgorithm algorithm;
+    std::vector<hpoea::core::AskTellRunPtr> runs;
+    runs.push_back(algorithm.start(problem, budget, 1UL));
+    runs.push_back(algorithm.start(problem, budget, 2UL));
+    const auto results = hpoea::core::run_interleaved(
+        runs, problem,
+        [](const hpoea::core::IProblem &, const std::vector<std::vector<double>> &) -> std::vector<double> {
+            throw hpoea::core::EvaluationFailure("batch evaluator down");
+        });
+    HPOEA_V2_CHECK(runner, results[0].status == hpoea::core::RunStatus::FailedEvaluation,
+                   "batch failure reaches the first run");
+    HPOEA_V2_CHECK(runner, results[1].status == hpoea::core::RunStatus::FailedEvaluation,
+                   "batch failure reaches the second run");
+}
+
+void test_short_batch_fails_runs(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(3);
+    hpoea::core::Budget budget;
+    budget.function_evaluations = 25u;
+
+    ProbeAlgorithm algorithm;
+    std::vector<hpoea::core::AskTellRunPtr> runs;
+    runs.push_back(algorithm.start(problem, budget, 1UL));
+    const auto results = hpoea::core::run_interleaved(
+        runs, problem, [](const hpoea::core::IProblem &, const std::vector<std::vector<double>> &) {
+            return std::vector<double>{};
+        });
+    HPOEA_V2_CHECK(runner, results[0].status == hpoea::core::RunStatus::InternalError,
+                   "short batch result fails the run");
+}
+
+void test_ask_tell_protocol(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(3);
+    hpoea::core::Budget budget;
+    budget.function_evaluations = 25u;
+
+    ProbeAlgorithm algorithm;
+    auto run = algorithm.start(problem, budget, 3UL);
+    HPOEA_V2_CHECK(runner, run->ask().size() == 1u, "first ask yields one candidate");
+    HPOEA_V2_CHECK(runner, run->ask().size() == 1u, "repeated ask returns the same pending candidate");
+    bool rejected = false;
+    try {
+        run->tell({1.0, 2.0});
+    } catch (const std::invalid_argument &) {
+        rejected = true;
+    }
+    HPOEA_V2_CHECK(runner, rejected, "tell rejects a wrong-sized fitness batch");
+    run.reset();
+    HPOEA_V2_CHECK(runner, true, "abandoning a suspended run does not hang");
+}
+
+} // namespace
+
+int main() {
+    hpoea::tests_v2::TestRunner runner;
+    test_stepped_run_matches_run(runner);
+    test_interleaved_batches_runs(runner);
+    test_interleaved_bounds_active_runs(runner);
+    test_interleaved_batches_generations(runner);
+    test_batch_failure_fails_runs(runner);
+    test_short_batch_fails_runs(runner);
+    test_ask_tell_protocol(runner);
+    return runner.summarize("ask_tell_tests");
+}
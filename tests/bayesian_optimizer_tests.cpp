@@ -0,0 +1,199 @@
+#include "test_harness.hpp"
+#include "test_fixtures.hpp"
+#include "test_utils.hpp"
+
+#include "hpoea/core/bayesian_optimizer.hpp"
+#include "hpoea/core/gaussian_process.hpp"
+#include "hpoea/core/parameter_sampling.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+hpoea::core::ParameterSpace make_algorithm_space() {
+    using namespace hpoea::tests_v2;
+    return make_space({continuous_descriptor("rate", 1e-3, 10.0, 1.0), continuous_descriptor("shift", -1.0, 1.0, 0.0),
+                       integer_descriptor("width", 1, 4, 1), categorical_descriptor("mode", {"a", "b", "c"}, "a")});
+}
+
+// smooth in log(rate) and shift, minimum 0 at rate 0.1, shift 0.3, width 2, mode b
+hpoea::tests_v2::BowlFactory make_factory() {
+    return {make_algorithm_space(), [](const hpoea::tests_v2::BowlRun &run) {
+                const auto rate = std::log10(std::get<double>(run.parameters.at("rate"))) + 1.0;
+                const auto shift = std::get<double>(run.parameters.at("shift")) - 0.3;
+                const auto width = static_cast<double>(std::get<std::int64_t>(run.parameters.at("width")) - 2);
+                const auto mode = std::get<std::string>(run.parameters.at("mode")) == "b" ? 0.0 : 0.5;
+                return rate * rate + shift * shift + 0.1 * width * width + mode;
+            }};
+}
+
+std::shared_ptr<hpoea::core::SearchSpace> log_rate_search() {
+    auto search = std::make_shared<hpoea::core::SearchSpace>();
+    search->optimize("rate", hpoea::core::ContinuousRange{1e-3, 10.0}, hpoea::core::Transform::log);
+    return search;
+}
+
+void test_unit_cube_encoding(hpoea::tests_v2::TestRunner &runner) {
+    const auto space = make_algorithm_space();
+    auto search = log_rate_search();
+    search->fix("width", std::int64_t{3});
+    const hpoea::core::UnitCubeEncoding encoding(space, search.get());
+    HPOEA_V2_REQUIRE(runner, encoding.dimension() == 3u, "fixed parameters take no coordinate");
+
+    const auto low = encoding.decode({0.0, 0.0, 0.0});
+    const auto mid = encoding.decode({0.5, 0.5, 0.5});
+    const auto high = encoding.decode({1.0, 1.0, 1.0});
+    HPOEA_V2_CHECK(runner, hpoea::tests_v2::nearly_equal(std::get<double>(low.at("rate")), 1e-3),
+                   "cube origin maps to the lower bound");
+    HPOEA_V2_CHECK(runner, hpoea::tests_v2::nearly_equal(std::get<double>(mid.at("rate")), 0.1),
+                   "log transform warps the cube midpoint to the geometric mean");
+    HPOEA_V2_CHECK(runner, hpoea::tests_v2::nearly_equal(std::get<double>(high.at("rate")), 10.0),
+                   "cube corner maps to the upper bound");
+    HPOEA_V2_CHECK(runner, std::get<std::string>(low.at("mode")) == "a" && std::get<std::string>(mid.at("mode")) == "b" &&
+                               std::get<std::string>(high.at("mode")) == "c",
+                   "categorical choices take equal cells");
+    HPOEA_V2_CHECK(runner, std::get<std::int64_t>(mid.at("width")) == 3, "fixed values are kept");
+}
+
+void test_incremental_factor(hpoea::tests_v2::TestRunner &runner) {
+    std::mt19937_64 rng{5};
+    std::uniform_real_distribution<double> unit{0.0, 1.0};
+    hpoea::core::GaussianProcess incremental(2, {0.3, 1e-4});
+    std::vector<double> targets;
+    for (int i = 0; i < 40; ++i) {
+        std::vector<double> x{unit(rng), unit(rng)};
+        incremental.add(x);
+        targets.push_back(std::sin(6.0 * x[0]) + x[1] * x[1]);
+    }
+    incremental.set_targets(targets);
+
+    // set_kernel refactors every point from scratch
+    auto rebuilt = incremental;
+    rebuilt.set_kernel({0.3, 1e-4});
+
+    std::vector<double> scratch;
+    bool matches = true;
+    for (int i = 0; i < 20; ++i) {
+        const std::vector<double> x{unit(rng), unit(rng)};
+        const auto a = incremental.predict(x, scratch);
+        const auto b = rebuilt.predict(x, scratch);
+        matches = matches && std::abs(a.mean - b.mean) < 1e-9 && std::abs(a.variance - b.variance) < 1e-9;
+    }
+    HPOEA_V2_CHECK(runner, matches, "incremental cholesky matches a full refactor");
+
+    const std::vector<double> probe{0.25, 0.5};
+    hpoea::core::GaussianProcess exact(2, {0.3, 1e-8});
+    exact.add(probe);
+    exact.add({0.75, 0.1});
+    exact.set_targets({2.0, -1.0});
+    const auto at_point = exact.predict(probe, scratch);
+    HPOEA_V2_CHECK(runner, std::abs(at_point.mean - 2.0) < 1e-4 && at_point.variance < 1e-4,
+                   "noise-free model interpolates its observations");
+
+    bool rejected = false;
+    try {
+        hpoea::core::GaussianProcess stale(2);
+        stale.add(probe);
+        (void)stale.predict(probe, scratch);
+    } catch (const std::logic_error &) {
+        rejected = true;
+    }
+    HPOEA_V2_CHECK(runner, rejected, "predict needs targets for every point");
+}
+
+hpoea::core::ParameterSet bo_parameters(std::int64_t samples, std::int64_t batch, std::int64_t workers,
+                                        const std::string &acquisition = "ei") {
+    hpoea::core::ParameterSet params;
+    params.emplace("sample_count", samples);
+    params.emplace("batch_size", batch);
+    params.emplace("parallel_workers", workers);
+    params.emplace("acquisition", acquisition);
+    return params;
+}
+
+bool same_trials(const hpoea::core::HyperparameterOptimizationResult &lhs,
+                 const hpoea::core::HyperparameterOptimizationResult &rhs) {
+    if (lhs.trials.size() != rhs.trials.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < lhs.trials.size(); ++i) {
+        if (!hpoea::tests_v2::parameter_set_equals(lhs.trials[i].parameters, rhs.trials[i].parameters) ||
+            lhs.trials[i].optimization_result.seed != rhs.trials[i].optimization_result.seed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_optimizer(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(2);
+    auto factory = make_factory();
+
+    hpoea::core::BayesianOptimizer optimizer;
+    HPOEA_V2_CHECK(runner, optimizer.identity().family == "BayesianOptimization",
+                   "identity family is BayesianOptimization");
+    optimizer.configure(bo_parameters(40, 1, 1));
+    optimizer.set_search_space(log_rate_search());
+    const auto result = optimizer.optimize(factory, problem, {}, {}, 21UL);
+    HPOEA_V2_REQUIRE(runner, result.status == hpoea::core::RunStatus::Success, "bayesian optimization succeeds");
+    HPOEA_V2_CHECK(runner, result.trials.size() == 40u, "sample_count sets the trial count");
+    HPOEA_V2_CHECK(runner, result.optimizer_usage.objective_calls == 40u, "every trial is an objective call");
+
+    double design_best = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < 9u; ++i) {
+        design_best = std::min(design_best, result.trials[i].optimization_result.best_fitness);
+    }
+    HPOEA_V2_CHECK(runner, result.best_objective < design_best, "model proposals improve on the sobol design");
+    HPOEA_V2_CHECK(runner, result.best_objective < 0.1, "bayesian optimization finds the bowl minimum");
+
+    hpoea::core::BayesianOptimizer repeat;
+    repeat.configure(bo_parameters(40, 1, 4));
+    repeat.set_search_space(log_rate_search());
+    HPOEA_V2_CHECK(runner, same_trials(result, repeat.optimize(factory, problem, {}, {}, 21UL)),
+                   "worker count does not change the trials");
+
+    for (const std::string acquisition : {"ei", "ucb"}) {
+        hpoea::core::BayesianOptimizer serial_batch;
+        serial_batch.configure(bo_parameters(30, 4, 1, acquisition));
+        hpoea::core::BayesianOptimizer parallel_batch;
+        parallel_batch.configure(bo_parameters(30, 4, 3, acquisition));
+        const auto serial = serial_batch.optimize(factory, problem, {}, {}, 8UL);
+        const auto parallel = parallel_batch.optimize(factory, problem, {}, {}, 8UL);
+        HPOEA_V2_CHECK(runner, serial.status == hpoea::core::RunStatus::Success && serial.trials.size() == 30u,
+                       "batched proposals fill the sample count");
+        HPOEA_V2_CHECK(runner, same_trials(serial, parallel), "batched trials do not depend on the worker count");
+        bool distinct = true;
+        for (std::size_t i = 9; i + 1 < serial.trials.size(); ++i) {
+            distinct = distinct && !hpoea::tests_v2::parameter_set_equals(serial.trials[i].parameters,
+                                                                          serial.trials[i + 1].parameters);
+        }
+        HPOEA_V2_CHECK(runner, distinct, "fantasies keep a batch from repeating one proposal");
+    }
+
+    hpoea::core::Budget capped;
+    capped.function_evaluations = 12u;
+    hpoea::core::BayesianOptimizer budgeted;
+    const auto budgeted_result = budgeted.optimize(factory, problem, capped, {}, 3UL);
+    HPOEA_V2_CHECK(runner, budgeted_result.trials.size() == 12u, "function_evaluations budget sets the default count");
+
+    hpoea::core::Budget generations;
+    generations.generations = 3u;
+    const auto rejected = budgeted.optimize(factory, problem, generations, {}, 3UL);
+    HPOEA_V2_CHECK(runner, rejected.status == hpoea::core::RunStatus::InvalidConfiguration,
+                   "generations optimizer budget is rejected");
+}
+
+} // namespace
+
+int main() {
+    hpoea::tests_v2::TestRunner runner;
+    test_unit_cube_encoding(runner);
+    test_incremental_factor(runner);
+    test_optimizer(runner);
+    return runner.summarize("bayesian_optimizer_tests");
+}
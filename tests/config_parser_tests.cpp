@@ -45,6 +45,13 @@ const char *basic_config() {
         lower_bound = -5.0
         upper_bound = 5.0
 
+        [problem_sets.family]
+        problems = ["sphere10", "sphere10"]
+        aggregation = "mean_rank"
+        scales = [10, 2.5]
+        references = [[1.5, 0.5], [2]]
+        parallel_instances = 2
+
         [algorithms.de_default]
         type = "de"
         fixed = { population_size = 40, variant = 2, label = "draft" }
@@ -78,6 +85,14 @@ const char *basic_config() {
         repetitions = 3
         seed = 9001
         output_name = "sphere_de"
+        batch_evaluator = "thread"
+        share_initial_population = true
+
+        [experiments.seed_repeats]
+        min_repeats = 2
+        max_repeats = 8
+        relative_margin = 0.05
+        parallel_repeats = 4
 
         [experiments.algorithm_budget]
         generations = 25
@@ -108,6 +123,7 @@ int main() {
                        "suite_seed parses");
         HPOEA_V2_CHECK(runner, cfg.repetitions == 2, "suite repetitions parse");
         HPOEA_V2_CHECK(runner, cfg.problems.size() == 1, "problem definition parses");
+        HPOEA_V2_CHECK(runner, cfg.problem_sets.size() == 1, "problem set definition parses");
         HPOEA_V2_CHECK(runner, cfg.algorithms.size() == 1, "algorithm definition parses");
         HPOEA_V2_CHECK(runner, cfg.optimizers.size() == 1, "optimizer definition parses");
         HPOEA_V2_CHECK(runner, cfg.experiments.size() == 1, "explicit experiment parses");
@@ -118,6 +134,19 @@ int main() {
         HPOEA_V2_CHECK(runner, cfg.optimizers.front().id == "cmaes_fast", "optimizer id parses");
         HPOEA_V2_CHECK(runner, cfg.optimizers.front().type == "cmaes", "optimizer type parses");
 
+        const auto &problem_set = cfg.problem_sets.front();
+        HPOEA_V2_CHECK(runner, problem_set.id == "family" && problem_set.problems.size() == 2 &&
+                                   problem_set.problems.front() == "sphere10",
+                       "problem set members parse");
+        HPOEA_V2_CHECK(runner, problem_set.aggregation == "mean_rank" && problem_set.parallel_instances == 2,
+                       "problem set aggregation and parallel_instances parse");
+        HPOEA_V2_CHECK(runner, problem_set.offsets.empty() && (problem_set.scales == std::vector<double>{10.0, 2.5}),
+                       "problem set scales parse and offsets default to empty");
+        HPOEA_V2_CHECK(runner, problem_set.references.size() == 2 &&
+                                   (problem_set.references[0] == std::vector<double>{1.5, 0.5}) &&
+                                   (problem_set.references[1] == std::vector<double>{2.0}),
+                       "problem set references parse one array per problem");
+
         const auto &problem_params = cfg.problems.front().parameters;
         const auto &fixed = cfg.algorithms.front().fixed_parameters;
         const auto &search = cfg.algorithms.front().search_parameters;
@@ -168,6 +197,16 @@ int main() {
                        "experiment seed parses");
         HPOEA_V2_CHECK(runner, experiment.output_name == std::optional<std::string>{"sphere_de"},
                        "experiment output_name parses");
+        HPOEA_V2_CHECK(runner, experiment.batch_evaluator == std::optional<std::string>{"thread"},
+                       "experiment batch_evaluator parses");
+        HPOEA_V2_CHECK(runner, experiment.share_initial_population == std::optional<bool>{true},
+                       "experiment share_initial_population parses");
+        HPOEA_V2_CHECK(runner, experiment.seed_repeats.has_value() && experiment.seed_repeats->min_repeats == 2u &&
+                                   experiment.seed_repeats->max_repeats == 8u &&
+                                   experiment.seed_repeats->relative_margin == 0.05 &&
+                                   experiment.seed_repeats->absolute_margin == 0.0 &&
+                                   experiment.seed_repeats->parallel_repeats == 4u,
+                       "experiment seed_repeats parses with defaults for missing keys");
         HPOEA_V2_CHECK(runner, experiment.algorithm_budget->generations == std::optional<std::size_t>{25},
                        "algorithm budget generation value parses");
         HPOEA_V2_CHECK(runner, experiment.optimizer_budget->function_evaluations == std::optional<std::size_t>{800},
@@ -258,6 +297,24 @@ int main() {
                        "max_parallel_experiments diagnostic is exact");
     }
 
+    {
+        const auto result = hpoea::config::parse_config_string(R"(
+            schema_version = 1
+
+            [suite]
+            name = "sets"
+            output_dir = "results/sets"
+
+            [problem_sets.family]
+            problems = ["a", 3]
+            weights = [1.0]
+        )", "sets.toml");
+        HPOEA_V2_CHECK(runner, has_error(result, "sets.toml", "problem_sets.family.problems[1]", "expected string"),
+                       "problem set members must be strings");
+        HPOEA_V2_CHECK(runner, has_error(result, "sets.toml", "problem_sets.family.weights", "unknown field"),
+                       "unknown problem set fields fail");
+    }
+
     {
         const auto result = hpoea::config::parse_config_string(R"(
             schema_version = 1
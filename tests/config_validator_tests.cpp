@@ -16,6 +16,7 @@ namespace {
 using hpoea::config::AlgorithmSpec;
 using hpoea::config::ExperimentSpec;
 using hpoea::config::OptimizerSpec;
+using hpoea::config::ProblemSetSpec;
 using hpoea::config::ProblemSpec;
 using hpoea::config::SearchParameterMode;
 using hpoea::config::SearchParameterSpec;
@@ -52,6 +53,15 @@ bool has_warning(const ValidationResult &result,
     return false;
 }
 
+ProblemSetSpec make_problem_set() {
+    ProblemSetSpec problem_set;
+    problem_set.id = "family";
+    problem_set.problems = {"sphere10", "sphere10"};
+    problem_set.aggregation = "worst_case";
+    problem_set.scales = {1.0, 10.0};
+    return problem_set;
+}
+
 SuiteConfig make_valid_suite() {
     SuiteConfig cfg;
     cfg.schema_version = 1;
@@ -116,6 +126,15 @@ int main() {
         HPOEA_V2_CHECK(runner, result.ok(), "validator accepts open custom type ids");
     }
 
+    {
+        auto cfg = make_valid_suite();
+        cfg.problem_sets.push_back(make_problem_set());
+        cfg.experiments.front().problem = "family";
+        const auto result = hpoea::config::validate_suite_config(cfg);
+        HPOEA_V2_CHECK(runner, result.ok() && result.diagnostics.empty(),
+                       "experiments can name a problem set");
+    }
+
     {
         auto cfg = make_valid_suite();
         cfg.experiments.front().optimizer_budget = hpoea::config::BudgetConfig{7, std::nullopt};
@@ -155,6 +174,42 @@ int main() {
              "unknown problem refs fail", [](SuiteConfig &cfg) {
                  cfg.experiments.front().problem = "missing_problem";
              }},
+            {"problem_sets.family.problems[1]", "problem set 'family': unknown problem 'missing_problem'",
+             "unknown problem set members fail", [](SuiteConfig &cfg) {
+                 cfg.problem_sets.push_back(make_problem_set());
+                 cfg.problem_sets.front().problems.back() = "missing_problem";
+             }},
+            {"problem_sets.family.aggregation", "aggregation must be 'mean_rank', 'mean_normalized' or 'worst_case'",
+             "unknown problem set aggregation fails", [](SuiteConfig &cfg) {
+                 cfg.problem_sets.push_back(make_problem_set());
+                 cfg.problem_sets.front().aggregation = "median";
+             }},
+            {"problem_sets.family.scales", "expected one value per problem (2), got 1",
+             "problem set scales need one value per problem", [](SuiteConfig &cfg) {
+                 cfg.problem_sets.push_back(make_problem_set());
+                 cfg.problem_sets.front().scales = {1.0};
+             }},
+            {"problem_sets.family.references", "expected one reference array per problem (2), got 0",
+             "mean_rank problem sets need references", [](SuiteConfig &cfg) {
+                 cfg.problem_sets.push_back(make_problem_set());
+                 cfg.problem_sets.front().aggregation = "mean_rank";
+             }},
+            {"problem_sets.family.references[1]", "reference values must be finite and non-empty",
+             "empty reference arrays fail", [](SuiteConfig &cfg) {
+                 cfg.problem_sets.push_back(make_problem_set());
+                 cfg.problem_sets.front().aggregation = "mean_rank";
+                 cfg.problem_sets.front().references = {{1.0}, {}};
+             }},
+            {"problem_sets.family.scales[0]", "scale must be finite and positive",
+             "non-positive problem set scales fail", [](SuiteConfig &cfg) {
+                 cfg.problem_sets.push_back(make_problem_set());
+                 cfg.problem_sets.front().scales.front() = 0.0;
+             }},
+            {"problem_sets.sphere10", "problem set id 'sphere10' is also a problem id",
+             "problem set ids cannot shadow problem ids", [](SuiteConfig &cfg) {
+                 cfg.problem_sets.push_back(make_problem_set());
+                 cfg.problem_sets.front().id = "sphere10";
+             }},
             {"experiments[0].algorithm", "experiment 'sphere_ea': unknown algorithm 'missing_algorithm'",
              "unknown algorithm refs fail", [](SuiteConfig &cfg) {
                  cfg.experiments.front().algorithm = "missing_algorithm";
@@ -239,6 +294,22 @@ int main() {
                  spec.continuous_range = hpoea::core::ContinuousRange{0.1, 0.9};
                  cfg.algorithms.front().search_parameters.emplace("scaling_factor", spec);
              }},
+            {"experiments[0].batch_evaluator", "batch_evaluator must be 'none' or 'thread'",
+             "unknown batch evaluator diagnostic is exact", [](SuiteConfig &cfg) {
+                 cfg.experiments.front().batch_evaluator = "custom";
+             }},
+            {"experiments[0].batch_evaluator", "batch_evaluator must be 'none' or 'thread'",
+             "misspelled batch evaluator is rejected", [](SuiteConfig &cfg) {
+                 cfg.experiments.front().batch_evaluator = "threads";
+             }},
+            {"experiments[0].seed_repeats.max_repeats", "max_repeats must not be below min_repeats",
+             "seed repeats below the minimum are rejected", [](SuiteConfig &cfg) {
+                 cfg.experiments.front().seed_repeats = hpoea::config::SeedRepeatsConfig{4, 2};
+             }},
+            {"experiments[0].seed_repeats.relative_margin", "relative_margin must be finite and non-negative",
+             "a negative seed repeat margin is rejected", [](SuiteConfig &cfg) {
+                 cfg.experiments.front().seed_repeats = hpoea::config::SeedRepeatsConfig{1, 4, -0.1};
+             }},
             {"experiments[1].output_name",
              "duplicate final output name 'shared_output' also produced by experiments[0].output_name",
              "duplicate output name diagnostic is exact", [](SuiteConfig &cfg) {
@@ -1,6 +1,7 @@
 #include "test_harness.hpp"
 #include "test_fixtures.hpp"
 
+#include "hpoea/core/ask_tell.hpp"
 #include "hpoea/wrappers/pagmo/cmaes_algorithm.hpp"
 #include "hpoea/wrappers/pagmo/de1220_algorithm.hpp"
 #include "hpoea/wrappers/pagmo/de_algorithm.hpp"
@@ -9,10 +10,14 @@
 #include "hpoea/wrappers/pagmo/sga_algorithm.hpp"
 #include "hpoea/wrappers/problems/benchmark_problems.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <filesystem>
 #include <functional>
 #include <limits>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -62,6 +67,32 @@ hpoea::core::ParameterSet endpoint_params(const hpoea::core::ParameterSpace &spa
     return params;
 }
 
+// same id and bounds as the wrapped problem
+// but fails every evaluation past fail_after, like a crashed worker
+class CrashingProblem final : public hpoea::core::IProblem {
+public:
+    CrashingProblem(const hpoea::core::IProblem &inner, std::size_t fail_after)
+        : inner_(inner), fail_after_(fail_after) {}
+
+    [[nodiscard]] const hpoea::core::ProblemMetadata &metadata() const noexcept override { return inner_.metadata(); }
+    [[nodiscard]] std::size_t dimension() const override { return inner_.dimension(); }
+    [[nodiscard]] std::vector<double> lower_bounds() const override { return inner_.lower_bounds(); }
+    [[nodiscard]] std::vector<double> upper_bounds() const override { return inner_.upper_bounds(); }
+    [[nodiscard]] double evaluate(const std::vector<double> &x) const override {
+        if (calls_.fetch_add(1) >= fail_after_) {
+            throw std::runtime_error("simulated crash");
+        }
+        return inner_.evaluate(x);
+    }
+
+    [[nodiscard]] std::size_t calls() const noexcept { return calls_.load(); }
+
+private:
+    const hpoea::core::IProblem &inner_;
+    std::size_t fail_after_;
+    mutable std::atomic<std::size_t> calls_{0};
+};
+
 }
 
 int main() {
@@ -313,5 +344,509 @@ int main() {
     }
 
 
+    {
+        // a checkpointed run interrupted mid-way resumes from its file
+        // and ends exactly like an uninterrupted checkpointed run
+        hpoea::wrappers::problems::SphereProblem sphere(3);
+        hpoea::core::Budget budget;
+        budget.generations = 12u;
+        const auto dir = std::filesystem::temp_directory_path() / "hpoea_checkpoint_tests";
+        std::filesystem::remove_all(dir);
+
+        struct Case {
+            const char *name;
+            std::function<std::unique_ptr<hpoea::core::IEvolutionaryAlgorithmFactory>()> make;
+        };
+        const Case cases[] = {
+            {"DE",    []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoDifferentialEvolutionFactory>(); }},
+            {"SADE",  []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoSelfAdaptiveDEFactory>(); }},
+            {"PSO",   []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoParticleSwarmOptimizationFactory>(); }},
+            {"CMAES", []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoCmaesFactory>(); }},
+        };
+
+        for (const auto &c : cases) {
+            const std::string name = c.name;
+            hpoea::core::ParameterSet params;
+            params.emplace("population_size", std::int64_t{10});
+            params.emplace("generations", std::int64_t{12});
+
+            auto run_checkpointed = [&](const hpoea::core::IProblem &problem, const std::filesystem::path &path) {
+                auto algo = c.make()->create();
+                algo->configure(params);
+                auto &base = dynamic_cast<hpoea::pagmo_wrappers::PagmoAlgorithmBase &>(*algo);
+                hpoea::core::CheckpointPolicy policy;
+                policy.path = path;
+                policy.every_generations = 3u;
+                base.set_checkpoint_policy(policy);
+                return algo->run(problem, budget, 5UL);
+            };
+
+            const auto reference = run_checkpointed(sphere, dir / (name + "_reference.ckpt"));
+            HPOEA_V2_CHECK(runner, reference.status == hpoea::core::RunStatus::Success,
+                           name + " checkpointed run succeeds");
+            HPOEA_V2_CHECK(runner, reference.algorithm_usage.generations == 12u,
+                           name + " checkpointed run steps every generation");
+
+            const auto resumed_path = dir / (name + "_resumed.ckpt");
+            CrashingProblem crashing(sphere, 10u * 8u);
+            const auto crashed = run_checkpointed(crashing, resumed_path);
+            HPOEA_V2_CHECK(runner, crashed.status == hpoea::core::RunStatus::FailedEvaluation,
+                           name + " simulated crash fails the run");
+            HPOEA_V2_CHECK(runner, std::filesystem::exists(resumed_path),
+                           name + " crash leaves a checkpoint behind");
+
+            const auto resumed = run_checkpointed(sphere, resumed_path);
+            HPOEA_V2_CHECK(runner, resumed.status == hpoea::core::RunStatus::Success,
+                           name + " resumed run succeeds");
+            HPOEA_V2_CHECK(runner, resumed.best_fitness == reference.best_fitness &&
+                                      vector_equal(resumed.best_solution, reference.best_solution),
+                           name + " resumed run matches the uninterrupted run");
+            HPOEA_V2_CHECK(runner, resumed.algorithm_usage.function_evaluations ==
+                                      reference.algorithm_usage.function_evaluations,
+                           name + " resumed run reports the full feval count");
+
+            hpoea::core::Budget other_budget = budget;
+            other_budget.generations = 11u;
+            auto algo = c.make()->create();
+            algo->configure(params);
+            hpoea::core::CheckpointPolicy policy;
+            policy.path = resumed_path;
+            dynamic_cast<hpoea::pagmo_wrappers::PagmoAlgorithmBase &>(*algo).set_checkpoint_policy(policy);
+            const auto mismatched = algo->run(sphere, other_budget, 5UL);
+            HPOEA_V2_CHECK(runner, mismatched.status == hpoea::core::RunStatus::InvalidConfiguration,
+                           name + " refuses a checkpoint from a different run");
+        }
+        std::filesystem::remove_all(dir);
+    }
+
+
+    {
+        // a checkpointed run steps with memory on, which carries the same
+        // adaptation state a one-shot evolve keeps internally: with the
+        // ftol/xtol stops out of reach it matches a plain run exactly
+        hpoea::wrappers::problems::SphereProblem sphere(3);
+        hpoea::core::Budget budget;
+        budget.generations = 8u;
+        const auto dir = std::filesystem::temp_directory_path() / "hpoea_checkpoint_parity_tests";
+        std::filesystem::remove_all(dir);
+
+        struct Case {
+            const char *name;
+            bool has_tolerances;
+            std::function<std::unique_ptr<hpoea::core::IEvolutionaryAlgorithmFactory>()> make;
+        };
+        const Case cases[] = {
+            {"DE",     true,  []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoDifferentialEvolutionFactory>(); }},
+            {"SADE",   true,  []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoSelfAdaptiveDEFactory>(); }},
+            {"DE1220", true,  []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoDe1220Factory>(); }},
+            {"PSO",    false, []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoParticleSwarmOptimizationFactory>(); }},
+            {"CMAES",  true,  []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoCmaesFactory>(); }},
+        };
+
+        for (const auto &c : cases) {
+            const std::string name = c.name;
+            hpoea::core::ParameterSet params;
+            params.emplace("population_size", std::int64_t{10});
+            params.emplace("generations", std::int64_t{8});
+            if (c.has_tolerances) {
+                params.emplace("ftol", 0.0);
+                params.emplace("xtol", 0.0);
+            }
+
+            auto algo = c.make()->create();
+            algo->configure(params);
+            const auto plain = algo->run(sphere, budget, 9UL);
+
+            auto checkpointed_algo = c.make()->create();
+            checkpointed_algo->configure(params);
+            hpoea::core::CheckpointPolicy policy;
+            policy.path = dir / (name + ".ckpt");
+            dynamic_cast<hpoea::pagmo_wrappers::PagmoAlgorithmBase &>(*checkpointed_algo)
+                .set_checkpoint_policy(policy);
+            const auto checkpointed = checkpointed_algo->run(sphere, budget, 9UL);
+
+            HPOEA_V2_CHECK(runner, checkpointed.status == hpoea::core::RunStatus::Success,
+                           name + " checkpointed parity run succeeds");
+            HPOEA_V2_CHECK(runner, checkpointed.best_fitness == plain.best_fitness &&
+                                      vector_equal(checkpointed.best_solution, plain.best_solution),
+                           name + " checkpointed run matches a plain run without tolerance stops");
+            HPOEA_V2_CHECK(runner, checkpointed.algorithm_usage.function_evaluations ==
+                                      plain.algorithm_usage.function_evaluations,
+                           name + " checkpointed run spends the plain run's budget");
+        }
+        std::filesystem::remove_all(dir);
+    }
+
+
+    {
+        // batch evaluators keep fevals exact; only pso changes its trajectory
+        hpoea::wrappers::problems::SphereProblem sphere(4);
+        hpoea::core::Budget budget;
+        budget.generations = 6u;
+
+        struct Case {
+            const char *name;
+            bool same_trajectory;
+            std::function<std::unique_ptr<hpoea::core::IEvolutionaryAlgorithmFactory>()> make;
+        };
+        const Case cases[] = {
+            {"DE",     true,  []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoDifferentialEvolutionFactory>(); }},
+            {"SADE",   true,  []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoSelfAdaptiveDEFactory>(); }},
+            {"DE1220", true,  []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoDe1220Factory>(); }},
+            {"PSO",    false, []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoParticleSwarmOptimizationFactory>(); }},
+            {"SGA",    true,  []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoSgaFactory>(); }},
+            {"CMAES",  true,  []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoCmaesFactory>(); }},
+        };
+
+        for (const auto &c : cases) {
+            const std::string name = c.name;
+            hpoea::core::ParameterSet params;
+            params.emplace("population_size", std::int64_t{12});
+            params.emplace("generations", std::int64_t{6});
+            const std::size_t expected_fevals = 12u * 7u;
+
+            auto run_with = [&](const hpoea::core::BatchEvaluatorConfig &config) {
+                auto algo = c.make()->create();
+                algo->configure(params);
+                algo->set_batch_evaluator(config);
+                return algo->run(sphere, budget, 21UL);
+            };
+
+            const auto plain = run_with({});
+            const auto threaded = run_with({hpoea::core::BatchEvaluatorKind::Thread, {}});
+            HPOEA_V2_CHECK(runner, threaded.status == hpoea::core::RunStatus::Success,
+                           name + " thread batch evaluator run succeeds");
+            HPOEA_V2_CHECK(runner, threaded.algorithm_usage.function_evaluations == expected_fevals,
+                           name + " thread batch evaluator counts every evaluation");
+
+            std::atomic<std::size_t> batched{0};
+            std::atomic<std::size_t> calls{0};
+            hpoea::core::BatchEvaluatorConfig custom;
+            custom.kind = hpoea::core::BatchEvaluatorKind::Custom;
+            custom.evaluate = [&](const hpoea::core::IProblem &problem, const std::vector<std::vector<double>> &batch) {
+                ++calls;
+                batched += batch.size();
+                std::vector<double> fitness;
+                for (const auto &x : batch) {
+                    fitness.push_back(problem.evaluate(x));
+                }
+                return fitness;
+            };
+            const auto custom_run = run_with(custom);
+            HPOEA_V2_CHECK(runner, custom_run.status == hpoea::core::RunStatus::Success,
+                           name + " custom batch evaluator run succeeds");
+            HPOEA_V2_CHECK(runner, custom_run.algorithm_usage.function_evaluations == expected_fevals,
+                           name + " custom batch evaluator counts every evaluation");
+            HPOEA_V2_CHECK(runner, calls.load() >= 1u && batched.load() >= 12u,
+                           name + " custom batch evaluator receives the initial population");
+            auto kept = custom;
+            kept.keep_trajectory = true;
+            const auto kept_run = run_with(kept);
+            HPOEA_V2_CHECK(runner, kept_run.best_fitness == plain.best_fitness &&
+                                      kept_run.algorithm_usage.function_evaluations == expected_fevals,
+                           name + " batch evaluator with keep_trajectory does not change the result");
+
+            // stepped runs batch through a keep_trajectory evaluator
+            auto stepped_algo = c.make()->create();
+            stepped_algo->configure(params);
+            auto stepped_run = stepped_algo->start(sphere, budget, 21UL);
+            const auto stepped = hpoea::core::drive_ask_tell(*stepped_run, sphere);
+            HPOEA_V2_CHECK(runner, stepped.status == hpoea::core::RunStatus::Success &&
+                                      stepped.best_fitness == plain.best_fitness &&
+                                      stepped.best_solution == plain.best_solution,
+                           name + " ask/tell run matches run()");
+
+            if (c.same_trajectory) {
+                HPOEA_V2_CHECK(runner, threaded.best_fitness == plain.best_fitness &&
+                                          custom_run.best_fitness == plain.best_fitness,
+                               name + " batch evaluation does not change the result");
+            } else {
+                HPOEA_V2_CHECK(runner, batched.load() == expected_fevals,
+                               name + " batch evaluates every generation");
+                HPOEA_V2_CHECK(runner, threaded.best_fitness == custom_run.best_fitness,
+                               name + " thread and custom batch evaluators follow the same trajectory");
+            }
+        }
+
+        // pso reports the generational variant it switches to
+        hpoea::pagmo_wrappers::PagmoParticleSwarmOptimization pso;
+        const auto plain_implementation = pso.identity().implementation;
+        pso.set_batch_evaluator({hpoea::core::BatchEvaluatorKind::Thread, {}});
+        const auto threaded_implementation = pso.identity().implementation;
+        auto kept_config = hpoea::core::BatchEvaluatorConfig{hpoea::core::BatchEvaluatorKind::Thread, {}};
+        kept_config.keep_trajectory = true;
+        pso.set_batch_evaluator(kept_config);
+        const auto kept_implementation = pso.identity().implementation;
+        pso.set_batch_evaluator({});
+        HPOEA_V2_CHECK(runner, kept_implementation == "pagmo::pso",
+                       "PSO keeps pagmo::pso under a keep_trajectory batch evaluator");
+        HPOEA_V2_CHECK(runner, plain_implementation == "pagmo::pso" && threaded_implementation == "pagmo::pso_gen" &&
+                                  pso.identity().implementation == "pagmo::pso",
+                       "PSO identity follows the batch evaluator");
+
+        hpoea::pagmo_wrappers::PagmoDifferentialEvolution de;
+        bool rejected = false;
+        try {
+            de.set_batch_evaluator({hpoea::core::BatchEvaluatorKind::Custom, {}});
+        } catch (const std::invalid_argument &) {
+            rejected = true;
+        }
+        HPOEA_V2_CHECK(runner, rejected, "custom batch evaluator without a function is rejected");
+    }
+
+
+    {
+        // runs sharing an initial-population cache evaluate it once
+        // but are still charged for it
+        hpoea::wrappers::problems::SphereProblem base(4);
+        CrashingProblem counting(base, std::numeric_limits<std::size_t>::max());
+        hpoea::core::Budget cache_budget;
+        cache_budget.generations = 6u;
+        auto cache = std::make_shared<hpoea::core::InitialPopulationCache>(99UL);
+        hpoea::pagmo_wrappers::PagmoDifferentialEvolutionFactory factory;
+
+        auto run_shared = [&](double scaling_factor, std::int64_t population_size, unsigned long seed) {
+            auto algo = factory.create();
+            hpoea::core::ParameterSet params;
+            params.emplace("population_size", population_size);
+            params.emplace("generations", std::int64_t{6});
+            params.emplace("scaling_factor", scaling_factor);
+            algo->configure(params);
+            algo->set_initial_population_cache(cache);
+            return algo->run(counting, cache_budget, seed);
+        };
+
+        const auto first = run_shared(0.5, 10, 1UL);
+        const auto second = run_shared(0.9, 10, 2UL);
+        HPOEA_V2_CHECK(runner, first.status == hpoea::core::RunStatus::Success &&
+                                  second.status == hpoea::core::RunStatus::Success,
+                       "runs sharing an initial population succeed");
+        HPOEA_V2_CHECK(runner, first.algorithm_usage.cached_function_evaluations == 0u,
+                       "first shared run evaluates the initial population");
+        HPOEA_V2_CHECK(runner, second.algorithm_usage.cached_function_evaluations == 10u,
+                       "second shared run reuses the initial population");
+        HPOEA_V2_CHECK(runner, second.algorithm_usage.function_evaluations == 70u &&
+                                  second.algorithm_usage.generations == 6u,
+                       "reused evaluations are still charged");
+        HPOEA_V2_CHECK(runner, counting.calls() == 70u + 60u,
+                       "reused evaluations are not recomputed");
+
+        const auto other_size = run_shared(0.5, 12, 3UL);
+        HPOEA_V2_CHECK(runner, other_size.algorithm_usage.cached_function_evaluations == 0u,
+                       "a different population size draws its own population");
+
+        const auto repeat = run_shared(0.5, 10, 1UL);
+        HPOEA_V2_CHECK(runner, repeat.best_fitness == first.best_fitness &&
+                                  vector_equal(repeat.best_solution, first.best_solution),
+                       "a cache hit evolves exactly like the miss that filled it");
+    }
+
+
+    {
+        // low-discrepancy initial populations keep fevals exact and are seeded
+        hpoea::wrappers::problems::SphereProblem sphere(5);
+        hpoea::core::Budget budget;
+        budget.generations = 4u;
+
+        const std::vector<std::pair<std::string, std::function<std::unique_ptr<hpoea::core::IEvolutionaryAlgorithmFactory>()>>>
+            factories = {
+                {"DE",     []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoDifferentialEvolutionFactory>(); }},
+                {"SADE",   []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoSelfAdaptiveDEFactory>(); }},
+                {"DE1220", []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoDe1220Factory>(); }},
+                {"PSO",    []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoParticleSwarmOptimizationFactory>(); }},
+                {"SGA",    []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoSgaFactory>(); }},
+                {"CMAES",  []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoCmaesFactory>(); }},
+            };
+
+        for (const auto &[name, make] : factories) {
+            HPOEA_V2_CHECK(runner, make()->parameter_space().contains("population_init"),
+                           name + " exposes population_init");
+            for (const char *init : {"sobol", "halton", "lhs"}) {
+                auto run_with = [&](const hpoea::core::BatchEvaluatorConfig &config) {
+                    auto algo = make()->create();
+                    hpoea::core::ParameterSet params;
+                    params.emplace("population_size", std::int64_t{16});
+                    params.emplace("generations", std::int64_t{4});
+                    params.emplace("population_init", std::string{init});
+                    algo->configure(params);
+                    algo->set_batch_evaluator(config);
+                    return algo->run(sphere, budget, 5UL);
+                };
+                const auto first = run_with({});
+                const auto again = run_with({});
+                const auto threaded = run_with({hpoea::core::BatchEvaluatorKind::Thread, {}});
+                HPOEA_V2_CHECK(runner, first.status == hpoea::core::RunStatus::Success,
+                               name + " " + init + " initialization run succeeds");
+                HPOEA_V2_CHECK(runner, first.algorithm_usage.function_evaluations == 16u * 5u,
+                               name + " " + init + " initialization counts every evaluation");
+                HPOEA_V2_CHECK(runner, again.best_fitness == first.best_fitness,
+                               name + " " + init + " initialization is reproducible");
+                HPOEA_V2_CHECK(runner, threaded.algorithm_usage.function_evaluations == 16u * 5u,
+                               name + " " + init + " batch-evaluated initialization counts every evaluation");
+            }
+        }
+
+        auto de = hpoea::pagmo_wrappers::PagmoDifferentialEvolutionFactory{}.create();
+        hpoea::core::ParameterSet params;
+        params.emplace("population_init", std::string{"grid"});
+        bool rejected = false;
+        try {
+            de->configure(params);
+        } catch (const std::exception &) {
+            rejected = true;
+        }
+        HPOEA_V2_CHECK(runner, rejected, "unknown population_init is rejected");
+    }
+
+
+    {
+        // progress reports come after the initial population and every
+        // generation, and a false return prunes the run
+        hpoea::wrappers::problems::SphereProblem sphere(4);
+        hpoea::core::Budget progress_budget;
+        progress_budget.generations = 6u;
+        hpoea::pagmo_wrappers::PagmoDifferentialEvolutionFactory factory;
+        hpoea::core::ParameterSet params;
+        params.emplace("population_size", std::int64_t{10});
+        params.emplace("generations", std::int64_t{6});
+
+        std::vector<hpoea::core::ProgressReport> reports;
+        auto watched = factory.create();
+        watched->configure(params);
+        watched->set_progress_callback([&](const hpoea::core::ProgressReport &report) {
+            reports.push_back(report);
+            return true;
+        });
+        const auto full = watched->run(sphere, progress_budget, 4UL);
+        HPOEA_V2_CHECK(runner, full.status == hpoea::core::RunStatus::Success, "a watched run succeeds");
+        HPOEA_V2_CHECK(runner, reports.size() == 7u, "one report per generation plus the initial population");
+        bool monotone = reports.size() == 7u;
+        for (std::size_t i = 0; i < reports.size(); ++i) {
+            monotone = monotone && reports[i].function_evaluations == 10u * (i + 1) && reports[i].generations == i &&
+                       (i == 0 || reports[i].best_fitness <= reports[i - 1].best_fitness);
+        }
+        HPOEA_V2_CHECK(runner, monotone, "reports carry exact fevals and a non-increasing best");
+        HPOEA_V2_CHECK(runner, !reports.empty() && reports.back().best_fitness == full.best_fitness,
+                       "the last report is the result");
+
+        auto stopped = factory.create();
+        stopped->configure(params);
+        stopped->set_progress_callback([](const hpoea::core::ProgressReport &report) {
+            return report.generations < 2u;
+        });
+        const auto pruned = stopped->run(sphere, progress_budget, 4UL);
+        HPOEA_V2_CHECK(runner, pruned.status == hpoea::core::RunStatus::Pruned, "a false report prunes the run");
+        HPOEA_V2_CHECK(runner, pruned.algorithm_usage.function_evaluations == 30u &&
+                                  pruned.algorithm_usage.generations == 2u,
+                       "a pruned run stops at the report that pruned it");
+        HPOEA_V2_CHECK(runner, reports.size() > 2u && pruned.best_fitness == reports[2].best_fitness,
+                       "a pruned run keeps its best-so-far");
+    }
+
+    {
+        // a callback only watches: a run it lets finish is the plain run,
+        // tolerance stops and adaptation state included
+        hpoea::wrappers::problems::SphereProblem sphere(3);
+        hpoea::core::Budget budget;
+        budget.generations = 8u;
+        struct Case {
+            const char *name;
+            std::function<std::unique_ptr<hpoea::core::IEvolutionaryAlgorithmFactory>()> make;
+        };
+        const Case cases[] = {
+            {"SADE",   []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoSelfAdaptiveDEFactory>(); }},
+            {"DE1220", []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoDe1220Factory>(); }},
+            {"PSO",    []{ return std::make_unique<hpoea::pagmo_wrappers::PagmoParticleSwarmOptimizationFactory>(); }},
+        };
+        for (const auto &c : cases) {
+            const std::string name = c.name;
+            hpoea::core::ParameterSet params;
+            params.emplace("population_size", std::int64_t{10});
+            params.emplace("generations", std::int64_t{8});
+
+            auto algo = c.make()->create();
+            algo->configure(params);
+            const auto plain = algo->run(sphere, budget, 5UL);
+
+            std::size_t reports = 0;
+            auto watched_algo = c.make()->create();
+            watched_algo->configure(params);
+            watched_algo->set_progress_callback([&](const hpoea::core::ProgressReport &) {
+                ++reports;
+                return true;
+            });
+            const auto watched = watched_algo->run(sphere, budget, 5UL);
+            HPOEA_V2_CHECK(runner, watched.best_fitness == plain.best_fitness &&
+                                      vector_equal(watched.best_solution, plain.best_solution) &&
+                                      watched.algorithm_usage.function_evaluations ==
+                                          plain.algorithm_usage.function_evaluations,
+                           name + " watched run matches a plain run");
+            HPOEA_V2_CHECK(runner, reports == plain.algorithm_usage.generations + 1u,
+                           name + " watched run reports every generation");
+        }
+
+        // a spent wall time stops the run between generations
+        hpoea::core::Budget timed;
+        timed.wall_time = std::chrono::milliseconds{0};
+        hpoea::core::ParameterSet params;
+        params.emplace("population_size", std::int64_t{10});
+        params.emplace("generations", std::int64_t{8});
+        auto de = hpoea::pagmo_wrappers::PagmoDifferentialEvolutionFactory{}.create();
+        de->configure(params);
+        const auto stopped = de->run(sphere, timed, 5UL);
+        HPOEA_V2_CHECK(runner, stopped.status == hpoea::core::RunStatus::BudgetExceeded &&
+                                  stopped.algorithm_usage.function_evaluations == 10u &&
+                                  std::isfinite(stopped.best_fitness) && stopped.best_solution.size() == 3u,
+                       "a spent wall time stops after the initial population with its best");
+    }
+
+    {
+        // a warm start from the same configuration resumes the algorithm
+        // state, so two halves match one run over both
+        hpoea::wrappers::problems::SphereProblem sphere(3);
+        hpoea::core::ParameterSet params;
+        params.emplace("population_size", std::int64_t{10});
+        params.emplace("generations", std::int64_t{8});
+        hpoea::pagmo_wrappers::PagmoSelfAdaptiveDEFactory factory;
+
+        hpoea::core::Budget whole;
+        whole.generations = 8u;
+        auto one = factory.create();
+        one->configure(params);
+        const auto plain = one->run(sphere, whole, 5UL);
+
+        hpoea::core::Budget half;
+        half.generations = 4u;
+        auto first = factory.create();
+        first->configure(params);
+        HPOEA_V2_CHECK(runner, first->set_warm_start(nullptr), "SADE accepts warm starts");
+        const auto head = first->run(sphere, half, 5UL);
+        HPOEA_V2_CHECK(runner, head.final_population && !head.final_population->state.empty(),
+                       "the final population carries the algorithm state");
+
+        auto second = factory.create();
+        second->configure(params);
+        (void)second->set_warm_start(head.final_population);
+        const auto tail = second->run(sphere, half, 6UL);
+        HPOEA_V2_CHECK(runner, tail.status == hpoea::core::RunStatus::Success &&
+                                  tail.algorithm_usage.cached_function_evaluations == 10u &&
+                                  tail.algorithm_usage.function_evaluations == 50u,
+                       "a resumed run charges its individuals as cached evaluations");
+        HPOEA_V2_CHECK(runner, tail.best_fitness == plain.best_fitness &&
+                                  vector_equal(tail.best_solution, plain.best_solution),
+                       "a resumed run continues the run it was started from");
+
+        auto changed = params;
+        changed["population_size"] = std::int64_t{12};
+        auto other = factory.create();
+        other->configure(changed);
+        (void)other->set_warm_start(head.final_population);
+        const auto fallback = other->run(sphere, half, 6UL);
+        HPOEA_V2_CHECK(runner, fallback.status == hpoea::core::RunStatus::Success &&
+                                  fallback.algorithm_usage.cached_function_evaluations == 10u,
+                       "another configuration keeps the individuals only");
+    }
+
+
     return runner.summarize("evolutionary_algorithms_tests");
 }
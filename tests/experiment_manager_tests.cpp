@@ -7,6 +7,7 @@
 #include "hpoea/wrappers/problems/benchmark_problems.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <memory>
 #include <mutex>
@@ -197,6 +198,35 @@ int main() {
     }
 
 
+    {
+        hpoea::core::ExperimentConfig config;
+        config.experiment_id = "exp_batch_evaluator";
+        config.trials_per_optimizer = 1;
+        config.algorithm_budget.generations = 2u;
+        config.optimizer_budget.generations = 1u;
+        config.algorithm_baseline_parameters = hpoea::core::ParameterSet{{"variant", std::int64_t{2}}};
+
+        std::atomic<std::size_t> batched{0};
+        config.batch_evaluator.kind = hpoea::core::BatchEvaluatorKind::Custom;
+        config.batch_evaluator.evaluate = [&](const hpoea::core::IProblem &p,
+                                              const std::vector<std::vector<double>> &batch) {
+            batched += batch.size();
+            std::vector<double> fitness;
+            for (const auto &x : batch) {
+                fitness.push_back(p.evaluate(x));
+            }
+            return fitness;
+        };
+
+        hpoea::core::SequentialExperimentManager manager;
+        auto result = manager.run_experiment(config, optimizer, factory, problem, logger);
+        HPOEA_V2_CHECK(runner, result.optimizer_results.front().status == hpoea::core::RunStatus::Success,
+                       "experiment with a batch evaluator succeeds");
+        HPOEA_V2_CHECK(runner, batched.load() >= 20u,
+                       "experiment batch evaluator reaches algorithms behind baseline parameters");
+    }
+
+
     {
         hpoea::wrappers::problems::SphereProblem sphere(2);
         hpoea::pagmo_wrappers::PagmoDifferentialEvolutionFactory de_factory;
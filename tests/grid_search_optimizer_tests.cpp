@@ -0,0 +1,186 @@
+#include "test_harness.hpp"
+#include "test_fixtures.hpp"
+#include "test_utils.hpp"
+
+#include "hpoea/core/grid_search_optimizer.hpp"
+#include "hpoea/core/search_space.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+hpoea::core::ParameterSpace make_algorithm_space() {
+    using namespace hpoea::tests_v2;
+    return make_space({integer_descriptor("variant", 1, 100, 1), continuous_descriptor("rate", 0.0, 1.0, 0.5),
+                       boolean_descriptor("flag", false)});
+}
+
+// objective |rate - 0.5| + variant, plus 0.25 when flag is set
+hpoea::tests_v2::BowlFactory make_factory() {
+    return {make_algorithm_space(), [](const hpoea::tests_v2::BowlRun &run) {
+                return std::abs(std::get<double>(run.parameters.at("rate")) - 0.5) +
+                       static_cast<double>(std::get<std::int64_t>(run.parameters.at("variant"))) +
+                       (std::get<bool>(run.parameters.at("flag")) ? 0.25 : 0.0);
+            }};
+}
+
+hpoea::core::ParameterSet grid_parameters(std::int64_t resolution, std::int64_t start_index, std::int64_t workers) {
+    hpoea::core::ParameterSet params;
+    params.emplace("resolution", resolution);
+    params.emplace("start_index", start_index);
+    params.emplace("parallel_workers", workers);
+    return params;
+}
+
+bool same_trials(const std::vector<hpoea::core::HyperparameterTrialRecord> &lhs,
+                 const std::vector<hpoea::core::HyperparameterTrialRecord> &rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        if (!hpoea::tests_v2::parameter_set_equals(lhs[i].parameters, rhs[i].parameters) ||
+            lhs[i].trial_index != rhs[i].trial_index ||
+            lhs[i].optimization_result.seed != rhs[i].optimization_result.seed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_full_grid(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(2);
+    auto factory = make_factory();
+
+    hpoea::core::GridSearchOptimizer optimizer;
+    HPOEA_V2_CHECK(runner, optimizer.identity().family == "GridSearch", "identity family is GridSearch");
+    optimizer.configure(grid_parameters(3, 0, 1));
+    HPOEA_V2_CHECK(runner, optimizer.grid_size(factory.parameter_space()) == 18u,
+                   "the grid is the product of the axis sizes");
+
+    const auto result = optimizer.optimize(factory, problem, {}, {}, 11UL);
+    HPOEA_V2_REQUIRE(runner, result.status == hpoea::core::RunStatus::Success && result.trials.size() == 18u,
+                     "grid search visits every point");
+    std::set<std::string> seen;
+    bool indexed = true;
+    for (std::size_t i = 0; i < result.trials.size(); ++i) {
+        const auto &parameters = result.trials[i].parameters;
+        seen.insert(std::to_string(std::get<std::int64_t>(parameters.at("variant"))) + "/" +
+                    std::to_string(std::get<double>(parameters.at("rate"))) + "/" +
+                    (std::get<bool>(parameters.at("flag")) ? "1" : "0"));
+        indexed = indexed && result.trials[i].trial_index == i;
+    }
+    HPOEA_V2_CHECK(runner, seen.size() == 18u, "no grid point repeats");
+    HPOEA_V2_CHECK(runner, indexed, "trial_index is the grid index");
+
+    const auto &first = result.trials[0].parameters;
+    const auto &second = result.trials[1].parameters;
+    HPOEA_V2_CHECK(runner, std::get<std::int64_t>(first.at("variant")) == 1 &&
+                               std::get<double>(first.at("rate")) == 0.0 && !std::get<bool>(first.at("flag")) &&
+                               std::get<bool>(second.at("flag")),
+                   "the last parameter is the fastest digit");
+    HPOEA_V2_CHECK(runner, result.best_objective == 1.0 && std::get<double>(result.best_parameters.at("rate")) == 0.5,
+                   "the best grid point wins");
+    HPOEA_V2_CHECK(runner, result.optimizer_usage.objective_calls == 18u, "every point is an objective call");
+
+    hpoea::core::GridSearchOptimizer parallel;
+    parallel.configure(grid_parameters(3, 0, 4));
+    HPOEA_V2_CHECK(runner, same_trials(result.trials, parallel.optimize(factory, problem, {}, {}, 11UL).trials),
+                   "worker count does not change the trials");
+}
+
+void test_resume(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(2);
+    auto factory = make_factory();
+
+    hpoea::core::GridSearchOptimizer whole;
+    whole.configure(grid_parameters(3, 0, 2));
+    const auto full = whole.optimize(factory, problem, {}, {}, 4UL);
+
+    hpoea::core::Budget seven;
+    seven.function_evaluations = 7u;
+    hpoea::core::GridSearchOptimizer part;
+    part.configure(grid_parameters(3, 0, 2));
+    const auto head = part.optimize(factory, problem, seven, {}, 4UL);
+    HPOEA_V2_CHECK(runner, head.trials.size() == 7u, "the budget caps the grid points");
+    HPOEA_V2_CHECK(runner, hpoea::core::GridSearchOptimizer::resume_index(head) == 7u,
+                   "resume_index follows the last trial");
+
+    const auto resume = static_cast<std::int64_t>(hpoea::core::GridSearchOptimizer::resume_index(head));
+    part.configure(grid_parameters(3, resume, 2));
+    const auto tail = part.optimize(factory, problem, {}, {}, 4UL);
+    auto joined = head.trials;
+    joined.insert(joined.end(), tail.trials.begin(), tail.trials.end());
+    HPOEA_V2_CHECK(runner, same_trials(joined, full.trials), "a resumed grid repeats the uninterrupted trials");
+
+    part.configure(grid_parameters(3, 18, 1));
+    const auto done = part.optimize(factory, problem, {}, {}, 4UL);
+    HPOEA_V2_CHECK(runner, done.status == hpoea::core::RunStatus::BudgetExceeded && done.trials.empty(),
+                   "a finished grid runs nothing");
+    HPOEA_V2_CHECK(runner, hpoea::core::GridSearchOptimizer::resume_index(done) == 18u,
+                   "resume_index without trials is the start index");
+
+    part.configure(grid_parameters(3, 19, 1));
+    HPOEA_V2_CHECK(runner, part.optimize(factory, problem, {}, {}, 4UL).status ==
+                               hpoea::core::RunStatus::InvalidConfiguration,
+                   "a start_index past the grid is rejected");
+
+    hpoea::core::Budget generations;
+    generations.generations = 2u;
+    part.configure(grid_parameters(3, 0, 1));
+    HPOEA_V2_CHECK(runner, part.optimize(factory, problem, generations, {}, 4UL).status ==
+                               hpoea::core::RunStatus::InvalidConfiguration,
+                   "a generations budget is rejected");
+}
+
+void test_axes(hpoea::tests_v2::TestRunner &runner) {
+    auto factory = make_factory();
+    auto search = std::make_shared<hpoea::core::SearchSpace>();
+    search->optimize("rate", hpoea::core::ContinuousRange{0.01, 1.0}, hpoea::core::Transform::log);
+    search->fix("flag", true);
+
+    hpoea::core::GridSearchOptimizer optimizer;
+    optimizer.configure(grid_parameters(5, 0, 1));
+    optimizer.set_search_space(search);
+    HPOEA_V2_CHECK(runner, optimizer.grid_size(factory.parameter_space()) == 25u,
+                   "wide integer ranges and fixed parameters shrink the grid");
+
+    std::set<std::int64_t> variants;
+    for (std::size_t i = 0; i < 25u; i += 5u) {
+        variants.insert(std::get<std::int64_t>(optimizer.grid_point(factory.parameter_space(), i).at("variant")));
+    }
+    HPOEA_V2_CHECK(runner, variants.size() == 5u && *variants.begin() == 1 && *variants.rbegin() == 100,
+                   "a wide integer range gets evenly spaced values with both ends");
+
+    bool logarithmic = true;
+    for (std::size_t i = 0; i < 5u; ++i) {
+        const auto point = optimizer.grid_point(factory.parameter_space(), i);
+        const auto expected = std::pow(10.0, -2.0 + 0.5 * static_cast<double>(i));
+        logarithmic = logarithmic && std::abs(std::get<double>(point.at("rate")) / expected - 1.0) < 1e-9 &&
+                      std::get<bool>(point.at("flag"));
+    }
+    HPOEA_V2_CHECK(runner, logarithmic, "continuous axes are evenly spaced in transformed space");
+
+    bool threw = false;
+    try {
+        (void)optimizer.grid_point(factory.parameter_space(), 25u);
+    } catch (const std::out_of_range &) {
+        threw = true;
+    }
+    HPOEA_V2_CHECK(runner, threw, "grid_point past the grid throws");
+}
+
+} // namespace
+
+int main() {
+    hpoea::tests_v2::TestRunner runner;
+    test_full_grid(runner);
+    test_resume(runner);
+    test_axes(runner);
+    return runner.summarize("grid_search_optimizer_tests");
+}
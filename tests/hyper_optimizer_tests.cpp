@@ -1,6 +1,7 @@
 #include "test_harness.hpp"
 
 #include "hpoea/core/search_space.hpp"
+#include "hpoea/core/trial_history.hpp"
 #include "hpoea/wrappers/pagmo/cmaes_hyper.hpp"
 #include "hpoea/wrappers/pagmo/de_algorithm.hpp"
 #include "hpoea/wrappers/pagmo/nm_hyper.hpp"
@@ -8,13 +9,16 @@
 #include "hpoea/wrappers/pagmo/sa_hyper.hpp"
 #include "hpoea/wrappers/problems/benchmark_problems.hpp"
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cmath>
 #include <functional>
 #include <memory>
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <variant>
 #include <vector>
 
 namespace {
@@ -102,6 +106,60 @@ struct ControllableFactory final : public hpoea::core::IEvolutionaryAlgorithmFac
     [[nodiscard]] const hpoea::core::AlgorithmIdentity &identity() const noexcept override { return id; }
 };
 
+// inner objective (x - 0.3)^2 of the configured x, the same for every seed
+class QuadraticAlgorithm final : public hpoea::core::IEvolutionaryAlgorithm {
+public:
+    explicit QuadraticAlgorithm(hpoea::core::ParameterSpace space) : space_(std::move(space)) {}
+
+    [[nodiscard]] const hpoea::core::AlgorithmIdentity &identity() const noexcept override { return id_; }
+    [[nodiscard]] const hpoea::core::ParameterSpace &parameter_space() const noexcept override { return space_; }
+
+    void configure(const hpoea::core::ParameterSet &parameters) override { x_ = std::get<double>(parameters.at("x")); }
+
+    [[nodiscard]] hpoea::core::OptimizationResult run(const hpoea::core::IProblem &problem,
+                                                      const hpoea::core::Budget &, unsigned long seed) override {
+        hpoea::core::OptimizationResult r;
+        r.best_solution.assign(problem.dimension(), 0.0);
+        r.algorithm_usage.function_evaluations = 1u;
+        r.seed = seed;
+        r.status = hpoea::core::RunStatus::Success;
+        r.best_fitness = (x_ - 0.3) * (x_ - 0.3);
+        return r;
+    }
+
+    [[nodiscard]] std::unique_ptr<hpoea::core::IEvolutionaryAlgorithm> clone() const override {
+        return std::make_unique<QuadraticAlgorithm>(*this);
+    }
+
+private:
+    hpoea::core::AlgorithmIdentity id_{"Quadratic", "tests", "1.0"};
+    hpoea::core::ParameterSpace space_;
+    double x_{0.5};
+};
+
+struct QuadraticFactory final : public hpoea::core::IEvolutionaryAlgorithmFactory {
+    hpoea::core::ParameterSpace space;
+    hpoea::core::AlgorithmIdentity id{"QuadraticFactory", "tests", "1.0"};
+
+    [[nodiscard]] hpoea::core::EvolutionaryAlgorithmPtr create() const override {
+        return std::make_unique<QuadraticAlgorithm>(space);
+    }
+    [[nodiscard]] const hpoea::core::ParameterSpace &parameter_space() const noexcept override { return space; }
+    [[nodiscard]] const hpoea::core::AlgorithmIdentity &identity() const noexcept override { return id; }
+};
+
+// tried configurations in trial_index order, and sorted
+std::vector<double> tried_x(const hpoea::core::HyperparameterOptimizationResult &result, bool sorted) {
+    std::vector<double> xs;
+    for (const auto &trial : result.trials) {
+        xs.push_back(std::get<double>(trial.parameters.at("x")));
+    }
+    if (sorted) {
+        std::sort(xs.begin(), xs.end());
+    }
+    return xs;
+}
+
 hpoea::core::ParameterSpace one_continuous_param_space() {
     hpoea::core::ParameterSpace space;
     hpoea::core::ParameterDescriptor d;
@@ -210,6 +268,61 @@ int main() {
     }
 
 
+    {
+        // outer populations evaluated on several threads
+        // give the same trials in the same order as one thread
+        auto same_trials = [](const hpoea::core::HyperparameterOptimizationResult &a,
+                              const hpoea::core::HyperparameterOptimizationResult &b) {
+            if (a.trials.size() != b.trials.size() || a.best_objective != b.best_objective) {
+                return false;
+            }
+            for (std::size_t i = 0; i < a.trials.size(); ++i) {
+                if (a.trials[i].trial_index != i || b.trials[i].trial_index != i ||
+                    a.trials[i].parameters != b.trials[i].parameters ||
+                    a.trials[i].optimization_result.seed != b.trials[i].optimization_result.seed ||
+                    a.trials[i].optimization_result.best_fitness != b.trials[i].optimization_result.best_fitness) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        auto run_with_workers = [&](auto optimizer, std::int64_t workers) {
+            optimizer.set_search_space(single_de_dimension());
+            hpoea::core::ParameterSet p;
+            p.emplace("generations", std::int64_t{3});
+            p.emplace("parallel_workers", workers);
+            return run_optimizer(optimizer, p, opt_budget, algo_budget, 19UL);
+        };
+
+        const auto cmaes_serial = run_with_workers(hpoea::pagmo_wrappers::PagmoCmaesHyperOptimizer{}, 1);
+        const auto cmaes_parallel = run_with_workers(hpoea::pagmo_wrappers::PagmoCmaesHyperOptimizer{}, 4);
+        HPOEA_V2_CHECK(runner, !cmaes_serial.trials.empty() && same_trials(cmaes_serial, cmaes_parallel),
+                       "CMA-ES hyper trials do not depend on parallel_workers");
+
+        // more than one worker switches pso to pso_gen, whose trials
+        // then do not depend on the worker count
+        const auto pso_serial = run_with_workers(hpoea::pagmo_wrappers::PagmoPsoHyperOptimizer{}, 1);
+        const auto pso_two = run_with_workers(hpoea::pagmo_wrappers::PagmoPsoHyperOptimizer{}, 2);
+        const auto pso_parallel = run_with_workers(hpoea::pagmo_wrappers::PagmoPsoHyperOptimizer{}, 4);
+        HPOEA_V2_CHECK(runner, !pso_serial.trials.empty() && !pso_two.trials.empty() &&
+                                  same_trials(pso_two, pso_parallel),
+                       "PSO hyper trials do not depend on parallel_workers above one");
+
+        hpoea::pagmo_wrappers::PagmoPsoHyperOptimizer pso;
+        hpoea::core::ParameterSet pso_params;
+        pso_params.emplace("parallel_workers", std::int64_t{1});
+        pso.configure(pso_params);
+        const auto serial_implementation = pso.identity().implementation;
+        pso_params.insert_or_assign("parallel_workers", std::int64_t{4});
+        pso.configure(pso_params);
+        HPOEA_V2_CHECK(runner, serial_implementation == "pagmo::pso" &&
+                                  pso.identity().implementation == "pagmo::pso_gen",
+                       "PSO hyper reports pagmo::pso for one worker and pagmo::pso_gen for more");
+        HPOEA_V2_CHECK(runner, pso_parallel.optimizer_usage.objective_calls == pso_parallel.trials.size(),
+                       "PSO hyper parallel objective_calls matches recorded trials");
+    }
+
+
     {
         hpoea::pagmo_wrappers::PagmoCmaesHyperOptimizer optimizer;
         auto search = std::make_shared<hpoea::core::SearchSpace>();
@@ -362,6 +475,76 @@ int main() {
         HPOEA_V2_CHECK(runner, starved.message.find("insufficient") != std::string::npos &&
                                   starved.message.find("10") != std::string::npos,
                        "NM starved message states insufficient budget and the minimum evaluation count");
+
+        // small caps force restarts, four of them at a time
+        hpoea::core::ParameterSet parallel_params;
+        parallel_params.emplace("max_fevals", std::int64_t{12});
+        parallel_params.emplace("parallel_workers", std::int64_t{4});
+        parallel_params.emplace("restarts_per_wave", std::int64_t{4});
+        hpoea::core::Budget shared_budget;
+        shared_budget.function_evaluations = 120u;
+        auto parallel = run_optimizer(optimizer, parallel_params, shared_budget, algo_budget, 5UL);
+        HPOEA_V2_CHECK(runner, parallel.status == hpoea::core::RunStatus::Success &&
+                                  parallel.optimizer_usage.objective_calls <= 120u,
+                       "NM parallel restarts stay within the shared budget");
+        HPOEA_V2_CHECK(runner, parallel.optimizer_usage.iterations >= 4u,
+                       "NM parallel restarts split the budget into several solves");
+        bool ordered = true;
+        for (std::size_t i = 0; i < parallel.trials.size(); ++i) {
+            ordered = ordered && parallel.trials[i].trial_index == i;
+        }
+        HPOEA_V2_CHECK(runner, ordered, "NM parallel trials are recorded in trial_index order");
+
+        // grants, start points and trial seeds follow from finished waves
+        // only, so a run does not depend on the worker count or timing
+        QuadraticFactory quadratic;
+        quadratic.space = one_continuous_param_space();
+        hpoea::wrappers::problems::SphereProblem sphere(2);
+        hpoea::core::Budget wave_budget;
+        wave_budget.function_evaluations = 90u;
+        const auto run_waves = [&](std::int64_t workers) {
+            hpoea::pagmo_wrappers::PagmoNelderMeadHyperOptimizer waves;
+            hpoea::core::ParameterSet wave_params;
+            wave_params.emplace("max_fevals", std::int64_t{6});
+            wave_params.emplace("restarts_per_wave", std::int64_t{3});
+            wave_params.emplace("parallel_workers", workers);
+            waves.configure(wave_params);
+            return waves.optimize(quadratic, sphere, wave_budget, algo_budget, 7UL);
+        };
+        const auto same_run = [](const hpoea::core::HyperparameterOptimizationResult &lhs,
+                                 const hpoea::core::HyperparameterOptimizationResult &rhs) {
+            if (lhs.trials.size() != rhs.trials.size() ||
+                lhs.optimizer_usage.iterations != rhs.optimizer_usage.iterations ||
+                lhs.optimizer_usage.objective_calls != rhs.optimizer_usage.objective_calls ||
+                lhs.best_objective != rhs.best_objective) {
+                return false;
+            }
+            for (std::size_t i = 0; i < lhs.trials.size(); ++i) {
+                if (lhs.trials[i].trial_index != i || rhs.trials[i].trial_index != i ||
+                    lhs.trials[i].parameters != rhs.trials[i].parameters ||
+                    lhs.trials[i].optimization_result.seed != rhs.trials[i].optimization_result.seed) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        const auto serial = run_waves(1);
+        HPOEA_V2_CHECK(runner, serial.optimizer_usage.iterations >= 3u && same_run(serial, run_waves(1)),
+                       "NM waves are reproducible from the seed");
+        bool reproducible = true;
+        for (int repeat = 0; repeat < 5; ++repeat) {
+            reproducible = reproducible && same_run(serial, run_waves(3));
+        }
+        HPOEA_V2_CHECK(runner, reproducible && same_run(serial, run_waves(2)),
+                       "NM waves give the same trials and seeds with one worker and with several");
+
+        hpoea::core::Budget timed_budget;
+        timed_budget.function_evaluations = 100000u;
+        timed_budget.wall_time = std::chrono::milliseconds{1};
+        auto timed = run_optimizer(optimizer, parallel_params, timed_budget, algo_budget, 5UL);
+        HPOEA_V2_CHECK(runner, timed.optimizer_usage.objective_calls < 100000u &&
+                                  timed.status != hpoea::core::RunStatus::Success,
+                       "NM stops mid-solve once the wall time is spent");
     }
 
 
@@ -378,6 +561,40 @@ int main() {
     }
 
 
+    {
+        hpoea::pagmo_wrappers::PagmoPsoHyperOptimizer optimizer;
+        hpoea::core::ParameterSet params;
+        params.emplace("generations", std::int64_t{4});
+        hpoea::core::Budget algo_budget;
+        algo_budget.generations = 5u;
+
+        hpoea::core::Budget open_budget;
+        open_budget.function_evaluations = 1000u;
+        hpoea::core::Budget gated_budget = open_budget;
+        gated_budget.wall_time = std::chrono::hours{1};
+        const auto open = run_optimizer(optimizer, params, open_budget, algo_budget, 13UL);
+        const auto gated = run_optimizer(optimizer, params, gated_budget, algo_budget, 13UL);
+        bool same = open.trials.size() == gated.trials.size();
+        for (std::size_t i = 0; same && i < open.trials.size(); ++i) {
+            same = open.trials[i].parameters == gated.trials[i].parameters &&
+                   open.trials[i].optimization_result.best_fitness == gated.trials[i].optimization_result.best_fitness;
+        }
+        HPOEA_V2_CHECK(runner, !open.trials.empty() && same && gated.optimizer_usage.iterations == 4u,
+                       "PSO with a wall time that never trips matches the unchecked run");
+
+        hpoea::core::Budget timed_budget;
+        timed_budget.function_evaluations = 100000u;
+        timed_budget.wall_time = std::chrono::milliseconds{1};
+        params.insert_or_assign("generations", std::int64_t{1000});
+        const auto timed = run_optimizer(optimizer, params, timed_budget, algo_budget, 13UL);
+        HPOEA_V2_CHECK(runner, timed.optimizer_usage.iterations < 1000u &&
+                                  timed.status != hpoea::core::RunStatus::Success,
+                       "PSO stops between generations once the wall time is spent");
+        HPOEA_V2_CHECK(runner, !timed.trials.empty() && std::isfinite(timed.best_objective),
+                       "PSO stopped on wall time keeps the best trial so far");
+    }
+
+
     {
         ControllableFactory factory;
         factory.space = one_continuous_param_space();
@@ -441,5 +658,71 @@ int main() {
                        "mid-flight failure recovers the k completed trials");
     }
 
+    {
+        // earlier trials seed the first population and the annealing start
+        ControllableFactory factory;
+        factory.space = one_continuous_param_space();
+        hpoea::wrappers::problems::SphereProblem problem(4);
+        auto history = std::make_shared<hpoea::core::TrialHistory>();
+        const hpoea::core::HistoryKey key{factory.id, problem.metadata().id,
+                                          hpoea::core::search_space_fingerprint(factory.space, nullptr)};
+        hpoea::core::ParameterSet prior;
+        prior.emplace("x", 0.125);
+        history->add(key, prior, 0.0);
+        prior.insert_or_assign("x", 2.0);
+        history->add(key, prior, -1.0);
+
+        hpoea::pagmo_wrappers::PagmoCmaesHyperOptimizer cmaes;
+        hpoea::core::ParameterSet params;
+        params.emplace("generations", std::int64_t{1});
+        cmaes.configure(params);
+        cmaes.set_trial_history(history);
+        const auto seeded = cmaes.optimize(factory, problem, opt_budget, algo_budget, 42UL);
+        HPOEA_V2_CHECK(runner, !seeded.trials.empty() &&
+                                   std::get<double>(seeded.trials.front().parameters.at("x")) == 0.125,
+                       "the best prior inside the bounds is the first individual");
+
+        hpoea::pagmo_wrappers::PagmoSimulatedAnnealingHyperOptimizer annealing;
+        annealing.set_trial_history(history);
+        const auto annealed = annealing.optimize(factory, problem, opt_budget, algo_budget, 42UL);
+        HPOEA_V2_CHECK(runner, !annealed.trials.empty() &&
+                                   std::get<double>(annealed.trials.front().parameters.at("x")) == 0.125,
+                       "annealing starts from the best prior");
+    }
+
+    {
+        // a three-value space makes most candidates repeats
+        ControllableFactory factory;
+        hpoea::core::ParameterDescriptor d;
+        d.name = "k";
+        d.type = hpoea::core::ParameterType::Integer;
+        d.integer_range = hpoea::core::IntegerRange{0, 2};
+        d.default_value = std::int64_t{0};
+        factory.space.add_descriptor(d);
+        hpoea::wrappers::problems::SphereProblem problem(2);
+
+        const auto run_pso = [&](const char *policy) {
+            hpoea::pagmo_wrappers::PagmoPsoHyperOptimizer pso;
+            hpoea::core::ParameterSet params;
+            params.emplace("generations", std::int64_t{4});
+            params.emplace("duplicate_policy", std::string{policy});
+            pso.configure(params);
+            return pso.optimize(factory, problem, opt_budget, algo_budget, 42UL);
+        };
+        const auto rerun = run_pso("rerun");
+        const auto reuse = run_pso("reuse");
+        const auto &usage = reuse.optimizer_usage;
+        HPOEA_V2_CHECK(runner, rerun.optimizer_usage.duplicate_configurations > 0u &&
+                                   rerun.optimizer_usage.cached_objective_calls == 0u,
+                       "rerun reports duplicates without caching them");
+        HPOEA_V2_CHECK(runner, reuse.status == hpoea::core::RunStatus::Success && reuse.trials.size() <= 3u,
+                       "reuse runs each distinct configuration once");
+        HPOEA_V2_CHECK(runner, usage.objective_calls == reuse.trials.size() &&
+                                   usage.proposed_configurations == usage.objective_calls + usage.cached_objective_calls,
+                       "reuse reports cache hits apart from objective calls");
+        HPOEA_V2_CHECK(runner, usage.proposed_configurations == rerun.optimizer_usage.proposed_configurations,
+                       "the policy does not change how many candidates are scored");
+    }
+
     return runner.summarize("hyper_optimizer_tests");
 }
@@ -7,12 +7,15 @@
 #include "hpoea/wrappers/pagmo/sade_algorithm.hpp"
 #include "hpoea/wrappers/problems/benchmark_problems.hpp"
 
+#include "decode_plan.hpp"
 #include "hyper_tuning_udp.hpp"
 
 #include <atomic>
 #include <cmath>
 #include <limits>
 #include <memory>
+#include <optional>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -21,12 +24,15 @@ namespace {
 
 class StubAlgorithm final : public hpoea::core::IEvolutionaryAlgorithm {
 public:
+    // throw_above: run() throws when the configured "x" exceeds it
     StubAlgorithm(hpoea::core::ParameterSpace parameter_space,
                   hpoea::core::RunStatus status,
-                  double best_fitness)
+                  double best_fitness,
+                  std::optional<double> throw_above = std::nullopt)
         : parameter_space_(std::move(parameter_space)),
           status_(status),
-          best_fitness_(best_fitness) {}
+          best_fitness_(best_fitness),
+          throw_above_(throw_above) {}
 
     [[nodiscard]] const hpoea::core::AlgorithmIdentity &identity() const noexcept override {
         return identity_;
@@ -43,6 +49,9 @@ public:
     [[nodiscard]] hpoea::core::OptimizationResult run(const hpoea::core::IProblem &problem,
                                                       const hpoea::core::Budget &budget,
                                                       unsigned long seed) override {
+        if (throw_above_ && std::get<double>(configured_.at("x")) > *throw_above_) {
+            throw std::runtime_error("stub algorithm crashed");
+        }
         hpoea::core::OptimizationResult result;
         result.status = status_;
         result.best_fitness = best_fitness_;
@@ -65,6 +74,7 @@ private:
     hpoea::core::ParameterSet configured_{};
     hpoea::core::RunStatus status_{hpoea::core::RunStatus::Success};
     double best_fitness_{0.0};
+    std::optional<double> throw_above_;
 };
 
 struct StubFactory final : public hpoea::core::IEvolutionaryAlgorithmFactory {
@@ -72,9 +82,10 @@ struct StubFactory final : public hpoea::core::IEvolutionaryAlgorithmFactory {
     hpoea::core::AlgorithmIdentity id{"StubFactory", "tests", "1.0"};
     hpoea::core::RunStatus status{hpoea::core::RunStatus::Success};
     double best_fitness{0.0};
+    std::optional<double> throw_above;
 
     [[nodiscard]] hpoea::core::EvolutionaryAlgorithmPtr create() const override {
-        return std::make_unique<StubAlgorithm>(space, status, best_fitness);
+        return std::make_unique<StubAlgorithm>(space, status, best_fitness, throw_above);
     }
 
     [[nodiscard]] const hpoea::core::ParameterSpace &parameter_space() const noexcept override {
@@ -665,5 +676,248 @@ int main() {
                        "mixed_selection: BudgetExceeded trial (5.0) selected as best, not the lower failed 2.0");
     }
 
+    {
+        // batch_fitness numbers trials by candidate position for any thread count
+        hpoea::pagmo_wrappers::PagmoDifferentialEvolutionFactory de_factory;
+        hpoea::wrappers::problems::SphereProblem sphere_batch(2);
+        auto ss = std::make_shared<hpoea::core::SearchSpace>();
+        ss->fix("population_size", std::int64_t{8});
+        ss->fix("crossover_rate", 0.9);
+        ss->fix("variant", std::int64_t{2});
+        ss->fix("generations", std::int64_t{3});
+        ss->fix("ftol", 1e-6);
+        ss->fix("xtol", 1e-6);
+
+        auto run_batch = [&](std::size_t workers) {
+            auto c = std::make_shared<hpoea::pagmo_wrappers::HyperparameterTuningProblem::Context>();
+            c->factory = &de_factory;
+            c->problem = &sphere_batch;
+            c->algorithm_budget.generations = 3;
+            c->base_seed = 21UL;
+            c->trials = std::make_shared<std::vector<hpoea::core::HyperparameterTrialRecord>>();
+            c->search_space = ss;
+            c->workers = workers;
+            hpoea::pagmo_wrappers::HyperparameterTuningProblem udp_batch(c);
+            (void)udp_batch.fitness({0.3});
+            const auto fitness = udp_batch.batch_fitness({0.1, 0.2, 0.4, 0.5, 0.6, 0.7, 0.8});
+            return std::make_pair(fitness, *c->trials);
+        };
+
+        const auto [serial_fitness, serial_trials] = run_batch(1);
+        const auto [parallel_fitness, parallel_trials] = run_batch(4);
+        HPOEA_V2_CHECK(runner, serial_trials.size() == 8u && parallel_trials.size() == 8u,
+                       "batch_fitness records one trial per candidate");
+        bool ordered = serial_trials.size() == parallel_trials.size();
+        bool identical = serial_fitness == parallel_fitness;
+        for (std::size_t i = 0; i < serial_trials.size(); ++i) {
+            ordered = ordered && parallel_trials[i].trial_index == i;
+            identical = identical &&
+                        parallel_trials[i].optimization_result.seed == serial_trials[i].optimization_result.seed &&
+                        parallel_trials[i].optimization_result.best_fitness ==
+                            serial_trials[i].optimization_result.best_fitness;
+        }
+        HPOEA_V2_CHECK(runner, ordered, "batch_fitness trials follow candidate order");
+        HPOEA_V2_CHECK(runner, identical, "batch_fitness results do not depend on the thread count");
+
+        auto c = std::make_shared<hpoea::pagmo_wrappers::HyperparameterTuningProblem::Context>();
+        c->factory = &de_factory;
+        c->problem = &sphere_batch;
+        c->search_space = ss;
+        c->trials = std::make_shared<std::vector<hpoea::core::HyperparameterTrialRecord>>();
+        hpoea::pagmo_wrappers::HyperparameterTuningProblem udp_threads(c);
+        HPOEA_V2_CHECK(runner, udp_threads.get_thread_safety() == pagmo::thread_safety::constant,
+                       "tuning problem declares constant thread safety");
+        bool rejected = false;
+        try {
+            (void)udp_threads.batch_fitness({0.1, 0.2, 0.3});
+        } catch (const std::invalid_argument &) {
+            rejected = true;
+        }
+        HPOEA_V2_CHECK(runner, !rejected && c->trials->size() == 3u, "batch of three one-dimensional candidates runs");
+    }
+
+    {
+        // a run that throws does not drop the trials finished around it
+        StubFactory factory;
+        hpoea::core::ParameterDescriptor x;
+        x.name = "x";
+        x.type = hpoea::core::ParameterType::Continuous;
+        x.continuous_range = hpoea::core::ContinuousRange{0.0, 1.0};
+        x.default_value = 0.0;
+        factory.space.add_descriptor(x);
+        factory.best_fitness = 1.0;
+        factory.throw_above = 0.5;
+        hpoea::wrappers::problems::SphereProblem sphere_throw(2);
+
+        for (std::size_t workers : {std::size_t{1}, std::size_t{3}}) {
+            auto c = std::make_shared<hpoea::pagmo_wrappers::HyperparameterTuningProblem::Context>();
+            c->factory = &factory;
+            c->problem = &sphere_throw;
+            c->trials = std::make_shared<std::vector<hpoea::core::HyperparameterTrialRecord>>();
+            c->workers = workers;
+            hpoea::pagmo_wrappers::HyperparameterTuningProblem udp_throw(c);
+            bool threw = false;
+            try {
+                (void)udp_throw.batch_fitness({0.1, 0.9, 0.2, 0.3});
+            } catch (const std::runtime_error &) {
+                threw = true;
+            }
+            HPOEA_V2_CHECK(runner, threw, "batch_fitness rethrows a failed run");
+            HPOEA_V2_CHECK(runner, c->trials->size() == 3u,
+                           "batch_fitness commits every completed run before rethrowing");
+            HPOEA_V2_CHECK(runner, c->best_trial.has_value(),
+                           "completed runs of a failed batch can still be selected");
+        }
+    }
+
+    {
+        // candidates rounding to k = 1 are repeats of one parameter set
+        hpoea::core::ParameterSpace int_space;
+        hpoea::core::ParameterDescriptor k;
+        k.name = "k";
+        k.type = hpoea::core::ParameterType::Integer;
+        k.integer_range = hpoea::core::IntegerRange{0, 3};
+        k.default_value = std::int64_t{0};
+        int_space.add_descriptor(k);
+        hpoea::wrappers::problems::SphereProblem sphere_dup(2);
+
+        struct DuplicateRun {
+            pagmo::vector_double fitness;
+            std::size_t trials{0};
+            std::size_t objective_calls{0};
+            std::size_t proposed{0};
+            std::size_t duplicates{0};
+            std::size_t cached{0};
+        };
+        using hpoea::pagmo_wrappers::DuplicatePolicy;
+        const auto run_policy = [&](DuplicatePolicy policy, const std::vector<pagmo::vector_double> &batches) {
+            SequencedFactory f;
+            f.space = int_space;
+            f.seq = std::make_shared<std::vector<SeqEntry>>(std::vector<SeqEntry>{
+                {hpoea::core::RunStatus::Success, 4.0},
+                {hpoea::core::RunStatus::Success, 2.0},
+                {hpoea::core::RunStatus::Success, 7.0}});
+            f.idx = std::make_shared<std::atomic<std::size_t>>(0);
+            auto c = std::make_shared<hpoea::pagmo_wrappers::HyperparameterTuningProblem::Context>();
+            c->factory = &f;
+            c->problem = &sphere_dup;
+            c->trials = std::make_shared<std::vector<hpoea::core::HyperparameterTrialRecord>>();
+            c->duplicate_policy = policy;
+            hpoea::pagmo_wrappers::HyperparameterTuningProblem u(c);
+            DuplicateRun out;
+            for (const auto &batch : batches) {
+                const auto fitness = batch.size() == 1 ? u.fitness(batch) : u.batch_fitness(batch);
+                out.fitness.insert(out.fitness.end(), fitness.begin(), fitness.end());
+            }
+            out.trials = c->trials->size();
+            out.objective_calls = c->get_objective_calls();
+            out.proposed = c->get_proposed();
+            out.duplicates = c->duplicates.load();
+            out.cached = c->cached.load();
+            return out;
+        };
+        const std::vector<pagmo::vector_double> batches{{1.2}, {0.9, 2.0, 1.1}};
+
+        const auto rerun = run_policy(DuplicatePolicy::rerun, batches);
+        HPOEA_V2_CHECK(runner, rerun.fitness == pagmo::vector_double({4.0, 2.0, 7.0, 7.0}) && rerun.trials == 4u,
+                       "rerun runs every repeat");
+        HPOEA_V2_CHECK(runner, rerun.proposed == 4u && rerun.duplicates == 2u && rerun.cached == 0u,
+                       "rerun still counts the repeats");
+
+        const auto reuse = run_policy(DuplicatePolicy::reuse, batches);
+        HPOEA_V2_CHECK(runner, reuse.fitness == pagmo::vector_double({4.0, 4.0, 2.0, 4.0}) && reuse.trials == 2u,
+                       "reuse answers repeats with the first result");
+        HPOEA_V2_CHECK(runner, reuse.objective_calls == 2u && reuse.cached == 2u && reuse.duplicates == 2u,
+                       "reuse does not charge cache hits");
+
+        const auto counted = run_policy(DuplicatePolicy::reuse_counted, batches);
+        HPOEA_V2_CHECK(runner, counted.trials == 2u && counted.objective_calls == 4u,
+                       "reuse_counted charges cache hits as objective calls");
+
+        const auto average = run_policy(DuplicatePolicy::average, batches);
+        HPOEA_V2_CHECK(runner, average.trials == 4u && average.fitness.size() == 4u &&
+                                   average.fitness[1] == 3.0 && average.fitness[2] == 7.0 &&
+                                   std::abs(average.fitness[3] - 13.0 / 3.0) < 1e-12,
+                       "average answers with the mean over the configuration's runs");
+
+        const auto same_batch = run_policy(DuplicatePolicy::reuse, {{3.0, 2.8, 0.2}});
+        HPOEA_V2_CHECK(runner, same_batch.fitness == pagmo::vector_double({4.0, 4.0, 2.0}) &&
+                                   same_batch.trials == 2u && same_batch.cached == 1u,
+                       "a repeat within one batch waits for the earlier candidate's run");
+    }
+
+    {
+        // the decode plan resolves the search space once and decodes rows alike
+        hpoea::core::ParameterSpace space;
+        hpoea::core::ParameterDescriptor d;
+        d.name = "rate";
+        d.type = hpoea::core::ParameterType::Continuous;
+        d.continuous_range = hpoea::core::ContinuousRange{0.001, 10.0};
+        space.add_descriptor(d);
+        d = {};
+        d.name = "size";
+        d.type = hpoea::core::ParameterType::Integer;
+        d.integer_range = hpoea::core::IntegerRange{1, 100};
+        space.add_descriptor(d);
+        d = {};
+        d.name = "mode";
+        d.type = hpoea::core::ParameterType::Categorical;
+        d.categorical_choices = {"a", "b", "c"};
+        space.add_descriptor(d);
+        d = {};
+        d.name = "seeded";
+        d.type = hpoea::core::ParameterType::Boolean;
+        d.default_value = false;
+        space.add_descriptor(d);
+        d = {};
+        d.name = "tol";
+        d.type = hpoea::core::ParameterType::Continuous;
+        d.continuous_range = hpoea::core::ContinuousRange{0.0, 1.0};
+        d.default_value = 0.5;
+        space.add_descriptor(d);
+
+        hpoea::core::SearchSpace search;
+        search.optimize("rate", hpoea::core::ContinuousRange{0.01, 1.0}, hpoea::core::Transform::log);
+        search.optimize_choices("size", {hpoea::core::ParameterValue{std::int64_t{8}},
+                                         hpoea::core::ParameterValue{std::int64_t{64}}});
+        search.fix("seeded", true);
+        search.exclude("tol");
+
+        const hpoea::pagmo_wrappers::DecodePlan plan(space, &search);
+        HPOEA_V2_CHECK(runner, plan.dimension() == 3u, "decode_plan: fixed and excluded parameters have no column");
+        HPOEA_V2_CHECK(runner, plan.lower_bounds() == std::vector<double>({-2.0, 0.0, 0.0}) &&
+                                   plan.upper_bounds() == std::vector<double>({0.0, 1.0, 2.0}),
+                       "decode_plan: bounds are transformed and choice tables are indexed");
+
+        const std::vector<double> rows{-1.0, 0.2, 1.6, 5.0, 0.9, -3.0};
+        const auto decoded = plan.decode_batch(rows);
+        HPOEA_V2_CHECK(runner, decoded.size() == 2u, "decode_plan: one parameter set per row");
+        HPOEA_V2_CHECK(runner, decoded.size() == 2u && decoded[0] == plan.decode({-1.0, 0.2, 1.6}) &&
+                                   decoded[1] == plan.decode({5.0, 0.9, -3.0}),
+                       "decode_plan: batch rows decode like single candidates");
+        const auto &first = decoded.at(0);
+        HPOEA_V2_CHECK(runner, std::abs(std::get<double>(first.at("rate")) - 0.1) < 1e-12 &&
+                                   std::get<std::int64_t>(first.at("size")) == 8 &&
+                                   std::get<std::string>(first.at("mode")) == "c" && std::get<bool>(first.at("seeded")) &&
+                                   !first.contains("tol"),
+                       "decode_plan: values come from ranges, choice tables and the fixed template");
+        const auto &second = decoded.at(1);
+        HPOEA_V2_CHECK(runner, std::get<double>(second.at("rate")) == 1.0 &&
+                                   std::get<std::int64_t>(second.at("size")) == 64 &&
+                                   std::get<std::string>(second.at("mode")) == "a",
+                       "decode_plan: out-of-bounds values clamp to the ends");
+
+        const auto encoded = plan.encode(first);
+        HPOEA_V2_CHECK(runner, encoded.has_value() && plan.decode(*encoded) == first,
+                       "decode_plan: encode inverts decode");
+        bool threw = false;
+        try {
+            (void)plan.decode_batch({0.0, 1.0});
+        } catch (const std::invalid_argument &) {
+            threw = true;
+        }
+        HPOEA_V2_CHECK(runner, threw, "decode_plan: a ragged batch is rejected");
+    }
+
     return runner.summarize("hyper_tuning_udp_tests");
 }
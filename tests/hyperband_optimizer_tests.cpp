@@ -0,0 +1,217 @@
+#include "test_harness.hpp"
+#include "test_fixtures.hpp"
+#include "test_utils.hpp"
+
+#include "hpoea/core/hyperband_optimizer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// objective grows with the fidelity, so low rungs look better than the top
+hpoea::tests_v2::BowlFactory make_factory() {
+    auto space = hpoea::tests_v2::rate_space();
+    space.add_descriptor(hpoea::tests_v2::integer_descriptor("width", 1, 5, 1));
+    return {std::move(space), [](const hpoea::tests_v2::BowlRun &run) {
+                const auto fidelity = run.budget.function_evaluations.value_or(run.budget.generations.value_or(1u));
+                run.result.effective_budget = run.budget;
+                run.result.algorithm_usage.function_evaluations = run.budget.function_evaluations.value_or(1u);
+                run.result.algorithm_usage.generations = run.budget.generations.value_or(0u);
+                return (std::get<double>(run.parameters.at("rate")) +
+                        0.01 * static_cast<double>(std::get<std::int64_t>(run.parameters.at("width")))) *
+                       static_cast<double>(fidelity);
+            }};
+}
+
+void configure(hpoea::core::HyperbandOptimizer &optimizer, const std::string &variant, std::int64_t workers,
+               std::int64_t iterations = 1) {
+    hpoea::core::ParameterSet params;
+    params.emplace("variant", variant);
+    params.emplace("parallel_workers", workers);
+    params.emplace("iterations", iterations);
+    optimizer.configure(params);
+}
+
+hpoea::core::Budget fevals(std::size_t value) {
+    hpoea::core::Budget budget;
+    budget.function_evaluations = value;
+    return budget;
+}
+
+std::size_t fidelity(const hpoea::core::HyperparameterTrialRecord &trial) {
+    return trial.optimization_result.requested_budget.function_evaluations.value_or(0u);
+}
+
+bool same_trials(const std::vector<hpoea::core::HyperparameterTrialRecord> &lhs,
+                 const std::vector<hpoea::core::HyperparameterTrialRecord> &rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        if (!hpoea::tests_v2::parameter_set_equals(lhs[i].parameters, rhs[i].parameters) ||
+            lhs[i].trial_index != rhs[i].trial_index || fidelity(lhs[i]) != fidelity(rhs[i]) ||
+            lhs[i].optimization_result.seed != rhs[i].optimization_result.seed ||
+            lhs[i].optimization_result.best_fitness != rhs[i].optimization_result.best_fitness) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_hyperband_brackets(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(2);
+    auto factory = make_factory();
+    hpoea::core::HyperbandOptimizer optimizer;
+    HPOEA_V2_CHECK(runner, optimizer.identity().family == "Hyperband", "identity family is Hyperband");
+    configure(optimizer, "hyperband", 1);
+
+    // eta 3, R 27: rungs 1, 3, 9, 27 and brackets of 27+9+3+1, 12+4+1, 6+2, 4 trials
+    const auto result = optimizer.optimize(factory, problem, {}, fevals(27u), 5UL);
+    HPOEA_V2_REQUIRE(runner, result.status == hpoea::core::RunStatus::Success, "hyperband succeeds");
+    HPOEA_V2_CHECK(runner, result.trials.size() == 69u, "hyperband runs every rung of every bracket");
+    HPOEA_V2_CHECK(runner, result.optimizer_usage.objective_calls == 69u, "every rung evaluation is an objective call");
+
+    std::map<std::size_t, std::size_t> per_fidelity;
+    bool indexed = true;
+    for (std::size_t i = 0; i < result.trials.size(); ++i) {
+        ++per_fidelity[fidelity(result.trials[i])];
+        indexed = indexed && result.trials[i].trial_index == i;
+    }
+    HPOEA_V2_CHECK(runner, indexed, "trial indexes follow evaluation order");
+    HPOEA_V2_CHECK(runner, per_fidelity[1] == 27u && per_fidelity[3] == 21u && per_fidelity[9] == 13u &&
+                               per_fidelity[27] == 8u,
+                   "rung fidelities follow the eta ladder");
+
+    // the first bracket promotes the best third of its 27 starts
+    std::vector<double> rung0;
+    for (std::size_t i = 0; i < 27u; ++i) {
+        rung0.push_back(result.trials[i].optimization_result.best_fitness);
+    }
+    std::sort(rung0.begin(), rung0.end());
+    bool promoted_best = true;
+    for (std::size_t i = 27u; i < 36u; ++i) {
+        const auto low = result.trials[i].optimization_result.best_fitness / 3.0;
+        promoted_best = promoted_best &&
+                        std::any_of(rung0.begin(), rung0.begin() + 9, [&](double f) {
+                            return hpoea::tests_v2::nearly_equal(f, low);
+                        });
+    }
+    HPOEA_V2_CHECK(runner, promoted_best, "promotions come from the top 1/eta of the rung");
+
+    double top_best = std::numeric_limits<double>::infinity();
+    for (const auto &trial : result.trials) {
+        if (fidelity(trial) == 27u) {
+            top_best = std::min(top_best, trial.optimization_result.best_fitness);
+        }
+    }
+    HPOEA_V2_CHECK(runner, hpoea::tests_v2::nearly_equal(result.best_objective, top_best),
+                   "best objective comes from the full-fidelity rung");
+
+    for (std::int64_t workers : {4, 0}) {
+        hpoea::core::HyperbandOptimizer parallel;
+        configure(parallel, "hyperband", workers);
+        const auto parallel_result = parallel.optimize(factory, problem, {}, fevals(27u), 5UL);
+        HPOEA_V2_CHECK(runner, same_trials(result.trials, parallel_result.trials),
+                       "parallel hyperband matches the serial trials");
+    }
+}
+
+void test_asha(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(2);
+    auto factory = make_factory();
+
+    for (std::int64_t workers : {1, 4}) {
+        hpoea::core::HyperbandOptimizer optimizer;
+        configure(optimizer, "asha", workers, 2);
+        const auto result = optimizer.optimize(factory, problem, {}, fevals(27u), 11UL);
+        HPOEA_V2_REQUIRE(runner, result.status == hpoea::core::RunStatus::Success, "asha succeeds");
+
+        // two iterations of 27 starts, each promotion needs a lower rung result first
+        std::set<unsigned long> starts;
+        bool ordered = true;
+        bool promotions_valid = true;
+        for (std::size_t i = 0; i < result.trials.size(); ++i) {
+            const auto &trial = result.trials[i];
+            ordered = ordered && trial.trial_index == i;
+            const auto f = fidelity(trial);
+            promotions_valid = promotions_valid && (f == 1u || f == 3u || f == 9u || f == 27u);
+            const auto seed = trial.optimization_result.seed;
+            if (f == 1u) {
+                starts.insert(seed);
+            } else {
+                promotions_valid = promotions_valid && starts.contains(seed);
+            }
+        }
+        HPOEA_V2_CHECK(runner, ordered, "asha trials are ordered by trial index");
+        HPOEA_V2_CHECK(runner, starts.size() == 54u, "asha samples iterations * eta^(rungs - 1) configurations");
+        HPOEA_V2_CHECK(runner, promotions_valid, "asha only promotes configurations that ran on a lower rung");
+        HPOEA_V2_CHECK(runner, result.trials.size() > 54u, "asha promotes configurations");
+        HPOEA_V2_CHECK(runner, result.optimizer_usage.objective_calls == result.trials.size(),
+                       "asha objective calls match trials");
+    }
+
+    hpoea::core::HyperbandOptimizer capped;
+    configure(capped, "asha", 4);
+    const auto capped_result = capped.optimize(factory, problem, fevals(10u), fevals(27u), 11UL);
+    HPOEA_V2_CHECK(runner, capped_result.trials.size() == 10u, "optimizer function_evaluations caps asha trials");
+}
+
+void test_budgets(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(2);
+    auto factory = make_factory();
+
+    hpoea::core::HyperbandOptimizer optimizer;
+    configure(optimizer, "hyperband", 1);
+    const auto no_fidelity = optimizer.optimize(factory, problem, {}, {}, 3UL);
+    HPOEA_V2_CHECK(runner, no_fidelity.status == hpoea::core::RunStatus::InvalidConfiguration,
+                   "missing inner budget is InvalidConfiguration");
+
+    hpoea::core::Budget generations;
+    generations.generations = 9u;
+    const auto by_generations = optimizer.optimize(factory, problem, {}, generations, 3UL);
+    bool generation_fidelity = !by_generations.trials.empty();
+    for (const auto &trial : by_generations.trials) {
+        generation_fidelity = generation_fidelity &&
+                              trial.optimization_result.requested_budget.generations.has_value() &&
+                              !trial.optimization_result.requested_budget.function_evaluations.has_value();
+    }
+    HPOEA_V2_CHECK(runner, generation_fidelity, "generations serve as fidelity without a fevals budget");
+
+    const auto capped = optimizer.optimize(factory, problem, fevals(10u), fevals(27u), 3UL);
+    HPOEA_V2_CHECK(runner, capped.trials.size() == 10u, "optimizer function_evaluations caps hyperband trials");
+    HPOEA_V2_CHECK(runner, capped.status == hpoea::core::RunStatus::Success, "capped hyperband keeps its best");
+
+    hpoea::core::ParameterSet too_high;
+    too_high.emplace("min_fidelity", std::int64_t{50});
+    optimizer.configure(too_high);
+    const auto rejected = optimizer.optimize(factory, problem, {}, fevals(27u), 3UL);
+    HPOEA_V2_CHECK(runner, rejected.status == hpoea::core::RunStatus::InvalidConfiguration,
+                   "min_fidelity above the full fidelity is rejected");
+
+    hpoea::core::HyperbandOptimizer timed;
+    hpoea::core::Budget wall_time;
+    wall_time.wall_time = std::chrono::milliseconds{0};
+    const auto timed_out = timed.optimize(factory, problem, wall_time, fevals(27u), 3UL);
+    HPOEA_V2_CHECK(runner, timed_out.status == hpoea::core::RunStatus::BudgetExceeded,
+                   "zero wall-time budget returns BudgetExceeded");
+    HPOEA_V2_CHECK(runner, timed_out.trials.empty(), "zero wall-time budget records no trials");
+}
+
+} // namespace
+
+int main() {
+    hpoea::tests_v2::TestRunner runner;
+    test_hyperband_brackets(runner);
+    test_asha(runner);
+    test_budgets(runner);
+    return runner.summarize("hyperband_optimizer_tests");
+}
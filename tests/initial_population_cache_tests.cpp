@@ -0,0 +1,93 @@
+#include "test_harness.hpp"
+#include "test_fixtures.hpp"
+
+#include "hpoea/core/initial_population_cache.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+hpoea::core::InitialPopulation make_population(std::size_t size) {
+    hpoea::core::InitialPopulation population;
+    for (std::size_t i = 0; i < size; ++i) {
+        population.decision_vectors.push_back({static_cast<double>(i)});
+        population.fitness.push_back(static_cast<double>(i) * 2.0);
+    }
+    return population;
+}
+
+void test_builds_once_per_key(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(1);
+    hpoea::core::InitialPopulationCache cache(11UL);
+    std::size_t builds = 0;
+    const auto build = [&] {
+        ++builds;
+        return make_population(4);
+    };
+
+    bool built = false;
+    const auto first = cache.get_or_build(problem, 4, build, &built);
+    HPOEA_V2_CHECK(runner, built && builds == 1u, "first request builds the population");
+    const auto second = cache.get_or_build(problem, 4, build, &built);
+    HPOEA_V2_CHECK(runner, !built && builds == 1u, "second request reuses the population");
+    HPOEA_V2_CHECK(runner, first == second, "reused population is the same object");
+    HPOEA_V2_CHECK(runner, cache.reused_evaluations() == 4u, "reuse is counted in evaluations");
+
+    (void)cache.get_or_build(problem, 6, [] { return make_population(6); }, &built);
+    HPOEA_V2_CHECK(runner, built, "a different population size is a different key");
+    (void)cache.get_or_build(problem, 4, 2u, build, &built);
+    HPOEA_V2_CHECK(runner, built && builds == 2u, "a different variant is a different key");
+    HPOEA_V2_CHECK(runner, cache.seed_for(4) == cache.seed_for(4) && cache.seed_for(4) != cache.seed_for(6),
+                   "seed streams are per population size and deterministic");
+}
+
+void test_failed_build_is_retried(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(1);
+    hpoea::core::InitialPopulationCache cache(3UL);
+    bool threw = false;
+    try {
+        (void)cache.get_or_build(problem, 4, []() -> hpoea::core::InitialPopulation {
+            throw std::runtime_error("evaluation down");
+        });
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    HPOEA_V2_CHECK(runner, threw, "build failure reaches the caller");
+    bool built = false;
+    (void)cache.get_or_build(problem, 4, [] { return make_population(4); }, &built);
+    HPOEA_V2_CHECK(runner, built, "failed key is rebuilt by the next caller");
+}
+
+void test_concurrent_callers_share_one_build(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(1);
+    hpoea::core::InitialPopulationCache cache(5UL);
+    std::atomic<std::size_t> builds{0};
+    std::vector<std::thread> workers;
+    for (int i = 0; i < 8; ++i) {
+        workers.emplace_back([&] {
+            (void)cache.get_or_build(problem, 10, [&] {
+                ++builds;
+                return make_population(10);
+            });
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    HPOEA_V2_CHECK(runner, builds.load() == 1u, "concurrent callers trigger a single build");
+    HPOEA_V2_CHECK(runner, cache.reused_evaluations() == 70u, "every other caller is served from the cache");
+}
+
+} // namespace
+
+int main() {
+    hpoea::tests_v2::TestRunner runner;
+    test_builds_once_per_key(runner);
+    test_failed_build_is_retried(runner);
+    test_concurrent_callers_share_one_build(runner);
+    return runner.summarize("initial_population_cache_tests");
+}
@@ -192,7 +192,7 @@ int main() {
         rt.objective_value = 3.14159;
         rt.requested_budget = Budget{5000u, 100u, std::chrono::milliseconds{3000}};
         rt.effective_budget = EffectiveBudget{5000u, 100u, std::chrono::milliseconds{3000}};
-        rt.algorithm_usage = AlgorithmRunUsage{1234u, 56u, std::chrono::milliseconds{789}};
+        rt.algorithm_usage = AlgorithmRunUsage{1234u, 56u, std::chrono::milliseconds{789}, 34u};
         rt.error_info = ErrorInfo{"config_error", "E001", "value \"out\" of\trange\n"};
         rt.algorithm_seed = 42;
         rt.optimizer_seed = 99u;
@@ -240,6 +240,8 @@ int main() {
                         "rt: algorithm_usage generations");
         HPOEA_V2_CHECK(runner, rt_json.find("\"wall_time_ms\":789") != std::string::npos,
                         "rt: algorithm_usage wall_time_ms");
+        HPOEA_V2_CHECK(runner, rt_json.find("\"cached_function_evaluations\":34") != std::string::npos,
+                        "rt: algorithm_usage cached_function_evaluations");
 
 
         HPOEA_V2_CHECK(runner, rt_json.find("\"category\":\"config_error\"") != std::string::npos,
@@ -367,6 +369,7 @@ int main() {
         check_status(RunStatus::FailedEvaluation, "failed_evaluation");
         check_status(RunStatus::InvalidConfiguration, "invalid_configuration");
         check_status(RunStatus::InternalError, "internal_error");
+        check_status(RunStatus::Pruned, "pruned");
         check_status(static_cast<RunStatus>(99), "unknown");
     }
 
@@ -0,0 +1,144 @@
+#include "test_harness.hpp"
+#include "test_fixtures.hpp"
+#include "test_utils.hpp"
+
+#include "hpoea/core/parallel_tempering_optimizer.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// objective (rate - 0.3)^2 + 0.01 * (level - 7)^2 after one problem evaluation
+hpoea::tests_v2::BowlFactory make_factory() {
+    auto space = hpoea::tests_v2::rate_space();
+    space.add_descriptor(hpoea::tests_v2::integer_descriptor("level", 0, 10, 0));
+    return {std::move(space), [](const hpoea::tests_v2::BowlRun &run) {
+                (void)run.problem.evaluate(std::vector<double>(run.problem.dimension(), 0.0));
+                const auto rate = std::get<double>(run.parameters.at("rate"));
+                const auto level = static_cast<double>(std::get<std::int64_t>(run.parameters.at("level")));
+                return (rate - 0.3) * (rate - 0.3) + 0.01 * (level - 7.0) * (level - 7.0);
+            }};
+}
+
+hpoea::core::ParameterSet tempering_parameters(std::int64_t replicas, std::int64_t sweeps, std::int64_t workers) {
+    hpoea::core::ParameterSet params;
+    params.emplace("replicas", replicas);
+    params.emplace("sweeps", sweeps);
+    params.emplace("parallel_workers", workers);
+    return params;
+}
+
+hpoea::core::Budget evaluations(std::size_t count) {
+    hpoea::core::Budget budget;
+    budget.function_evaluations = count;
+    return budget;
+}
+
+bool same_trials(const hpoea::core::HyperparameterOptimizationResult &lhs,
+                 const hpoea::core::HyperparameterOptimizationResult &rhs) {
+    if (lhs.trials.size() != rhs.trials.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < lhs.trials.size(); ++i) {
+        if (!hpoea::tests_v2::parameter_set_equals(lhs.trials[i].parameters, rhs.trials[i].parameters) ||
+            lhs.trials[i].optimization_result.seed != rhs.trials[i].optimization_result.seed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_exact_spend(hpoea::tests_v2::TestRunner &runner) {
+    auto factory = make_factory();
+    hpoea::tests_v2::DummyProblem problem(2);
+    hpoea::core::ParallelTemperingOptimizer optimizer;
+    HPOEA_V2_CHECK(runner, optimizer.identity().family == "ParallelTempering", "identity family is set");
+    optimizer.configure(tempering_parameters(4, 10, 1));
+
+    const auto result = optimizer.optimize(factory, problem, evaluations(23), evaluations(5), 7UL);
+    HPOEA_V2_REQUIRE(runner, result.status == hpoea::core::RunStatus::Success && result.trials.size() == 23u,
+                     "a budget ending mid-sweep is spent exactly");
+    HPOEA_V2_CHECK(runner, result.optimizer_usage.objective_calls == 23u && result.optimizer_usage.iterations == 5u,
+                   "usage counts runs and sweeps after the starts");
+    HPOEA_V2_CHECK(runner, std::get<std::int64_t>(result.effective_optimizer_parameters.at("sweeps")) == 5,
+                   "effective sweeps record what the budget allows");
+
+    bool indexed = true;
+    for (std::size_t i = 0; i < result.trials.size(); ++i) {
+        indexed = indexed && result.trials[i].trial_index == i;
+    }
+    HPOEA_V2_CHECK(runner, indexed, "trials are indexed in sweep order");
+
+    const auto unbounded = optimizer.optimize(factory, problem, hpoea::core::Budget{}, evaluations(5), 7UL);
+    HPOEA_V2_CHECK(runner, unbounded.trials.size() == 44u, "without a budget every chain runs every sweep");
+}
+
+void test_converges(hpoea::tests_v2::TestRunner &runner) {
+    auto factory = make_factory();
+    hpoea::tests_v2::DummyProblem problem(2);
+    hpoea::core::ParallelTemperingOptimizer optimizer;
+    auto params = tempering_parameters(4, 60, 1);
+    params.emplace("ts", 1.0);
+    params.emplace("tf", 0.01);
+    optimizer.configure(params);
+
+    const auto result = optimizer.optimize(factory, problem, evaluations(244), evaluations(5), 3UL);
+    HPOEA_V2_REQUIRE(runner, result.status == hpoea::core::RunStatus::Success, "run succeeds");
+    HPOEA_V2_CHECK(runner, result.best_objective < 0.005, "the cold chain settles near the optimum");
+    HPOEA_V2_CHECK(runner, std::get<std::int64_t>(result.best_parameters.at("level")) == 7,
+                   "integer coordinates move between cells");
+}
+
+void test_parallel_determinism(hpoea::tests_v2::TestRunner &runner) {
+    auto factory = make_factory();
+    hpoea::tests_v2::DummyProblem problem(2);
+    hpoea::core::ParallelTemperingOptimizer serial;
+    serial.configure(tempering_parameters(6, 8, 1));
+    hpoea::core::ParallelTemperingOptimizer parallel;
+    parallel.configure(tempering_parameters(6, 8, 4));
+
+    const auto lhs = serial.optimize(factory, problem, evaluations(50), evaluations(5), 21UL);
+    const auto rhs = parallel.optimize(factory, problem, evaluations(50), evaluations(5), 21UL);
+    HPOEA_V2_CHECK(runner, lhs.trials.size() == 50u && same_trials(lhs, rhs),
+                   "parallel_workers does not change the trials");
+    HPOEA_V2_CHECK(runner, lhs.best_objective == rhs.best_objective, "parallel_workers does not change the incumbent");
+}
+
+void test_rejections(hpoea::tests_v2::TestRunner &runner) {
+    auto factory = make_factory();
+    hpoea::tests_v2::DummyProblem problem(2);
+    hpoea::core::ParallelTemperingOptimizer optimizer;
+    optimizer.configure(tempering_parameters(4, 10, 1));
+
+    const auto none = optimizer.optimize(factory, problem, evaluations(3), evaluations(5), 5UL);
+    HPOEA_V2_CHECK(runner, none.status == hpoea::core::RunStatus::BudgetExceeded && none.trials.empty(),
+                   "a budget below one start per replica runs nothing");
+
+    hpoea::core::Budget generations;
+    generations.generations = 4u;
+    const auto rejected = optimizer.optimize(factory, problem, generations, evaluations(5), 5UL);
+    HPOEA_V2_CHECK(runner, rejected.status != hpoea::core::RunStatus::Success && rejected.trials.empty(),
+                   "an optimizer generations budget is rejected");
+
+    auto params = tempering_parameters(4, 10, 1);
+    params.emplace("ts", 0.5);
+    params.emplace("tf", 1.0);
+    optimizer.configure(params);
+    const auto inverted = optimizer.optimize(factory, problem, evaluations(20), evaluations(5), 5UL);
+    HPOEA_V2_CHECK(runner, inverted.status != hpoea::core::RunStatus::Success && inverted.trials.empty(),
+                   "tf above ts is rejected");
+}
+
+} // namespace
+
+int main() {
+    hpoea::tests_v2::TestRunner runner;
+    test_exact_spend(runner);
+    test_converges(runner);
+    test_parallel_determinism(runner);
+    test_rejections(runner);
+    return runner.summarize("parallel_tempering_optimizer_tests");
+}
@@ -1,6 +1,7 @@
 #include "test_harness.hpp"
 #include "test_utils.hpp"
 
+#include "hpoea/core/parameter_vector.hpp"
 #include "hpoea/core/parameters.hpp"
 
 #include <functional>
@@ -225,5 +226,81 @@ int main() {
         HPOEA_V2_CHECK(runner, threw, "apply_defaults rejects invalid override");
     }
 
+    {
+        ParameterSet first;
+        first.emplace("alpha", 0.0);
+        first.emplace("mode", std::string{"fast"});
+        first.emplace("flag", true);
+        ParameterSet second;
+        second.emplace("flag", true);
+        second.emplace("mode", std::string{"fast"});
+        second.emplace("alpha", -0.0);
+        HPOEA_V2_CHECK(runner, hpoea::core::hash_parameter_set(first) == hpoea::core::hash_parameter_set(second),
+                       "hash_parameter_set ignores insertion order and the sign of zero");
+        second.insert_or_assign("flag", false);
+        HPOEA_V2_CHECK(runner, hpoea::core::hash_parameter_set(first) != hpoea::core::hash_parameter_set(second),
+                       "hash_parameter_set tells different values apart");
+        ParameterSet integer;
+        integer.emplace("alpha", std::int64_t{0});
+        ParameterSet real;
+        real.emplace("alpha", 0.0);
+        HPOEA_V2_CHECK(runner, hpoea::core::hash_parameter_set(integer) != hpoea::core::hash_parameter_set(real),
+                       "hash_parameter_set tells value types apart");
+    }
+
+    {
+        // schema vectors agree with the map-based validate and apply_defaults
+        ParameterSpace space = make_space();
+        const hpoea::core::ParameterSchema schema(space);
+        ParameterSet overrides;
+        overrides.emplace("alpha", std::int64_t{1});
+        overrides.emplace("beta", std::int64_t{4});
+        overrides.emplace("mode", std::string{"slow"});
+        auto values = schema.to_vector(overrides);
+        HPOEA_V2_CHECK(runner, values.size() == space.size() && values[2].set && values[2].integer == 1 &&
+                                   !values[3].set,
+                       "to_vector stores categoricals as choice indices by descriptor position");
+        schema.apply_defaults(values);
+        HPOEA_V2_CHECK(runner, schema.to_set(values) == space.apply_defaults(overrides),
+                       "vector apply_defaults matches ParameterSpace::apply_defaults");
+        HPOEA_V2_CHECK(runner, std::get<double>(schema.to_set(values).at("alpha")) == 1.0,
+                       "integer literals widen to continuous values");
+
+        values[1].integer = 11;
+        std::string message;
+        try {
+            schema.validate(values);
+        } catch (const ParameterValidationError &ex) {
+            message = ex.what();
+        }
+        std::string expected;
+        try {
+            space.validate_value(space.descriptor("beta"), std::int64_t{11});
+        } catch (const ParameterValidationError &ex) {
+            expected = ex.what();
+        }
+        HPOEA_V2_CHECK(runner, !message.empty() && message == expected,
+                       "vector validation reports like validate_value");
+
+        values[1].set = false;
+        bool threw = false;
+        try {
+            schema.validate(values);
+        } catch (const ParameterValidationError &) {
+            threw = true;
+        }
+        HPOEA_V2_CHECK(runner, threw, "vector validation requires required slots");
+
+        threw = false;
+        try {
+            ParameterSet unknown;
+            unknown.emplace("gamma", 1.0);
+            (void)schema.to_vector(unknown);
+        } catch (const ParameterValidationError &) {
+            threw = true;
+        }
+        HPOEA_V2_CHECK(runner, threw, "to_vector rejects unknown parameters");
+    }
+
     return runner.summarize("parameter_space_tests");
 }
@@ -0,0 +1,295 @@
+#include "test_harness.hpp"
+#include "test_fixtures.hpp"
+#include "test_utils.hpp"
+
+#include "hpoea/core/initial_population_cache.hpp"
+#include "hpoea/core/logging.hpp"
+#include "hpoea/core/pbt_optimizer.hpp"
+#include "hpoea/core/seed_repeats.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// objective rate after one problem evaluation. the final population holds
+// one individual whose decision vector counts the segments run before, so
+// a warm started run ends one deeper than its start.
+hpoea::tests_v2::BowlFactory make_factory() {
+    return {hpoea::tests_v2::rate_space(),
+            [](const hpoea::tests_v2::BowlRun &run) {
+                (void)run.problem.evaluate(std::vector<double>(run.problem.dimension(), 0.0));
+                const auto rate = std::get<double>(run.parameters.at("rate"));
+                const auto depth = run.warm_start ? run.warm_start->decision_vectors.at(0).at(0) + 1.0 : 0.0;
+                auto population = std::make_shared<hpoea::core::InitialPopulation>();
+                population->decision_vectors.push_back({depth});
+                population->fitness.push_back(rate);
+                run.result.final_population = std::move(population);
+                return rate;
+            },
+            true};
+}
+
+hpoea::core::ParameterSet pbt_parameters(std::int64_t members, std::int64_t rounds, double exploit_fraction,
+                                         std::int64_t workers) {
+    hpoea::core::ParameterSet params;
+    params.emplace("members", members);
+    params.emplace("rounds", rounds);
+    params.emplace("exploit_fraction", exploit_fraction);
+    params.emplace("parallel_workers", workers);
+    return params;
+}
+
+hpoea::core::Budget evaluations(std::size_t count) {
+    hpoea::core::Budget budget;
+    budget.function_evaluations = count;
+    return budget;
+}
+
+double depth(const hpoea::core::HyperparameterTrialRecord &trial) {
+    const auto &population = trial.optimization_result.final_population;
+    return population ? population->decision_vectors.at(0).at(0) : -1.0;
+}
+
+bool same_trials(const hpoea::core::HyperparameterOptimizationResult &lhs,
+                 const hpoea::core::HyperparameterOptimizationResult &rhs) {
+    if (lhs.trials.size() != rhs.trials.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < lhs.trials.size(); ++i) {
+        const auto &a = lhs.trials[i];
+        const auto &b = rhs.trials[i];
+        if (!hpoea::tests_v2::parameter_set_equals(a.parameters, b.parameters) ||
+            a.optimization_result.seed != b.optimization_result.seed || !a.lineage || !b.lineage ||
+            a.lineage->parent_trial != b.lineage->parent_trial || a.lineage->exploited != b.lineage->exploited) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_rounds_and_lineage(hpoea::tests_v2::TestRunner &runner) {
+    auto factory = make_factory();
+    hpoea::tests_v2::DummyProblem problem(2);
+    hpoea::core::PbtOptimizer optimizer;
+    HPOEA_V2_CHECK(runner, optimizer.identity().family == "PopulationBasedTraining", "identity family is set");
+    optimizer.configure(pbt_parameters(4, 3, 0.25, 1));
+
+    const auto result = optimizer.optimize(factory, problem, evaluations(12), evaluations(12), 11UL);
+    HPOEA_V2_REQUIRE(runner, result.status == hpoea::core::RunStatus::Success && result.trials.size() == 12u,
+                     "every member runs every round");
+    HPOEA_V2_CHECK(runner, result.optimizer_usage.objective_calls == 12u && result.optimizer_usage.iterations == 3u,
+                   "usage counts runs and rounds");
+
+    bool indexed = true;
+    bool split = true;
+    bool continued = true;
+    for (std::size_t i = 0; i < result.trials.size(); ++i) {
+        const auto &trial = result.trials[i];
+        indexed = indexed && trial.trial_index == i && trial.lineage.has_value() && trial.lineage->member == i % 4 &&
+                  trial.lineage->round == i / 4;
+        split = split && trial.optimization_result.requested_budget.function_evaluations == 4u;
+        continued = continued && depth(trial) == static_cast<double>(i / 4) && trial.lineage &&
+                    trial.lineage->resumed == (i >= 4u);
+    }
+    HPOEA_V2_CHECK(runner, indexed, "trial r * members + m is member m in round r");
+    HPOEA_V2_CHECK(runner, split, "each segment gets 1 / rounds of the algorithm budget");
+    HPOEA_V2_CHECK(runner, continued,
+                   "every segment continues from the population of the one before and records that it resumed");
+
+    bool first_round_fresh = true;
+    for (std::size_t m = 0; m < 4u; ++m) {
+        first_round_fresh = first_round_fresh && !result.trials[m].lineage->parent_trial.has_value() &&
+                            !result.trials[m].lineage->exploited;
+    }
+    HPOEA_V2_CHECK(runner, first_round_fresh, "first round members have no parent");
+
+    bool exploits = true;
+    for (std::size_t round = 1; round < 3u; ++round) {
+        std::size_t best = 0;
+        std::size_t worst = 0;
+        for (std::size_t m = 1; m < 4u; ++m) {
+            const auto objective = result.trials[(round - 1) * 4 + m].optimization_result.best_fitness;
+            if (objective < result.trials[(round - 1) * 4 + best].optimization_result.best_fitness) {
+                best = m;
+            }
+            if (objective > result.trials[(round - 1) * 4 + worst].optimization_result.best_fitness) {
+                worst = m;
+            }
+        }
+        for (std::size_t m = 0; m < 4u; ++m) {
+            const auto &lineage = *result.trials[round * 4 + m].lineage;
+            const auto parent = m == worst ? (round - 1) * 4 + best : (round - 1) * 4 + m;
+            exploits = exploits && lineage.exploited == (m == worst) && lineage.parent_trial == parent;
+        }
+    }
+    HPOEA_V2_CHECK(runner, exploits, "the worst member continues from the best one and the rest from themselves");
+
+    const auto best_rate = std::get<double>(result.best_parameters.at("rate"));
+    HPOEA_V2_CHECK(runner, result.best_objective == best_rate, "the best trial is the incumbent");
+}
+
+void test_exploit_off(hpoea::tests_v2::TestRunner &runner) {
+    auto factory = make_factory();
+    hpoea::tests_v2::DummyProblem problem(2);
+    hpoea::core::PbtOptimizer optimizer;
+    optimizer.configure(pbt_parameters(3, 3, 0.0, 1));
+
+    const auto result = optimizer.optimize(factory, problem, evaluations(9), evaluations(9), 3UL);
+    HPOEA_V2_REQUIRE(runner, result.trials.size() == 9u, "every member runs every round");
+    bool kept = true;
+    for (std::size_t i = 3; i < 9u; ++i) {
+        const auto &trial = result.trials[i];
+        kept = kept && !trial.lineage->exploited &&
+               hpoea::tests_v2::parameter_set_equals(trial.parameters, result.trials[i % 3].parameters);
+    }
+    HPOEA_V2_CHECK(runner, kept, "without exploitation members keep their parameters");
+}
+
+void test_parallel_determinism(hpoea::tests_v2::TestRunner &runner) {
+    auto factory = make_factory();
+    hpoea::tests_v2::DummyProblem problem(2);
+    hpoea::core::PbtOptimizer serial;
+    serial.configure(pbt_parameters(8, 4, 0.5, 1));
+    hpoea::core::PbtOptimizer parallel;
+    parallel.configure(pbt_parameters(8, 4, 0.5, 4));
+
+    const auto lhs = serial.optimize(factory, problem, evaluations(32), evaluations(40), 21UL);
+    const auto rhs = parallel.optimize(factory, problem, evaluations(32), evaluations(40), 21UL);
+    HPOEA_V2_CHECK(runner, lhs.trials.size() == 32u && same_trials(lhs, rhs),
+                   "parallel_workers does not change the trials");
+}
+
+void test_budgets(hpoea::tests_v2::TestRunner &runner) {
+    auto factory = make_factory();
+    hpoea::tests_v2::DummyProblem problem(2);
+    hpoea::core::PbtOptimizer optimizer;
+    optimizer.configure(pbt_parameters(4, 3, 0.25, 1));
+
+    const auto partial = optimizer.optimize(factory, problem, evaluations(10), evaluations(12), 5UL);
+    HPOEA_V2_CHECK(runner, partial.trials.size() == 8u && partial.optimizer_usage.iterations == 2u,
+                   "only whole rounds that fit the budget run");
+
+    const auto none = optimizer.optimize(factory, problem, evaluations(3), evaluations(12), 5UL);
+    HPOEA_V2_CHECK(runner, none.status == hpoea::core::RunStatus::BudgetExceeded && none.trials.empty(),
+                   "a budget below one round runs nothing");
+
+    hpoea::core::Budget wall_time_only;
+    wall_time_only.wall_time = std::chrono::milliseconds{1000};
+    const auto unsplit = optimizer.optimize(factory, problem, evaluations(12), wall_time_only, 5UL);
+    HPOEA_V2_CHECK(runner, unsplit.status != hpoea::core::RunStatus::Success && unsplit.trials.empty(),
+                   "an algorithm budget without evaluations or generations is rejected");
+
+    const auto small = optimizer.optimize(factory, problem, evaluations(12), evaluations(2), 5UL);
+    HPOEA_V2_CHECK(runner, small.status != hpoea::core::RunStatus::Success,
+                   "an algorithm budget smaller than rounds is rejected");
+
+    hpoea::core::Budget generations;
+    generations.generations = 4u;
+    const auto rejected = optimizer.optimize(factory, problem, generations, evaluations(12), 5UL);
+    HPOEA_V2_CHECK(runner, rejected.status != hpoea::core::RunStatus::Success,
+                   "an optimizer generations budget is rejected");
+}
+
+void test_wall_time_within_round(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::BowlFactory factory{hpoea::tests_v2::rate_space(),
+                                         [](const hpoea::tests_v2::BowlRun &run) {
+                                             std::this_thread::sleep_for(std::chrono::milliseconds{20});
+                                             return std::get<double>(run.parameters.at("rate"));
+                                         },
+                                         true};
+    hpoea::tests_v2::DummyProblem problem(2);
+    hpoea::core::PbtOptimizer optimizer;
+    optimizer.configure(pbt_parameters(8, 2, 0.25, 1));
+
+    auto budget = evaluations(16);
+    budget.wall_time = std::chrono::milliseconds{30};
+    const auto result = optimizer.optimize(factory, problem, budget, evaluations(12), 5UL);
+    HPOEA_V2_CHECK(runner, result.status == hpoea::core::RunStatus::BudgetExceeded,
+                   "a spent wall time ends the run");
+    HPOEA_V2_CHECK(runner, !result.trials.empty() && result.trials.size() < 8u &&
+                               result.optimizer_usage.iterations == 0u,
+                   "the wall time is checked between the trials of a round");
+}
+
+void test_warm_start_through_wrappers(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(2);
+    hpoea::core::PbtOptimizer optimizer;
+    optimizer.configure(pbt_parameters(2, 3, 0.0, 1));
+
+    hpoea::tests_v2::BowlFactory refusing{hpoea::tests_v2::rate_space(),
+                                          [](const hpoea::tests_v2::BowlRun &run) {
+                                              return std::get<double>(run.parameters.at("rate"));
+                                          }};
+    const auto fresh = optimizer.optimize(refusing, problem, evaluations(6), evaluations(6), 5UL);
+    bool refused = fresh.trials.size() == 6u;
+    for (const auto &trial : fresh.trials) {
+        refused = refused && trial.lineage && !trial.lineage->resumed;
+    }
+    HPOEA_V2_CHECK(runner, refused, "segments of algorithms that refuse warm starts record that they began fresh");
+
+    // every repeat continues from its own part of the state
+    auto base = make_factory();
+    hpoea::core::SeedRepeatFactory repeats(base, hpoea::core::SeedRepeatPolicy{2, 2, 0.1, 0.0, 1});
+    const auto result = optimizer.optimize(repeats, problem, evaluations(6), evaluations(12), 5UL);
+    HPOEA_V2_REQUIRE(runner, result.trials.size() == 6u, "every member runs every round over the repeats");
+    bool continued = true;
+    for (std::size_t i = 0; i < result.trials.size(); ++i) {
+        const auto &trial = result.trials[i];
+        const auto &state = trial.optimization_result.final_population;
+        continued = continued && trial.lineage && trial.lineage->resumed == (i >= 2u) && state &&
+                    state->parts.size() == 2u;
+        for (std::size_t r = 0; continued && r < 2u; ++r) {
+            continued = state->parts[r] && state->parts[r]->decision_vectors.at(0).at(0) == static_cast<double>(i / 2);
+        }
+    }
+    HPOEA_V2_CHECK(runner, continued, "seed-repeated segments continue from the populations of the one before");
+}
+
+void test_logged_lineage(hpoea::tests_v2::TestRunner &runner) {
+    auto factory = make_factory();
+    hpoea::tests_v2::DummyProblem problem(2);
+    hpoea::core::PbtOptimizer optimizer;
+    optimizer.configure(pbt_parameters(2, 2, 0.5, 1));
+    hpoea::tests_v2::CapturingLogger logger;
+
+    hpoea::core::ExperimentConfig config;
+    config.experiment_id = "pbt";
+    config.optimizer_budget.function_evaluations = 4u;
+    config.algorithm_budget.function_evaluations = 10u;
+    config.validation_repeats = 1;
+    config.random_seed = 9UL;
+
+    hpoea::core::SequentialExperimentManager manager;
+    (void)manager.run_experiment(config, optimizer, factory, problem, logger);
+    HPOEA_V2_REQUIRE(runner, logger.records.size() == 5u, "four tuning records and one validation run");
+
+    const auto &tuning = logger.records[3];
+    HPOEA_V2_CHECK(runner, tuning.lineage.has_value() && tuning.lineage->member == 1u && tuning.lineage->round == 1u,
+                   "tuning records carry the lineage");
+    const auto line = hpoea::core::serialize_run_record(tuning);
+    HPOEA_V2_CHECK(runner, line.find("\"lineage\":{\"member\":1,\"round\":1,\"parent_trial\":") != std::string::npos,
+                   "the lineage is serialized as an object");
+    const auto validation = hpoea::core::serialize_run_record(logger.records.back());
+    HPOEA_V2_CHECK(runner, validation.find("\"lineage\":null}") != std::string::npos,
+                   "validation runs have no lineage");
+}
+
+} // namespace
+
+int main() {
+    hpoea::tests_v2::TestRunner runner;
+    test_rounds_and_lineage(runner);
+    test_exploit_off(runner);
+    test_parallel_determinism(runner);
+    test_budgets(runner);
+    test_wall_time_within_round(runner);
+    test_warm_start_through_wrappers(runner);
+    test_logged_lineage(runner);
+    return runner.summarize("pbt_optimizer_tests");
+}
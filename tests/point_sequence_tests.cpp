@@ -0,0 +1,130 @@
+#include "test_harness.hpp"
+
+#include "hpoea/core/point_sequence.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+using hpoea::core::PointSequence;
+using hpoea::core::PointSequenceKind;
+
+std::vector<std::vector<double>> draw(PointSequenceKind kind, std::size_t dimension, std::size_t count,
+                                      std::uint64_t seed) {
+    PointSequence sequence(kind, dimension, count, seed);
+    std::vector<std::vector<double>> points(count);
+    for (auto &point : points) {
+        sequence.next(point);
+    }
+    return points;
+}
+
+// every coordinate j of points[0..bins) falls in a different 1/bins interval
+bool stratified(const std::vector<std::vector<double>> &points, std::size_t j, std::size_t bins) {
+    std::vector<int> seen(bins, 0);
+    for (std::size_t i = 0; i < bins; ++i) {
+        const auto value = points[i][j];
+        if (value < 0.0 || value >= 1.0) {
+            return false;
+        }
+        // tolerance for interval edges that round just below
+        const auto bin = std::min(static_cast<std::size_t>(value * static_cast<double>(bins) + 1e-9), bins - 1);
+        if (seen[bin]++ != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_sobol_is_a_scrambled_net(hpoea::tests_v2::TestRunner &runner) {
+    // 40 dimensions reach past the joe-kuo table into generated polynomials
+    const auto points = draw(PointSequenceKind::Sobol, 40, 64, 17);
+    bool all = true;
+    for (std::size_t j = 0; j < 40; ++j) {
+        all = all && stratified(points, j, 64);
+    }
+    HPOEA_V2_CHECK(runner, all, "sobol 64 points fill one interval per 1/64 in every dimension");
+
+    std::vector<int> cells(16, 0);
+    bool net = true;
+    for (std::size_t i = 0; i < 16; ++i) {
+        const auto cell = static_cast<std::size_t>(points[i][0] * 4) * 4 + static_cast<std::size_t>(points[i][1] * 4);
+        net = net && cells[cell]++ == 0;
+    }
+    HPOEA_V2_CHECK(runner, net, "sobol first 16 points fill every cell of a 4x4 grid");
+
+    const auto other = draw(PointSequenceKind::Sobol, 40, 64, 18);
+    HPOEA_V2_CHECK(runner, other[0] != points[0], "sobol scrambling depends on the seed");
+    HPOEA_V2_CHECK(runner, draw(PointSequenceKind::Sobol, 40, 64, 17) == points, "sobol is reproducible");
+}
+
+void test_halton_is_stratified(hpoea::tests_v2::TestRunner &runner) {
+    const auto points = draw(PointSequenceKind::Halton, 3, 81, 5);
+    HPOEA_V2_CHECK(runner, stratified(points, 0, 64), "halton base 2 fills one interval per 1/64");
+    HPOEA_V2_CHECK(runner, stratified(points, 1, 81), "halton base 3 fills one interval per 1/81");
+    HPOEA_V2_CHECK(runner, stratified(points, 2, 25), "halton base 5 fills one interval per 1/25");
+    HPOEA_V2_CHECK(runner, draw(PointSequenceKind::Halton, 3, 81, 6) != points,
+                   "halton scrambling depends on the seed");
+}
+
+void test_latin_hypercube_blocks(hpoea::tests_v2::TestRunner &runner) {
+    PointSequence sequence(PointSequenceKind::LatinHypercube, 5, 10, 3);
+    std::vector<std::vector<double>> block(10);
+    bool all = true;
+    for (int round = 0; round < 3; ++round) {
+        for (auto &point : block) {
+            sequence.next(point);
+        }
+        for (std::size_t j = 0; j < 5; ++j) {
+            all = all && stratified(block, j, 10);
+        }
+    }
+    HPOEA_V2_CHECK(runner, all, "every latin hypercube block has one point per stratum and dimension");
+}
+
+void test_next_reuses_storage(hpoea::tests_v2::TestRunner &runner) {
+    for (const auto kind : {PointSequenceKind::Uniform, PointSequenceKind::Sobol, PointSequenceKind::Halton,
+                            PointSequenceKind::LatinHypercube}) {
+        PointSequence sequence(kind, 6, 8, 1);
+        std::vector<double> point;
+        sequence.next(point);
+        const auto *data = point.data();
+        bool stable = true;
+        for (int i = 0; i < 20; ++i) {
+            sequence.next(point);
+            stable = stable && point.data() == data && point.size() == 6u;
+        }
+        HPOEA_V2_CHECK(runner, stable, std::string(hpoea::core::to_string(kind)) + " next() reuses the buffer");
+    }
+
+    PointSequence boxed(PointSequenceKind::Sobol, 2, 4, 9);
+    std::vector<double> point;
+    boxed.next_in_box({-5.0, 10.0}, {5.0, 10.0}, point);
+    HPOEA_V2_CHECK(runner, point[0] >= -5.0 && point[0] < 5.0 && point[1] == 10.0, "next_in_box maps onto the box");
+}
+
+void test_kind_names(hpoea::tests_v2::TestRunner &runner) {
+    bool round_trip = true;
+    for (const auto &name : hpoea::core::point_sequence_choices()) {
+        const auto kind = hpoea::core::parse_point_sequence_kind(name);
+        round_trip = round_trip && kind && hpoea::core::to_string(*kind) == name;
+    }
+    HPOEA_V2_CHECK(runner, round_trip, "point sequence names round-trip");
+    HPOEA_V2_CHECK(runner, !hpoea::core::parse_point_sequence_kind("grid"), "unknown point sequence is rejected");
+}
+
+} // namespace
+
+int main() {
+    hpoea::tests_v2::TestRunner runner;
+    test_sobol_is_a_scrambled_net(runner);
+    test_halton_is_stratified(runner);
+    test_latin_hypercube_blocks(runner);
+    test_next_reuses_storage(runner);
+    test_kind_names(runner);
+    return runner.summarize("point_sequence_tests");
+}
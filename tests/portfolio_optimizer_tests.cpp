@@ -0,0 +1,269 @@
+#include "test_harness.hpp"
+#include "test_fixtures.hpp"
+#include "test_utils.hpp"
+
+#include "hpoea/core/grid_search_optimizer.hpp"
+#include "hpoea/core/hyperband_optimizer.hpp"
+#include "hpoea/core/parallel_tempering_optimizer.hpp"
+#include "hpoea/core/portfolio_optimizer.hpp"
+#include "hpoea/core/random_search_optimizer.hpp"
+#include "hpoea/core/trial_runner.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace {
+
+std::atomic<std::size_t> inner_runs{0};
+
+// objective (rate - 0.3)^2 after one problem evaluation, counted in inner_runs
+hpoea::tests_v2::BowlFactory make_factory() {
+    return {hpoea::tests_v2::rate_space(), [](const hpoea::tests_v2::BowlRun &run) {
+                inner_runs.fetch_add(1, std::memory_order_relaxed);
+                (void)run.problem.evaluate(std::vector<double>(run.problem.dimension(), 0.0));
+                const auto rate = std::get<double>(run.parameters.at("rate"));
+                return (rate - 0.3) * (rate - 0.3);
+            }};
+}
+
+// spends its whole budget on one call: the same parameter set on seed 1,
+// whatever seed the portfolio hands it
+hpoea::core::HyperparameterOptimizerPtr fixed_point_tuner(double rate) {
+    return std::make_unique<hpoea::tests_v2::StubHyperOptimizer>(
+        [rate](const hpoea::core::IEvolutionaryAlgorithmFactory &factory, const hpoea::core::IProblem &problem,
+               const hpoea::core::Budget &budget, const hpoea::core::Budget &algorithm_budget, unsigned long) {
+            hpoea::core::HyperparameterOptimizationResult result;
+            const auto calls = budget.function_evaluations.value_or(1u);
+            for (std::size_t i = 0; i < calls; ++i) {
+                result.trials.push_back(hpoea::core::run_trial(factory, problem, algorithm_budget, 1UL, i, [rate] {
+                    hpoea::core::ParameterSet parameters;
+                    parameters.emplace("rate", rate);
+                    return parameters;
+                }));
+            }
+            result.optimizer_usage.objective_calls = calls;
+            hpoea::core::select_best_trial(result, "fixed point");
+            return result;
+        });
+}
+
+hpoea::core::ParameterSet portfolio_parameters(std::int64_t rounds, std::int64_t workers) {
+    hpoea::core::ParameterSet params;
+    params.emplace("rounds", rounds);
+    params.emplace("parallel_workers", workers);
+    return params;
+}
+
+hpoea::core::Budget evaluations(std::size_t count) {
+    hpoea::core::Budget budget;
+    budget.function_evaluations = count;
+    return budget;
+}
+
+std::size_t count_trials(const hpoea::core::HyperparameterOptimizationResult &result, std::size_t member,
+                         std::size_t round) {
+    std::size_t count = 0;
+    for (const auto &trial : result.trials) {
+        if (trial.lineage && trial.lineage->member == member && trial.lineage->round == round) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void test_reallocation_and_memo(hpoea::tests_v2::TestRunner &runner) {
+    auto factory = make_factory();
+    hpoea::tests_v2::DummyProblem problem(2);
+    std::vector<hpoea::core::HyperparameterOptimizerPtr> members;
+    members.push_back(fixed_point_tuner(0.3));
+    members.push_back(fixed_point_tuner(0.9));
+    hpoea::core::PortfolioOptimizer optimizer(std::move(members));
+    HPOEA_V2_CHECK(runner, optimizer.identity().family == "Portfolio", "identity family is set");
+    optimizer.configure(portfolio_parameters(2, 1));
+
+    inner_runs = 0;
+    const auto result = optimizer.optimize(factory, problem, evaluations(40), evaluations(5), 7UL);
+    HPOEA_V2_REQUIRE(runner, result.status == hpoea::core::RunStatus::Success && result.trials.size() == 58u,
+                     "budget the memo saves carries over to the last round");
+    HPOEA_V2_CHECK(runner, inner_runs.load() == 2u && result.optimizer_usage.objective_calls == 2u,
+                   "each parameter set runs once and objective_calls counts real runs");
+    HPOEA_V2_CHECK(runner, result.optimizer_usage.cached_objective_calls == 56u &&
+                              result.optimizer_usage.proposed_configurations == 58u,
+                   "memo hits are reported as cached calls");
+    HPOEA_V2_CHECK(runner, count_trials(result, 0, 0) == 10u && count_trials(result, 1, 0) == 10u,
+                   "the first round splits evenly");
+    HPOEA_V2_CHECK(runner, count_trials(result, 0, 1) == 34u && count_trials(result, 1, 1) == 4u,
+                   "the member that improved gets the larger share of the next round");
+    HPOEA_V2_CHECK(runner, result.best_objective == 0.0, "the best member's trial is the incumbent");
+
+    bool indexed = true;
+    for (std::size_t i = 0; i < result.trials.size(); ++i) {
+        indexed = indexed && result.trials[i].trial_index == i;
+    }
+    HPOEA_V2_CHECK(runner, indexed, "merged trials are indexed in order");
+
+    const auto copy = optimizer.clone();
+    const auto again = copy->optimize(factory, problem, evaluations(40), evaluations(5), 7UL);
+    HPOEA_V2_CHECK(runner, again.trials.size() == 58u, "a clone carries its members");
+}
+
+void test_core_members(hpoea::tests_v2::TestRunner &runner) {
+    auto factory = make_factory();
+    hpoea::tests_v2::DummyProblem problem(2);
+    const auto make = [](std::int64_t workers) {
+        hpoea::core::PortfolioOptimizer optimizer;
+        auto random_search = std::make_unique<hpoea::core::RandomSearchOptimizer>();
+        auto tempering = std::make_unique<hpoea::core::ParallelTemperingOptimizer>();
+        hpoea::core::ParameterSet tempering_params;
+        tempering_params.emplace("replicas", std::int64_t{2});
+        tempering->configure(tempering_params);
+        optimizer.add_member(std::move(random_search));
+        optimizer.add_member(std::move(tempering));
+        optimizer.configure(portfolio_parameters(3, workers));
+        return optimizer;
+    };
+
+    auto serial = make(1);
+    auto parallel = make(2);
+    inner_runs = 0;
+    const auto lhs = serial.optimize(factory, problem, evaluations(60), evaluations(5), 11UL);
+    HPOEA_V2_REQUIRE(runner, lhs.status == hpoea::core::RunStatus::Success, "run succeeds");
+    HPOEA_V2_CHECK(runner, lhs.optimizer_usage.objective_calls <= 60u &&
+                              inner_runs.load() == lhs.optimizer_usage.objective_calls,
+                   "the members together stay within the budget");
+    HPOEA_V2_CHECK(runner, lhs.optimizer_usage.iterations == 3u, "iterations counts rounds");
+
+    const auto rhs = parallel.optimize(factory, problem, evaluations(60), evaluations(5), 11UL);
+    bool same = lhs.trials.size() == rhs.trials.size();
+    for (std::size_t i = 0; same && i < lhs.trials.size(); ++i) {
+        same = hpoea::tests_v2::parameter_set_equals(lhs.trials[i].parameters, rhs.trials[i].parameters) &&
+               lhs.trials[i].lineage->member == rhs.trials[i].lineage->member;
+    }
+    HPOEA_V2_CHECK(runner, same, "parallel_workers does not change the trials");
+}
+
+void test_repeating_member(hpoea::tests_v2::TestRunner &runner) {
+    // the objective depends on the seed, so a repeat on the member's own
+    // seed would score differently
+    hpoea::tests_v2::BowlFactory factory{hpoea::tests_v2::rate_space(), [](const hpoea::tests_v2::BowlRun &run) {
+                                             inner_runs.fetch_add(1, std::memory_order_relaxed);
+                                             const auto rate = std::get<double>(run.parameters.at("rate"));
+                                             return (rate - 0.3) * (rate - 0.3) +
+                                                    static_cast<double>(run.seed % 1000u) * 1e-6;
+                                         }};
+    hpoea::tests_v2::DummyProblem problem(2);
+    hpoea::core::PortfolioOptimizer optimizer;
+    // grid search walks the same five points every round, each on a seed
+    // of its own
+    optimizer.add_member(std::make_unique<hpoea::core::GridSearchOptimizer>());
+    optimizer.add_member(std::make_unique<hpoea::core::RandomSearchOptimizer>());
+    optimizer.configure(portfolio_parameters(3, 1));
+
+    inner_runs = 0;
+    const auto result = optimizer.optimize(factory, problem, evaluations(60), evaluations(5), 5UL);
+    HPOEA_V2_REQUIRE(runner, result.status == hpoea::core::RunStatus::Success, "run succeeds");
+    const auto repeats = count_trials(result, 0, 1) + count_trials(result, 0, 2);
+    HPOEA_V2_CHECK(runner, count_trials(result, 0, 0) == 5u && repeats > 0u,
+                   "grid search walks its grid again in later rounds");
+    HPOEA_V2_CHECK(runner, result.optimizer_usage.cached_objective_calls >= repeats &&
+                              inner_runs.load() == result.optimizer_usage.objective_calls &&
+                              result.optimizer_usage.objective_calls +
+                                      result.optimizer_usage.cached_objective_calls ==
+                                  result.trials.size(),
+                   "later rounds' grid points are answered from the memo");
+
+    std::map<double, double> fitness_by_rate;
+    bool consistent = true;
+    for (const auto &trial : result.trials) {
+        const auto rate = std::get<double>(trial.parameters.at("rate"));
+        const auto fitness = trial.optimization_result.best_fitness;
+        const auto [it, inserted] = fitness_by_rate.emplace(rate, fitness);
+        consistent = consistent && (inserted || it->second == fitness);
+    }
+    HPOEA_V2_CHECK(runner, consistent, "a configuration has one value whichever member or round runs it");
+}
+
+void test_fidelity_member(hpoea::tests_v2::TestRunner &runner) {
+    // the objective improves with the run's budget, so a low rung answering
+    // a promotion would show in its fitness
+    hpoea::tests_v2::BowlFactory factory{hpoea::tests_v2::rate_space(), [](const hpoea::tests_v2::BowlRun &run) {
+                                             inner_runs.fetch_add(1, std::memory_order_relaxed);
+                                             const auto rate = std::get<double>(run.parameters.at("rate"));
+                                             return (rate - 0.3) * (rate - 0.3) +
+                                                    1.0 / static_cast<double>(
+                                                              run.budget.function_evaluations.value_or(1u));
+                                         }};
+    hpoea::tests_v2::DummyProblem problem(2);
+    hpoea::core::PortfolioOptimizer optimizer;
+    optimizer.add_member(std::make_unique<hpoea::core::HyperbandOptimizer>());
+    optimizer.configure(portfolio_parameters(1, 1));
+
+    inner_runs = 0;
+    const auto result = optimizer.optimize(factory, problem, evaluations(1000), evaluations(27), 3UL);
+    HPOEA_V2_REQUIRE(runner, result.status == hpoea::core::RunStatus::Success && !result.trials.empty(),
+                     "a hyperband member runs");
+    bool own_fidelity = true;
+    std::size_t promoted = 0;
+    for (const auto &trial : result.trials) {
+        const auto rate = std::get<double>(trial.parameters.at("rate"));
+        const auto fidelity = trial.optimization_result.requested_budget.function_evaluations.value_or(0u);
+        own_fidelity = own_fidelity && fidelity > 0u &&
+                       trial.optimization_result.best_fitness ==
+                           (rate - 0.3) * (rate - 0.3) + 1.0 / static_cast<double>(fidelity);
+        promoted += fidelity == 27u ? 1u : 0u;
+    }
+    HPOEA_V2_CHECK(runner, promoted > 0u && own_fidelity, "promoted configurations run at their own fidelity");
+    HPOEA_V2_CHECK(runner, result.optimizer_usage.cached_objective_calls == 0u &&
+                              inner_runs.load() == result.trials.size(),
+                   "rungs of one configuration on one seed are different calls");
+}
+
+void test_rejections(hpoea::tests_v2::TestRunner &runner) {
+    auto factory = make_factory();
+    hpoea::tests_v2::DummyProblem problem(2);
+
+    hpoea::core::PortfolioOptimizer empty;
+    const auto no_members = empty.optimize(factory, problem, evaluations(10), evaluations(5), 1UL);
+    HPOEA_V2_CHECK(runner, no_members.status != hpoea::core::RunStatus::Success, "a portfolio needs members");
+
+    hpoea::core::PortfolioOptimizer optimizer;
+    optimizer.add_member(fixed_point_tuner(0.5));
+    hpoea::core::Budget wall_time_only;
+    wall_time_only.wall_time = std::chrono::milliseconds{1000};
+    const auto unbounded = optimizer.optimize(factory, problem, wall_time_only, evaluations(5), 1UL);
+    HPOEA_V2_CHECK(runner, unbounded.status != hpoea::core::RunStatus::Success && unbounded.trials.empty(),
+                   "a function_evaluations budget is required");
+
+    hpoea::core::Budget generations = evaluations(10);
+    generations.generations = 2u;
+    const auto rejected = optimizer.optimize(factory, problem, generations, evaluations(5), 1UL);
+    HPOEA_V2_CHECK(runner, rejected.status != hpoea::core::RunStatus::Success, "a generations budget is rejected");
+
+    hpoea::core::PortfolioOptimizer failing;
+    failing.add_member(std::make_unique<hpoea::tests_v2::StubHyperOptimizer>(
+        [](const auto &, const auto &, const auto &, const auto &, unsigned long) {
+            hpoea::core::HyperparameterOptimizationResult result;
+            result.status = hpoea::core::RunStatus::InvalidConfiguration;
+            result.message = "member rejected the budget";
+            return result;
+        }));
+    const auto failed = failing.optimize(factory, problem, evaluations(10), evaluations(5), 1UL);
+    HPOEA_V2_CHECK(runner, failed.status == hpoea::core::RunStatus::InvalidConfiguration &&
+                              failed.message == "member rejected the budget",
+                   "a portfolio whose members all fail reports the first failure");
+}
+
+} // namespace
+
+int main() {
+    hpoea::tests_v2::TestRunner runner;
+    test_reallocation_and_memo(runner);
+    test_core_members(runner);
+    test_repeating_member(runner);
+    test_fidelity_member(runner);
+    test_rejections(runner);
+    return runner.summarize("portfolio_optimizer_tests");
+}
@@ -0,0 +1,280 @@
+#include "test_harness.hpp"
+#include "test_fixtures.hpp"
+#include "test_utils.hpp"
+
+#include "hpoea/core/initial_population_cache.hpp"
+#include "hpoea/core/problem_set.hpp"
+#include "hpoea/core/random_search_optimizer.hpp"
+#include "hpoea/core/seeding.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// one-dimensional problem with objective level + x^2
+class LevelProblem final : public hpoea::core::IProblem {
+public:
+    LevelProblem(std::string id, double level) : level_(level) {
+        metadata_.id = std::move(id);
+        metadata_.family = "tests";
+    }
+
+    [[nodiscard]] const hpoea::core::ProblemMetadata &metadata() const noexcept override { return metadata_; }
+    [[nodiscard]] std::size_t dimension() const override { return 1; }
+    [[nodiscard]] std::vector<double> lower_bounds() const override { return {-1.0}; }
+    [[nodiscard]] std::vector<double> upper_bounds() const override { return {1.0}; }
+
+    [[nodiscard]] double evaluate(const std::vector<double> &decision_vector) const override {
+        return level_ + decision_vector.at(0) * decision_vector.at(0);
+    }
+
+private:
+    double level_;
+    hpoea::core::ProblemMetadata metadata_{};
+};
+
+// evaluates the problem once at x = rate
+hpoea::tests_v2::BowlFactory make_factory() {
+    return {hpoea::tests_v2::rate_space(), [](const hpoea::tests_v2::BowlRun &run) {
+                run.result.algorithm_usage.generations = 1;
+                return run.problem.evaluate({std::get<double>(run.parameters.at("rate"))});
+            }};
+}
+
+// instances at levels 1 and 5, scaled by 1 and 4, with the values of
+// rates 0, 0.5 and 1 as mean_rank references
+std::shared_ptr<const hpoea::core::ProblemSet> make_set(hpoea::core::ProblemSetAggregation aggregation,
+                                                        std::size_t parallel_instances = 1) {
+    std::vector<hpoea::core::ProblemSetInstance> instances;
+    instances.push_back({std::make_shared<LevelProblem>("low", 1.0), 0.0, 1.0, {2.0, 1.0, 1.25}});
+    instances.push_back({std::make_shared<LevelProblem>("high", 5.0), 1.0, 4.0, {5.0, 5.25, 6.0}});
+    return std::make_shared<hpoea::core::ProblemSet>("levels", std::move(instances), aggregation,
+                                                     parallel_instances);
+}
+
+hpoea::core::OptimizationResult run_at(const hpoea::core::IEvolutionaryAlgorithmFactory &factory, double rate,
+                                       unsigned long seed = 7UL) {
+    auto algorithm = factory.create();
+    hpoea::core::ParameterSet parameters;
+    parameters.emplace("rate", rate);
+    algorithm->configure(parameters);
+    hpoea::core::Budget budget;
+    budget.function_evaluations = 10u;
+    hpoea::tests_v2::DummyProblem ignored(1);
+    return algorithm->run(ignored, budget, seed);
+}
+
+bool near(double lhs, double rhs) { return std::abs(lhs - rhs) < 1e-12; }
+
+void test_aggregation(hpoea::tests_v2::TestRunner &runner) {
+    auto base = make_factory();
+
+    hpoea::core::ProblemSetFactory normalized(base, make_set(hpoea::core::ProblemSetAggregation::MeanNormalized));
+    HPOEA_V2_CHECK(runner, normalized.identity().family == "BowlFactory" &&
+                               normalized.parameter_space().contains("rate"),
+                   "the factory keeps the base identity and space");
+    const auto result = run_at(normalized, 0.5);
+    HPOEA_V2_REQUIRE(runner, result.status == hpoea::core::RunStatus::Success && result.instance_results.size() == 2u,
+                     "a problem-set run returns one result per instance");
+    HPOEA_V2_CHECK(runner, near(result.instance_results[0].best_fitness, 1.25) &&
+                               near(result.instance_results[1].best_fitness, 5.25),
+                   "instance results are in instance order");
+    HPOEA_V2_CHECK(runner, near(result.best_fitness, (1.25 + 4.25 / 4.0) / 2.0),
+                   "mean_normalized averages (fitness - offset) / scale");
+    HPOEA_V2_CHECK(runner, result.instance_results[0].seed == hpoea::core::derive_stream_seed(7u, 0) &&
+                               result.instance_results[1].seed == hpoea::core::derive_stream_seed(7u, 1),
+                   "instance seeds derive from the run seed and the instance index");
+    HPOEA_V2_CHECK(runner, result.algorithm_usage.function_evaluations == 2u &&
+                               result.requested_budget.function_evaluations == 20u,
+                   "usage and budget are totals over the instances");
+
+    hpoea::core::ProblemSetFactory worst(base, make_set(hpoea::core::ProblemSetAggregation::WorstCase));
+    HPOEA_V2_CHECK(runner, near(run_at(worst, 0.5).best_fitness, 1.25),
+                   "worst_case takes the largest normalized value");
+
+    hpoea::core::ProblemSetFactory ranked(base, make_set(hpoea::core::ProblemSetAggregation::MeanRank));
+    HPOEA_V2_CHECK(runner, near(run_at(ranked, 0.5).best_fitness, 0.5), "a tie with the middle reference ranks 0.5");
+    HPOEA_V2_CHECK(runner, near(run_at(ranked, 0.1).best_fitness, 0.375), "a better run ranks lower");
+    HPOEA_V2_CHECK(runner, near(run_at(ranked, 0.9).best_fitness, 0.625), "a worse run ranks higher");
+
+    hpoea::core::ProblemSetFactory reversed(base, make_set(hpoea::core::ProblemSetAggregation::MeanRank));
+    const auto worse_first = run_at(reversed, 0.9).best_fitness;
+    const auto better_second = run_at(reversed, 0.1).best_fitness;
+    HPOEA_V2_CHECK(runner, near(worse_first, 0.625) && near(better_second, 0.375),
+                   "ranks do not depend on the runs before");
+}
+
+void test_parallel_instances(hpoea::tests_v2::TestRunner &runner) {
+    auto base = make_factory();
+    hpoea::core::ProblemSetFactory serial(base, make_set(hpoea::core::ProblemSetAggregation::MeanNormalized, 1));
+    hpoea::core::ProblemSetFactory parallel(base, make_set(hpoea::core::ProblemSetAggregation::MeanNormalized, 4));
+
+    const auto lhs = run_at(serial, 0.3, 19UL);
+    const auto rhs = run_at(parallel, 0.3, 19UL);
+    HPOEA_V2_CHECK(runner, lhs.best_fitness == rhs.best_fitness &&
+                               lhs.instance_results[1].seed == rhs.instance_results[1].seed,
+                   "parallel_instances does not change the result");
+
+    const auto copy = parallel.create();
+    hpoea::core::ParameterSet parameters;
+    parameters.emplace("rate", 0.3);
+    copy->configure(parameters);
+    const auto cloned = copy->clone();
+    hpoea::tests_v2::DummyProblem ignored(1);
+    HPOEA_V2_CHECK(runner, cloned->run(ignored, {}, 19UL).best_fitness == lhs.best_fitness,
+                   "a clone keeps the configuration and the instances");
+}
+
+void test_failing_instance(hpoea::tests_v2::TestRunner &runner) {
+    auto base = make_factory();
+    std::vector<hpoea::core::ProblemSetInstance> instances;
+    instances.push_back({std::make_shared<LevelProblem>("low", 1.0), 0.0, 1.0, {}});
+    instances.push_back({std::make_shared<hpoea::tests_v2::ThrowingProblem>(1), 0.0, 1.0, {}});
+    hpoea::core::ProblemSetFactory factory(
+        base, std::make_shared<hpoea::core::ProblemSet>("broken", std::move(instances)));
+
+    const auto result = run_at(factory, 0.5);
+    HPOEA_V2_CHECK(runner, result.status != hpoea::core::RunStatus::Success, "a failing instance fails the run");
+    HPOEA_V2_CHECK(runner, !std::isfinite(result.best_fitness), "a failing instance leaves no aggregate");
+    HPOEA_V2_CHECK(runner, result.message.find("instance 'throwing'") != std::string::npos,
+                   "the message names the failing instance");
+    HPOEA_V2_CHECK(runner, result.instance_results.size() == 2u &&
+                               result.instance_results[0].status == hpoea::core::RunStatus::Success,
+                   "the other instances still report their results");
+}
+
+void test_warm_start(hpoea::tests_v2::TestRunner &runner) {
+    // final population holds the warm start's first value plus one
+    hpoea::tests_v2::BowlFactory base{hpoea::tests_v2::rate_space(),
+                                      [](const hpoea::tests_v2::BowlRun &run) {
+                                          auto population = std::make_shared<hpoea::core::InitialPopulation>();
+                                          population->decision_vectors.push_back(
+                                              {run.warm_start ? run.warm_start->decision_vectors.at(0).at(0) + 1.0
+                                                              : 0.0});
+                                          population->fitness.push_back(0.0);
+                                          run.result.final_population = std::move(population);
+                                          return run.problem.evaluate({std::get<double>(run.parameters.at("rate"))});
+                                      },
+                                      true};
+    hpoea::core::ProblemSetFactory factory(base, make_set(hpoea::core::ProblemSetAggregation::MeanNormalized));
+    auto algorithm = factory.create();
+    hpoea::core::ParameterSet parameters;
+    parameters.emplace("rate", 0.5);
+    algorithm->configure(parameters);
+    hpoea::tests_v2::DummyProblem ignored(1);
+
+    HPOEA_V2_CHECK(runner, algorithm->set_warm_start(nullptr), "a problem set accepts a fresh start");
+    const auto first = algorithm->run(ignored, {}, 7UL);
+    HPOEA_V2_REQUIRE(runner, first.final_population && first.final_population->parts.size() == 2u,
+                     "the final population holds one part per instance");
+    HPOEA_V2_CHECK(runner, algorithm->set_warm_start(first.final_population),
+                   "a problem set accepts its own final population");
+    const auto second = algorithm->run(ignored, {}, 7UL);
+    bool continued = second.final_population && second.final_population->parts.size() == 2u;
+    for (std::size_t i = 0; continued && i < 2u; ++i) {
+        const auto &part = second.final_population->parts[i];
+        continued = part && part->decision_vectors.at(0).at(0) == 1.0;
+    }
+    HPOEA_V2_CHECK(runner, continued, "every instance continues from its own part");
+
+    auto plain = std::make_shared<hpoea::core::InitialPopulation>();
+    plain->decision_vectors.push_back({0.0});
+    plain->fitness.push_back(0.0);
+    HPOEA_V2_CHECK(runner, !algorithm->set_warm_start(plain), "a population without one part per instance is refused");
+}
+
+void test_validation(hpoea::tests_v2::TestRunner &runner) {
+    const auto rejects = [](std::vector<hpoea::core::ProblemSetInstance> instances) {
+        try {
+            hpoea::core::ProblemSet set("bad", std::move(instances));
+        } catch (const std::invalid_argument &) {
+            return true;
+        }
+        return false;
+    };
+    const auto problem = std::make_shared<LevelProblem>("low", 1.0);
+
+    HPOEA_V2_CHECK(runner, rejects({}), "an empty set is rejected");
+    HPOEA_V2_CHECK(runner, rejects({{nullptr, 0.0, 1.0, {}}}), "a null instance is rejected");
+    HPOEA_V2_CHECK(runner, rejects({{problem, 0.0, 0.0, {}}}), "a zero scale is rejected");
+    HPOEA_V2_CHECK(runner, rejects({{problem, std::nan(""), 1.0, {}}}), "a non-finite offset is rejected");
+    HPOEA_V2_CHECK(runner, !rejects({{problem, -3.0, 2.0, {}}}), "a finite offset and positive scale are accepted");
+
+    const auto ranked_rejects = [](std::vector<double> reference) {
+        try {
+            std::vector<hpoea::core::ProblemSetInstance> instances;
+            instances.push_back({std::make_shared<LevelProblem>("low", 1.0), 0.0, 1.0, std::move(reference)});
+            hpoea::core::ProblemSet set("ranked", std::move(instances), hpoea::core::ProblemSetAggregation::MeanRank);
+        } catch (const std::invalid_argument &) {
+            return true;
+        }
+        return false;
+    };
+    HPOEA_V2_CHECK(runner, ranked_rejects({}) && ranked_rejects({1.0, std::nan("")}),
+                   "mean_rank needs finite reference values");
+    HPOEA_V2_CHECK(runner, !ranked_rejects({1.0}), "one reference value is enough");
+
+    HPOEA_V2_CHECK(runner, hpoea::core::parse_problem_set_aggregation("worst_case") ==
+                               hpoea::core::ProblemSetAggregation::WorstCase,
+                   "aggregations parse by name");
+    HPOEA_V2_CHECK(runner, !hpoea::core::parse_problem_set_aggregation("median").has_value(),
+                   "unknown aggregations do not parse");
+}
+
+void test_experiment_records(hpoea::tests_v2::TestRunner &runner) {
+    auto base = make_factory();
+    const auto set = make_set(hpoea::core::ProblemSetAggregation::MeanNormalized, 2);
+    hpoea::core::RandomSearchOptimizer optimizer;
+    hpoea::tests_v2::CapturingLogger logger;
+
+    hpoea::core::ExperimentConfig config;
+    config.experiment_id = "problem_set";
+    config.trials_per_optimizer = 1;
+    config.optimizer_budget.function_evaluations = 3u;
+    config.algorithm_budget.function_evaluations = 10u;
+    config.problem_set = set;
+    config.random_seed = 5UL;
+
+    hpoea::core::SequentialExperimentManager manager;
+    const auto experiment =
+        manager.run_experiment(config, optimizer, base, *set->instances().front().problem, logger);
+    HPOEA_V2_REQUIRE(runner, experiment.optimizer_results.size() == 1u &&
+                                 experiment.optimizer_results[0].trials.size() == 3u,
+                     "the optimizer runs three problem-set trials");
+    HPOEA_V2_CHECK(runner, logger.records.size() == 6u, "every instance run is its own record");
+
+    std::set<std::string> problems;
+    bool tagged = true;
+    bool aggregated = true;
+    for (std::size_t i = 0; i < logger.records.size(); ++i) {
+        const auto &record = logger.records[i];
+        problems.insert(record.problem_id);
+        tagged = tagged && record.problem_set_id == std::optional<std::string>{"levels"};
+        const auto &trial = experiment.optimizer_results[0].trials[i / 2];
+        aggregated = aggregated && record.aggregated_objective.has_value() &&
+                     *record.aggregated_objective == trial.optimization_result.best_fitness;
+    }
+    HPOEA_V2_CHECK(runner, (problems == std::set<std::string>{"low", "high"}), "records carry the instance id");
+    HPOEA_V2_CHECK(runner, tagged, "records carry the problem set id");
+    HPOEA_V2_CHECK(runner, aggregated, "records carry the trial's aggregated objective");
+}
+
+} // namespace
+
+int main() {
+    hpoea::tests_v2::TestRunner runner;
+    test_aggregation(runner);
+    test_parallel_instances(runner);
+    test_failing_instance(runner);
+    test_warm_start(runner);
+    test_validation(runner);
+    test_experiment_records(runner);
+    return runner.summarize("problem_set_tests");
+}
@@ -0,0 +1,231 @@
+#include "test_harness.hpp"
+#include "test_fixtures.hpp"
+#include "test_utils.hpp"
+
+#include "hpoea/core/problem_set.hpp"
+#include "hpoea/core/pruning.hpp"
+#include "hpoea/core/random_search_optimizer.hpp"
+#include "hpoea/core/seed_repeats.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+hpoea::core::ProgressReport at(std::size_t fevals, double best) {
+    hpoea::core::ProgressReport report;
+    report.function_evaluations = fevals;
+    report.best_fitness = best;
+    return report;
+}
+
+void test_median_rule(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::core::PruningPolicy policy;
+    policy.rule = hpoea::core::PruningRule::Median;
+    policy.interval = 10;
+    policy.startup_trials = 3;
+    policy.warmup_checkpoints = 1;
+    hpoea::core::TrialPruner pruner(policy);
+
+    for (const double value : {4.0, 2.0, 6.0}) {
+        auto monitor = pruner.monitor();
+        HPOEA_V2_CHECK(runner, monitor(at(10, value + 1.0)) && monitor(at(20, value)),
+                       "startup trials are never pruned");
+    }
+    HPOEA_V2_CHECK(runner, pruner.recorded(1).size() == 3u, "each checkpoint keeps one value per trial");
+
+    auto early = pruner.monitor();
+    HPOEA_V2_CHECK(runner, early(at(10, 100.0)), "warmup checkpoints never prune");
+
+    auto good = pruner.monitor();
+    HPOEA_V2_CHECK(runner, good(at(5, 50.0)), "a report before the first checkpoint records nothing");
+    HPOEA_V2_CHECK(runner, good(at(25, 3.0)), "a run at or below the median goes on");
+
+    auto bad = pruner.monitor();
+    HPOEA_V2_CHECK(runner, !bad(at(20, 4.5)), "a run above the median at a checkpoint is pruned");
+    HPOEA_V2_CHECK(runner, pruner.pruned_count() == 1u, "pruned runs are counted");
+
+    auto failed = pruner.monitor();
+    HPOEA_V2_CHECK(runner, !failed(at(40, std::numeric_limits<double>::infinity())),
+                   "a run with no finite best is pruned");
+}
+
+void test_percentile_and_patience(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::core::PruningPolicy policy;
+    policy.rule = hpoea::core::PruningRule::Percentile;
+    policy.interval = 1;
+    policy.percentile = 25.0;
+    policy.startup_trials = 4;
+    policy.warmup_checkpoints = 0;
+    hpoea::core::TrialPruner strict(policy);
+    for (const double value : {1.0, 2.0, 3.0, 4.0}) {
+        (void)strict.monitor()(at(1, value));
+    }
+    HPOEA_V2_CHECK(runner, strict.monitor()(at(1, 1.75)), "a run at the 25th percentile goes on");
+    HPOEA_V2_CHECK(runner, !strict.monitor()(at(1, 2.5)), "a run above the 25th percentile is pruned");
+
+    policy = {};
+    policy.rule = hpoea::core::PruningRule::Patience;
+    policy.interval = 10;
+    policy.patience = 2;
+    policy.min_delta = 0.1;
+    policy.warmup_checkpoints = 0;
+    hpoea::core::TrialPruner patient(policy);
+    auto monitor = patient.monitor();
+    HPOEA_V2_CHECK(runner, monitor(at(10, 5.0)) && monitor(at(20, 4.0)), "improving runs go on");
+    HPOEA_V2_CHECK(runner, monitor(at(30, 3.95)), "one stale checkpoint is within patience");
+    HPOEA_V2_CHECK(runner, !monitor(at(40, 3.95)), "patience runs out after two stale checkpoints");
+    HPOEA_V2_CHECK(runner, patient.monitor()(at(40, 9.0)),
+                   "patience ignores the other trials");
+
+    bool rejected = false;
+    try {
+        policy.interval = 0;
+        hpoea::core::TrialPruner invalid(policy);
+    } catch (const std::invalid_argument &) {
+        rejected = true;
+    }
+    HPOEA_V2_CHECK(runner, rejected, "a zero interval is rejected");
+}
+
+hpoea::core::ParameterSpace make_quality_space() {
+    return hpoea::tests_v2::make_space({hpoea::tests_v2::continuous_descriptor("quality", 0.0, 1.0, 0.5)});
+}
+
+// ten generations of ten evaluations each; best after generation g is
+// quality + 1 / (g + 1), so the ranking is visible from the first report
+hpoea::tests_v2::BowlFactory make_factory() {
+    return {make_quality_space(), [](const hpoea::tests_v2::BowlRun &run) {
+                const auto quality = std::get<double>(run.parameters.at("quality"));
+                auto &result = run.result;
+                for (std::size_t generation = 0; generation < 10u; ++generation) {
+                    result.best_fitness = quality + 1.0 / static_cast<double>(generation + 1);
+                    result.algorithm_usage.function_evaluations = 10u * (generation + 1);
+                    result.algorithm_usage.generations = generation;
+                    hpoea::core::ProgressReport report;
+                    report.function_evaluations = result.algorithm_usage.function_evaluations;
+                    report.generations = generation;
+                    report.best_fitness = result.best_fitness;
+                    if (run.progress && !run.progress(report)) {
+                        result.status = hpoea::core::RunStatus::Pruned;
+                        break;
+                    }
+                }
+                return result.best_fitness;
+            }};
+}
+
+void test_random_search_pruning(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(2);
+    auto factory = make_factory();
+    hpoea::core::ParameterSet params;
+    params.emplace("sample_count", std::int64_t{30});
+
+    hpoea::core::RandomSearchOptimizer plain;
+    plain.configure(params);
+    const auto unpruned = plain.optimize(factory, problem, {}, {}, 12UL);
+
+    hpoea::core::PruningPolicy policy;
+    policy.rule = hpoea::core::PruningRule::Median;
+    policy.interval = 20;
+    policy.startup_trials = 4;
+    hpoea::core::RandomSearchOptimizer optimizer;
+    optimizer.configure(params);
+    optimizer.set_pruning_policy(policy);
+    auto copy = optimizer.clone();
+    const auto result = optimizer.optimize(factory, problem, {}, {}, 12UL);
+
+    HPOEA_V2_CHECK(runner, result.status == hpoea::core::RunStatus::Success, "pruned random search succeeds");
+    std::size_t pruned = 0;
+    std::size_t pruned_fevals = 0;
+    for (const auto &trial : result.trials) {
+        if (trial.optimization_result.status == hpoea::core::RunStatus::Pruned) {
+            ++pruned;
+            pruned_fevals += trial.optimization_result.algorithm_usage.function_evaluations;
+        }
+    }
+    HPOEA_V2_CHECK(runner, pruned > 5u, "runs worse than the median are pruned");
+    HPOEA_V2_CHECK(runner, pruned_fevals < pruned * 100u, "pruned runs stop before their budget");
+    HPOEA_V2_CHECK(runner, result.best_objective == unpruned.best_objective &&
+                               hpoea::tests_v2::parameter_set_equals(result.best_parameters, unpruned.best_parameters),
+                   "pruning keeps the best configuration");
+    const auto copied = copy->optimize(factory, problem, {}, {}, 12UL);
+    std::size_t copied_pruned = 0;
+    for (const auto &trial : copied.trials) {
+        copied_pruned += trial.optimization_result.status == hpoea::core::RunStatus::Pruned ? 1u : 0u;
+    }
+    HPOEA_V2_CHECK(runner, copied.trials.size() == 30u && copied_pruned == pruned,
+                   "clones keep the pruning policy and pruned trials are still recorded");
+
+    bool rejected = false;
+    try {
+        policy.percentile = 120.0;
+        policy.rule = hpoea::core::PruningRule::Percentile;
+        optimizer.set_pruning_policy(policy);
+    } catch (const std::invalid_argument &) {
+        rejected = true;
+    }
+    HPOEA_V2_CHECK(runner, rejected, "an invalid policy is rejected when set");
+}
+
+void test_wrapper_pruning(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(2);
+    auto base = make_factory();
+    std::vector<hpoea::core::ProblemSetInstance> instances;
+    instances.push_back({std::make_shared<hpoea::tests_v2::DummyProblem>(2), 0.0, 1.0, {}});
+    instances.push_back({std::make_shared<hpoea::tests_v2::DummyProblem>(3), 0.0, 1.0, {}});
+    hpoea::core::ProblemSetFactory problem_set(base, std::make_shared<hpoea::core::ProblemSet>("pair", std::move(instances)));
+    hpoea::core::SeedRepeatFactory repeats(base, hpoea::core::SeedRepeatPolicy{2, 2, 0.1, 0.0, 1});
+
+    hpoea::core::PruningPolicy policy;
+    policy.rule = hpoea::core::PruningRule::Median;
+    policy.interval = 20;
+    policy.startup_trials = 4;
+
+    // every inner run reports as its own stream
+    hpoea::core::TrialPruner pruner(policy);
+    auto algorithm = problem_set.create();
+    hpoea::core::ParameterSet parameters;
+    parameters.emplace("quality", 0.5);
+    algorithm->configure(parameters);
+    algorithm->set_progress_callback(pruner.monitor());
+    (void)algorithm->run(problem, {}, 3UL);
+    HPOEA_V2_CHECK(runner, pruner.recorded(0, 0).size() == 1u && pruner.recorded(0, 1).size() == 1u,
+                   "problem set instances report as separate streams");
+
+    hpoea::core::ParameterSet params;
+    params.emplace("sample_count", std::int64_t{30});
+    const auto count_pruned = [&](const hpoea::core::IEvolutionaryAlgorithmFactory &factory) {
+        hpoea::core::RandomSearchOptimizer optimizer;
+        optimizer.configure(params);
+        optimizer.set_pruning_policy(policy);
+        const auto result = optimizer.optimize(factory, problem, {}, {}, 12UL);
+        std::size_t pruned = 0;
+        for (const auto &trial : result.trials) {
+            if (trial.optimization_result.status == hpoea::core::RunStatus::Pruned) {
+                ++pruned;
+                if (trial.optimization_result.algorithm_usage.function_evaluations >= 200u) {
+                    return std::size_t{0};
+                }
+            }
+        }
+        return result.status == hpoea::core::RunStatus::Success ? pruned : std::size_t{0};
+    };
+    HPOEA_V2_CHECK(runner, count_pruned(problem_set) > 5u, "pruning stops runs over a problem set early");
+    HPOEA_V2_CHECK(runner, count_pruned(repeats) > 5u, "pruning stops seed-repeated runs early");
+}
+
+} // namespace
+
+int main() {
+    hpoea::tests_v2::TestRunner runner;
+    test_median_rule(runner);
+    test_percentile_and_patience(runner);
+    test_random_search_pruning(runner);
+    test_wrapper_pruning(runner);
+    return runner.summarize("pruning_tests");
+}
@@ -0,0 +1,183 @@
+#include "test_harness.hpp"
+#include "test_fixtures.hpp"
+#include "test_utils.hpp"
+
+#include "hpoea/core/racing_optimizer.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+// a sphere centered on the origin, counting its evaluations
+class CountingProblem final : public hpoea::core::IProblem {
+public:
+    explicit CountingProblem(std::size_t dim) : dim_(dim) {
+        metadata_.id = "counting_" + std::to_string(dim);
+        metadata_.family = "tests";
+    }
+
+    [[nodiscard]] const hpoea::core::ProblemMetadata &metadata() const noexcept override { return metadata_; }
+    [[nodiscard]] std::size_t dimension() const override { return dim_; }
+    [[nodiscard]] std::vector<double> lower_bounds() const override { return std::vector<double>(dim_, -1.0); }
+    [[nodiscard]] std::vector<double> upper_bounds() const override { return std::vector<double>(dim_, 1.0); }
+
+    [[nodiscard]] double evaluate(const std::vector<double> &decision_vector) const override {
+        evaluations_.fetch_add(1, std::memory_order_relaxed);
+        double sum = 0.0;
+        for (const auto v : decision_vector) {
+            sum += v * v;
+        }
+        return sum;
+    }
+
+    [[nodiscard]] std::size_t evaluations() const noexcept { return evaluations_.load(); }
+
+private:
+    std::size_t dim_;
+    hpoea::core::ProblemMetadata metadata_{};
+    mutable std::atomic<std::size_t> evaluations_{0};
+};
+
+// evaluates the problem at rate - 0.3 in every coordinate, plus a noise
+// term of the seed and the rate
+hpoea::tests_v2::BowlFactory make_factory() {
+    return {hpoea::tests_v2::rate_space(), [](const hpoea::tests_v2::BowlRun &run) {
+                const auto offset = std::get<double>(run.parameters.at("rate")) - 0.3;
+                const auto noise = (run.seed + static_cast<unsigned long>(offset * 1000.0 + 300.0)) % 7u;
+                return run.problem.evaluate(std::vector<double>(run.problem.dimension(), offset)) +
+                       0.02 * static_cast<double>(noise);
+            }};
+}
+
+hpoea::core::ParameterSet racing_parameters(std::int64_t candidates, std::int64_t max_steps, const std::string &test,
+                                            std::int64_t workers) {
+    hpoea::core::ParameterSet params;
+    params.emplace("candidates", candidates);
+    params.emplace("max_steps", max_steps);
+    params.emplace("test", test);
+    params.emplace("parallel_workers", workers);
+    return params;
+}
+
+bool same_trials(const hpoea::core::HyperparameterOptimizationResult &lhs,
+                 const hpoea::core::HyperparameterOptimizationResult &rhs) {
+    if (lhs.trials.size() != rhs.trials.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < lhs.trials.size(); ++i) {
+        if (!hpoea::tests_v2::parameter_set_equals(lhs.trials[i].parameters, rhs.trials[i].parameters) ||
+            lhs.trials[i].optimization_result.seed != rhs.trials[i].optimization_result.seed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_friedman_race(hpoea::tests_v2::TestRunner &runner) {
+    auto first = std::make_shared<CountingProblem>(1);
+    auto second = std::make_shared<CountingProblem>(2);
+    auto third = std::make_shared<CountingProblem>(3);
+    auto factory = make_factory();
+
+    hpoea::core::RacingOptimizer optimizer;
+    HPOEA_V2_CHECK(runner, optimizer.identity().family == "Racing", "identity family is Racing");
+    optimizer.configure(racing_parameters(16, 30, "friedman", 1));
+    optimizer.set_instances({second, third});
+    HPOEA_V2_CHECK(runner, optimizer.instances().size() == 2u, "instances are kept");
+
+    const auto result = optimizer.optimize(factory, *first, {}, {}, 5UL);
+    HPOEA_V2_REQUIRE(runner, result.status == hpoea::core::RunStatus::Success, "friedman race succeeds");
+    HPOEA_V2_CHECK(runner, result.trials.size() < 16u * 30u, "eliminations save trials over a full grid");
+    HPOEA_V2_CHECK(runner, result.trials.size() >= 16u * 5u, "every candidate runs until the first test");
+    HPOEA_V2_CHECK(runner, result.optimizer_usage.objective_calls == result.trials.size(),
+                   "every trial is an objective call");
+    HPOEA_V2_CHECK(runner, first->evaluations() > 0u && second->evaluations() > 0u && third->evaluations() > 0u,
+                   "steps cycle through the instances");
+
+    const auto rate = std::get<double>(result.best_parameters.at("rate"));
+    HPOEA_V2_CHECK(runner, rate > 0.15 && rate < 0.45, "the winner is close to the best rate");
+    HPOEA_V2_CHECK(runner, result.best_objective < 0.4, "best_objective is the winner's mean objective");
+
+    // the first step runs every candidate with one seed
+    bool shared_seed = true;
+    for (std::size_t i = 1; i < 16u; ++i) {
+        shared_seed = shared_seed &&
+                      result.trials[i].optimization_result.seed == result.trials[0].optimization_result.seed;
+    }
+    HPOEA_V2_CHECK(runner, shared_seed, "candidates of one step share the seed");
+
+    hpoea::core::RacingOptimizer repeat;
+    repeat.configure(racing_parameters(16, 30, "friedman", 4));
+    repeat.set_instances({second, third});
+    HPOEA_V2_CHECK(runner, same_trials(result, repeat.optimize(factory, *first, {}, {}, 5UL)),
+                   "worker count does not change the trials");
+}
+
+void test_t_test_race(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(2);
+    auto factory = make_factory();
+
+    hpoea::core::RacingOptimizer optimizer;
+    optimizer.configure(racing_parameters(12, 40, "t_test", 2));
+    const auto result = optimizer.optimize(factory, problem, {}, {}, 9UL);
+    HPOEA_V2_REQUIRE(runner, result.status == hpoea::core::RunStatus::Success, "t-test race succeeds");
+    HPOEA_V2_CHECK(runner, result.trials.size() < 12u * 40u, "paired t-tests drop candidates");
+    const auto rate = std::get<double>(result.best_parameters.at("rate"));
+    HPOEA_V2_CHECK(runner, rate > 0.1 && rate < 0.5, "the t-test winner is close to the best rate");
+}
+
+void test_budgets(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(2);
+    auto factory = make_factory();
+
+    hpoea::core::Budget capped;
+    capped.function_evaluations = 50u;
+    hpoea::core::RacingOptimizer budgeted;
+    budgeted.configure(racing_parameters(32, 0, "friedman", 1));
+    const auto result = budgeted.optimize(factory, problem, capped, {}, 3UL);
+    HPOEA_V2_CHECK(runner, result.status == hpoea::core::RunStatus::Success, "budgeted race succeeds");
+    HPOEA_V2_CHECK(runner, result.trials.size() <= 50u, "the race stays within function_evaluations");
+    HPOEA_V2_CHECK(runner, std::get<std::int64_t>(result.effective_optimizer_parameters.at("candidates")) == 10,
+                   "the budget caps candidates to reach the first test");
+
+    hpoea::core::Budget tiny;
+    tiny.function_evaluations = 1u;
+    const auto zero = budgeted.optimize(factory, problem, tiny, {}, 3UL);
+    HPOEA_V2_CHECK(runner, zero.status == hpoea::core::RunStatus::BudgetExceeded && zero.trials.empty(),
+                   "a budget below one step runs nothing");
+
+    hpoea::core::RacingOptimizer unbounded;
+    unbounded.configure(racing_parameters(8, 0, "friedman", 1));
+    const auto missing = unbounded.optimize(factory, problem, {}, {}, 3UL);
+    HPOEA_V2_CHECK(runner, missing.status == hpoea::core::RunStatus::InvalidConfiguration,
+                   "a race without max_steps or budget is rejected");
+
+    hpoea::core::Budget generations;
+    generations.generations = 4u;
+    const auto rejected = budgeted.optimize(factory, problem, generations, {}, 3UL);
+    HPOEA_V2_CHECK(runner, rejected.status == hpoea::core::RunStatus::InvalidConfiguration,
+                   "a generations budget is rejected");
+
+    hpoea::core::RacingOptimizer null_instances;
+    bool threw = false;
+    try {
+        null_instances.set_instances({nullptr});
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    HPOEA_V2_CHECK(runner, threw, "null instances are rejected");
+}
+
+} // namespace
+
+int main() {
+    hpoea::tests_v2::TestRunner runner;
+    test_friedman_race(runner);
+    test_t_test_race(runner);
+    test_budgets(runner);
+    return runner.summarize("racing_optimizer_tests");
+}
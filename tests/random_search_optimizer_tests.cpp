@@ -3,14 +3,18 @@
 #include "test_utils.hpp"
 
 #include "hpoea/core/random_search_optimizer.hpp"
+#include "hpoea/core/search_space.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -110,7 +114,12 @@ class FakeAlgorithm final : public hpoea::core::IEvolutionaryAlgorithm {
 
     [[nodiscard]] hpoea::core::OptimizationResult run(const hpoea::core::IProblem &problem,
                                                       const hpoea::core::Budget &budget, unsigned long seed) override {
-        observations_->push_back(Observation{configured_, seed});
+        {
+            // parallel random search runs trials concurrently
+            static std::mutex observations_mutex;
+            std::scoped_lock lock(observations_mutex);
+            observations_->push_back(Observation{configured_, seed});
+        }
         if (run_fn_) {
             return run_fn_(configured_, problem, budget, seed);
         }
@@ -454,5 +463,133 @@ int main() {
                        "logged records include random search parameters");
     }
 
+    {
+        // parallel workers produce the serial trials in the serial order
+        auto run_with_workers = [&](std::int64_t workers) {
+            hpoea::core::RandomSearchOptimizer optimizer;
+            hpoea::core::ParameterSet params;
+            params.emplace("sample_count", std::int64_t{40});
+            params.emplace("parallel_workers", workers);
+            optimizer.configure(params);
+            FakeFactory factory([](const hpoea::core::ParameterSet &parameters, const hpoea::core::IProblem &p,
+                                   const hpoea::core::Budget &budget, unsigned long seed) {
+                return seed % 3u == 0u ? failed_result(seed) : successful_result(parameters, p, budget, seed);
+            });
+            return optimizer.optimize(factory, problem, {}, {}, 4242UL);
+        };
+
+        const auto serial = run_with_workers(1);
+        const auto parallel = run_with_workers(4);
+        const auto all_cores = run_with_workers(0);
+        auto same_trials = [](const hpoea::core::HyperparameterOptimizationResult &lhs,
+                              const hpoea::core::HyperparameterOptimizationResult &rhs) {
+            if (!trial_parameters_equal(lhs.trials, rhs.trials)) {
+                return false;
+            }
+            for (std::size_t i = 0; i < lhs.trials.size(); ++i) {
+                const auto &a = lhs.trials[i];
+                const auto &b = rhs.trials[i];
+                if (a.trial_index != i || b.trial_index != i ||
+                    a.optimization_result.seed != b.optimization_result.seed ||
+                    a.optimization_result.status != b.optimization_result.status ||
+                    a.optimization_result.best_fitness != b.optimization_result.best_fitness) {
+                    return false;
+                }
+            }
+            return lhs.best_objective == rhs.best_objective &&
+                   lhs.optimizer_usage.objective_calls == rhs.optimizer_usage.objective_calls;
+        };
+        HPOEA_V2_CHECK(runner, serial.trials.size() == 40u, "serial random search runs every sample");
+        HPOEA_V2_CHECK(runner, same_trials(serial, parallel), "parallel random search matches the serial trials");
+        HPOEA_V2_CHECK(runner, same_trials(serial, all_cores), "parallel_workers 0 matches the serial trials");
+
+        hpoea::core::RandomSearchOptimizer timed;
+        hpoea::core::ParameterSet params;
+        params.emplace("sample_count", std::int64_t{1000});
+        params.emplace("parallel_workers", std::int64_t{4});
+        timed.configure(params);
+        FakeFactory slow_factory([](const hpoea::core::ParameterSet &parameters, const hpoea::core::IProblem &p,
+                                    const hpoea::core::Budget &budget, unsigned long seed) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            return successful_result(parameters, p, budget, seed);
+        });
+        hpoea::core::Budget wall_budget;
+        wall_budget.wall_time = std::chrono::milliseconds(30);
+        const auto timed_result = timed.optimize(slow_factory, problem, wall_budget, {}, 5UL);
+        bool prefix = timed_result.trials.size() < 1000u;
+        for (std::size_t i = 0; i < timed_result.trials.size(); ++i) {
+            prefix = prefix && timed_result.trials[i].trial_index == i;
+        }
+        HPOEA_V2_CHECK(runner, timed_result.status == hpoea::core::RunStatus::BudgetExceeded,
+                       "parallel random search stops dispatching at the wall-time budget");
+        HPOEA_V2_CHECK(runner, prefix, "a wall-time stop keeps a gap-free prefix of trials");
+    }
+
+
+    {
+        // quasi-random designs are fixed by the seed and spread per type
+        const auto run_sampler = [&](const char *sampler, std::int64_t samples, unsigned long seed,
+                                     std::shared_ptr<hpoea::core::SearchSpace> search = nullptr) {
+            hpoea::core::RandomSearchOptimizer optimizer;
+            hpoea::core::ParameterSet params;
+            params.emplace("sample_count", samples);
+            params.emplace("sampler", std::string{sampler});
+            optimizer.configure(params);
+            if (search) {
+                optimizer.set_search_space(std::move(search));
+            }
+            FakeFactory factory;
+            return optimizer.optimize(factory, problem, {}, {}, seed);
+        };
+
+        const auto lhs = run_sampler("lhs", 10, 3UL);
+        std::vector<int> populations(11, 0);
+        std::size_t flags = 0;
+        std::vector<int> categories(3, 0);
+        for (const auto &trial : lhs.trials) {
+            ++populations[static_cast<std::size_t>(std::get<std::int64_t>(trial.parameters.at("population")))];
+            flags += std::get<bool>(trial.parameters.at("flag")) ? 1u : 0u;
+            ++categories[static_cast<std::size_t>(std::get<std::string>(trial.parameters.at("category"))[0] - 'a')];
+        }
+        HPOEA_V2_CHECK(runner, lhs.status == hpoea::core::RunStatus::Success && lhs.trials.size() == 10u,
+                       "lhs random search runs every sample");
+        HPOEA_V2_CHECK(runner, std::count(populations.begin() + 1, populations.end(), 1) == 10,
+                       "lhs puts one sample in every integer value");
+        HPOEA_V2_CHECK(runner, flags == 5u, "lhs splits booleans evenly");
+        HPOEA_V2_CHECK(runner, *std::min_element(categories.begin(), categories.end()) >= 3,
+                       "lhs spreads categorical choices evenly");
+
+        for (const auto *sampler : {"sobol", "halton", "lhs"}) {
+            const auto first = run_sampler(sampler, 12, 8UL);
+            const auto again = run_sampler(sampler, 12, 8UL);
+            const auto other = run_sampler(sampler, 12, 9UL);
+            HPOEA_V2_CHECK(runner, trial_parameters_equal(first.trials, again.trials),
+                           std::string{sampler} + " designs repeat with the seed");
+            HPOEA_V2_CHECK(runner, !trial_parameters_equal(first.trials, other.trials),
+                           std::string{sampler} + " designs change with the seed");
+        }
+
+        auto log_space = std::make_shared<hpoea::core::SearchSpace>();
+        log_space->optimize("rate", hpoea::core::ContinuousRange{0.01, 100.0}, hpoea::core::Transform::log);
+        const auto sobol = run_sampler("sobol", 64, 5UL, log_space);
+        std::size_t below_one = 0;
+        for (const auto &trial : sobol.trials) {
+            below_one += std::get<double>(trial.parameters.at("rate")) < 1.0 ? 1u : 0u;
+        }
+        HPOEA_V2_CHECK(runner, sobol.trials.size() == 64u && below_one == 32u,
+                       "sobol designs are balanced in the log-transformed space");
+
+        hpoea::core::RandomSearchOptimizer unknown;
+        bool rejected = false;
+        try {
+            hpoea::core::ParameterSet params;
+            params.emplace("sampler", std::string{"grid"});
+            unknown.configure(params);
+        } catch (const hpoea::core::ParameterValidationError &) {
+            rejected = true;
+        }
+        HPOEA_V2_CHECK(runner, rejected, "an unknown sampler is rejected");
+    }
+
     return runner.summarize("random_search_optimizer_tests");
 }
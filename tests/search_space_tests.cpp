@@ -1,11 +1,13 @@
 #include "test_harness.hpp"
 
+#include "hpoea/core/parameter_sampling.hpp"
 #include "hpoea/core/parameters.hpp"
 #include "hpoea/core/search_space.hpp"
 
 #include <cmath>
 #include <cstdint>
 #include <functional>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -365,5 +367,34 @@ int main() {
                        "get_optimization_dimension: 1 fixed + 1 excluded = 1 remaining");
     }
 
+    {
+        // an opt-out descriptor stays at its default until the search space names it
+        ParameterSpace params = make_space();
+        ParameterDescriptor init;
+        init.name = "init";
+        init.type = ParameterType::Categorical;
+        init.categorical_choices = {"uniform", "sobol"};
+        init.default_value = std::string{"uniform"};
+        init.tuned_by_default = false;
+        params.add_descriptor(init);
+
+        hpoea::core::SearchSpace defaults;
+        HPOEA_V2_CHECK(runner, defaults.get_optimization_dimension(params) == 4u,
+                       "opt-out: descriptor does not add a dimension");
+        HPOEA_V2_CHECK(runner, defaults.get_effective_bounds(params).back().mode == SearchMode::fixed,
+                       "opt-out: effective mode is fixed");
+        const hpoea::core::UnitCubeEncoding encoding(params, &defaults);
+        HPOEA_V2_CHECK(runner, encoding.dimension() == 4u, "opt-out: encoding leaves it out");
+        std::mt19937_64 rng{3};
+        const auto sampled = hpoea::core::sample_parameters(params, &defaults, rng);
+        HPOEA_V2_CHECK(runner, std::get<std::string>(sampled.at("init")) == "uniform",
+                       "opt-out: sampled sets carry the default");
+
+        hpoea::core::SearchSpace named;
+        named.optimize_choices("init", {std::string{"uniform"}, std::string{"sobol"}});
+        HPOEA_V2_CHECK(runner, named.get_optimization_dimension(params) == 5u,
+                       "opt-out: naming it in the search space tunes it");
+    }
+
     return runner.summarize("search_space_tests");
 }
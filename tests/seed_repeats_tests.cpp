@@ -0,0 +1,181 @@
+#include "test_harness.hpp"
+#include "test_fixtures.hpp"
+#include "test_utils.hpp"
+
+#include "hpoea/core/random_search_optimizer.hpp"
+#include "hpoea/core/seed_repeats.hpp"
+#include "hpoea/core/seeding.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// seed noise in [0, 1)
+double noise(unsigned long seed) { return static_cast<double>(seed % 100u) / 100.0; }
+
+// objective 10 * rate plus seed noise, after one problem evaluation
+hpoea::tests_v2::BowlFactory make_factory() {
+    return {hpoea::tests_v2::rate_space(), [](const hpoea::tests_v2::BowlRun &run) {
+                (void)run.problem.evaluate(std::vector<double>(run.problem.dimension(), 0.0));
+                return 10.0 * std::get<double>(run.parameters.at("rate")) + noise(run.seed);
+            }};
+}
+
+hpoea::core::SeedRepeatPolicy make_policy(std::size_t min_repeats, std::size_t max_repeats,
+                                          std::size_t parallel_repeats = 1) {
+    hpoea::core::SeedRepeatPolicy policy;
+    policy.min_repeats = min_repeats;
+    policy.max_repeats = max_repeats;
+    policy.relative_margin = 0.0;
+    policy.absolute_margin = 1.0;
+    policy.parallel_repeats = parallel_repeats;
+    return policy;
+}
+
+hpoea::core::OptimizationResult run_at(const hpoea::core::IEvolutionaryAlgorithmFactory &factory,
+                                       const hpoea::core::IProblem &problem, double rate,
+                                       unsigned long seed = 7UL) {
+    auto algorithm = factory.create();
+    hpoea::core::ParameterSet parameters;
+    parameters.emplace("rate", rate);
+    algorithm->configure(parameters);
+    hpoea::core::Budget budget;
+    budget.function_evaluations = 10u;
+    return algorithm->run(problem, budget, seed);
+}
+
+void test_fixed_repeats(hpoea::tests_v2::TestRunner &runner) {
+    auto base = make_factory();
+    hpoea::tests_v2::DummyProblem problem(2);
+    hpoea::core::SeedRepeatFactory factory(base, make_policy(3, 3));
+    HPOEA_V2_CHECK(runner, factory.identity().family == "BowlFactory", "the factory keeps the base identity");
+
+    const auto result = run_at(factory, problem, 0.2);
+    HPOEA_V2_REQUIRE(runner, result.status == hpoea::core::RunStatus::Success && result.repeat_results.size() == 3u,
+                     "a repeated run returns one result per repeat");
+    bool seeded = true;
+    double sum = 0.0;
+    for (std::size_t r = 0; r < 3u; ++r) {
+        const auto expected = static_cast<unsigned long>(hpoea::core::derive_stream_seed(7u, r));
+        seeded = seeded && result.repeat_results[r].seed == expected;
+        sum += 2.0 + noise(expected);
+    }
+    HPOEA_V2_CHECK(runner, seeded, "repeat seeds derive from the run seed and the repeat index");
+    HPOEA_V2_CHECK(runner, std::abs(result.best_fitness - sum / 3.0) < 1e-12, "the objective is the repeat mean");
+    HPOEA_V2_CHECK(runner, result.algorithm_usage.function_evaluations == 3u &&
+                               result.requested_budget.function_evaluations == 30u,
+                   "usage and budget are totals over the repeats");
+
+    hpoea::core::SeedRepeatFactory parallel(base, make_policy(3, 3, 4));
+    const auto again = run_at(parallel, problem, 0.2);
+    HPOEA_V2_CHECK(runner, again.best_fitness == result.best_fitness &&
+                               again.repeat_results[2].seed == result.repeat_results[2].seed,
+                   "parallel_repeats does not change the result");
+}
+
+void test_adaptive_repeats(hpoea::tests_v2::TestRunner &runner) {
+    auto base = make_factory();
+    hpoea::tests_v2::DummyProblem problem(2);
+    hpoea::core::SeedRepeatFactory factory(base, make_policy(1, 4));
+
+    const auto first = run_at(factory, problem, 0.1, 3UL);
+    HPOEA_V2_CHECK(runner, first.repeat_results.size() == 4u, "without an incumbent a run takes every repeat");
+
+    const auto bad = run_at(factory, problem, 0.9, 5UL);
+    HPOEA_V2_CHECK(runner, bad.repeat_results.size() == 1u, "a run far behind the incumbent stops after one repeat");
+    HPOEA_V2_CHECK(runner, bad.status == hpoea::core::RunStatus::Success && std::isfinite(bad.best_fitness) &&
+                               bad.best_fitness > first.best_fitness,
+                   "a stopped run keeps its partial mean");
+    HPOEA_V2_CHECK(runner, bad.message.find("behind the incumbent") != std::string::npos,
+                   "the message says why the run stopped");
+    HPOEA_V2_CHECK(runner, bad.requested_budget.function_evaluations == 10u,
+                   "the budget counts the repeats made");
+
+    const auto close = run_at(factory, problem, 0.12, 9UL);
+    HPOEA_V2_CHECK(runner, close.repeat_results.size() == 4u, "a run near the incumbent takes every repeat");
+
+    hpoea::core::SeedRepeatFactory fresh(base, make_policy(1, 4));
+    HPOEA_V2_CHECK(runner, run_at(fresh, problem, 0.9, 5UL).repeat_results.size() == 4u,
+                   "every factory starts without an incumbent");
+}
+
+void test_failing_repeat(hpoea::tests_v2::TestRunner &runner) {
+    auto base = make_factory();
+    hpoea::tests_v2::ThrowingProblem problem(2);
+    hpoea::core::SeedRepeatFactory factory(base, make_policy(2, 4));
+
+    const auto result = run_at(factory, problem, 0.5);
+    HPOEA_V2_CHECK(runner, result.status != hpoea::core::RunStatus::Success && !std::isfinite(result.best_fitness),
+                   "a failing repeat fails the run");
+    HPOEA_V2_CHECK(runner, result.message.rfind("repeat 0: ", 0) == 0, "the message names the failing repeat");
+    HPOEA_V2_CHECK(runner, result.repeat_results.size() == 2u, "no repeats start after a failure");
+
+    const auto rejects = [&](hpoea::core::SeedRepeatPolicy policy) {
+        try {
+            hpoea::core::SeedRepeatFactory rejected(base, policy);
+        } catch (const std::invalid_argument &) {
+            return true;
+        }
+        return false;
+    };
+    HPOEA_V2_CHECK(runner, rejects(make_policy(0, 2)), "min_repeats 0 is rejected");
+    HPOEA_V2_CHECK(runner, rejects(make_policy(3, 2)), "max_repeats below min_repeats is rejected");
+    auto negative = make_policy(1, 2);
+    negative.relative_margin = -0.5;
+    HPOEA_V2_CHECK(runner, rejects(negative), "a negative margin is rejected");
+}
+
+void test_experiment_records(hpoea::tests_v2::TestRunner &runner) {
+    auto base = make_factory();
+    hpoea::tests_v2::DummyProblem problem(2);
+    hpoea::core::RandomSearchOptimizer optimizer;
+    hpoea::tests_v2::CapturingLogger logger;
+
+    hpoea::core::ExperimentConfig config;
+    config.experiment_id = "seed_repeats";
+    config.optimizer_budget.function_evaluations = 3u;
+    config.algorithm_budget.function_evaluations = 10u;
+    config.validation_repeats = 1;
+    config.seed_repeats = make_policy(2, 2);
+    config.random_seed = 5UL;
+
+    hpoea::core::SequentialExperimentManager manager;
+    const auto experiment = manager.run_experiment(config, optimizer, base, problem, logger);
+    HPOEA_V2_REQUIRE(runner, experiment.optimizer_results.size() == 1u &&
+                                 experiment.optimizer_results[0].trials.size() == 3u,
+                     "the optimizer runs three repeated trials");
+    HPOEA_V2_REQUIRE(runner, logger.records.size() == 7u, "every repeat is its own record, plus one validation run");
+
+    bool indexed = true;
+    bool aggregated = true;
+    for (std::size_t i = 0; i < 6u; ++i) {
+        const auto &record = logger.records[i];
+        const auto &trial = experiment.optimizer_results[0].trials[i / 2];
+        indexed = indexed && record.repeat_index == std::optional<std::size_t>{i % 2} &&
+                  record.algorithm_seed == trial.optimization_result.repeat_results[i % 2].seed;
+        aggregated = aggregated && record.aggregated_objective == trial.optimization_result.best_fitness;
+    }
+    HPOEA_V2_CHECK(runner, indexed, "tuning records carry the repeat index and seed");
+    HPOEA_V2_CHECK(runner, aggregated, "tuning records carry the repeat mean");
+
+    const auto &validation = logger.records.back();
+    HPOEA_V2_CHECK(runner, validation.phase == hpoea::core::RunPhase::Validation &&
+                               !validation.repeat_index.has_value() && !validation.aggregated_objective.has_value(),
+                   "validation runs are single runs");
+}
+
+} // namespace
+
+int main() {
+    hpoea::tests_v2::TestRunner runner;
+    test_fixed_repeats(runner);
+    test_adaptive_repeats(runner);
+    test_failing_repeat(runner);
+    test_experiment_records(runner);
+    return runner.summarize("seed_repeats_tests");
+}
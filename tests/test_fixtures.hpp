@@ -1,11 +1,13 @@
 #pragma once
 
+#include "hpoea/core/evolution_algorithm.hpp"
 #include "hpoea/core/experiment.hpp"
 #include "hpoea/core/hyperparameter_optimizer.hpp"
 #include "hpoea/core/logging.hpp"
 #include "hpoea/core/problem.hpp"
 #include "hpoea/core/types.hpp"
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -147,4 +149,139 @@ private:
     core::AlgorithmIdentity identity_{};
 };
 
+inline core::ParameterDescriptor continuous_descriptor(std::string name, double lower, double upper, double fallback) {
+    core::ParameterDescriptor d;
+    d.name = std::move(name);
+    d.type = core::ParameterType::Continuous;
+    d.continuous_range = core::ContinuousRange{lower, upper};
+    d.default_value = fallback;
+    return d;
+}
+
+inline core::ParameterDescriptor integer_descriptor(std::string name, std::int64_t lower, std::int64_t upper,
+                                                    std::int64_t fallback) {
+    core::ParameterDescriptor d;
+    d.name = std::move(name);
+    d.type = core::ParameterType::Integer;
+    d.integer_range = core::IntegerRange{lower, upper};
+    d.default_value = fallback;
+    return d;
+}
+
+inline core::ParameterDescriptor categorical_descriptor(std::string name, std::vector<std::string> choices,
+                                                        std::string fallback) {
+    core::ParameterDescriptor d;
+    d.name = std::move(name);
+    d.type = core::ParameterType::Categorical;
+    d.categorical_choices = std::move(choices);
+    d.default_value = std::move(fallback);
+    return d;
+}
+
+inline core::ParameterDescriptor boolean_descriptor(std::string name, bool fallback) {
+    core::ParameterDescriptor d;
+    d.name = std::move(name);
+    d.type = core::ParameterType::Boolean;
+    d.default_value = fallback;
+    return d;
+}
+
+inline core::ParameterSpace make_space(const std::vector<core::ParameterDescriptor> &descriptors) {
+    core::ParameterSpace space;
+    for (const auto &descriptor : descriptors) {
+        space.add_descriptor(descriptor);
+    }
+    return space;
+}
+
+// the single parameter rate in [0, 1], default 0.5
+inline core::ParameterSpace rate_space() { return make_space({continuous_descriptor("rate", 0.0, 1.0, 0.5)}); }
+
+// one run of a BowlAlgorithm. result starts as a successful run of one
+// evaluation carrying the configured parameters; the objective may adjust
+// it (usage, status, final population) and returns the best fitness.
+struct BowlRun {
+    const core::ParameterSet &parameters;
+    const core::IProblem &problem;
+    const core::Budget &budget;
+    unsigned long seed;
+    const std::shared_ptr<const core::InitialPopulation> &warm_start;
+    const core::ProgressCallback &progress;
+    core::OptimizationResult &result;
+};
+
+using BowlObjective = std::function<double(const BowlRun &)>;
+
+// scripted inner algorithm: scores its configured parameters with an
+// objective instead of searching. accepts warm starts only when asked to.
+class BowlAlgorithm final : public core::IEvolutionaryAlgorithm {
+public:
+    BowlAlgorithm(core::ParameterSpace space, BowlObjective objective, bool warm_starts)
+        : space_(std::move(space)), objective_(std::move(objective)), warm_starts_(warm_starts) {}
+
+    [[nodiscard]] const core::AlgorithmIdentity &identity() const noexcept override { return identity_; }
+
+    [[nodiscard]] const core::ParameterSpace &parameter_space() const noexcept override { return space_; }
+
+    void configure(const core::ParameterSet &parameters) override {
+        configured_ = space_.apply_defaults(parameters);
+        space_.validate(configured_);
+    }
+
+    bool set_warm_start(std::shared_ptr<const core::InitialPopulation> start) override {
+        if (!warm_starts_) {
+            return false;
+        }
+        start_ = std::move(start);
+        return true;
+    }
+
+    void set_progress_callback(core::ProgressCallback callback) override { progress_ = std::move(callback); }
+
+    [[nodiscard]] core::OptimizationResult run(const core::IProblem &problem, const core::Budget &budget,
+                                               unsigned long seed) override {
+        core::OptimizationResult result;
+        result.status = core::RunStatus::Success;
+        result.seed = seed;
+        result.requested_budget = budget;
+        result.algorithm_usage.function_evaluations = 1;
+        result.effective_parameters = configured_;
+        result.best_fitness = objective_(BowlRun{configured_, problem, budget, seed, start_, progress_, result});
+        return result;
+    }
+
+    [[nodiscard]] core::EvolutionaryAlgorithmPtr clone() const override {
+        return std::make_unique<BowlAlgorithm>(*this);
+    }
+
+private:
+    core::AlgorithmIdentity identity_{"BowlAlgorithm", "tests", "1.0"};
+    core::ParameterSpace space_;
+    BowlObjective objective_;
+    bool warm_starts_{false};
+    core::ParameterSet configured_;
+    std::shared_ptr<const core::InitialPopulation> start_;
+    core::ProgressCallback progress_;
+};
+
+class BowlFactory final : public core::IEvolutionaryAlgorithmFactory {
+public:
+    BowlFactory(core::ParameterSpace space, BowlObjective objective, bool warm_starts = false)
+        : space_(std::move(space)), objective_(std::move(objective)), warm_starts_(warm_starts) {}
+
+    [[nodiscard]] core::EvolutionaryAlgorithmPtr create() const override {
+        return std::make_unique<BowlAlgorithm>(space_, objective_, warm_starts_);
+    }
+
+    [[nodiscard]] const core::ParameterSpace &parameter_space() const noexcept override { return space_; }
+
+    [[nodiscard]] const core::AlgorithmIdentity &identity() const noexcept override { return identity_; }
+
+private:
+    core::ParameterSpace space_;
+    BowlObjective objective_;
+    bool warm_starts_{false};
+    core::AlgorithmIdentity identity_{"BowlFactory", "tests", "1.0"};
+};
+
 }
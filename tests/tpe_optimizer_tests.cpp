@@ -0,0 +1,160 @@
+#include "test_harness.hpp"
+#include "test_fixtures.hpp"
+#include "test_utils.hpp"
+
+#include "hpoea/core/parameter_sampling.hpp"
+#include "hpoea/core/tpe_optimizer.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+hpoea::core::ParameterSpace make_algorithm_space() {
+    using namespace hpoea::tests_v2;
+    return make_space({continuous_descriptor("rate", 1e-3, 10.0, 1.0), integer_descriptor("width", 1, 8, 1),
+                       categorical_descriptor("mode", {"a", "b", "c", "d", "e"}, "a"),
+                       boolean_descriptor("elitism", false)});
+}
+
+// minimum 0 at rate 0.1, width 6, mode d, elitism on
+hpoea::tests_v2::BowlFactory make_factory() {
+    return {make_algorithm_space(), [](const hpoea::tests_v2::BowlRun &run) {
+                const auto rate = std::log10(std::get<double>(run.parameters.at("rate"))) + 1.0;
+                const auto width = static_cast<double>(std::get<std::int64_t>(run.parameters.at("width")) - 6);
+                const auto mode = std::get<std::string>(run.parameters.at("mode")) == "d" ? 0.0 : 1.0;
+                const auto elitism = std::get<bool>(run.parameters.at("elitism")) ? 0.0 : 0.5;
+                return rate * rate + 0.05 * width * width + mode + elitism;
+            }};
+}
+
+std::shared_ptr<hpoea::core::SearchSpace> log_rate_search() {
+    auto search = std::make_shared<hpoea::core::SearchSpace>();
+    search->optimize("rate", hpoea::core::ContinuousRange{1e-3, 10.0}, hpoea::core::Transform::log);
+    return search;
+}
+
+void test_choice_coordinates(hpoea::tests_v2::TestRunner &runner) {
+    const auto space = make_algorithm_space();
+    const hpoea::core::UnitCubeEncoding encoding(space, nullptr);
+    HPOEA_V2_REQUIRE(runner, encoding.dimension() == 4u, "every parameter takes a coordinate");
+    HPOEA_V2_CHECK(runner, encoding.choices(0) == 0u && encoding.choices(1) == 0u,
+                   "continuous and integer ranges are ordered");
+    HPOEA_V2_CHECK(runner, encoding.choices(2) == 5u && encoding.choices(3) == 2u,
+                   "categorical and boolean parameters are unordered choices");
+
+    bool centers_decode = true;
+    const char *modes[] = {"a", "b", "c", "d", "e"};
+    for (std::size_t k = 0; k < 5u; ++k) {
+        const auto decoded = encoding.decode({0.5, 0.5, (static_cast<double>(k) + 0.5) / 5.0, 0.75});
+        centers_decode = centers_decode && std::get<std::string>(decoded.at("mode")) == modes[k] &&
+                         std::get<bool>(decoded.at("elitism"));
+    }
+    HPOEA_V2_CHECK(runner, centers_decode, "choice k decodes from its cell center");
+}
+
+hpoea::core::ParameterSet tpe_parameters(std::int64_t samples, std::int64_t batch, std::int64_t workers) {
+    hpoea::core::ParameterSet params;
+    params.emplace("sample_count", samples);
+    params.emplace("batch_size", batch);
+    params.emplace("parallel_workers", workers);
+    return params;
+}
+
+bool same_trials(const hpoea::core::HyperparameterOptimizationResult &lhs,
+                 const hpoea::core::HyperparameterOptimizationResult &rhs) {
+    if (lhs.trials.size() != rhs.trials.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < lhs.trials.size(); ++i) {
+        if (!hpoea::tests_v2::parameter_set_equals(lhs.trials[i].parameters, rhs.trials[i].parameters) ||
+            lhs.trials[i].optimization_result.seed != rhs.trials[i].optimization_result.seed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_optimizer(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(2);
+    auto factory = make_factory();
+
+    hpoea::core::TpeOptimizer optimizer;
+    HPOEA_V2_CHECK(runner, optimizer.identity().family == "TPE", "identity family is TPE");
+    optimizer.configure(tpe_parameters(120, 1, 1));
+    optimizer.set_search_space(log_rate_search());
+    const auto result = optimizer.optimize(factory, problem, {}, {}, 17UL);
+    HPOEA_V2_REQUIRE(runner, result.status == hpoea::core::RunStatus::Success, "tpe succeeds");
+    HPOEA_V2_CHECK(runner, result.trials.size() == 120u, "sample_count sets the trial count");
+    HPOEA_V2_CHECK(runner, result.optimizer_usage.objective_calls == 120u, "every trial is an objective call");
+
+    double startup_best = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < 10u; ++i) {
+        startup_best = std::min(startup_best, result.trials[i].optimization_result.best_fitness);
+    }
+    HPOEA_V2_CHECK(runner, result.best_objective < startup_best, "model proposals improve on the random startup");
+    HPOEA_V2_CHECK(runner, result.best_objective < 0.2, "tpe finds the bowl minimum");
+    HPOEA_V2_CHECK(runner,
+                   std::get<std::string>(result.best_parameters.at("mode")) == "d" &&
+                       std::get<bool>(result.best_parameters.at("elitism")),
+                   "categorical densities settle on the best choices");
+
+    std::size_t late_best_mode = 0;
+    for (std::size_t i = 60; i < result.trials.size(); ++i) {
+        late_best_mode += std::get<std::string>(result.trials[i].parameters.at("mode")) == "d" ? 1u : 0u;
+    }
+    HPOEA_V2_CHECK(runner, late_best_mode > 30u, "late proposals favour the good choice over uniform sampling");
+
+    hpoea::core::TpeOptimizer repeat;
+    repeat.configure(tpe_parameters(120, 1, 4));
+    repeat.set_search_space(log_rate_search());
+    HPOEA_V2_CHECK(runner, same_trials(result, repeat.optimize(factory, problem, {}, {}, 17UL)),
+                   "worker count does not change the trials");
+
+    hpoea::core::TpeOptimizer serial_batch;
+    serial_batch.configure(tpe_parameters(40, 4, 1));
+    hpoea::core::TpeOptimizer parallel_batch;
+    parallel_batch.configure(tpe_parameters(40, 4, 3));
+    const auto serial = serial_batch.optimize(factory, problem, {}, {}, 8UL);
+    const auto parallel = parallel_batch.optimize(factory, problem, {}, {}, 8UL);
+    HPOEA_V2_CHECK(runner, serial.status == hpoea::core::RunStatus::Success && serial.trials.size() == 40u,
+                   "batched proposals fill the sample count");
+    HPOEA_V2_CHECK(runner, same_trials(serial, parallel), "batched trials do not depend on the worker count");
+
+    hpoea::core::Budget capped;
+    capped.function_evaluations = 12u;
+    hpoea::core::TpeOptimizer budgeted;
+    const auto budgeted_result = budgeted.optimize(factory, problem, capped, {}, 3UL);
+    HPOEA_V2_CHECK(runner, budgeted_result.trials.size() == 12u, "function_evaluations budget sets the default count");
+
+    hpoea::core::Budget generations;
+    generations.generations = 3u;
+    const auto rejected = budgeted.optimize(factory, problem, generations, {}, 3UL);
+    HPOEA_V2_CHECK(runner, rejected.status == hpoea::core::RunStatus::InvalidConfiguration,
+                   "generations optimizer budget is rejected");
+
+    auto all_fixed = std::make_shared<hpoea::core::SearchSpace>();
+    all_fixed->fix("rate", 1.0);
+    all_fixed->fix("width", std::int64_t{2});
+    all_fixed->fix("mode", std::string{"a"});
+    all_fixed->fix("elitism", true);
+    hpoea::core::TpeOptimizer fixed;
+    fixed.configure(tpe_parameters(5, 1, 1));
+    fixed.set_search_space(all_fixed);
+    const auto fixed_result = fixed.optimize(factory, problem, {}, {}, 3UL);
+    HPOEA_V2_CHECK(runner, fixed_result.status == hpoea::core::RunStatus::InvalidConfiguration,
+                   "a space with nothing to tune is rejected");
+}
+
+} // namespace
+
+int main() {
+    hpoea::tests_v2::TestRunner runner;
+    test_choice_coordinates(runner);
+    test_optimizer(runner);
+    return runner.summarize("tpe_optimizer_tests");
+}
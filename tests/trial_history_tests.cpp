@@ -0,0 +1,287 @@
+#include "test_harness.hpp"
+#include "test_fixtures.hpp"
+#include "test_utils.hpp"
+
+#include "hpoea/core/bayesian_optimizer.hpp"
+#include "hpoea/core/logging.hpp"
+#include "hpoea/core/random_search_optimizer.hpp"
+#include "hpoea/core/tpe_optimizer.hpp"
+#include "hpoea/core/trial_history.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+
+std::filesystem::path unique_test_path(const std::string &base_name) {
+    return std::filesystem::temp_directory_path() / (base_name + "_" + std::to_string(::getpid()));
+}
+
+hpoea::core::ParameterSpace make_algorithm_space() {
+    using namespace hpoea::tests_v2;
+    return make_space({continuous_descriptor("rate", 0.0, 4.0, 2.0), integer_descriptor("width", 1, 8, 1),
+                       categorical_descriptor("mode", {"a", "b", "c"}, "a"), boolean_descriptor("elitism", false)});
+}
+
+// minimum 0 at rate 3, width 6, mode c, elitism on
+hpoea::tests_v2::BowlFactory make_factory() {
+    return {make_algorithm_space(), [](const hpoea::tests_v2::BowlRun &run) {
+                const auto rate = std::get<double>(run.parameters.at("rate")) - 3.0;
+                const auto width = static_cast<double>(std::get<std::int64_t>(run.parameters.at("width")) - 6);
+                const auto mode = std::get<std::string>(run.parameters.at("mode")) == "c" ? 0.0 : 1.0;
+                const auto elitism = std::get<bool>(run.parameters.at("elitism")) ? 0.0 : 0.5;
+                return rate * rate + 0.05 * width * width + mode + elitism;
+            }};
+}
+
+hpoea::core::ParameterSet bowl_parameters(double rate, std::int64_t width, const std::string &mode, bool elitism) {
+    hpoea::core::ParameterSet params;
+    params.emplace("rate", rate);
+    params.emplace("width", width);
+    params.emplace("mode", mode);
+    params.emplace("elitism", elitism);
+    return params;
+}
+
+hpoea::core::HistoryKey bowl_key(const std::string &problem_id = "dummy") {
+    return {make_factory().identity(), problem_id, hpoea::core::search_space_fingerprint(make_algorithm_space(), nullptr)};
+}
+
+void test_fingerprint(hpoea::tests_v2::TestRunner &runner) {
+    const auto space = make_algorithm_space();
+    const auto plain = hpoea::core::search_space_fingerprint(space, nullptr);
+    const hpoea::core::SearchSpace empty;
+    HPOEA_V2_CHECK(runner, plain == hpoea::core::search_space_fingerprint(space, &empty),
+                   "an empty search space fingerprints like none");
+    HPOEA_V2_CHECK(runner, plain == hpoea::core::search_space_fingerprint(make_algorithm_space(), nullptr),
+                   "fingerprints are stable");
+
+    hpoea::core::SearchSpace narrowed;
+    narrowed.optimize("rate", hpoea::core::ContinuousRange{1.0, 4.0});
+    hpoea::core::SearchSpace logged;
+    logged.optimize("rate", hpoea::core::ContinuousRange{0.0, 4.0});
+    logged.set("rate", {hpoea::core::SearchMode::optimize, std::nullopt, hpoea::core::ContinuousRange{0.5, 4.0},
+                        std::nullopt, {}, hpoea::core::Transform::log});
+    hpoea::core::SearchSpace fixed;
+    fixed.fix("width", std::int64_t{3});
+    hpoea::core::SearchSpace fixed_other;
+    fixed_other.fix("width", std::int64_t{4});
+    const auto narrowed_print = hpoea::core::search_space_fingerprint(space, &narrowed);
+    const auto logged_print = hpoea::core::search_space_fingerprint(space, &logged);
+    const auto fixed_print = hpoea::core::search_space_fingerprint(space, &fixed);
+    HPOEA_V2_CHECK(runner, narrowed_print != plain && logged_print != plain && logged_print != narrowed_print,
+                   "bounds and transforms change the fingerprint");
+    HPOEA_V2_CHECK(runner,
+                   fixed_print != plain && fixed_print != hpoea::core::search_space_fingerprint(space, &fixed_other),
+                   "fixed values change the fingerprint");
+}
+
+void test_store(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::core::TrialHistory history;
+    history.add(bowl_key(), bowl_parameters(1.0, 2, "a", false), 3.0);
+    history.add(bowl_key(), bowl_parameters(2.5, 5, "c", true), 0.5);
+    history.add(bowl_key(), bowl_parameters(0.5, 1, "b", false), std::numeric_limits<double>::quiet_NaN());
+    history.add(bowl_key("other"), bowl_parameters(3.0, 6, "c", true), 0.0);
+    HPOEA_V2_CHECK(runner, history.size() == 3u, "non-finite objectives are dropped");
+
+    const auto best = history.best(bowl_key(), 5);
+    HPOEA_V2_REQUIRE(runner, best.size() == 2u, "best returns the key's trials");
+    HPOEA_V2_CHECK(runner, best[0].objective == 0.5 && best[1].objective == 3.0, "best sorts by objective");
+    HPOEA_V2_CHECK(runner, history.best(bowl_key(), 1).size() == 1u, "best caps the count");
+    HPOEA_V2_CHECK(runner, history.best(bowl_key("missing"), 5).empty(), "unknown keys have no trials");
+
+    const auto path = unique_test_path("hpoea_trial_history") += ".bin";
+    history.save(path);
+    auto reopened = hpoea::core::TrialHistory::open(path);
+    HPOEA_V2_CHECK(runner, reopened.size() == 3u, "open indexes every saved trial");
+    const auto mapped = reopened.best(bowl_key(), 5);
+    HPOEA_V2_REQUIRE(runner, mapped.size() == 2u, "mapped trials keep their key");
+    HPOEA_V2_CHECK(runner,
+                   hpoea::tests_v2::parameter_set_equals(mapped[0].parameters, best[0].parameters) &&
+                       mapped[0].objective == 0.5,
+                   "parameters of every type survive the file");
+
+    reopened.add(bowl_key(), bowl_parameters(3.0, 6, "c", false), 0.25);
+    const auto merged = reopened.best(bowl_key(), 2);
+    HPOEA_V2_CHECK(runner, merged.size() == 2u && merged[0].objective == 0.25 && merged[1].objective == 0.5,
+                   "added trials merge with mapped ones");
+
+    const auto resaved = unique_test_path("hpoea_trial_history_resaved") += ".bin";
+    reopened.save(resaved);
+    HPOEA_V2_CHECK(runner, hpoea::core::TrialHistory::open(resaved).best(bowl_key(), 8).size() == 3u,
+                   "a mapped history saves with its additions");
+
+#if !defined(_WIN32)
+    reopened.save(path);
+    const auto still_mapped = reopened.best(bowl_key(), 8);
+    HPOEA_V2_CHECK(runner, still_mapped.size() == 3u && still_mapped[1].objective == 0.5 &&
+                               hpoea::tests_v2::parameter_set_equals(still_mapped[1].parameters, best[0].parameters),
+                   "saving over the mapped file leaves the open history intact");
+    HPOEA_V2_CHECK(runner, hpoea::core::TrialHistory::open(path).best(bowl_key(), 8).size() == 3u &&
+                               !std::filesystem::exists(std::filesystem::path(path) += ".tmp"),
+                   "saving over the mapped file replaces it");
+#endif
+
+    {
+        std::ofstream truncated(path, std::ios::binary | std::ios::trunc);
+        truncated << "HPOEATH1";
+    }
+    bool rejected = false;
+    try {
+        (void)hpoea::core::TrialHistory::open(path);
+    } catch (const std::runtime_error &) {
+        rejected = true;
+    }
+    HPOEA_V2_CHECK(runner, rejected, "a truncated file is rejected");
+    std::filesystem::remove(path);
+    std::filesystem::remove(resaved);
+}
+
+void test_large_file(hpoea::tests_v2::TestRunner &runner) {
+    constexpr std::size_t count = 200000;
+    hpoea::core::TrialHistory history;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto key = bowl_key("problem_" + std::to_string(i % 4u));
+        history.add(key, bowl_parameters(static_cast<double>(i % 400u) / 100.0, 1, "a", false),
+                    static_cast<double>((i * 7919u) % count));
+    }
+    const auto path = unique_test_path("hpoea_trial_history_large") += ".bin";
+    history.save(path);
+
+    const auto reopened = hpoea::core::TrialHistory::open(path);
+    HPOEA_V2_CHECK(runner, reopened.size() == count, "a large file opens with every trial indexed");
+    const auto top = reopened.best(bowl_key("problem_1"), 3);
+    HPOEA_V2_CHECK(runner, top.size() == 3u && top[0].objective <= top[1].objective &&
+                               top[1].objective <= top[2].objective,
+                   "queries on a large file return sorted trials");
+    std::filesystem::remove(path);
+}
+
+void test_jsonl(hpoea::tests_v2::TestRunner &runner) {
+    const auto path = unique_test_path("hpoea_trial_history_log") += ".jsonl";
+    std::filesystem::remove(path);
+    {
+        hpoea::core::JsonlLogger logger(path);
+        hpoea::core::RunRecord record;
+        record.problem_id = "dummy";
+        record.evolutionary_algorithm = make_factory().identity();
+        record.status = hpoea::core::RunStatus::Success;
+        record.algorithm_parameters = bowl_parameters(3.0, 6, "c", true);
+        record.objective_value = 0.125;
+        logger.log(record);
+
+        record.algorithm_parameters = bowl_parameters(1.5, 2, "b", false);
+        record.status = hpoea::core::RunStatus::FailedEvaluation;
+        logger.log(record);
+
+        record.status = hpoea::core::RunStatus::Success;
+        record.phase = hpoea::core::RunPhase::Validation;
+        logger.log(record);
+
+        record.phase = hpoea::core::RunPhase::Tuning;
+        record.objective_value = std::numeric_limits<double>::infinity();
+        logger.log(record);
+
+        record.algorithm_parameters = bowl_parameters(0.75, 3, "a\n\"quoted\"", true);
+        record.objective_value = 2.0;
+        logger.log(record);
+    }
+
+    auto history = std::make_shared<hpoea::core::TrialHistory>();
+    const auto fingerprint = hpoea::core::search_space_fingerprint(make_algorithm_space(), nullptr);
+    HPOEA_V2_CHECK(runner, history->load_jsonl(path, fingerprint) == 2u,
+                   "only finite successful tuning records load");
+    const auto best = history->best(bowl_key(), 4);
+    HPOEA_V2_REQUIRE(runner, best.size() == 2u, "logged trials file under the given fingerprint");
+    HPOEA_V2_CHECK(runner, std::holds_alternative<std::int64_t>(best[0].parameters.at("rate")),
+                   "whole-valued doubles read back as integers");
+    HPOEA_V2_CHECK(runner, std::get<std::string>(best[1].parameters.at("mode")) == "a\n\"quoted\"",
+                   "escaped strings read back");
+
+    // random search re-runs the best prior first, converted back to a double
+    hpoea::tests_v2::DummyProblem problem(2);
+    auto factory = make_factory();
+    hpoea::core::RandomSearchOptimizer optimizer;
+    hpoea::core::ParameterSet params;
+    params.emplace("sample_count", std::int64_t{4});
+    optimizer.configure(params);
+    optimizer.set_trial_history(history, 1);
+    const auto result = optimizer.optimize(factory, problem, {}, {}, 11UL);
+    HPOEA_V2_REQUIRE(runner, result.status == hpoea::core::RunStatus::Success && result.trials.size() == 4u,
+                     "warm-started random search succeeds");
+    HPOEA_V2_CHECK(runner,
+                   hpoea::tests_v2::parameter_set_equals(result.trials[0].parameters,
+                                                         bowl_parameters(3.0, 6, "c", true)),
+                   "the first trial re-runs the best prior");
+    HPOEA_V2_CHECK(runner, result.best_objective == 0.0, "the prior is the incumbent");
+
+    {
+        std::ofstream broken(path, std::ios::app);
+        broken << "{\"phase\":\n";
+    }
+    bool rejected = false;
+    try {
+        (void)hpoea::core::TrialHistory{}.load_jsonl(path, fingerprint);
+    } catch (const std::runtime_error &) {
+        rejected = true;
+    }
+    HPOEA_V2_CHECK(runner, rejected, "a malformed line is rejected");
+    std::filesystem::remove(path);
+}
+
+void test_model_priors(hpoea::tests_v2::TestRunner &runner) {
+    hpoea::tests_v2::DummyProblem problem(2);
+    auto factory = make_factory();
+    auto history = std::make_shared<hpoea::core::TrialHistory>();
+    history->add(bowl_key(), bowl_parameters(3.0, 6, "c", true), 0.0);
+    history->add(bowl_key(), bowl_parameters(2.8, 5, "c", true), 0.09);
+    // a trial from another search space never reaches the optimizer
+    history->add({factory.identity(), "dummy", 1u}, bowl_parameters(0.0, 1, "a", false), -100.0);
+
+    hpoea::core::ParameterSet params;
+    params.emplace("sample_count", std::int64_t{12});
+
+    hpoea::core::TpeOptimizer cold;
+    cold.configure(params);
+    hpoea::core::TpeOptimizer warm;
+    warm.configure(params);
+    warm.set_trial_history(history);
+    const auto cold_result = cold.optimize(factory, problem, {}, {}, 4UL);
+    const auto warm_result = warm.optimize(factory, problem, {}, {}, 4UL);
+    HPOEA_V2_CHECK(runner, warm_result.status == hpoea::core::RunStatus::Success &&
+                               warm_result.trials.size() == 12u,
+                   "priors do not change the tpe trial count");
+    HPOEA_V2_CHECK(runner, warm_result.best_objective < cold_result.best_objective,
+                   "tpe priors steer proposals toward the earlier best");
+
+    hpoea::core::BayesianOptimizer bayesian;
+    hpoea::core::ParameterSet bayesian_params;
+    bayesian_params.emplace("sample_count", std::int64_t{8});
+    bayesian.configure(bayesian_params);
+    bayesian.set_trial_history(history);
+    const auto bayesian_result = bayesian.optimize(factory, problem, {}, {}, 4UL);
+    HPOEA_V2_CHECK(runner, bayesian_result.status == hpoea::core::RunStatus::Success &&
+                               bayesian_result.trials.size() == 8u,
+                   "bayesian optimization runs with priors");
+    HPOEA_V2_CHECK(runner, bayesian_result.best_objective > -1.0, "foreign-space trials are ignored");
+}
+
+} // namespace
+
+int main() {
+    hpoea::tests_v2::TestRunner runner;
+    test_fingerprint(runner);
+    test_store(runner);
+    test_large_file(runner);
+    test_jsonl(runner);
+    test_model_priors(runner);
+    return runner.summarize("trial_history_tests");
+}